@@ -25,6 +25,12 @@
                                   will be copied into an 8-byte aligned memory region associated
                                   with each in-flight request, default value is 16 (== 128 bytes)
     SFETCH_MAX_CHANNELS         - max number of IO channels (default is 16, also see sfetch_desc_t.num_channels)
+    SFETCH_USE_IO_URING         - on Linux, issue the file reads of all active lanes of a channel
+                                  through an io_uring instead of blocking pread() calls (requires
+                                  the <linux/io_uring.h> kernel header, falls back to pread() at
+                                  runtime if the kernel doesn't support io_uring)
+    SFETCH_MAX_PACKS            - max number of mounted pack files (default is 8, see sfetch_mount_pack())
+    SFETCH_NUM_PRIORITIES       - number of request priority levels (default is 4, see sfetch_request_t.priority)
 
     If sokol_fetch.h is compiled as a DLL, define the following before
     including the declaration or implementation:
@@ -228,7 +234,7 @@
             Pointer to an UTF-8 encoded C string describing the filesystem
             path or HTTP URL. The string will be copied into an internal data
             structure, and passed "as is" (apart from any required
-            encoding-conversions) to fopen(), CreateFileW() or
+            encoding-conversions) to open(), CreateFileW() or
             XMLHttpRequest. The maximum length of the string is defined by
             the SFETCH_MAX_PATH configuration define, the default is 1024 bytes
             including the 0-terminator byte.
@@ -255,6 +261,35 @@
             important information how streaming works if the web server
             is serving compressed data.
 
+        - offset (uint64_t, optional)
+            The byte offset in the file where loading should start, the
+            default is 0. Together with 'size' this allows to load or
+            stream just a part of a file. Search below for LOADING
+            BYTE RANGES AND LARGE FILES.
+
+        - size (uint64_t, optional)
+            The number of bytes to load starting at 'offset'. The default
+            is 0, which means 'up to the end of the file'.
+
+        - memory_map (bool, optional)
+            If true, the file (or the byte range described by offset and
+            size) is mapped into memory instead of being loaded into a
+            buffer. Memory-mapped requests can't have a buffer or a
+            chunk_size. Search below for MEMORY-MAPPED FILES.
+
+        - priority (uint32_t, optional)
+            Requests with a higher priority are dispatched to their channel
+            before requests with a lower priority, requests with the same
+            priority are dispatched in the order they were sent. The default
+            priority is 0 (the lowest), the highest is SFETCH_NUM_PRIORITIES-1.
+            Search below for REQUEST PRIORITIES AND COALESCING.
+
+        - coalesce (bool, optional)
+            If true, and another request for the same path and byte range is
+            already in flight, the request piggybacks on that request instead
+            of reading the file again. Can't be combined with chunk_size or
+            memory_map. Search below for REQUEST PRIORITIES AND COALESCING.
+
         - buffer (sfetch_range_t)
             This is a optional pointer/size pair describing a chunk of memory where
             data will be loaded into (if no buffer is provided upfront, this
@@ -397,6 +432,26 @@
             }
         }
 
+    sfetch_mapping_t sfetch_keep_mapping(sfetch_handle_t request)
+    -------------------------------------------------------------
+    Takes ownership of the mapped file data of a memory-mapped request,
+    the data will then stay mapped after the last response callback until
+    it is released with sfetch_release_mapping(). Must be called from
+    inside the response callback.
+
+    void sfetch_release_mapping(const sfetch_mapping_t* mapping)
+    ------------------------------------------------------------
+    Unmaps file data obtained with sfetch_keep_mapping(). This can be
+    called on any thread.
+
+    bool sfetch_mount_pack(const char* path)
+    ----------------------------------------
+    Opens a pack file and reads its index, the paths of all following
+    requests are then looked up in the pack file before going to the
+    filesystem (see the section PACK FILES below). Returns false if the
+    pack file can't be opened or isn't a valid pack file. Mounted pack
+    files stay open until sfetch_shutdown().
+
     sfetch_desc_t sfetch_desc(void)
     -------------------------------
     sfetch_desc() returns a copy of the sfetch_desc_t struct passed to
@@ -491,7 +546,8 @@
             - data.size: the number of bytes in the provided buffer
             - data_offset: the byte offset of the loaded data chunk in the
               overall file (this is only set to a non-zero value in a streaming
-              scenario)
+              scenario, or when loading a byte range with a non-zero
+              request.offset)
 
         Once all file data has been loaded, the 'finished' flag will be set
         in the response callback's sfetch_response_t argument.
@@ -637,6 +693,143 @@
     the request will fail with error code SFETCH_ERROR_BUFFER_TOO_SMALL.
 
 
+    LOADING BYTE RANGES AND LARGE FILES
+    ===================================
+    All file offsets and sizes are 64-bit, so files bigger than 4 GB
+    can be streamed in chunks (or loaded in one go if you can afford
+    a big enough buffer).
+
+    Instead of the whole file, a request can also load just a byte range
+    by providing a start offset and an optional size:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "assets.pak",
+            .callback = response_callback,
+            .offset = entry_offset,
+            .size = entry_size,
+            .buffer = { .ptr = buf, .size = entry_size },
+        });
+
+    This is useful to load a single asset out of a pack file, or to resume
+    streaming at an arbitrary position. Combined with a chunk_size, the
+    byte range is streamed in chunks. The response's data_offset is always
+    the position of the fetched data in the whole file (so the first
+    response of above request has data_offset == entry_offset).
+
+    If the byte range doesn't fit into the file, the request fails with
+    SFETCH_ERROR_UNEXPECTED_EOF. On the web platform byte ranges are
+    loaded with HTTP range requests, if the range size isn't known
+    upfront, a HEAD request is sent first to query the file size.
+
+    On 32-bit POSIX platforms, compile with -D_FILE_OFFSET_BITS=64,
+    otherwise files bigger than 2 GB can't be loaded.
+
+
+    MEMORY-MAPPED FILES
+    ===================
+    Loading a big file in one go requires a buffer at least the size
+    of the file, and the data is copied into that buffer. If your code
+    parses the file data in place, you can avoid both by setting the
+    memory_map flag in the request. The file is then mapped into memory
+    on the IO thread (via mmap() or MapViewOfFile()), and the response
+    callback gets the mapped data in response->data:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "assets.pak",
+            .callback = response_callback,
+            .memory_map = true,
+        });
+
+        void response_callback(const sfetch_response_t* response) {
+            if (response->fetched) {
+                parse_in_place(response->data.ptr, response->data.size);
+            }
+        }
+
+    The mapped data is read-only, and it is unmapped right after the last
+    response callback returns. To keep the data around for longer, call
+    sfetch_keep_mapping() in the response callback and release the data
+    with sfetch_release_mapping() when it's no longer needed:
+
+        static sfetch_mapping_t mapping;
+
+        void response_callback(const sfetch_response_t* response) {
+            if (response->fetched) {
+                mapping = sfetch_keep_mapping(response->handle);
+            }
+        }
+        ...
+        sfetch_release_mapping(&mapping);
+
+    Memory-mapped requests can be combined with the offset and size
+    request parameters to map a byte range of a file, but they can't
+    be streamed in chunks and they don't need (and can't have) a buffer.
+    Pages are loaded on demand by the operating system when the data is
+    accessed, so the first access to the data may stall on disk IO.
+
+    If mapping the file fails, the request fails with error code
+    SFETCH_ERROR_MEMORY_MAP_FAILED. Memory-mapped requests are not
+    supported on the web platform.
+
+
+    PACK FILES
+    ==========
+    Opening a file is much more expensive than reading a few kilobytes
+    from a file that's already open. If your game loads thousands of small
+    files, bundle them into a pack file with the sfetch-pack command line
+    tool (see util/sfetch_pack.c):
+
+        sfetch-pack -C data game.pack textures/hero.png sounds/jump.wav ...
+
+    ...and mount the pack file after sfetch_setup():
+
+        sfetch_mount_pack("game.pack");
+
+    The path of each request is then looked up in the mounted pack files
+    (in reverse mount order, so a pack file mounted later overrides
+    files of a pack file mounted earlier), and if the path is found, the
+    file data is read from the already open pack file. Paths which aren't
+    found in any mounted pack file are loaded from the filesystem as usual.
+    The path of a request must match the path stored in the pack file
+    exactly, there's no normalization except that sfetch-pack stores
+    Windows-style backslashes as forward slashes.
+
+    Everything else works the same as with regular files: requests can
+    be streamed in chunks, load a byte range of the packed file, or
+    memory-map the packed file (the offset in the response refers to
+    the start of the packed file, not the start of the pack file).
+
+    The pack file format is simple enough to write your own packer
+    (all values are little-endian):
+
+        header (16 bytes):
+            char magic[4]       - "SFPK"
+            uint32_t version    - 2
+            uint32_t num_entries
+            uint32_t alignment  - alignment of the file data in bytes
+        entries (num_entries * 32 bytes, sorted by ascending path hash):
+            uint64_t path_hash  - 64-bit FNV-1a hash of the UTF-8 path
+            uint64_t offset     - start of the file data from the start of the pack file
+            uint64_t size       - size of the file data in bytes
+            uint32_t path_offset - start of the path in the path table
+            uint32_t path_length - length of the path in bytes, without the zero terminator
+        path table, directly after the entries:
+            the zero-terminated UTF-8 paths of all entries
+        file data, each file starting at a multiple of the alignment
+
+    Lookups go through the path hash, and a hash match is confirmed by
+    comparing the path with the path in the path table. Two paths with
+    the same hash can't go into the same pack file (sfetch-pack checks
+    this). sfetch-pack also rejects absolute paths and paths with '..'
+    components.
+
+    sfetch_mount_pack() must be called on the same thread as sfetch_setup(),
+    it allocates memory for the pack file index through the sokol-fetch
+    allocator (see MEMORY ALLOCATION OVERRIDE). At most SFETCH_MAX_PACKS
+    pack files can be mounted at the same time (default: 8). Pack files
+    are not supported on the web platform.
+
+
     CHANNELS AND LANES
     ==================
     Channels and lanes are (somewhat artificial) concepts to manage
@@ -700,6 +893,59 @@
         }
 
 
+    REQUEST PRIORITIES AND COALESCING
+    =================================
+    Within a channel, requests wait in the order they were sent until a lane
+    becomes free. A request which is needed right now (for instance the
+    texture the player is looking at) would have to wait behind all
+    background requests which were sent before it. To prevent this, give
+    the request a higher priority:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "hero.png",
+            .callback = response_callback,
+            .priority = 3,
+        });
+
+    Whenever a lane becomes free, the waiting request with the highest
+    priority is dispatched next. The priority only affects the order of
+    dispatching, a request which already occupies a lane isn't interrupted
+    by requests with a higher priority. The number of priority levels is
+    configured with the SFETCH_NUM_PRIORITIES define (default: 4, so the
+    valid priorities are 0, 1, 2 and 3).
+
+    When different parts of your code request the same file at the same
+    time, the file is read once per request. Requests which have the
+    coalesce flag set are instead attached to an in-flight request
+    for the same path and byte range (if one exists), and they are
+    finished together with that request, without reading the file
+    again and without occupying a lane:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "shared.bin",
+            .callback = response_callback,
+            .coalesce = true,
+        });
+
+    If the coalesced request has a buffer, the fetched data is copied
+    into that buffer (and the request fails with SFETCH_ERROR_BUFFER_TOO_SMALL
+    if the buffer is too small). If the coalesced request has no buffer,
+    response->data points into the buffer of the request which actually
+    read the file, this data is only valid until the response callback
+    returns. Coalesced requests are finished right before the request
+    which read the file, and they get the same error code when the file
+    couldn't be read. If that request fails for other reasons (for
+    instance because it was cancelled), the attached requests are sent
+    to their channel again and load the file themselves.
+
+    A request is only attached to another request if that request loads
+    the whole byte range in one go (no chunk_size and no memory_map), and,
+    if it is still waiting for a lane, has at least the same priority.
+    Pausing a request also pauses all requests attached to it, and a
+    cancelled coalesced request only finishes together with the request
+    it is attached to.
+
+
     NOTES ON OPTIMIZING PIPELINE LATENCY AND THROUGHPUT
     ===================================================
     With the default configuration of 1 channel and 1 lane per channel,
@@ -802,6 +1048,21 @@
     thread, but this is mainly an implementation detail to work around
     the blocking traditional file IO functions, not for performance reasons.
 
+    The IO thread of a channel doesn't process one request at a time,
+    instead it picks up the requests of all lanes that are waiting for
+    data and issues their file reads as one batch. By default the reads
+    of a batch are performed one after another with pread() (or ReadFile()
+    on Windows), but on Linux you can define SFETCH_USE_IO_URING before
+    including the implementation to submit the whole batch to the kernel
+    through an io_uring. The reads of a batch then overlap and complete in
+    any order, and each request is handed back to the user thread as soon
+    as its own read has completed. This means that a single channel with
+    many lanes is enough to keep a fast SSD busy, there's no need to spread
+    requests over many channels (and thus threads) just to get more reads
+    in flight. If the io_uring can't be created at runtime (for instance
+    on older kernels, or when io_uring has been disabled by a seccomp
+    filter), sokol_fetch.h silently falls back to pread().
+
 
     MEMORY ALLOCATION OVERRIDE
     ==========================
@@ -962,11 +1223,23 @@ extern "C" {
     _SFETCH_LOGITEM_XMACRO(REQUEST_PATH_TOO_LONG, "file path is too long (SFETCH_MAX_PATH)") \
     _SFETCH_LOGITEM_XMACRO(REQUEST_CALLBACK_MISSING, "no callback provided (sfetch_request_t.callback)") \
     _SFETCH_LOGITEM_XMACRO(REQUEST_CHUNK_SIZE_GREATER_BUFFER_SIZE, "chunk size is greater buffer size (sfetch_request_t.chunk_size vs .buffer.size)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_RANGE_OVERFLOW, "byte range overflows (sfetch_request_t.offset + .size)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_RANGE_SIZE_GREATER_BUFFER_SIZE, "range size is greater buffer size when loading without chunks (sfetch_request_t.size vs .buffer.size)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_MEMORY_MAP_WITH_CHUNK_SIZE, "memory-mapped requests can't be streamed (sfetch_request_t.memory_map vs .chunk_size)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_MEMORY_MAP_WITH_BUFFER, "memory-mapped requests don't load into a buffer (sfetch_request_t.memory_map vs .buffer)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_MEMORY_MAP_NOT_SUPPORTED, "memory-mapped requests are not supported on this platform (sfetch_request_t.memory_map)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_PRIORITY_TOO_BIG, "request priority too big (see SFETCH_NUM_PRIORITIES)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_COALESCE_WITH_CHUNK_SIZE, "coalesced requests can't be streamed (sfetch_request_t.coalesce vs .chunk_size)") \
+    _SFETCH_LOGITEM_XMACRO(REQUEST_COALESCE_WITH_MEMORY_MAP, "coalesced requests can't be memory-mapped (sfetch_request_t.coalesce vs .memory_map)") \
     _SFETCH_LOGITEM_XMACRO(REQUEST_USERDATA_PTR_IS_SET_BUT_USERDATA_SIZE_IS_NULL, "user data ptr is set but user data size is null (sfetch_request_t.user_data.ptr vs .size)") \
     _SFETCH_LOGITEM_XMACRO(REQUEST_USERDATA_PTR_IS_NULL_BUT_USERDATA_SIZE_IS_NOT, "user data ptr is null but size is not (sfetch_request_t.user_data.ptr vs .size)") \
     _SFETCH_LOGITEM_XMACRO(REQUEST_USERDATA_SIZE_TOO_BIG, "user data size too big (see SFETCH_MAX_USERDATA_UINT64)") \
     _SFETCH_LOGITEM_XMACRO(CLAMPING_NUM_CHANNELS_TO_MAX_CHANNELS, "clamping num channels to SFETCH_MAX_CHANNELS") \
     _SFETCH_LOGITEM_XMACRO(REQUEST_POOL_EXHAUSTED, "request pool exhausted (tweak via sfetch_desc_t.max_requests)") \
+    _SFETCH_LOGITEM_XMACRO(PACK_TOO_MANY_PACKS, "too many mounted pack files (see SFETCH_MAX_PACKS)") \
+    _SFETCH_LOGITEM_XMACRO(PACK_OPEN_FAILED, "failed to open pack file (sfetch_mount_pack())") \
+    _SFETCH_LOGITEM_XMACRO(PACK_INVALID, "not a valid pack file, or the pack file is damaged (sfetch_mount_pack())") \
+    _SFETCH_LOGITEM_XMACRO(PACK_NOT_SUPPORTED, "pack files are not supported on this platform (sfetch_mount_pack())") \
 
 #define _SFETCH_LOGITEM_XMACRO(item,msg) SFETCH_LOGITEM_##item,
 typedef enum sfetch_log_item_t {
@@ -1049,7 +1322,8 @@ typedef enum sfetch_error_t {
     SFETCH_ERROR_BUFFER_TOO_SMALL,
     SFETCH_ERROR_UNEXPECTED_EOF,
     SFETCH_ERROR_INVALID_HTTP_STATUS,
-    SFETCH_ERROR_CANCELLED
+    SFETCH_ERROR_CANCELLED,
+    SFETCH_ERROR_MEMORY_MAP_FAILED
 } sfetch_error_t;
 
 /* the response struct passed to the response callback */
@@ -1066,7 +1340,7 @@ typedef struct sfetch_response_t {
     uint32_t lane;                  // the lane this request occupies on its channel
     const char* path;               // the original filesystem path of the request
     void* user_data;                // pointer to read/write user-data area
-    uint32_t data_offset;           // current offset of fetched data chunk in the overall file data
+    uint64_t data_offset;           // current offset of fetched data chunk in the overall file data
     sfetch_range_t data;            // the fetched data as ptr/size pair (data.ptr == buffer.ptr, data.size <= buffer.size)
     sfetch_range_t buffer;          // the user-provided buffer which holds the fetched data
 } sfetch_response_t;
@@ -1074,12 +1348,24 @@ typedef struct sfetch_response_t {
 /* response callback function signature */
 typedef void(*sfetch_callback_t)(const sfetch_response_t*);
 
+/* a memory-mapped file range, returned by sfetch_keep_mapping() */
+typedef struct sfetch_mapping_t {
+    sfetch_range_t data;            // the mapped file data (same as sfetch_response_t.data)
+    void* base_ptr;                 // internal: start of the page-aligned mapping
+    size_t base_size;               // internal: size of the page-aligned mapping
+} sfetch_mapping_t;
+
 /* request parameters passed to sfetch_send() */
 typedef struct sfetch_request_t {
     uint32_t channel;               // index of channel this request is assigned to (default: 0)
     const char* path;               // filesystem path or HTTP URL (required)
     sfetch_callback_t callback;     // response callback function pointer (required)
     uint32_t chunk_size;            // number of bytes to load per stream-block (optional)
+    uint64_t offset;                // byte offset in the file where loading starts (optional)
+    uint64_t size;                  // number of bytes to load starting at offset, 0 means up to the end of file (optional)
+    bool memory_map;                // map the file into memory instead of loading it into a buffer (optional)
+    uint32_t priority;              // dispatch priority, 0 (default) is lowest, SFETCH_NUM_PRIORITIES-1 is highest (optional)
+    bool coalesce;                  // share the read of an in-flight request for the same file and byte range (optional)
     sfetch_range_t buffer;          // a memory buffer where the data will be loaded into (optional)
     sfetch_range_t user_data;       // ptr/size of a POD user data block which will be memcpy'd (optional)
 } sfetch_request_t;
@@ -1114,6 +1400,12 @@ SOKOL_FETCH_API_DECL void sfetch_cancel(sfetch_handle_t h);
 SOKOL_FETCH_API_DECL void sfetch_pause(sfetch_handle_t h);
 /* continue a paused request */
 SOKOL_FETCH_API_DECL void sfetch_continue(sfetch_handle_t h);
+/* take ownership of the mapped file data of a memory-mapped request, must be called from response callback */
+SOKOL_FETCH_API_DECL sfetch_mapping_t sfetch_keep_mapping(sfetch_handle_t h);
+/* unmap file data obtained with sfetch_keep_mapping() (can be called on any thread) */
+SOKOL_FETCH_API_DECL void sfetch_release_mapping(const sfetch_mapping_t* mapping);
+/* mount a pack file, the paths of following requests are looked up in the pack file first */
+SOKOL_FETCH_API_DECL bool sfetch_mount_pack(const char* path);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -1151,6 +1443,12 @@ inline sfetch_handle_t sfetch_send(const sfetch_request_t& request) { return sfe
 #ifndef SFETCH_MAX_CHANNELS
 #define SFETCH_MAX_CHANNELS (16)
 #endif
+#ifndef SFETCH_MAX_PACKS
+#define SFETCH_MAX_PACKS (8)
+#endif
+#ifndef SFETCH_NUM_PRIORITIES
+#define SFETCH_NUM_PRIORITIES (4)
+#endif
 
 #ifndef SOKOL_API_IMPL
     #define SOKOL_API_IMPL
@@ -1197,12 +1495,24 @@ inline sfetch_handle_t sfetch_send(const sfetch_request_t& request) { return sfe
     #define _SFETCH_HAS_THREADS (1)
 #else
     #include <pthread.h>
-    #include <stdio.h>  /* fopen, fread, fseek, fclose */
+    #include <errno.h>      /* errno, EINTR */
+    #include <fcntl.h>      /* open */
+    #include <unistd.h>     /* pread, close */
+    #include <sys/stat.h>   /* fstat */
+    #include <sys/mman.h>   /* mmap, munmap */
     #define _SFETCH_PLATFORM_POSIX (1)
     #define _SFETCH_PLATFORM_EMSCRIPTEN (0)
     #define _SFETCH_PLATFORM_WINDOWS (0)
     #define _SFETCH_HAS_THREADS (1)
 #endif
+#if _SFETCH_PLATFORM_POSIX && defined(__linux__) && defined(SFETCH_USE_IO_URING)
+    #include <linux/io_uring.h>
+    #include <sys/syscall.h>    /* __NR_io_uring_setup, __NR_io_uring_enter */
+    #include <sched.h>          /* sched_yield */
+    #define _SFETCH_USE_IO_URING (1)
+#else
+    #define _SFETCH_USE_IO_URING (0)
+#endif
 
 // ███████ ████████ ██████  ██    ██  ██████ ████████ ███████
 // ██         ██    ██   ██ ██    ██ ██         ██    ██
@@ -1242,8 +1552,8 @@ typedef struct {
 
 /* file handle abstraction */
 #if _SFETCH_PLATFORM_POSIX
-typedef FILE* _sfetch_file_handle_t;
-#define _SFETCH_INVALID_FILE_HANDLE (0)
+typedef int _sfetch_file_handle_t;
+#define _SFETCH_INVALID_FILE_HANDLE (-1)
 typedef void*(*_sfetch_thread_func_t)(void*);
 #elif _SFETCH_PLATFORM_WINDOWS
 typedef HANDLE _sfetch_file_handle_t;
@@ -1251,17 +1561,45 @@ typedef HANDLE _sfetch_file_handle_t;
 typedef LPTHREAD_START_ROUTINE _sfetch_thread_func_t;
 #endif
 
+/* a Linux io_uring, owned by the IO thread of a channel */
+#if _SFETCH_USE_IO_URING
+typedef struct {
+    int fd;
+    uint32_t num_entries;
+    /* submission queue */
+    uint32_t* sq_head;
+    uint32_t* sq_tail;
+    uint32_t* sq_mask;
+    uint32_t* sq_array;
+    struct io_uring_sqe* sqes;
+    /* completion queue */
+    uint32_t* cq_head;
+    uint32_t* cq_tail;
+    uint32_t* cq_mask;
+    struct io_uring_cqe* cqes;
+    /* mmapped regions */
+    void* sq_map;
+    size_t sq_map_size;
+    void* cq_map;
+    size_t cq_map_size;
+    size_t sqes_map_size;
+    bool valid;
+} _sfetch_uring_t;
+#endif
+
 /* user-side per-request state */
 typedef struct {
     bool pause;                 /* switch item to PAUSED state if true */
     bool cont;                  /* switch item back to FETCHING if true */
     bool cancel;                /* cancel the request, switch into FAILED state */
     /* transfer IO => user thread */
-    uint32_t fetched_offset;    /* number of bytes fetched so far */
-    uint32_t fetched_size;      /* size of last fetched chunk */
+    uint64_t fetched_offset;    /* number of bytes fetched so far */
+    uint64_t fetched_size;      /* size of last fetched chunk */
     sfetch_error_t error_code;
     bool finished;
+    sfetch_mapping_t mapping;   /* memory-mapped file data, unmapped after the last callback */
     /* user thread only */
+    sfetch_range_t coalesced_data;  /* data of the request this request is attached to (if it has no buffer) */
     size_t user_data_size;
     uint64_t user_data[SFETCH_MAX_USERDATA_UINT64];
 } _sfetch_item_user_t;
@@ -1269,18 +1607,24 @@ typedef struct {
 /* thread-side per-request state */
 typedef struct {
     /* transfer IO => user thread */
-    uint32_t fetched_offset;
-    uint32_t fetched_size;
+    uint64_t fetched_offset;    /* relative to the start of the requested byte range */
+    uint64_t fetched_size;
     sfetch_error_t error_code;
     bool failed;
     bool finished;
+    sfetch_mapping_t mapping;
     /* IO thread only */
     #if _SFETCH_PLATFORM_EMSCRIPTEN
-    uint32_t http_range_offset;
+    uint64_t http_range_offset;
     #else
     _sfetch_file_handle_t file_handle;
+    bool file_in_pack;          /* file_handle is the handle of a mounted pack file, don't close */
+    /* the next read, set up by the request handler and issued as part of a batch */
+    uint64_t read_offset;
+    uint64_t read_size;
+    bool read_pending;
     #endif
-    uint32_t content_size;
+    uint64_t content_size;      /* size of the requested byte range */
 } _sfetch_item_thread_t;
 
 /* a request goes through the following states, ping-ponging between IO and user thread */
@@ -1302,8 +1646,21 @@ typedef struct {
     uint32_t channel;
     uint32_t lane;
     uint32_t chunk_size;
+    uint64_t range_offset;
+    uint64_t range_size;
+    bool memory_map;
+    uint32_t priority;
+    bool coalesce;
+    bool coalesced;             /* attached to another request which reads the file */
+    uint32_t next_coalesced;    /* slot id of the next request attached to the same request */
     sfetch_callback_t callback;
     sfetch_range_t buffer;
+    #if _SFETCH_HAS_THREADS
+    /* location of the file data if the path was found in a mounted pack file */
+    _sfetch_file_handle_t pack_file_handle;
+    uint64_t pack_offset;
+    uint64_t pack_size;
+    #endif
 
     /* updated by IO-thread, off-limits to user thread */
     _sfetch_item_thread_t thread;
@@ -1338,18 +1695,41 @@ struct _sfetch_t;
 typedef struct {
     struct _sfetch_t* ctx;  // back-pointer to thread-local _sfetch state pointer, since this isn't accessible from the IO threads
     _sfetch_ring_t free_lanes;
-    _sfetch_ring_t user_sent;
+    _sfetch_ring_t user_sent[SFETCH_NUM_PRIORITIES];  // one queue per priority level
     _sfetch_ring_t user_incoming;
     _sfetch_ring_t user_outgoing;
     #if _SFETCH_HAS_THREADS
     _sfetch_ring_t thread_incoming;
     _sfetch_ring_t thread_outgoing;
     _sfetch_thread_t thread;
+    uint32_t num_lanes;
+    uint32_t* thread_batch;     // IO thread only: slot ids of the current batch of requests
+    #endif
+    #if _SFETCH_USE_IO_URING
+    _sfetch_uring_t uring;
     #endif
     void (*request_handler)(struct _sfetch_t* ctx, uint32_t slot_id);
     bool valid;
 } _sfetch_channel_t;
 
+/* a mounted pack file, the entries are sorted by path hash */
+#if _SFETCH_HAS_THREADS
+typedef struct {
+    uint64_t path_hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t path_offset;   // offset of the path in the path table
+    uint32_t path_length;   // length of the path without the zero terminator
+} _sfetch_pack_entry_t;
+
+typedef struct {
+    _sfetch_file_handle_t file_handle;
+    uint32_t num_entries;
+    _sfetch_pack_entry_t* entries;
+    char* paths;            // the zero-terminated paths of all entries
+} _sfetch_pack_t;
+#endif
+
 /* the sfetch global state */
 typedef struct _sfetch_t {
     bool setup;
@@ -1358,6 +1738,10 @@ typedef struct _sfetch_t {
     sfetch_desc_t desc;
     _sfetch_pool_t pool;
     _sfetch_channel_t chn[SFETCH_MAX_CHANNELS];
+    #if _SFETCH_HAS_THREADS
+    uint32_t num_packs;
+    _sfetch_pack_t packs[SFETCH_MAX_PACKS];
+    #endif
 } _sfetch_t;
 #if _SFETCH_HAS_THREADS
 #if defined(_MSC_VER)
@@ -1595,12 +1979,18 @@ _SOKOL_PRIVATE void _sfetch_item_init(_sfetch_item_t* item, uint32_t slot_id, co
     item->state = _SFETCH_STATE_INITIAL;
     item->channel = request->channel;
     item->chunk_size = request->chunk_size;
+    item->range_offset = request->offset;
+    item->range_size = request->size;
+    item->memory_map = request->memory_map;
+    item->priority = request->priority;
+    item->coalesce = request->coalesce;
     item->lane = _SFETCH_INVALID_LANE;
     item->callback = request->callback;
     item->buffer = request->buffer;
     item->path = _sfetch_path_make(request->path);
     #if !_SFETCH_PLATFORM_EMSCRIPTEN
     item->thread.file_handle = _SFETCH_INVALID_FILE_HANDLE;
+    item->pack_file_handle = _SFETCH_INVALID_FILE_HANDLE;
     #endif
     if (request->user_data.ptr &&
         (request->user_data.size > 0) &&
@@ -1725,27 +2115,182 @@ _SOKOL_PRIVATE _sfetch_item_t* _sfetch_pool_item_lookup(_sfetch_pool_t* pool, ui
 // >>posix
 #if _SFETCH_PLATFORM_POSIX
 _SOKOL_PRIVATE _sfetch_file_handle_t _sfetch_file_open(const _sfetch_path_t* path) {
-    return fopen(path->buf, "rb");
+    return open(path->buf, O_RDONLY);
 }
 
 _SOKOL_PRIVATE void _sfetch_file_close(_sfetch_file_handle_t h) {
-    fclose(h);
+    close(h);
 }
 
 _SOKOL_PRIVATE bool _sfetch_file_handle_valid(_sfetch_file_handle_t h) {
     return h != _SFETCH_INVALID_FILE_HANDLE;
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_file_size(_sfetch_file_handle_t h) {
-    fseek(h, 0, SEEK_END);
-    return (uint32_t) ftell(h);
+/* NOTE: on 32-bit platforms, compile with -D_FILE_OFFSET_BITS=64 to get a
+   64-bit off_t, otherwise files bigger than 2 GB can't be loaded
+*/
+_SOKOL_PRIVATE uint64_t _sfetch_file_size(_sfetch_file_handle_t h) {
+    struct stat st;
+    if (0 != fstat(h, &st)) {
+        return 0;
+    }
+    return (uint64_t) st.st_size;
+}
+
+/* a positional read doesn't touch the file pointer, so reads on the same
+   file never need to be serialized
+*/
+_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes, void* ptr) {
+    uint8_t* dst = (uint8_t*) ptr;
+    while (num_bytes > 0) {
+        if ((uint64_t)(off_t)offset != offset) {
+            return false;
+        }
+        /* Linux transfers at most 0x7FFFF000 bytes per call anyway */
+        const size_t max_bytes = 0x7FFFF000;
+        const size_t bytes_to_read = (num_bytes > max_bytes) ? max_bytes : (size_t)num_bytes;
+        const ssize_t res = pread(h, dst, bytes_to_read, (off_t)offset);
+        if (res > 0) {
+            dst += res;
+            offset += (uint64_t)res;
+            num_bytes -= (uint64_t)res;
+        }
+        else if ((res == 0) || (errno != EINTR)) {
+            return false;
+        }
+    }
+    return true;
 }
 
-_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint32_t offset, uint32_t num_bytes, void* ptr) {
-    fseek(h, (long)offset, SEEK_SET);
-    return num_bytes == fread(ptr, 1, num_bytes, h);
+/* map a byte range of a file into memory, the file handle can be closed
+   afterwards, the mapping stays valid until it is unmapped
+*/
+_SOKOL_PRIVATE bool _sfetch_file_map(_sfetch_file_handle_t h, uint64_t offset, uint64_t size, sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping && (size > 0));
+    const uint64_t page_size = (uint64_t) sysconf(_SC_PAGESIZE);
+    const uint64_t map_offset = offset - (offset % page_size);
+    const uint64_t map_size = size + (offset - map_offset);
+    if (((uint64_t)(off_t)map_offset != map_offset) || ((uint64_t)(size_t)map_size != map_size)) {
+        return false;
+    }
+    void* ptr = mmap(0, (size_t)map_size, PROT_READ, MAP_PRIVATE, h, (off_t)map_offset);
+    if (ptr == MAP_FAILED) {
+        return false;
+    }
+    mapping->base_ptr = ptr;
+    mapping->base_size = (size_t)map_size;
+    mapping->data.ptr = (uint8_t*)ptr + (offset - map_offset);
+    mapping->data.size = (size_t)size;
+    return true;
 }
 
+_SOKOL_PRIVATE void _sfetch_file_unmap(const sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping && mapping->base_ptr);
+    munmap(mapping->base_ptr, mapping->base_size);
+}
+
+#if _SFETCH_USE_IO_URING
+_SOKOL_PRIVATE void _sfetch_uring_discard(_sfetch_uring_t* ring) {
+    SOKOL_ASSERT(ring);
+    if (ring->sqes && (ring->sqes != MAP_FAILED)) {
+        munmap(ring->sqes, ring->sqes_map_size);
+    }
+    if (ring->cq_map && (ring->cq_map != MAP_FAILED) && (ring->cq_map != ring->sq_map)) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sq_map && (ring->sq_map != MAP_FAILED)) {
+        munmap(ring->sq_map, ring->sq_map_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    _sfetch_clear(ring, sizeof(_sfetch_uring_t));
+    ring->fd = -1;
+}
+
+/* create an io_uring with at least num_entries submission queue entries,
+   returns false if io_uring isn't available, in this case the IO thread
+   falls back to pread()
+*/
+_SOKOL_PRIVATE bool _sfetch_uring_init(_sfetch_uring_t* ring, uint32_t num_entries) {
+    SOKOL_ASSERT(ring && !ring->valid && (num_entries > 0));
+    /* file descriptor 0 is valid, so -1 marks a ring without a file descriptor */
+    ring->fd = -1;
+    struct io_uring_params params;
+    _sfetch_clear(&params, sizeof(params));
+    const int fd = (int) syscall(__NR_io_uring_setup, num_entries, &params);
+    if (fd < 0) {
+        return false;
+    }
+    ring->fd = fd;
+    ring->num_entries = params.sq_entries;
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_map_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    const bool single_mmap = 0 != (params.features & IORING_FEAT_SINGLE_MMAP);
+    if (single_mmap) {
+        if (ring->cq_map_size > ring->sq_map_size) {
+            ring->sq_map_size = ring->cq_map_size;
+        }
+        ring->cq_map_size = ring->sq_map_size;
+    }
+    ring->sq_map = mmap(0, ring->sq_map_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (single_mmap) {
+        ring->cq_map = ring->sq_map;
+    }
+    else {
+        ring->cq_map = mmap(0, ring->cq_map_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    }
+    ring->sqes = (struct io_uring_sqe*) mmap(0, ring->sqes_map_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_SQES);
+    if ((ring->sq_map == MAP_FAILED) || (ring->cq_map == MAP_FAILED) || (ring->sqes == MAP_FAILED)) {
+        _sfetch_uring_discard(ring);
+        return false;
+    }
+    uint8_t* sq = (uint8_t*) ring->sq_map;
+    ring->sq_head = (uint32_t*) (sq + params.sq_off.head);
+    ring->sq_tail = (uint32_t*) (sq + params.sq_off.tail);
+    ring->sq_mask = (uint32_t*) (sq + params.sq_off.ring_mask);
+    ring->sq_array = (uint32_t*) (sq + params.sq_off.array);
+    uint8_t* cq = (uint8_t*) ring->cq_map;
+    ring->cq_head = (uint32_t*) (cq + params.cq_off.head);
+    ring->cq_tail = (uint32_t*) (cq + params.cq_off.tail);
+    ring->cq_mask = (uint32_t*) (cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*) (cq + params.cq_off.cqes);
+    ring->valid = true;
+    return true;
+}
+
+/* put a read into the submission queue, this doesn't call into the kernel yet */
+_SOKOL_PRIVATE void _sfetch_uring_push_read(_sfetch_uring_t* ring, _sfetch_file_handle_t h, uint64_t offset, uint32_t num_bytes, void* ptr, uint32_t slot_id) {
+    SOKOL_ASSERT(ring && ring->valid);
+    const uint32_t tail = *ring->sq_tail;
+    SOKOL_ASSERT((tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE)) < ring->num_entries);
+    const uint32_t index = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    _sfetch_clear(sqe, sizeof(struct io_uring_sqe));
+    sqe->opcode = (uint8_t) IORING_OP_READ;
+    sqe->fd = h;
+    sqe->off = offset;
+    sqe->addr = (uint64_t) (uintptr_t) ptr;
+    sqe->len = num_bytes;
+    sqe->user_data = slot_id;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/* submit queued reads and wait for at least one completion, returns the
+   number of submitted reads, or -1 if the kernel refused the submission
+*/
+_SOKOL_PRIVATE int _sfetch_uring_enter(_sfetch_uring_t* ring, uint32_t to_submit) {
+    SOKOL_ASSERT(ring && ring->valid);
+    int res;
+    do {
+        res = (int) syscall(__NR_io_uring_enter, ring->fd, to_submit, 1, IORING_ENTER_GETEVENTS, 0, 0);
+    } while ((res < 0) && (errno == EINTR));
+    return res;
+}
+#endif /* _SFETCH_USE_IO_URING */
+
 _SOKOL_PRIVATE bool _sfetch_thread_init(_sfetch_thread_t* thread, _sfetch_thread_func_t thread_func, void* thread_arg) {
     SOKOL_ASSERT(thread && !thread->valid && !thread->stop_requested);
 
@@ -1836,20 +2381,25 @@ _SOKOL_PRIVATE void _sfetch_thread_enqueue_incoming(_sfetch_thread_t* thread, _s
     }
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming) {
-    /* called from thread function */
+_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming, uint32_t* dst, uint32_t max_items) {
+    /* called from thread function, blocks until at least one item is available
+       and then takes up to max_items, returns the number of dequeued items
+    */
     SOKOL_ASSERT(thread && thread->valid);
     SOKOL_ASSERT(incoming && incoming->buf);
+    SOKOL_ASSERT(dst && (max_items > 0));
     pthread_mutex_lock(&thread->incoming_mutex);
     while (_sfetch_ring_empty(incoming) && !thread->stop_requested) {
         pthread_cond_wait(&thread->incoming_cond, &thread->incoming_mutex);
     }
-    uint32_t item = 0;
+    uint32_t num_items = 0;
     if (!thread->stop_requested) {
-        item = _sfetch_ring_dequeue(incoming);
+        while ((num_items < max_items) && !_sfetch_ring_empty(incoming)) {
+            dst[num_items++] = _sfetch_ring_dequeue(incoming);
+        }
     }
     pthread_mutex_unlock(&thread->incoming_mutex);
-    return item;
+    return num_items;
 }
 
 _SOKOL_PRIVATE bool _sfetch_thread_enqueue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* outgoing, uint32_t item) {
@@ -1927,22 +2477,69 @@ _SOKOL_PRIVATE bool _sfetch_file_handle_valid(_sfetch_file_handle_t h) {
     return h != _SFETCH_INVALID_FILE_HANDLE;
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_file_size(_sfetch_file_handle_t h) {
-    return GetFileSize(h, NULL);
+_SOKOL_PRIVATE uint64_t _sfetch_file_size(_sfetch_file_handle_t h) {
+    LARGE_INTEGER size_li;
+    if (!GetFileSizeEx(h, &size_li)) {
+        return 0;
+    }
+    return (uint64_t) size_li.QuadPart;
 }
 
-_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint32_t offset, uint32_t num_bytes, void* ptr) {
-    LARGE_INTEGER offset_li;
-    offset_li.QuadPart = offset;
-    BOOL seek_res = SetFilePointerEx(h, offset_li, NULL, FILE_BEGIN);
-    if (seek_res) {
+/* the read offset is passed in an OVERLAPPED struct instead of moving the
+   file pointer, so that the IO threads of different channels can read from
+   the same (pack) file at the same time
+*/
+_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes, void* ptr) {
+    /* ReadFile() can read at most 4 GB at once */
+    uint8_t* dst = (uint8_t*) ptr;
+    while (num_bytes > 0) {
+        const DWORD bytes_to_read = (num_bytes > 0x80000000) ? 0x80000000 : (DWORD)num_bytes;
+        OVERLAPPED overlapped;
+        _sfetch_clear(&overlapped, sizeof(overlapped));
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
         DWORD bytes_read = 0;
-        BOOL read_res = ReadFile(h, ptr, (DWORD)num_bytes, &bytes_read, NULL);
-        return read_res && (bytes_read == num_bytes);
+        BOOL read_res = ReadFile(h, dst, bytes_to_read, &bytes_read, &overlapped);
+        if (!read_res || (bytes_read != bytes_to_read)) {
+            return false;
+        }
+        dst += bytes_read;
+        offset += bytes_read;
+        num_bytes -= bytes_read;
     }
-    else {
+    return true;
+}
+
+_SOKOL_PRIVATE bool _sfetch_file_map(_sfetch_file_handle_t h, uint64_t offset, uint64_t size, sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping && (size > 0));
+    SYSTEM_INFO sys_info;
+    GetSystemInfo(&sys_info);
+    const uint64_t granularity = sys_info.dwAllocationGranularity;
+    const uint64_t map_offset = offset - (offset % granularity);
+    const uint64_t map_size = size + (offset - map_offset);
+    if ((uint64_t)(SIZE_T)map_size != map_size) {
+        return false;
+    }
+    HANDLE file_mapping = CreateFileMappingW(h, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == file_mapping) {
+        return false;
+    }
+    void* ptr = MapViewOfFile(file_mapping, FILE_MAP_READ, (DWORD)(map_offset >> 32), (DWORD)(map_offset & 0xFFFFFFFF), (SIZE_T)map_size);
+    /* the view keeps the file mapping object alive */
+    CloseHandle(file_mapping);
+    if (NULL == ptr) {
         return false;
     }
+    mapping->base_ptr = ptr;
+    mapping->base_size = (size_t)map_size;
+    mapping->data.ptr = (uint8_t*)ptr + (offset - map_offset);
+    mapping->data.size = (size_t)size;
+    return true;
+}
+
+_SOKOL_PRIVATE void _sfetch_file_unmap(const sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping && mapping->base_ptr);
+    UnmapViewOfFile(mapping->base_ptr);
 }
 
 _SOKOL_PRIVATE bool _sfetch_thread_init(_sfetch_thread_t* thread, _sfetch_thread_func_t thread_func, void* thread_arg) {
@@ -2021,22 +2618,27 @@ _SOKOL_PRIVATE void _sfetch_thread_enqueue_incoming(_sfetch_thread_t* thread, _s
     }
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming) {
-    /* called from thread function */
+_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming, uint32_t* dst, uint32_t max_items) {
+    /* called from thread function, blocks until at least one item is available
+       and then takes up to max_items, returns the number of dequeued items
+    */
     SOKOL_ASSERT(thread && thread->valid);
     SOKOL_ASSERT(incoming && incoming->buf);
+    SOKOL_ASSERT(dst && (max_items > 0));
     EnterCriticalSection(&thread->incoming_critsec);
     while (_sfetch_ring_empty(incoming) && !thread->stop_requested) {
         LeaveCriticalSection(&thread->incoming_critsec);
         WaitForSingleObject(thread->incoming_event, INFINITE);
         EnterCriticalSection(&thread->incoming_critsec);
     }
-    uint32_t item = 0;
+    uint32_t num_items = 0;
     if (!thread->stop_requested) {
-        item = _sfetch_ring_dequeue(incoming);
+        while ((num_items < max_items) && !_sfetch_ring_empty(incoming)) {
+            dst[num_items++] = _sfetch_ring_dequeue(incoming);
+        }
     }
     LeaveCriticalSection(&thread->incoming_critsec);
-    return item;
+    return num_items;
 }
 
 _SOKOL_PRIVATE bool _sfetch_thread_enqueue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* outgoing, uint32_t item) {
@@ -2065,6 +2667,178 @@ _SOKOL_PRIVATE void _sfetch_thread_dequeue_outgoing(_sfetch_thread_t* thread, _s
 }
 #endif /* _SFETCH_PLATFORM_WINDOWS */
 
+// ██████   █████   ██████ ██   ██ ███████
+// ██   ██ ██   ██ ██      ██  ██  ██
+// ██████  ███████ ██      █████   ███████
+// ██      ██   ██ ██      ██  ██       ██
+// ██      ██   ██  ██████ ██   ██ ███████
+//
+// >>packs
+#if _SFETCH_HAS_THREADS
+#define _SFETCH_PACK_HEADER_SIZE (16)
+#define _SFETCH_PACK_ENTRY_SIZE (32)
+#define _SFETCH_PACK_VERSION (2)
+
+/* 64-bit FNV-1a hash of a path (the same hash function as in util/sfetch_pack.c) */
+_SOKOL_PRIVATE uint64_t _sfetch_pack_hash(const char* str) {
+    uint64_t hash = 0xCBF29CE484222325;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+/* pack files are little-endian, independent of the host */
+_SOKOL_PRIVATE uint32_t _sfetch_pack_read_u32(const uint8_t* ptr) {
+    return (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+}
+
+_SOKOL_PRIVATE uint64_t _sfetch_pack_read_u64(const uint8_t* ptr) {
+    return (uint64_t)_sfetch_pack_read_u32(ptr) | ((uint64_t)_sfetch_pack_read_u32(ptr + 4) << 32);
+}
+
+_SOKOL_PRIVATE void _sfetch_pack_discard(_sfetch_pack_t* pack) {
+    SOKOL_ASSERT(pack);
+    if (pack->entries) {
+        _sfetch_free(pack->entries);
+    }
+    if (pack->paths) {
+        _sfetch_free(pack->paths);
+    }
+    if (_sfetch_file_handle_valid(pack->file_handle)) {
+        _sfetch_file_close(pack->file_handle);
+    }
+    _sfetch_clear(pack, sizeof(_sfetch_pack_t));
+    pack->file_handle = _SFETCH_INVALID_FILE_HANDLE;
+}
+
+/* open a pack file and load its index, the pack file stays open until it is discarded */
+_SOKOL_PRIVATE bool _sfetch_pack_init(_sfetch_pack_t* pack, const char* path_str) {
+    SOKOL_ASSERT(pack && path_str);
+    _sfetch_clear(pack, sizeof(_sfetch_pack_t));
+    const _sfetch_path_t path = _sfetch_path_make(path_str);
+    pack->file_handle = path.buf[0] ? _sfetch_file_open(&path) : _SFETCH_INVALID_FILE_HANDLE;
+    if (!_sfetch_file_handle_valid(pack->file_handle)) {
+        pack->file_handle = _SFETCH_INVALID_FILE_HANDLE;
+        _SFETCH_ERROR(PACK_OPEN_FAILED);
+        return false;
+    }
+    const uint64_t file_size = _sfetch_file_size(pack->file_handle);
+    uint8_t header[_SFETCH_PACK_HEADER_SIZE];
+    if ((file_size < _SFETCH_PACK_HEADER_SIZE) ||
+        !_sfetch_file_read(pack->file_handle, 0, _SFETCH_PACK_HEADER_SIZE, header) ||
+        (0 != memcmp(header, "SFPK", 4)) ||
+        (_sfetch_pack_read_u32(header + 4) != _SFETCH_PACK_VERSION))
+    {
+        _SFETCH_ERROR(PACK_INVALID);
+        return false;
+    }
+    const uint32_t num_entries = _sfetch_pack_read_u32(header + 8);
+    if (((file_size - _SFETCH_PACK_HEADER_SIZE) / _SFETCH_PACK_ENTRY_SIZE) < num_entries) {
+        _SFETCH_ERROR(PACK_INVALID);
+        return false;
+    }
+    if (num_entries > 0) {
+        /* read the raw entries into the entry array and decode them in place */
+        SOKOL_ASSERT(sizeof(_sfetch_pack_entry_t) == _SFETCH_PACK_ENTRY_SIZE);
+        pack->entries = (_sfetch_pack_entry_t*) _sfetch_malloc((size_t)num_entries * sizeof(_sfetch_pack_entry_t));
+        if (!_sfetch_file_read(pack->file_handle, _SFETCH_PACK_HEADER_SIZE, (uint64_t)num_entries * _SFETCH_PACK_ENTRY_SIZE, pack->entries)) {
+            _SFETCH_ERROR(PACK_INVALID);
+            return false;
+        }
+        uint64_t paths_size = 0;
+        for (uint32_t i = 0; i < num_entries; i++) {
+            const uint8_t* src = (const uint8_t*) &pack->entries[i];
+            const uint64_t path_hash = _sfetch_pack_read_u64(src);
+            const uint64_t offset = _sfetch_pack_read_u64(src + 8);
+            const uint64_t size = _sfetch_pack_read_u64(src + 16);
+            const uint32_t path_offset = _sfetch_pack_read_u32(src + 24);
+            const uint32_t path_length = _sfetch_pack_read_u32(src + 28);
+            if ((offset > file_size) || (size > (file_size - offset)) ||
+                ((i > 0) && (path_hash <= pack->entries[i-1].path_hash)))
+            {
+                _SFETCH_ERROR(PACK_INVALID);
+                return false;
+            }
+            pack->entries[i].path_hash = path_hash;
+            pack->entries[i].offset = offset;
+            pack->entries[i].size = size;
+            pack->entries[i].path_offset = path_offset;
+            pack->entries[i].path_length = path_length;
+            const uint64_t path_end = (uint64_t)path_offset + path_length + 1;
+            if (path_end > paths_size) {
+                paths_size = path_end;
+            }
+        }
+        /* the path table follows the entries */
+        const uint64_t paths_pos = _SFETCH_PACK_HEADER_SIZE + (uint64_t)num_entries * _SFETCH_PACK_ENTRY_SIZE;
+        if (paths_size > (file_size - paths_pos)) {
+            _SFETCH_ERROR(PACK_INVALID);
+            return false;
+        }
+        pack->paths = (char*) _sfetch_malloc((size_t)paths_size);
+        if (!_sfetch_file_read(pack->file_handle, paths_pos, paths_size, pack->paths)) {
+            _SFETCH_ERROR(PACK_INVALID);
+            return false;
+        }
+        for (uint32_t i = 0; i < num_entries; i++) {
+            const _sfetch_pack_entry_t* entry = &pack->entries[i];
+            if (0 != pack->paths[entry->path_offset + entry->path_length]) {
+                _SFETCH_ERROR(PACK_INVALID);
+                return false;
+            }
+        }
+    }
+    pack->num_entries = num_entries;
+    return true;
+}
+
+/* binary search for a path hash in the sorted entries of a pack file,
+   the path is compared on a hash match to rule out hash collisions
+*/
+_SOKOL_PRIVATE const _sfetch_pack_entry_t* _sfetch_pack_find(const _sfetch_pack_t* pack, const char* path, uint64_t path_hash) {
+    SOKOL_ASSERT(pack && path);
+    uint32_t lo = 0;
+    uint32_t hi = pack->num_entries;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        const uint64_t mid_hash = pack->entries[mid].path_hash;
+        if (mid_hash == path_hash) {
+            const _sfetch_pack_entry_t* entry = &pack->entries[mid];
+            if (0 == strcmp(&pack->paths[entry->path_offset], path)) {
+                return entry;
+            }
+            return 0;
+        }
+        else if (mid_hash < path_hash) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return 0;
+}
+
+/* look up the path of a new request in the mounted pack files, the most recently mounted first */
+_SOKOL_PRIVATE void _sfetch_pack_lookup(_sfetch_t* ctx, _sfetch_item_t* item) {
+    if (0 == ctx->num_packs) {
+        return;
+    }
+    const uint64_t path_hash = _sfetch_pack_hash(item->path.buf);
+    for (uint32_t i = ctx->num_packs; i-- > 0;) {
+        const _sfetch_pack_entry_t* entry = _sfetch_pack_find(&ctx->packs[i], item->path.buf, path_hash);
+        if (entry) {
+            item->pack_file_handle = ctx->packs[i].file_handle;
+            item->pack_offset = entry->offset;
+            item->pack_size = entry->size;
+            return;
+        }
+    }
+}
+#endif /* _SFETCH_HAS_THREADS */
+
 //  ██████ ██   ██  █████  ███    ██ ███    ██ ███████ ██      ███████
 // ██      ██   ██ ██   ██ ████   ██ ████   ██ ██      ██      ██
 // ██      ███████ ███████ ██ ██  ██ ██ ██  ██ █████   ██      ███████
@@ -2073,14 +2847,50 @@ _SOKOL_PRIVATE void _sfetch_thread_dequeue_outgoing(_sfetch_thread_t* thread, _s
 //
 // >>channels
 
-/* per-channel request handler for native platforms accessing the local filesystem */
 #if _SFETCH_HAS_THREADS
+/* called on the IO thread when the pending read of a request has completed,
+   or right away by the request handler if there's nothing to read
+*/
+_SOKOL_PRIVATE void _sfetch_request_read_done(_sfetch_item_thread_t* thread, bool read_ok) {
+    if (thread->read_pending) {
+        thread->read_pending = false;
+        if (read_ok) {
+            thread->fetched_size = thread->read_size;
+            thread->fetched_offset += thread->read_size;
+        }
+        else {
+            thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+            thread->failed = true;
+        }
+    }
+    SOKOL_ASSERT(thread->fetched_offset <= thread->content_size);
+    if (thread->failed || (thread->fetched_offset == thread->content_size)) {
+        if (_sfetch_file_handle_valid(thread->file_handle)) {
+            if (!thread->file_in_pack) {
+                _sfetch_file_close(thread->file_handle);
+            }
+            thread->file_handle = _SFETCH_INVALID_FILE_HANDLE;
+        }
+        thread->finished = true;
+    }
+}
+
+/* per-channel request handler for native platforms accessing the local filesystem,
+   this only sets up the next read of a request, the reads of all requests
+   that were handed to the IO thread together are issued as one batch
+*/
 _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
     _sfetch_state_t state;
     _sfetch_path_t* path;
     _sfetch_item_thread_t* thread;
     sfetch_range_t* buffer;
     uint32_t chunk_size;
+    uint64_t range_offset;
+    uint64_t range_size;
+    bool memory_map;
+    _sfetch_file_handle_t pack_file_handle;
+    uint64_t pack_offset;
+    uint64_t pack_size;
     {
         _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
         if (!item) {
@@ -2094,12 +2904,18 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
         thread = &item->thread;
         buffer = &item->buffer;
         chunk_size = item->chunk_size;
+        range_offset = item->range_offset;
+        range_size = item->range_size;
+        memory_map = item->memory_map;
+        pack_file_handle = item->pack_file_handle;
+        pack_offset = item->pack_offset;
+        pack_size = item->pack_size;
     }
     if (thread->failed) {
         return;
     }
     if (state == _SFETCH_STATE_FETCHING) {
-        if ((buffer->ptr == 0) || (buffer->size == 0)) {
+        if (!memory_map && ((buffer->ptr == 0) || (buffer->size == 0))) {
             thread->error_code = SFETCH_ERROR_NO_BUFFER;
             thread->failed = true;
         }
@@ -2109,20 +2925,54 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
                 SOKOL_ASSERT(path->buf[0]);
                 SOKOL_ASSERT(thread->fetched_offset == 0);
                 SOKOL_ASSERT(thread->fetched_size == 0);
-                thread->file_handle = _sfetch_file_open(path);
+                if (_sfetch_file_handle_valid(pack_file_handle)) {
+                    /* the file data is inside an already open pack file */
+                    thread->file_handle = pack_file_handle;
+                    thread->file_in_pack = true;
+                }
+                else {
+                    thread->file_handle = _sfetch_file_open(path);
+                }
                 if (_sfetch_file_handle_valid(thread->file_handle)) {
-                    thread->content_size = _sfetch_file_size(thread->file_handle);
+                    /* the requested byte range must be inside the file */
+                    const uint64_t file_size = thread->file_in_pack ? pack_size : _sfetch_file_size(thread->file_handle);
+                    if (range_offset > file_size) {
+                        thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+                        thread->failed = true;
+                    }
+                    else if (range_size == 0) {
+                        thread->content_size = file_size - range_offset;
+                    }
+                    else if (range_size <= (file_size - range_offset)) {
+                        thread->content_size = range_size;
+                    }
+                    else {
+                        thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+                        thread->failed = true;
+                    }
                 }
                 else {
                     thread->error_code = SFETCH_ERROR_FILE_NOT_FOUND;
                     thread->failed = true;
                 }
             }
-            if (!thread->failed) {
-                uint32_t read_offset = 0;
-                uint32_t bytes_to_read = 0;
+            if (!thread->failed && memory_map) {
+                /* map the whole byte range at once, no read needed */
+                SOKOL_ASSERT(chunk_size == 0);
+                if ((thread->content_size == 0) || _sfetch_file_map(thread->file_handle, pack_offset + range_offset, thread->content_size, &thread->mapping)) {
+                    thread->fetched_size = thread->content_size;
+                    thread->fetched_offset = thread->content_size;
+                }
+                else {
+                    thread->error_code = SFETCH_ERROR_MEMORY_MAP_FAILED;
+                    thread->failed = true;
+                }
+            }
+            else if (!thread->failed) {
+                uint64_t read_offset = 0;
+                uint64_t bytes_to_read = 0;
                 if (chunk_size == 0) {
-                    /* load entire file */
+                    /* load entire file (or the entire byte range) */
                     if (thread->content_size <= buffer->size) {
                         bytes_to_read = thread->content_size;
                         read_offset = 0;
@@ -2148,29 +2998,140 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
                     }
                 }
                 if (!thread->failed) {
-                    if (_sfetch_file_read(thread->file_handle, read_offset, bytes_to_read, (void*)buffer->ptr)) {
-                        thread->fetched_size = bytes_to_read;
-                        thread->fetched_offset += bytes_to_read;
-                    }
-                    else {
-                        thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
-                        thread->failed = true;
-                    }
+                    thread->read_offset = pack_offset + range_offset + read_offset;
+                    thread->read_size = bytes_to_read;
+                    thread->read_pending = true;
                 }
             }
         }
-        SOKOL_ASSERT(thread->fetched_offset <= thread->content_size);
-        if (thread->failed || (thread->fetched_offset == thread->content_size)) {
-            if (_sfetch_file_handle_valid(thread->file_handle)) {
-                _sfetch_file_close(thread->file_handle);
-                thread->file_handle = _SFETCH_INVALID_FILE_HANDLE;
-            }
-            thread->finished = true;
+        if (!thread->read_pending) {
+            _sfetch_request_read_done(thread, false);
         }
     }
     /* ignore items in PAUSED or FAILED state */
 }
 
+/* a request goes back to the user thread as soon as its read has completed */
+_SOKOL_PRIVATE void _sfetch_channel_complete_read(_sfetch_channel_t* chn, _sfetch_item_t* item, bool read_ok) {
+    _sfetch_request_read_done(&item->thread, read_ok);
+    SOKOL_ASSERT(!_sfetch_ring_full(&chn->thread_outgoing));
+    _sfetch_thread_enqueue_outgoing(&chn->thread, &chn->thread_outgoing, item->handle.id);
+}
+
+_SOKOL_PRIVATE bool _sfetch_channel_blocking_read(_sfetch_item_t* item, uint64_t skip_bytes) {
+    const _sfetch_item_thread_t* thread = &item->thread;
+    SOKOL_ASSERT(skip_bytes <= thread->read_size);
+    return _sfetch_file_read(thread->file_handle,
+        thread->read_offset + skip_bytes,
+        thread->read_size - skip_bytes,
+        (uint8_t*)item->buffer.ptr + skip_bytes);
+}
+
+#if _SFETCH_USE_IO_URING
+/* take the reads which the kernel hasn't consumed yet back out of the
+   submission queue and finish them with blocking reads, returns the
+   number of reads taken back
+*/
+_SOKOL_PRIVATE uint32_t _sfetch_channel_uring_unqueue(_sfetch_channel_t* chn) {
+    _sfetch_uring_t* ring = &chn->uring;
+    const uint32_t head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    const uint32_t tail = *ring->sq_tail;
+    for (uint32_t i = head; i != tail; i++) {
+        const struct io_uring_sqe* sqe = &ring->sqes[ring->sq_array[i & *ring->sq_mask]];
+        _sfetch_item_t* item = _sfetch_pool_item_lookup(&chn->ctx->pool, (uint32_t)sqe->user_data);
+        SOKOL_ASSERT(item && item->thread.read_pending);
+        _sfetch_channel_complete_read(chn, item, _sfetch_channel_blocking_read(item, 0));
+    }
+    __atomic_store_n(ring->sq_tail, head, __ATOMIC_RELEASE);
+    return tail - head;
+}
+
+/* submit the reads queued by _sfetch_channel_read_batch() and complete the
+   requests in whatever order the kernel finishes them
+*/
+_SOKOL_PRIVATE void _sfetch_channel_uring_complete(_sfetch_channel_t* chn, uint32_t num_queued) {
+    _sfetch_uring_t* ring = &chn->uring;
+    uint32_t to_submit = num_queued;
+    uint32_t num_inflight = num_queued;
+    bool refused = false;
+    while (num_inflight > 0) {
+        const int num_submitted = _sfetch_uring_enter(ring, to_submit);
+        if (num_submitted >= 0) {
+            to_submit -= (uint32_t)num_submitted;
+        }
+        else if (!refused) {
+            /* the kernel refused the submission, stop using the io_uring and
+               finish the reads which haven't been submitted with blocking reads,
+               the submitted reads still own their buffers until they complete
+            */
+            refused = true;
+            num_inflight -= _sfetch_channel_uring_unqueue(chn);
+            to_submit = 0;
+        }
+        else {
+            /* waiting for completions failed too, poll the completion queue */
+            sched_yield();
+        }
+        uint32_t head = *ring->cq_head;
+        const uint32_t tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+            _sfetch_item_t* item = _sfetch_pool_item_lookup(&chn->ctx->pool, (uint32_t)cqe->user_data);
+            SOKOL_ASSERT(item && item->thread.read_pending);
+            /* short reads and errors (e.g. IORING_OP_READ not supported by an
+               older kernel) are retried with a blocking read of the remaining bytes
+            */
+            const uint64_t num_read = (cqe->res > 0) ? (uint64_t)cqe->res : 0;
+            bool read_ok = (num_read == item->thread.read_size);
+            if (!read_ok && (num_read < item->thread.read_size)) {
+                read_ok = _sfetch_channel_blocking_read(item, num_read);
+            }
+            _sfetch_channel_complete_read(chn, item, read_ok);
+            num_inflight--;
+            head++;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    if (refused) {
+        ring->valid = false;
+    }
+}
+#endif
+
+/* issue the pending reads of all requests in the current batch, requests
+   without a pending read (paused, failed, ...) are handed back right away
+*/
+_SOKOL_PRIVATE void _sfetch_channel_read_batch(_sfetch_channel_t* chn, uint32_t num_slots) {
+    #if _SFETCH_USE_IO_URING
+    uint32_t num_queued = 0;
+    #endif
+    for (uint32_t i = 0; i < num_slots; i++) {
+        const uint32_t slot_id = chn->thread_batch[i];
+        _sfetch_item_t* item = _sfetch_pool_item_lookup(&chn->ctx->pool, slot_id);
+        if (item && item->thread.read_pending) {
+            #if _SFETCH_USE_IO_URING
+            if (chn->uring.valid && (item->thread.read_size > 0)) {
+                /* a single read transfers at most 0x7FFFF000 bytes, the rest is picked up as a short read */
+                const uint32_t num_bytes = (item->thread.read_size > 0x7FFFF000) ? 0x7FFFF000 : (uint32_t)item->thread.read_size;
+                _sfetch_uring_push_read(&chn->uring, item->thread.file_handle, item->thread.read_offset, num_bytes, (void*)item->buffer.ptr, slot_id);
+                num_queued++;
+                continue;
+            }
+            #endif
+            _sfetch_channel_complete_read(chn, item, _sfetch_channel_blocking_read(item, 0));
+        }
+        else {
+            SOKOL_ASSERT(!_sfetch_ring_full(&chn->thread_outgoing));
+            _sfetch_thread_enqueue_outgoing(&chn->thread, &chn->thread_outgoing, slot_id);
+        }
+    }
+    #if _SFETCH_USE_IO_URING
+    if (num_queued > 0) {
+        _sfetch_channel_uring_complete(chn, num_queued);
+    }
+    #endif
+}
+
 #if _SFETCH_PLATFORM_WINDOWS
 _SOKOL_PRIVATE DWORD WINAPI _sfetch_channel_thread_func(LPVOID arg) {
 #else
@@ -2179,14 +3140,15 @@ _SOKOL_PRIVATE void* _sfetch_channel_thread_func(void* arg) {
     _sfetch_channel_t* chn = (_sfetch_channel_t*) arg;
     _sfetch_thread_entered(&chn->thread);
     while (!_sfetch_thread_stop_requested(&chn->thread)) {
-        /* block until work arrives */
-        uint32_t slot_id = _sfetch_thread_dequeue_incoming(&chn->thread, &chn->thread_incoming);
-        /* slot_id will be invalid if the thread was woken up to join */
+        /* block until work arrives, and take the requests of all lanes that are waiting */
+        const uint32_t num_slots = _sfetch_thread_dequeue_incoming(&chn->thread, &chn->thread_incoming, chn->thread_batch, chn->num_lanes);
+        /* num_slots will be zero if the thread was woken up to join */
         if (!_sfetch_thread_stop_requested(&chn->thread)) {
-            SOKOL_ASSERT(0 != slot_id);
-            chn->request_handler(chn->ctx, slot_id);
-            SOKOL_ASSERT(!_sfetch_ring_full(&chn->thread_outgoing));
-            _sfetch_thread_enqueue_outgoing(&chn->thread, &chn->thread_outgoing, slot_id);
+            SOKOL_ASSERT(num_slots > 0);
+            for (uint32_t i = 0; i < num_slots; i++) {
+                chn->request_handler(chn->ctx, chn->thread_batch[i]);
+            }
+            _sfetch_channel_read_batch(chn, num_slots);
         }
     }
     _sfetch_thread_leaving(&chn->thread);
@@ -2213,8 +3175,11 @@ EM_JS(void, sfetch_js_send_head_request, (uint32_t slot_id, const char* path_cst
     req.send();
 });
 
-/* if bytes_to_read != 0, a range-request will be sent, otherwise a normal request */
-EM_JS(void, sfetch_js_send_get_request, (uint32_t slot_id, const char* path_cstr, uint32_t offset, uint32_t bytes_to_read, void* buf_ptr, uint32_t buf_size), {
+/* if bytes_to_read != 0, a range-request will be sent, otherwise a normal request,
+   offsets and sizes are passed as double so that they survive the trip into Javascript
+   (exact up to 2^53 bytes)
+*/
+EM_JS(void, sfetch_js_send_get_request, (uint32_t slot_id, const char* path_cstr, double offset, double bytes_to_read, void* buf_ptr, uint32_t buf_size), {
     const path_str = UTF8ToString(path_cstr);
     const req = new XMLHttpRequest();
     req.open('GET', path_str);
@@ -2248,51 +3213,68 @@ EM_JS(void, sfetch_js_send_get_request, (uint32_t slot_id, const char* path_cstr
 #ifdef __cplusplus
 extern "C" {
 #endif
+/* streaming and byte-range requests need HTTP range requests */
+_SOKOL_PRIVATE bool _sfetch_emsc_needs_range_request(const _sfetch_item_t* item) {
+    return (item->chunk_size > 0) || (item->range_offset > 0) || (item->range_size > 0);
+}
+
 void _sfetch_emsc_send_get_request(uint32_t slot_id, _sfetch_item_t* item) {
     if ((item->buffer.ptr == 0) || (item->buffer.size == 0)) {
         item->thread.error_code = SFETCH_ERROR_NO_BUFFER;
         item->thread.failed = true;
     }
     else {
-        uint32_t offset = 0;
-        uint32_t bytes_to_read = 0;
-        if (item->chunk_size > 0) {
+        uint64_t offset = 0;
+        uint64_t bytes_to_read = 0;
+        if (_sfetch_emsc_needs_range_request(item)) {
             /* send HTTP range request */
-            SOKOL_ASSERT(item->thread.content_size > 0);
-            SOKOL_ASSERT(item->thread.http_range_offset < item->thread.content_size);
+            SOKOL_ASSERT(item->thread.http_range_offset <= item->thread.content_size);
             bytes_to_read = item->thread.content_size - item->thread.http_range_offset;
-            if (bytes_to_read > item->chunk_size) {
+            if ((item->chunk_size > 0) && (bytes_to_read > item->chunk_size)) {
                 bytes_to_read = item->chunk_size;
             }
-            SOKOL_ASSERT(bytes_to_read > 0);
-            offset = item->thread.http_range_offset;
+            if (bytes_to_read == 0) {
+                /* an empty byte range, nothing to fetch */
+                item->thread.finished = true;
+                _sfetch_ring_enqueue(&_sfetch_ctx()->chn[item->channel].user_outgoing, slot_id);
+                return;
+            }
+            offset = item->range_offset + item->thread.http_range_offset;
         }
-        sfetch_js_send_get_request(slot_id, item->path.buf, offset, bytes_to_read, (void*)item->buffer.ptr, item->buffer.size);
+        sfetch_js_send_get_request(slot_id, item->path.buf, (double)offset, (double)bytes_to_read, (void*)item->buffer.ptr, item->buffer.size);
     }
 }
 
-/* called by JS when an initial HEAD request finished successfully (only when streaming chunks) */
-EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_head_response(uint32_t slot_id, uint32_t content_length) {
+/* called by JS when an initial HEAD request finished successfully (only when the range size isn't known) */
+EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_head_response(uint32_t slot_id, double content_length) {
     _sfetch_t* ctx = _sfetch_ctx();
     if (ctx && ctx->valid) {
         _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
         if (item) {
             SOKOL_ASSERT(item->buffer.ptr && (item->buffer.size > 0));
-            item->thread.content_size = content_length;
+            const uint64_t file_size = (uint64_t)content_length;
+            if (item->range_offset > file_size) {
+                item->thread.error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+                item->thread.failed = true;
+                item->thread.finished = true;
+                _sfetch_ring_enqueue(&ctx->chn[item->channel].user_outgoing, slot_id);
+                return;
+            }
+            item->thread.content_size = file_size - item->range_offset;
             _sfetch_emsc_send_get_request(slot_id, item);
         }
     }
 }
 
 /* called by JS when a followup GET request finished successfully */
-EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_get_response(uint32_t slot_id, uint32_t range_fetched_size, uint32_t content_fetched_size) {
+EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_get_response(uint32_t slot_id, double range_fetched_size, double content_fetched_size) {
     _sfetch_t* ctx = _sfetch_ctx();
     if (ctx && ctx->valid) {
         _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
         if (item) {
-            item->thread.fetched_size = content_fetched_size;
-            item->thread.fetched_offset += content_fetched_size;
-            item->thread.http_range_offset += range_fetched_size;
+            item->thread.fetched_size = (uint64_t)content_fetched_size;
+            item->thread.fetched_offset += (uint64_t)content_fetched_size;
+            item->thread.http_range_offset += (uint64_t)range_fetched_size;
             if (item->chunk_size == 0) {
                 item->thread.finished = true;
             }
@@ -2346,7 +3328,12 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
         return;
     }
     if (item->state == _SFETCH_STATE_FETCHING) {
-        if ((item->chunk_size > 0) && (item->thread.content_size == 0)) {
+        if (_sfetch_emsc_needs_range_request(item) && (item->thread.content_size == 0) && (item->range_size > 0)) {
+            /* the size of an explicit byte range is known upfront */
+            item->thread.content_size = item->range_size;
+            _sfetch_emsc_send_get_request(slot_id, item);
+        }
+        else if (_sfetch_emsc_needs_range_request(item) && (item->thread.content_size == 0)) {
             /* if streaming download is requested, and the content-length isn't known
                yet, need to send a HEAD request first
              */
@@ -2379,9 +3366,18 @@ _SOKOL_PRIVATE void _sfetch_channel_discard(_sfetch_channel_t* chn) {
         }
         _sfetch_ring_discard(&chn->thread_incoming);
         _sfetch_ring_discard(&chn->thread_outgoing);
+        if (chn->thread_batch) {
+            _sfetch_free(chn->thread_batch);
+            chn->thread_batch = 0;
+        }
+    #endif
+    #if _SFETCH_USE_IO_URING
+        _sfetch_uring_discard(&chn->uring);
     #endif
     _sfetch_ring_discard(&chn->free_lanes);
-    _sfetch_ring_discard(&chn->user_sent);
+    for (uint32_t i = 0; i < SFETCH_NUM_PRIORITIES; i++) {
+        _sfetch_ring_discard(&chn->user_sent[i]);
+    }
     _sfetch_ring_discard(&chn->user_incoming);
     _sfetch_ring_discard(&chn->user_outgoing);
     _sfetch_ring_discard(&chn->free_lanes);
@@ -2398,12 +3394,20 @@ _SOKOL_PRIVATE bool _sfetch_channel_init(_sfetch_channel_t* chn, _sfetch_t* ctx,
     for (uint32_t lane = 0; lane < num_lanes; lane++) {
         _sfetch_ring_enqueue(&chn->free_lanes, lane);
     }
-    valid &= _sfetch_ring_init(&chn->user_sent, num_items);
+    for (uint32_t i = 0; i < SFETCH_NUM_PRIORITIES; i++) {
+        valid &= _sfetch_ring_init(&chn->user_sent[i], num_items);
+    }
     valid &= _sfetch_ring_init(&chn->user_incoming, num_lanes);
     valid &= _sfetch_ring_init(&chn->user_outgoing, num_lanes);
     #if _SFETCH_HAS_THREADS
         valid &= _sfetch_ring_init(&chn->thread_incoming, num_lanes);
         valid &= _sfetch_ring_init(&chn->thread_outgoing, num_lanes);
+        chn->num_lanes = num_lanes;
+        chn->thread_batch = (uint32_t*) _sfetch_malloc_clear(num_lanes * sizeof(uint32_t));
+    #endif
+    #if _SFETCH_USE_IO_URING
+        /* if this fails the IO thread falls back to pread() */
+        _sfetch_uring_init(&chn->uring, num_lanes);
     #endif
     if (valid) {
         chn->valid = true;
@@ -2418,13 +3422,14 @@ _SOKOL_PRIVATE bool _sfetch_channel_init(_sfetch_channel_t* chn, _sfetch_t* ctx,
     }
 }
 
-/* put a request into the channels sent-queue, this is where all new requests
-   are stored until a lane becomes free.
+/* put a request into the channels sent-queue for its priority, this is where
+   all new requests are stored until a lane becomes free.
 */
-_SOKOL_PRIVATE bool _sfetch_channel_send(_sfetch_channel_t* chn, uint32_t slot_id) {
+_SOKOL_PRIVATE bool _sfetch_channel_send(_sfetch_channel_t* chn, uint32_t slot_id, uint32_t priority) {
     SOKOL_ASSERT(chn && chn->valid);
-    if (!_sfetch_ring_full(&chn->user_sent)) {
-        _sfetch_ring_enqueue(&chn->user_sent, slot_id);
+    SOKOL_ASSERT(priority < SFETCH_NUM_PRIORITIES);
+    if (!_sfetch_ring_full(&chn->user_sent[priority])) {
+        _sfetch_ring_enqueue(&chn->user_sent[priority], slot_id);
         return true;
     }
     else {
@@ -2448,9 +3453,17 @@ _SOKOL_PRIVATE void _sfetch_invoke_response_callback(_sfetch_item_t* item) {
     response.lane = item->lane;
     response.path = item->path.buf;
     response.user_data = item->user.user_data;
-    response.data_offset = item->user.fetched_offset - item->user.fetched_size;
-    response.data.ptr = item->buffer.ptr;
-    response.data.size = item->user.fetched_size;
+    response.data_offset = item->range_offset + item->user.fetched_offset - item->user.fetched_size;
+    if (item->memory_map) {
+        response.data = item->user.mapping.data;
+    }
+    else if (item->user.coalesced_data.ptr) {
+        response.data = item->user.coalesced_data;
+    }
+    else {
+        response.data.ptr = item->buffer.ptr;
+        response.data.size = (size_t)item->user.fetched_size;
+    }
     response.buffer = item->buffer;
     item->callback(&response);
 }
@@ -2461,32 +3474,127 @@ _SOKOL_PRIVATE void _sfetch_cancel_item(_sfetch_item_t* item) {
     item->user.error_code = SFETCH_ERROR_CANCELLED;
 }
 
-/* per-frame channel stuff: move requests in and out of the IO threads, call response callbacks */
-_SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_t* pool) {
+/* try to attach a new coalesced request to an in-flight request for the same
+   path and byte range, returns false if there's no such request
+*/
+_SOKOL_PRIVATE bool _sfetch_coalesce_item(_sfetch_pool_t* pool, uint32_t slot_id) {
+    _sfetch_item_t* item = _sfetch_pool_item_lookup(pool, slot_id);
+    SOKOL_ASSERT(item && item->coalesce && (item->chunk_size == 0) && !item->memory_map);
+    for (uint32_t i = 1; i < pool->size; i++) {
+        _sfetch_item_t* leader = &pool->items[i];
+        if ((leader == item) ||
+            (leader->handle.id == 0) ||
+            leader->coalesced ||
+            leader->user.finished ||
+            leader->user.cancel ||
+            (leader->chunk_size != 0) ||
+            leader->memory_map ||
+            (leader->range_offset != item->range_offset) ||
+            (leader->range_size != item->range_size) ||
+            ((leader->state == _SFETCH_STATE_ALLOCATED) && (leader->priority < item->priority)) ||
+            (0 != strcmp(leader->path.buf, item->path.buf)))
+        {
+            continue;
+        }
+        /* append to the end of the list to finish requests in the order they were sent */
+        _sfetch_item_t* tail = leader;
+        while (tail->next_coalesced) {
+            tail = _sfetch_pool_item_lookup(pool, tail->next_coalesced);
+            SOKOL_ASSERT(tail);
+        }
+        tail->next_coalesced = slot_id;
+        item->coalesced = true;
+        return true;
+    }
+    return false;
+}
 
-    /* move items from sent- to incoming-queue permitting free lanes */
-    const uint32_t num_sent = _sfetch_ring_count(&chn->user_sent);
-    const uint32_t avail_lanes = _sfetch_ring_count(&chn->free_lanes);
-    const uint32_t num_move = (num_sent < avail_lanes) ? num_sent : avail_lanes;
-    for (uint32_t i = 0; i < num_move; i++) {
-        const uint32_t slot_id = _sfetch_ring_dequeue(&chn->user_sent);
+/* finish the requests attached to a finished request, this must happen before
+   the response callback of the finished request, which might reuse its buffer
+*/
+_SOKOL_PRIVATE void _sfetch_finish_coalesced(_sfetch_t* ctx, _sfetch_item_t* leader) {
+    SOKOL_ASSERT(leader->user.finished);
+    _sfetch_pool_t* pool = &ctx->pool;
+    uint32_t slot_id = leader->next_coalesced;
+    leader->next_coalesced = 0;
+    const sfetch_error_t error_code = leader->user.error_code;
+    const bool read_failed = (leader->state == _SFETCH_STATE_FAILED);
+    if (read_failed && (error_code != SFETCH_ERROR_FILE_NOT_FOUND) && (error_code != SFETCH_ERROR_UNEXPECTED_EOF)) {
+        /* the file might still be loadable, the first attached request
+           goes back into its channel and takes the others along
+        */
         _sfetch_item_t* item = _sfetch_pool_item_lookup(pool, slot_id);
-        SOKOL_ASSERT(item);
-        SOKOL_ASSERT(item->state == _SFETCH_STATE_ALLOCATED);
-        // if the item was cancelled early, kick it out immediately
+        SOKOL_ASSERT(item && item->coalesced);
+        item->coalesced = false;
+        _sfetch_channel_t* chn = &ctx->chn[item->channel];
+        SOKOL_ASSERT(!_sfetch_ring_full(&chn->user_sent[item->priority]));
+        _sfetch_ring_enqueue(&chn->user_sent[item->priority], slot_id);
+        return;
+    }
+    while (slot_id) {
+        _sfetch_item_t* item = _sfetch_pool_item_lookup(pool, slot_id);
+        SOKOL_ASSERT(item && item->coalesced);
+        const uint32_t next_slot_id = item->next_coalesced;
+        item->user.fetched_offset = leader->user.fetched_offset;
+        item->user.fetched_size = leader->user.fetched_size;
+        item->user.finished = true;
         if (item->user.cancel) {
             _sfetch_cancel_item(item);
-            _sfetch_invoke_response_callback(item);
-            _sfetch_pool_item_free(pool, slot_id);
-            continue;
         }
-        item->state = _SFETCH_STATE_DISPATCHED;
-        item->lane = _sfetch_ring_dequeue(&chn->free_lanes);
-        // if no buffer provided yet, invoke response callback to do so
-        if (0 == item->buffer.ptr) {
-            _sfetch_invoke_response_callback(item);
+        else if (read_failed) {
+            item->state = _SFETCH_STATE_FAILED;
+            item->user.error_code = error_code;
+        }
+        else if (0 == item->buffer.ptr) {
+            item->state = _SFETCH_STATE_FETCHED;
+            item->user.coalesced_data.ptr = leader->buffer.ptr;
+            item->user.coalesced_data.size = (size_t)leader->user.fetched_size;
+        }
+        else if (item->buffer.size >= leader->user.fetched_size) {
+            item->state = _SFETCH_STATE_FETCHED;
+            memcpy((void*)item->buffer.ptr, leader->buffer.ptr, (size_t)leader->user.fetched_size);
+        }
+        else {
+            item->state = _SFETCH_STATE_FAILED;
+            item->user.error_code = SFETCH_ERROR_BUFFER_TOO_SMALL;
+        }
+        _sfetch_invoke_response_callback(item);
+        _sfetch_pool_item_free(pool, slot_id);
+        slot_id = next_slot_id;
+    }
+}
+
+/* per-frame channel stuff: move requests in and out of the IO threads, call response callbacks */
+_SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_t* pool) {
+
+    /* move items from sent- to incoming-queue permitting free lanes, the
+       highest priority first, and in sending order within the same priority
+    */
+    for (uint32_t prio = SFETCH_NUM_PRIORITIES; prio-- > 0;) {
+        _sfetch_ring_t* sent = &chn->user_sent[prio];
+        while (!_sfetch_ring_empty(sent) && !_sfetch_ring_empty(&chn->free_lanes)) {
+            const uint32_t slot_id = _sfetch_ring_dequeue(sent);
+            _sfetch_item_t* item = _sfetch_pool_item_lookup(pool, slot_id);
+            SOKOL_ASSERT(item);
+            SOKOL_ASSERT(item->state == _SFETCH_STATE_ALLOCATED);
+            // if the item was cancelled early, kick it out immediately
+            if (item->user.cancel) {
+                _sfetch_cancel_item(item);
+                if (item->next_coalesced) {
+                    _sfetch_finish_coalesced(chn->ctx, item);
+                }
+                _sfetch_invoke_response_callback(item);
+                _sfetch_pool_item_free(pool, slot_id);
+                continue;
+            }
+            item->state = _SFETCH_STATE_DISPATCHED;
+            item->lane = _sfetch_ring_dequeue(&chn->free_lanes);
+            // if no buffer provided yet, invoke response callback to do so
+            if ((0 == item->buffer.ptr) && !item->memory_map) {
+                _sfetch_invoke_response_callback(item);
+            }
+            _sfetch_ring_enqueue(&chn->user_incoming, slot_id);
         }
-        _sfetch_ring_enqueue(&chn->user_incoming, slot_id);
     }
 
     /* prepare incoming items for being moved into the IO thread */
@@ -2550,6 +3658,7 @@ _SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_
         /* transfer output params from thread- to user-data */
         item->user.fetched_offset = item->thread.fetched_offset;
         item->user.fetched_size = item->thread.fetched_size;
+        item->user.mapping = item->thread.mapping;
         if (item->user.cancel) {
             _sfetch_cancel_item(item);
         }
@@ -2566,12 +3675,21 @@ _SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_
         else if (item->state == _SFETCH_STATE_FETCHING) {
             item->state = _SFETCH_STATE_FETCHED;
         }
+        if (item->user.finished && item->next_coalesced) {
+            _sfetch_finish_coalesced(chn->ctx, item);
+        }
         _sfetch_invoke_response_callback(item);
 
         /* when the request is finished, free the lane for another request,
            otherwise feed it back into the incoming queue
         */
         if (item->user.finished) {
+            #if _SFETCH_HAS_THREADS
+            /* unless the callback took ownership via sfetch_keep_mapping() */
+            if (item->user.mapping.base_ptr) {
+                _sfetch_file_unmap(&item->user.mapping);
+            }
+            #endif
             _sfetch_ring_enqueue(&chn->free_lanes, item->lane);
             _sfetch_pool_item_free(pool, slot_id);
         }
@@ -2602,6 +3720,40 @@ _SOKOL_PRIVATE bool _sfetch_validate_request(_sfetch_t* ctx, const sfetch_reques
         _SFETCH_ERROR(REQUEST_CHUNK_SIZE_GREATER_BUFFER_SIZE);
         return false;
     }
+    if ((req->offset + req->size) < req->offset) {
+        _SFETCH_ERROR(REQUEST_RANGE_OVERFLOW);
+        return false;
+    }
+    if ((req->chunk_size == 0) && req->buffer.ptr && (req->size > req->buffer.size)) {
+        _SFETCH_ERROR(REQUEST_RANGE_SIZE_GREATER_BUFFER_SIZE);
+        return false;
+    }
+    if (req->priority >= SFETCH_NUM_PRIORITIES) {
+        _SFETCH_ERROR(REQUEST_PRIORITY_TOO_BIG);
+        return false;
+    }
+    if (req->coalesce && (req->chunk_size > 0)) {
+        _SFETCH_ERROR(REQUEST_COALESCE_WITH_CHUNK_SIZE);
+        return false;
+    }
+    if (req->coalesce && req->memory_map) {
+        _SFETCH_ERROR(REQUEST_COALESCE_WITH_MEMORY_MAP);
+        return false;
+    }
+    if (req->memory_map) {
+        #if !_SFETCH_HAS_THREADS
+            _SFETCH_ERROR(REQUEST_MEMORY_MAP_NOT_SUPPORTED);
+            return false;
+        #endif
+        if (req->chunk_size > 0) {
+            _SFETCH_ERROR(REQUEST_MEMORY_MAP_WITH_CHUNK_SIZE);
+            return false;
+        }
+        if (req->buffer.ptr || (req->buffer.size > 0)) {
+            _SFETCH_ERROR(REQUEST_MEMORY_MAP_WITH_BUFFER);
+            return false;
+        }
+    }
     if (req->user_data.ptr && (req->user_data.size == 0)) {
         _SFETCH_ERROR(REQUEST_USERDATA_PTR_IS_SET_BUT_USERDATA_SIZE_IS_NULL);
         return false;
@@ -2671,6 +3823,19 @@ SOKOL_API_IMPL void sfetch_shutdown(void) {
             _sfetch_channel_discard(&ctx->chn[i]);
         }
     }
+    #if _SFETCH_HAS_THREADS
+    /* unmap file data of memory-mapped requests that never made it to their last callback */
+    if (ctx->pool.items) {
+        for (uint32_t i = 0; i < ctx->pool.size; i++) {
+            if (ctx->pool.items[i].thread.mapping.base_ptr) {
+                _sfetch_file_unmap(&ctx->pool.items[i].thread.mapping);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < ctx->num_packs; i++) {
+        _sfetch_pack_discard(&ctx->packs[i]);
+    }
+    #endif
     _sfetch_pool_discard(&ctx->pool);
     ctx->setup = false;
     _sfetch_free(ctx);
@@ -2724,7 +3889,14 @@ SOKOL_API_IMPL sfetch_handle_t sfetch_send(const sfetch_request_t* request) {
         _SFETCH_WARN(REQUEST_POOL_EXHAUSTED);
         return invalid_handle;
     }
-    if (!_sfetch_channel_send(&ctx->chn[request->channel], slot_id)) {
+    #if _SFETCH_HAS_THREADS
+    _sfetch_pack_lookup(ctx, _sfetch_pool_item_at(&ctx->pool, slot_id));
+    #endif
+    if (request->coalesce && _sfetch_coalesce_item(&ctx->pool, slot_id)) {
+        /* attached to an in-flight request, doesn't go into the channel */
+        return _sfetch_make_handle(slot_id);
+    }
+    if (!_sfetch_channel_send(&ctx->chn[request->channel], slot_id, request->priority)) {
         /* send failed because the channels sent-queue overflowed */
         _sfetch_pool_item_free(&ctx->pool, slot_id);
         return invalid_handle;
@@ -2779,6 +3951,33 @@ SOKOL_API_IMPL void* sfetch_unbind_buffer(sfetch_handle_t h) {
     }
 }
 
+SOKOL_API_IMPL sfetch_mapping_t sfetch_keep_mapping(sfetch_handle_t h) {
+    _sfetch_t* ctx = _sfetch_ctx();
+    SOKOL_ASSERT(ctx && ctx->valid);
+    SOKOL_ASSERT(ctx->in_callback);
+    sfetch_mapping_t mapping;
+    _sfetch_clear(&mapping, sizeof(mapping));
+    _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, h.id);
+    if (item && item->user.mapping.base_ptr) {
+        mapping = item->user.mapping;
+        /* the mapping is no longer owned by the request */
+        _sfetch_clear(&item->user.mapping, sizeof(item->user.mapping));
+        _sfetch_clear(&item->thread.mapping, sizeof(item->thread.mapping));
+    }
+    return mapping;
+}
+
+SOKOL_API_IMPL void sfetch_release_mapping(const sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping);
+    #if _SFETCH_HAS_THREADS
+    if (mapping->base_ptr) {
+        _sfetch_file_unmap(mapping);
+    }
+    #else
+    _SOKOL_UNUSED(mapping);
+    #endif
+}
+
 SOKOL_API_IMPL void sfetch_pause(sfetch_handle_t h) {
     _sfetch_t* ctx = _sfetch_ctx();
     SOKOL_ASSERT(ctx && ctx->valid);
@@ -2809,4 +4008,27 @@ SOKOL_API_IMPL void sfetch_cancel(sfetch_handle_t h) {
         item->user.cancel = true;
     }
 }
+
+SOKOL_API_IMPL bool sfetch_mount_pack(const char* path) {
+    _sfetch_t* ctx = _sfetch_ctx();
+    SOKOL_ASSERT(ctx && ctx->valid);
+    SOKOL_ASSERT(path);
+    #if _SFETCH_HAS_THREADS
+    if (ctx->num_packs >= SFETCH_MAX_PACKS) {
+        _SFETCH_ERROR(PACK_TOO_MANY_PACKS);
+        return false;
+    }
+    _sfetch_pack_t* pack = &ctx->packs[ctx->num_packs];
+    if (!_sfetch_pack_init(pack, path)) {
+        _sfetch_pack_discard(pack);
+        return false;
+    }
+    ctx->num_packs++;
+    return true;
+    #else
+    _SOKOL_UNUSED(path);
+    _SFETCH_ERROR(PACK_NOT_SUPPORTED);
+    return false;
+    #endif
+}
 #endif /* SOKOL_FETCH_IMPL */
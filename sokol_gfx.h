@@ -156,6 +156,13 @@
         Read the section 'UNIFORM DATA LAYOUT' to learn about the expected memory layout
         of the uniform data passed into sg_apply_uniforms().
 
+        If the uniform data is identical with the data of the previous
+        sg_apply_uniforms() call on the same shader stage and uniform block
+        slot (and no other pipeline has been applied and no new pass has
+        been started in between), the call is skipped without calling into
+        the backend 3D API. Uniform blocks bigger than 256 bytes are not
+        checked. This behaviour can be disabled with sg_desc.disable_uniform_cache.
+
     --- kick off a draw call with:
 
             sg_draw(int base_element, int num_elements, int num_instances)
@@ -258,7 +265,7 @@
         }
 
         A buffer to be used with sg_append_buffer() must have been created
-        with SG_USAGE_DYNAMIC or SG_USAGE_STREAM.
+        with SG_USAGE_DYNAMIC, SG_USAGE_STREAM or SG_USAGE_STREAM_RING.
 
         If the application appends more data to the buffer then fits into
         the buffer, the buffer will go into the "overflow" state for the
@@ -285,6 +292,68 @@
         is associated with one draw call, but will be problematic when
         a single indexed draw call spans several appended chunks of indices.
 
+    --- to write data directly into SG_USAGE_STREAM_RING buffers without
+        an intermediate copy, call:
+
+            sg_mapped_range sg_map_buffer_range(sg_buffer buf, size_t size)
+            void sg_unmap_buffer_range(sg_buffer buf)
+
+        See the section STREAMING DATA WITH RING BUFFERS for details.
+
+    --- to write pixel data for a dynamic image directly into upload buffer
+        memory and upload it without stalling the CPU, call:
+
+            sg_mapped_range sg_map_image_upload(sg_image img, int face, int mip_level)
+            sg_image_upload sg_unmap_image_upload(sg_image img)
+            bool sg_query_image_upload_done(sg_image_upload upload)
+
+        See the section ASYNCHRONOUS IMAGE UPLOADS for details.
+
+    --- to read back pixel data from a render target image or the default
+        framebuffer, call:
+
+            bool sg_read_image_async(const sg_read_desc* desc)
+            bool sg_read_image(const sg_read_desc* desc, const sg_range* data)
+
+        See the section READING BACK IMAGE DATA for details.
+
+    --- to generate the mipmap chain of a render target or dynamic image
+        on the GPU from the content of its first mip level, call:
+
+            sg_generate_mipmaps(sg_image img)
+
+        See the section GENERATING MIPMAPS for details.
+
+    --- to run compute shaders which read and write storage buffers, call:
+
+            sg_begin_compute_pass()
+            sg_apply_pipeline(sg_pipeline pip)
+            sg_apply_bindings(const sg_bindings* bindings)
+            sg_apply_uniforms(SG_SHADERSTAGE_CS, int ub_index, const sg_range* data)
+            sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z)
+            sg_end_pass()
+
+        See the section COMPUTE SHADERS AND STORAGE BUFFERS for details.
+
+    --- to get render target images and pass objects for the current frame
+        from a pool of reusable objects instead of creating and destroying
+        them, call:
+
+            sg_image sg_acquire_transient_image(const sg_transient_image_desc* desc)
+            sg_pass sg_acquire_transient_pass(const sg_pass_desc* desc)
+            void sg_release_transient_image(sg_image img)
+            sg_transient_stats sg_query_transient_stats(void)
+
+        See the section TRANSIENT RENDER TARGETS for details.
+
+    --- to get the estimated GPU memory size of all buffers and images, call:
+
+            sg_memory_stats sg_query_memory_stats(void)
+
+        ...an optional callback in sg_desc.memory_budget is called when
+        the total size crosses a threshold. See the section RESOURCE MEMORY
+        ACCOUNTING for details.
+
     --- to check at runtime for optional features, limits and pixelformat support,
         call:
 
@@ -784,6 +853,37 @@
     because sokol-gfx must be able to locate the uniform block members in order
     to upload them to the GPU with glUniformXXX() calls.
 
+    Alternatively the GL backends can upload an entire uniform block with a
+    single copy into a uniform buffer object, which is much cheaper on the CPU
+    side for uniform blocks with many members. To use this path, declare the
+    uniform block as a std140 GLSL uniform block and provide the GLSL block
+    name in sg_shader_uniform_block_desc.glsl_name:
+
+        layout(std140) uniform vs_params {
+            mat4 mvp;
+            vec4 offset;
+        };
+
+        sg_shader_desc desc = {
+            .vs.uniform_blocks[0] = {
+                .size = sizeof(vs_params_t),
+                .layout = SG_UNIFORMLAYOUT_STD140,
+                .glsl_name = "vs_params",
+                .uniforms = {
+                    [0] = { .name = "mvp", .type = SG_UNIFORMTYPE_MAT4 },
+                    [1] = { .name = "offset", .type = SG_UNIFORMTYPE_FLOAT4 },
+                }
+            }
+        };
+
+    The uniform block layout must be SG_UNIFORMLAYOUT_STD140 in this case.
+    The data of all sg_apply_uniforms() calls is written into a per-frame
+    uniform buffer (with the size sg_desc.uniform_buffer_size) and uploaded
+    before the next draw call. If the GLSL uniform block is not found in the
+    linked shader program, sokol-gfx falls back to the per-member glUniformXXX()
+    path, and the uniform block members still need to be described for this
+    fallback (and for validating the uniform block size).
+
     To describe the uniform block layout to sokol-gfx, the following information
     must be passed to the sg_make_shader() call in the sg_shader_desc struct:
 
@@ -1106,6 +1206,838 @@
     listener item was found and removed, and false otherwise.
 
 
+    RECORDING AND REPLAYING RENDERING COMMANDS
+    ==========================================
+    Static parts of a scene often issue the exact same sequence of
+    sg_apply_pipeline(), sg_apply_bindings(), sg_apply_uniforms() and sg_draw()
+    calls each frame, and each of those calls pays for validation and
+    resource-id lookups. Such sequences can be recorded once and replayed
+    cheaply in later frames:
+
+        sg_begin_pass(...);
+        sg_begin_recording();
+        sg_apply_pipeline(pip);
+        sg_apply_bindings(&bind);
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+        sg_draw(0, 36, 1);
+        ...
+        sg_recording rec = sg_end_recording();
+        sg_end_pass();
+
+    Between sg_begin_recording() and sg_end_recording(), the rendering
+    functions sg_apply_viewport(), sg_apply_scissor_rect(), sg_apply_pipeline(),
+    sg_apply_bindings(), sg_apply_uniforms() and sg_draw() are validated as usual,
+    but instead of being forwarded to the 3D backend, they are stored with all
+    resource ids already resolved (uniform data is copied into the recording).
+    Calls which would be skipped because of invalid resources are not recorded
+    at all. If the pipeline was applied before sg_begin_recording(),
+    it is recorded implicitly with the first sg_apply_bindings() call.
+
+    To execute a recording inside a pass, call:
+
+        sg_replay(rec);
+
+    ...this calls straight into the backend without validation or id lookups.
+    The only checks performed are that the resources used by the recording
+    are still alive (one generation-counter compare per resource), and in
+    debug mode, that the current pass has the same attachment pixel formats
+    and sample count as the pass the recording was created in. Recordings
+    can be replayed any number of times in any frame.
+
+    After sg_replay() returns, the last pipeline in the recording is the
+    currently applied pipeline, but resource bindings must be applied
+    again before the next sg_draw().
+
+    The number of recordings that can exist at the same time is defined
+    by sg_desc.recording_pool_size (default: 16). Destroy a recording
+    with:
+
+        sg_destroy_recording(rec);
+
+    Note that recordings cannot be nested, and a recording must be
+    finished before the pass it was started in ends. Calling sg_end_pass()
+    while recording is an error, and the unfinished recording will be
+    discarded.
+
+    In the sg_frame_stats struct, replayed commands are counted in
+    num_replay and num_replay_commands, not in num_apply_* and num_draw.
+
+
+    MULTITHREADED COMMAND ENCODING
+    ==============================
+    All sokol-gfx rendering functions must be called from the thread
+    which owns the 3D-API context. To move the CPU work of scene traversal
+    and draw emission to worker threads, rendering commands can be written
+    into sg_encoder objects instead, which are then submitted in a well-defined
+    order on the main thread.
+
+    Encoders are created and destroyed on the main thread:
+
+        sg_encoder enc = sg_make_encoder(&(sg_encoder_desc){
+            .size = 256 * 1024,     // default is 64 KBytes
+        });
+        ...
+        sg_destroy_encoder(enc);
+
+    All memory needed by an encoder is allocated in sg_make_encoder(),
+    filling an encoder never allocates. On a worker thread, record commands
+    with the following functions, which are equivalent to the regular
+    rendering functions:
+
+        sg_encoder_apply_viewport(enc, ...)
+        sg_encoder_apply_scissor_rect(enc, ...)
+        sg_encoder_apply_pipeline(enc, ...)
+        sg_encoder_apply_bindings(enc, ...)
+        sg_encoder_apply_uniforms(enc, ...)
+        sg_encoder_draw(enc, ...)
+
+    These functions only write into the encoder's own memory, so different
+    encoders can be filled in parallel without locking. A single encoder
+    must not be accessed from different threads at the same time, and
+    encoders must not be created or destroyed while other threads are
+    recording into encoders.
+
+    After all worker threads have finished, submit the encoders on the
+    main thread inside a pass, the submission order defines the order of
+    rendering commands:
+
+        sg_begin_default_pass(...);
+        for (int i = 0; i < num_workers; i++) {
+            sg_submit_encoder(workers[i].enc);
+        }
+        sg_end_pass();
+
+    sg_submit_encoder() forwards the recorded commands to the regular
+    sg_apply_*() and sg_draw() functions (so the usual validation and
+    frame stats apply), and then rewinds the encoder so that it is ready
+    for the next frame. An encoder can also be rewound explicitly
+    with sg_encoder_rewind().
+
+    If the encoder memory overflows, all further commands will be dropped,
+    and sg_submit_encoder() will log an error and skip the entire encoder
+    content. Call sg_query_encoder_overflow() to check if an encoder has
+    overflowed.
+
+    The number of encoders that can exist at the same time is defined by
+    sg_desc.encoder_pool_size (default: 16).
+
+
+    MULTI-DRAW AND INDIRECT DRAWING
+    ===============================
+    To issue many draw calls with the same pipeline and resource bindings
+    in one go, put the draw parameters into an array of sg_draw_args
+    structs and call:
+
+        sg_draw_multi(const sg_draw_args* args, int count)
+
+    This has the same effect as calling sg_draw() once for each array item,
+    items with zero elements or instances are skipped (as are items with
+    negative values, which are an error caught by an assert).
+
+    Alternatively the draw parameters can be sourced from a buffer object
+    created with type SG_BUFFERTYPE_INDIRECTBUFFER which contains a tightly
+    packed array of sg_draw_indirect_args structs:
+
+        sg_draw_indirect(sg_buffer buf, int offset, int count)
+
+    The offset is a byte offset into the buffer and must be a multiple
+    of 4. The sg_draw_indirect_args struct has the same memory layout as
+    GL's DrawElementsIndirectCommand struct. The base_vertex and
+    base_instance members are reserved and must be zero, this is checked
+    by the validation layer, and in release mode the fallback path skips
+    items with non-zero values (the native GL path passes them through).
+
+    The feature flags sg_features.multi_draw and sg_features.draw_indirect
+    indicate whether the backend 3D-API has native support for those
+    operations (currently only in the GL backend via glMultiDrawElements()
+    and glMultiDrawElementsIndirect()). Otherwise sg_draw_multi() and
+    sg_draw_indirect() fall back to a loop over the regular per-backend
+    draw function. For this, sokol-gfx keeps a CPU-side copy of the content
+    of indirect buffers which is written in sg_make_buffer(),
+    sg_update_buffer() and sg_append_buffer().
+
+    Calling sg_draw_multi() while a recording is in progress will record
+    one draw command per array item, sg_draw_indirect() cannot be called
+    while recording.
+
+    In the sg_frame_stats struct, sg_draw_multi() and sg_draw_indirect()
+    calls are counted in num_draw_multi and num_draw_indirect,
+    not in num_draw.
+
+
+    STREAMING DATA WITH RING BUFFERS
+    ================================
+    Buffers created with SG_USAGE_STREAM_RING are meant for data which is
+    written anew each frame in many small pieces (for instance the vertex
+    data of immediate-mode UIs, debug renderers or particle systems).
+    Instead of building the data in a temporary array and copying it with
+    sg_append_buffer(), producers can write directly into buffer memory:
+
+        sg_buffer buf = sg_make_buffer(&(sg_buffer_desc){
+            .usage = SG_USAGE_STREAM_RING,
+            .size = 4 * 1024 * 1024,
+        });
+        ...
+        const sg_mapped_range r = sg_map_buffer_range(buf, num_bytes);
+        if (r.ptr) {
+            // write up to r.size bytes to r.ptr
+            ...
+            sg_unmap_buffer_range(buf);
+            bindings.vertex_buffers[0] = buf;
+            bindings.vertex_buffer_offsets[0] = r.offset;
+            sg_apply_bindings(&bindings);
+            sg_draw(...);
+        }
+
+    The buffer is split into SG_NUM_INFLIGHT_FRAMES equally sized regions,
+    one region is used per frame, so each frame may write up to
+    sg_buffer_desc.size / SG_NUM_INFLIGHT_FRAMES bytes. Mapped ranges are
+    4-byte aligned. If a frame region runs out of space, sg_map_buffer_range()
+    returns a zero-initialized sg_mapped_range and the buffer goes into the
+    overflow state for the rest of the frame (just like sg_append_buffer()).
+    sg_append_buffer() also works on ring buffers, the returned offset
+    points into the current frame region.
+
+    Only one range per buffer may be mapped at a time, and the range must be
+    unmapped before any draw call which reads the data. sg_update_buffer()
+    cannot be used with ring buffers, and the SG_USAGE_STREAM_RING usage
+    is not allowed for images and for injected native buffers.
+
+    Backend specifics:
+
+    - on desktop GL with GL 4.4 or ARB_buffer_storage, ring buffers are
+      persistently mapped and sg_map_buffer_range() returns a pointer
+      directly into buffer memory, the CPU only waits for the GPU if a
+      frame region is still in use by the GPU (this is tracked with fences)
+    - on Metal, sg_map_buffer_range() returns a pointer into the buffer's
+      CPU-visible memory
+    - on all other backends sg_map_buffer_range() returns a pointer
+      into CPU-side staging memory, the data is copied into the
+      buffer in sg_unmap_buffer_range()
+
+    In the sg_frame_stats struct, calls to sg_map_buffer_range() are
+    counted in num_map_buffer and size_map_buffer.
+
+
+    BINDING SETS
+    ============
+    sg_apply_bindings() looks up and validates every resource id in the
+    sg_bindings struct on each call. For resource bindings which are used
+    over many frames, this work can be done once upfront by creating an
+    sg_binding_set object:
+
+        sg_binding_set bset = sg_make_binding_set(&(sg_binding_set_desc){
+            .bindings = {
+                .vertex_buffers[0] = vbuf,
+                .index_buffer = ibuf,
+                .fs = { .images[0] = img, .samplers[0] = smp },
+            }
+        });
+
+    All resources must be alive and in valid state when the binding set is
+    created, otherwise the binding set will be in the FAILED resource state.
+    Apply the binding set instead of an sg_bindings struct:
+
+        sg_apply_pipeline(pip);
+        sg_apply_binding_set(bset);
+        sg_draw(...);
+
+    The binding set keeps resolved resource pointers, sg_apply_binding_set()
+    only checks that the referenced resources are still alive (one
+    generation-counter compare per resource). In debug mode, the usual
+    sg_apply_bindings() validation against the currently applied pipeline
+    is only performed the first time a binding set is applied with a
+    specific pipeline. Binding sets may be used while recording (see
+    sg_begin_recording()), but not with sg_encoder objects.
+
+    The number of binding sets that can exist at the same time is defined
+    by sg_desc.binding_set_pool_size (default: 128). Destroy a binding set
+    with:
+
+        sg_destroy_binding_set(bset);
+
+    Destroying a resource which is referenced by a binding set doesn't
+    affect the binding set object, but applying the binding set will
+    fail from then on.
+
+    In the sg_frame_stats struct, calls to sg_apply_binding_set() are
+    counted in num_apply_bindings.
+
+
+    PIPELINE CACHE
+    ==============
+    When pipeline objects are created procedurally (for instance from
+    material permutations), many sg_make_pipeline() calls may end up
+    with identical pipeline state. With the optional pipeline cache,
+    such calls return the already existing pipeline object instead of
+    creating a new one:
+
+        sg_setup(&(sg_desc){
+            .enable_pipeline_cache = true,
+            ...
+        });
+
+    The cache key is a hash of the sg_pipeline_desc struct members after
+    default values have been patched in (the label is ignored), a cache
+    hit also compares all members to rule out hash collisions. Cached pipelines
+    are reference counted: each sg_make_pipeline() call which returns
+    a cached pipeline increments the reference count, and sg_destroy_pipeline()
+    only destroys the pipeline when the last reference is released.
+    Only pipelines created with sg_make_pipeline() are cached, and
+    pipelines in the FAILED resource state are never cached.
+
+    In the sg_frame_stats struct, cache hits and misses are counted in
+    num_pipeline_cache_hits and num_pipeline_cache_misses.
+
+
+    SORTED DRAW QUEUE
+    =================
+    The state caches in the backends only help if consecutive draw calls
+    share state, but the order in which an application submits draw calls
+    is often defined by scene traversal, not by rendering state. Instead of
+    calling sg_apply_pipeline(), sg_apply_bindings(), sg_apply_uniforms()
+    and sg_draw() directly, draw calls can be put into a queue, each draw
+    call tagged with a 64-bit sort key:
+
+        sg_begin_default_pass(...);
+        for (int i = 0; i < num_objects; i++) {
+            sg_queue_draw(&(sg_queued_draw){
+                .sort_key = ((uint64_t)obj[i].material << 32) | obj[i].depth,
+                .pipeline = obj[i].pip,
+                .bindings = obj[i].bindings,
+                .vs_uniforms[0] = SG_RANGE(obj[i].vs_params),
+                .num_elements = obj[i].num_elements,
+                .num_instances = 1,
+            });
+        }
+        sg_end_pass();
+
+    The layout of the sort key is up to the application, a common layout
+    is to put the most expensive state changes into the most significant
+    bits (e.g. the pipeline, followed by the texture set, followed by the
+    depth).
+
+    sg_queue_draw() copies the draw parameters and uniform data. In
+    sg_end_pass(), the queued draws are sorted by key (with a stable radix
+    sort, so that draws with identical keys are executed in submission
+    order) and then executed by calling the regular sg_apply_pipeline(),
+    sg_apply_bindings(), sg_apply_uniforms() and sg_draw() functions. Calls
+    to sg_apply_pipeline() and sg_apply_bindings() are skipped if consecutive
+    draws use the same pipeline or resource bindings.
+
+    Note that queued draws are executed after all rendering commands which
+    have been issued directly in the same pass. The queue cannot be used
+    while recording (see sg_begin_recording()).
+
+    In the sg_frame_stats struct, queued draws are counted in num_queue_draw,
+    and the number of pipeline and resource binding changes avoided by
+    sorting (compared to executing the draws in submission order) are
+    counted in num_queue_saved_apply_pipeline and num_queue_saved_apply_bindings.
+    Each avoided pipeline change saves a glUseProgram() and the associated
+    render state updates in the GL backend, and each avoided bindings change
+    saves the glBindBuffer(), glVertexAttribPointer() and glBindTexture()
+    calls for the resource bindings (see the GL-specific frame stats for
+    the number of GL calls actually issued).
+
+
+    GPU TIMINGS
+    ===========
+    The frame stats only count CPU-side calls. To measure how much GPU
+    time is spent in render passes and debug groups (see sg_push_debug_group()),
+    enable GPU timings in sg_setup():
+
+        sg_setup(&(sg_desc){
+            .enable_pass_timings = true,
+            ...
+        });
+
+    Each render pass and each debug group is then bracketed with a pair of
+    GPU timestamp queries. The results are read back a few frames later,
+    once the GPU has finished the frame, so that the CPU never waits for the
+    GPU. Call sg_query_pass_timings() to get the timings of the latest
+    frame for which the results are available:
+
+        const sg_pass_timings t = sg_query_pass_timings();
+        for (int i = 0; i < t.num_timings; i++) {
+            const sg_pass_timing* pt = &t.timings[i];
+            printf("%*s%s: %.3f ms\n", pt->depth * 2, "",
+                (pt->type == SG_TIMINGTYPE_PASS) ? "pass" : pt->name,
+                pt->gpu_time_ns / 1000000.0);
+        }
+
+    The timings are in the order in which the passes and debug groups
+    have been started in the frame, .frame_index is the frame the timings
+    have been recorded in, or 0 if no results are available yet. If the
+    results of a frame are still not available after 4 frames, they are
+    dropped. Up to SG_MAX_PASS_TIMINGS passes and debug groups are timed
+    per frame. Debug groups which are still open in sg_commit() end
+    at that point.
+
+    GPU timings are only supported if sg_features.pass_timings is true,
+    currently this is the case on desktop GL (with GL_TIMESTAMP queries)
+    and in the dummy backend. The dummy backend returns synthetic values
+    which are deterministic: each timestamp is 1000 nanoseconds after the
+    previous timestamp.
+
+
+    SHADER PROGRAM CACHE
+    ====================
+    On GL, creating a shader means compiling and linking GLSL source
+    code, which can take a lot of time at startup when many shaders
+    are created. To skip this work on the next application start, provide
+    a pair of callbacks which load and store compiled shader programs
+    (for instance in files):
+
+        sg_setup(&(sg_desc){
+            .shader_cache = {
+                .load_fn = my_load_shader_binary,
+                .store_fn = my_store_shader_binary,
+                .user_data = ...,
+            },
+            ...
+        });
+
+        sg_shader_binary my_load_shader_binary(uint64_t key, void* user_data) {
+            // return a previously stored binary for 'key', or a
+            // zero-initialized struct if there's no binary for 'key'
+            ...
+        }
+
+        void my_store_shader_binary(uint64_t key, const sg_shader_binary* bin, void* user_data) {
+            // store bin->format and a copy of the bin->data range for 'key'
+            ...
+        }
+
+    The key is a hash of the shader source code in the sg_shader_desc struct.
+    The data returned by the load callback must remain valid until the
+    sg_make_shader() call which invoked the callback returns.
+
+    In the GL backend, the binary is created with glGetProgramBinary() and
+    loaded with glProgramBinary(). If the GL driver rejects a binary (for
+    instance after a driver update), the shader is compiled from source,
+    and the store callback is called with the new binary. Program binaries
+    are available on GLES3 (but not WebGL2), and on desktop GL with GL 4.1
+    or the GL_ARB_get_program_binary extension, if the driver supports
+    at least one binary format. On all other backends the callbacks are
+    not called (except in the dummy backend, where the cache is emulated
+    with the cache key as binary data for testing).
+
+    In the sg_frame_stats struct, shaders created from a cached binary are
+    counted in num_shader_cache_hits, and shaders which had to be compiled
+    from source are counted in num_shader_cache_misses.
+
+
+    ASYNCHRONOUS SHADER CREATION
+    ============================
+    By default, sg_make_shader() waits until the GL driver has compiled and
+    linked the shader program. To keep the render loop responsive while
+    shaders are created, set sg_desc.enable_async_shaders to true:
+
+        sg_setup(&(sg_desc){
+            .enable_async_shaders = true,
+            ...
+        });
+
+    Now sg_make_shader() only starts compiling and linking the shader, and
+    returns a shader in the PENDING state. Pipeline objects created with
+    a PENDING shader are also in the PENDING state. Pending resources are
+    checked in sg_commit(): once the GL driver has finished a shader,
+    the shader goes into the VALID or FAILED state, and the pipeline objects
+    using the shader are created (or go into the FAILED state with the shader).
+
+    Applying a PENDING pipeline is not an error, instead all following
+    sg_apply_bindings(), sg_apply_uniforms() and draw calls are silently
+    skipped until the next sg_apply_pipeline(). This means that objects
+    simply don't show up until their shader is ready. Use
+    sg_query_pipeline_state() to check whether a pipeline is ready.
+
+    If the GL driver supports the GL_KHR_parallel_shader_compile or
+    GL_ARB_parallel_shader_compile extension, the driver compiles shaders
+    on background threads and sg_commit() polls the completion status without
+    blocking. Without the extension, pending shaders are finished in the
+    next sg_commit(), which still moves the compile and link stall out of
+    sg_make_shader(). Shaders which are loaded from the shader cache
+    (see SHADER PROGRAM CACHE) are never pending. On all other backends,
+    shaders are always created immediately (except in the dummy backend,
+    where pending shaders are emulated for testing).
+
+    In the sg_frame_stats struct, calls to sg_apply_pipeline() with a
+    PENDING pipeline are counted in num_apply_pending_pipeline.
+
+
+    GROWABLE RESOURCE POOLS
+    =======================
+    Resource objects live in pools which are allocated in sg_setup(), with
+    sizes defined by the sg_desc.xxx_pool_size items. By default, creating
+    a resource fails when its pool is exhausted. To let the buffer, image,
+    sampler, shader, pipeline and pass pools grow instead, set
+    sg_desc.enable_growable_pools to true:
+
+        sg_setup(&(sg_desc){
+            .buffer_pool_size = 256,
+            .enable_growable_pools = true,
+            ...
+        });
+
+    An exhausted pool then grows by another chunk of the initial pool size
+    (for instance 256 buffers). Existing resource objects are never moved
+    when a pool grows, and resource ids stay valid. Pools never shrink, and
+    a pool can't grow beyond 65535 items.
+
+    To right-size the initial pool sizes, call sg_query_pool_stats(), which
+    returns the current size, number of used slots and high-water mark
+    (the max number of used slots since sg_setup()) of each pool.
+
+
+    ASYNCHRONOUS IMAGE UPLOADS
+    ==========================
+    sg_update_image() copies pixel data from client memory, on GL this
+    happens in glTexSubImage2D/3D() which often blocks until the driver
+    has copied the data. For large, frequently updated images (like video
+    frames or streamed texture atlas pages), pixel data can instead be
+    written directly into a ring-buffer of upload memory and uploaded
+    from there without stalling the CPU:
+
+        const sg_mapped_range r = sg_map_image_upload(img, 0, 0);
+        if (r.ptr) {
+            // write r.size bytes of pixel data to r.ptr
+            ...
+            sg_image_upload upload = sg_unmap_image_upload(img);
+            ...
+            // later, check whether the GPU has finished the upload
+            if (sg_query_image_upload_done(upload)) {
+                ...
+            }
+        }
+
+    sg_map_image_upload() maps the pixel data of one mip level of one cube
+    face (for all other image types, the face index must be 0). The size of
+    the mapped range is the size of the whole mip level, for 3D and array
+    images this includes all slices, rows are tightly packed.
+
+    sg_unmap_image_upload() issues the upload into the image and returns a
+    handle which can be used to check whether the GPU has finished the upload
+    (sg_query_image_upload_done() returns false for failed uploads with an
+    id of 0). Draw calls issued after sg_unmap_image_upload() always see the
+    uploaded data. Only one image upload may be mapped at a time.
+
+    The upload buffer is allocated on first use, with the size defined in
+    sg_desc.upload_buffer_size (default: 8 MB). Upload memory is recycled
+    once the GPU has finished reading it. When the upload buffer (or the
+    queue of 64 pending uploads) is full, sg_map_image_upload() doesn't
+    wait for the GPU but returns a zero-initialized sg_mapped_range, in
+    this case try again in a later frame or fall back to sg_update_image().
+
+    Image uploads are only allowed for images with SG_USAGE_DYNAMIC or
+    SG_USAGE_STREAM and an uncompressed pixel format. Unlike
+    sg_update_image(), the upload writes into the texture which is currently
+    used for rendering (instead of rotating to the next texture), and
+    multiple uploads per image and frame are allowed. Don't mix
+    sg_update_image() and image uploads on the same image.
+
+    Backend specifics:
+
+    - on GL, the upload buffer is a GL_PIXEL_UNPACK_BUFFER, and
+      sg_query_image_upload_done() checks a fence object; on WebGL2,
+      pixel data is written into CPU-side staging memory and copied into
+      the pixel buffer in sg_unmap_image_upload()
+    - the dummy backend uses CPU-side staging memory, uploads are reported
+      as done after the next sg_commit()
+    - image uploads are not yet supported on the Metal, D3D11 and WebGPU
+      backends, check sg_query_features().image_upload
+
+    In the sg_frame_stats struct, calls to sg_unmap_image_upload() are
+    counted in num_image_upload and size_image_upload.
+
+
+    READING BACK IMAGE DATA
+    =======================
+    Pixel data can be read back from render target images and from the
+    default framebuffer, for instance for visual regression tests,
+    screenshots or thumbnails. sg_read_image_async() starts a read and
+    doesn't wait for the GPU, the pixel data is passed to a callback in
+    a later sg_commit():
+
+        static void read_done(const sg_read_result* res) {
+            // res->data.ptr and res->data.size is the pixel data, this
+            // is only valid until the callback returns
+            ...
+        }
+        ...
+        sg_read_image_async(&(sg_read_desc){
+            .image = img,
+            .callback = read_done,
+            .user_data = ...,
+        });
+
+    The optional .x, .y, .width and .height items define the rectangle to
+    read, by default the whole image is read. To read from the default
+    framebuffer, leave .image at SG_INVALID_ID and provide the width and
+    height of the rectangle to read. sg_read_image_async() returns false if
+    the read couldn't be started, up to 16 reads may be pending at a time.
+    If a started read fails later (for instance when the GL read buffer
+    can't be mapped), the callback is still called, but with
+    sg_read_result.failed set to true and an empty .data range.
+
+    sg_read_image() is the synchronous version which waits for the GPU and
+    copies the pixel data into the provided memory range (the .callback item
+    is ignored). This is mainly useful for tests and tools, since it stalls
+    the CPU until the GPU has finished rendering.
+
+    Reads must happen outside of render passes. Only 2D render target images
+    with a color pixel format and a sample count of 1 can be read (for MSAA
+    render targets, read the resolve image instead), and only from the
+    first mip level. The pixel data is in the pixel format of the image (or
+    sg_desc.context.color_format for the default framebuffer) with tightly
+    packed rows. The row order is the native order of the backend, for
+    instance on GL the first row is the bottom row (check
+    sg_features.origin_top_left).
+
+    Backend specifics:
+
+    - on GL, sg_read_image_async() reads into a GL_PIXEL_PACK_BUFFER and
+      checks a fence object in sg_commit(), the callback is called in the
+      first sg_commit() after the GPU has finished writing the data. Note
+      that GLES3 only guarantees that reading RGBA8 data works.
+    - the dummy backend returns deterministic pixel data for testing: the
+      first byte of each pixel is its x coordinate, the second byte is its
+      y coordinate (both truncated to 8 bits), all remaining bytes are 0xFF,
+      the callback is called in the next sg_commit()
+    - reading back image data is not yet supported on the Metal, D3D11 and
+      WebGPU backends, check sg_query_features().image_read
+
+    Pending reads are dropped without calling the callback in sg_shutdown().
+
+
+    GENERATING MIPMAPS
+    ==================
+    Images which aren't initialized with data at creation (render targets
+    and dynamic or stream images) only get their first mip level written
+    by rendering or sg_update_image(). Instead of building the remaining
+    mip levels on the CPU, the mipmap chain can be generated on the GPU by
+    downsampling the first mip level:
+
+        sg_generate_mipmaps(img);
+
+    This must be called outside of render passes, and for dynamic and
+    stream images after sg_update_image() in the same frame. Images with
+    a single mip level are silently ignored.
+
+    For render targets, mipmaps can also be generated automatically at the
+    end of each render pass which renders into the image by setting
+    sg_image_desc.generate_mipmaps at creation:
+
+        sg_image img = sg_make_image(&(sg_image_desc){
+            .render_target = true,
+            .width = 256,
+            .height = 256,
+            .num_mipmaps = 9,
+            .generate_mipmaps = true,
+        });
+
+    This only happens for pass attachments which render into the first mip
+    level. For MSAA render passes, set .generate_mipmaps on the resolve
+    image, MSAA images themselves can't have mipmaps.
+
+    Mipmap generation requires a pixel format which is both filterable and
+    renderable (check sg_query_pixelformat()), depth and compressed pixel
+    formats are not supported.
+
+    Backend specifics:
+
+    - GL uses glGenerateMipmap()
+    - Metal uses a blit command encoder
+    - on the dummy backend, mipmap generation is a no-op
+    - mipmap generation is not yet supported on the D3D11 and WebGPU
+      backends, check sg_query_features().generate_mipmaps
+
+
+    COMPUTE SHADERS AND STORAGE BUFFERS
+    ===================================
+    Storage buffers are buffers which shaders can read and write, they are
+    created with the buffer type SG_BUFFERTYPE_STORAGEBUFFER:
+
+        sg_buffer sbuf = sg_make_buffer(&(sg_buffer_desc){
+            .type = SG_BUFFERTYPE_STORAGEBUFFER,
+            .usage = SG_USAGE_DYNAMIC,
+            .size = num_particles * sizeof(particle_t),
+        });
+
+    The storage buffers used by a shader stage are declared in
+    sg_shader_stage_desc.storage_buffers[] (the slots must be continuous),
+    and bound in sg_stage_bindings.storage_buffers[]. A storage buffer can
+    also be bound as vertex buffer, for instance to render the output of a
+    compute shader.
+
+    A compute shader is created by providing the shader code in
+    sg_shader_desc.cs instead of .vs and .fs, and used in a pipeline object
+    with .compute = true (compute pipelines don't need a vertex layout):
+
+        sg_shader shd = sg_make_shader(&(sg_shader_desc){
+            .cs = {
+                .source = cs_src,
+                .uniform_blocks[0].size = sizeof(params_t),
+                .storage_buffers[0].used = true,
+            },
+        });
+        sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+            .shader = shd,
+            .compute = true,
+        });
+
+    Compute shaders run inside compute passes, which are started with
+    sg_begin_compute_pass() and finished with sg_end_pass() like render
+    passes. Only compute pipelines can be applied in compute passes (and
+    only render pipelines in render passes), resources are bound in
+    sg_bindings.cs, and uniforms are applied to SG_SHADERSTAGE_CS:
+
+        sg_begin_compute_pass();
+        sg_apply_pipeline(pip);
+        sg_apply_bindings(&(sg_bindings){ .cs.storage_buffers[0] = sbuf });
+        sg_apply_uniforms(SG_SHADERSTAGE_CS, 0, &SG_RANGE(params));
+        sg_dispatch(num_particles / 64, 1, 1);
+        sg_end_pass();
+
+    Draw calls and recordings are not allowed in compute passes, and
+    sg_dispatch() is not allowed in render passes. Storage buffer writes
+    of a dispatch are visible to following dispatches and render passes
+    without additional synchronization.
+
+    Compute passes and storage buffers are only available when
+    sg_query_features().compute is true.
+
+    Backend specifics:
+
+    - GL requires GL 4.3 (or GL_ARB_compute_shader and
+      GL_ARB_shader_storage_buffer_object), GLES3 and macOS are not
+      supported. Storage buffers must be declared in GLSL with an explicit
+      binding point: the slot index for compute shaders, and
+      'stage * SG_MAX_SHADERSTAGE_STORAGEBUFFERS + slot' for the vertex-
+      and fragment-shader-stage, for instance:
+
+        layout(std430, binding=0) buffer particles { particle_t prt[]; };
+
+    - on the dummy backend, dispatches are validated and tracked in the
+      frame stats, but nothing is executed
+    - compute shaders are not yet supported on the Metal, D3D11 and WebGPU
+      backends
+
+
+    TRANSIENT RENDER TARGETS
+    ========================
+    Offscreen render targets of post-processing chains often only live for
+    a part of a frame, and need to be recreated when the window is resized
+    or effects are toggled. Instead of creating and destroying such images
+    and passes with sg_make_image() and sg_make_pass(), they can be acquired
+    from a pool of transient objects which are handed out for the current
+    frame and returned in sg_commit():
+
+        const sg_image img = sg_acquire_transient_image(&(sg_transient_image_desc){
+            .width = width / 2,
+            .height = height / 2,
+            .pixel_format = SG_PIXELFORMAT_RGBA16F,
+        });
+        const sg_pass pass = sg_acquire_transient_pass(&(sg_pass_desc){
+            .color_attachments[0].image = img,
+        });
+        sg_begin_pass(pass, &pass_action);
+        ...
+
+    sg_acquire_transient_image() returns an image that hasn't been acquired
+    in the current frame yet, with the same width, height, pixel format and
+    sample count (the pixel format and sample count default to the values in
+    sg_desc.context). A new render target image is only created if no such
+    image exists. Transient images are plain render target images with a
+    single mip level, they can be bound as textures like any other image.
+
+    If an image is no longer needed in the current frame (for instance
+    after it has been consumed by the next pass in a post-processing
+    chain), it can be handed back earlier so that a later acquisition in
+    the same frame reuses the image:
+
+        sg_release_transient_image(img);
+
+    sg_acquire_transient_pass() returns a pass object with identical
+    attachments if one exists (transient passes may be acquired many
+    times in a frame), otherwise a new pass object is created. Since the
+    same transient images are handed out in the same order each frame,
+    the transient passes which render into them are reused as well.
+
+    Transient images and passes which haven't been acquired for 16 frames
+    are destroyed in sg_commit(), and when a transient image is destroyed,
+    all transient passes which render into it are destroyed too. The max
+    number of transient images and passes is defined with
+    sg_desc.transient_pool_size (default: 32), when the pool is exhausted
+    the least recently used transient object which isn't in use is destroyed
+    to make room (a released transient image still counts as in use while
+    a transient pass which renders into it is in use). Don't call sg_destroy_image()
+    or sg_destroy_pass() on transient objects.
+
+    In the sg_frame_stats struct, acquisitions which reused an existing
+    object are counted in num_transient_hits, and acquisitions which
+    needed to create a new object in num_transient_misses.
+    sg_query_transient_stats() returns the number of transient objects,
+    and the estimated GPU memory size of all transient images and its
+    peak value since sg_setup():
+
+        const sg_transient_stats stats = sg_query_transient_stats();
+        printf("transient images: %d, %d KB (peak %d KB)\n",
+            stats.num_images,
+            (int)(stats.size / 1024),
+            (int)(stats.peak_size / 1024));
+
+
+    RESOURCE MEMORY ACCOUNTING
+    ==========================
+    sokol-gfx keeps track of the estimated GPU memory size of all buffers
+    and images in the VALID resource state. The size of a single resource
+    is returned in sg_buffer_info.memory_size and sg_image_info.memory_size,
+    and the sizes of all resources, grouped by resource type and usage, are
+    returned by sg_query_memory_stats():
+
+        const sg_memory_stats mem = sg_query_memory_stats();
+        printf("images: %d KB (render targets: %d KB), buffers: %d KB\n",
+            (int)(mem.images.total / 1024),
+            (int)(mem.images.render_target / 1024),
+            (int)(mem.buffers.total / 1024));
+
+    The sizes are computed from the creation parameters: the buffer size,
+    and for images the size of all mip levels, slices, cube faces and MSAA
+    samples. Dynamic and stream resources are counted once per internal
+    'renaming' slot (see sg_buffer_info.num_slots). The actual GPU memory
+    usage depends on alignment, padding and compression done by the
+    driver, so treat the sizes as a lower bound.
+
+    To enforce a memory budget, provide a threshold and a callback in
+    sg_desc.memory_budget:
+
+        static void budget_cb(const sg_memory_stats* stats, bool over_budget, void* user_data) {
+            if (over_budget) {
+                // free some resources, or drop the texture quality
+                ...
+            }
+        }
+
+        sg_setup(&(sg_desc){
+            .memory_budget = {
+                .size = 512 * 1024 * 1024,
+                .callback = budget_cb,
+            },
+            ...
+        });
+
+    The callback is called with over_budget == true when the total size
+    of all resources grows above the threshold, and with over_budget == false
+    when it drops back to or below the threshold. It is called at the end
+    of the function which created or destroyed the resource (for instance
+    sg_make_image() or sg_destroy_buffer()) when the resource has been
+    completely created or destroyed, so it's safe to create and destroy
+    resources in the callback. Transient images which are created or evicted
+    in sg_acquire_transient_image(), sg_acquire_transient_pass() and sg_commit()
+    are reported when the function has finished its bookkeeping. The callback
+    is never called from sg_shutdown().
+
+
     RESOURCE CREATION AND DESTRUCTION IN DETAIL
     ===========================================
     The 'vanilla' way to create resource objects is with the 'make functions':
@@ -1422,6 +2354,9 @@ extern "C" {
     sg_pipeline:    associated shader and vertex-layouts, and render states
     sg_pass:        a bundle of render targets and actions on them
     sg_context:     a 'context handle' for switching between 3D-API contexts
+    sg_recording:   a pre-validated sequence of rendering commands (see sg_begin_recording())
+    sg_encoder:     a command list which can be filled on a worker thread
+    sg_binding_set: pre-resolved resource bindings (see sg_make_binding_set())
 
     Instead of pointers, resource creation functions return a 32-bit
     number which uniquely identifies the resource object.
@@ -1442,6 +2377,9 @@ typedef struct sg_shader   { uint32_t id; } sg_shader;
 typedef struct sg_pipeline { uint32_t id; } sg_pipeline;
 typedef struct sg_pass     { uint32_t id; } sg_pass;
 typedef struct sg_context  { uint32_t id; } sg_context;
+typedef struct sg_recording { uint32_t id; } sg_recording;
+typedef struct sg_encoder  { uint32_t id; } sg_encoder;
+typedef struct sg_binding_set { uint32_t id; } sg_binding_set;
 
 /*
     sg_range is a pointer-size-pair struct used to pass memory blobs into
@@ -1479,10 +2417,12 @@ enum {
     SG_MAX_SHADERSTAGE_SAMPLERS = 8,
     SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS = 12,
     SG_MAX_SHADERSTAGE_UBS = 4,
+    SG_MAX_SHADERSTAGE_STORAGEBUFFERS = 8,
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_MAX_PASS_TIMINGS = 64,
 };
 
 /*
@@ -1652,6 +2592,13 @@ typedef struct sg_features {
     bool image_clamp_to_border;         // border color and clamp-to-border UV-wrap mode is supported
     bool mrt_independent_blend_state;   // multiple-render-target rendering can use per-render-target blend state
     bool mrt_independent_write_mask;    // multiple-render-target rendering can use per-render-target color write masks
+    bool multi_draw;                    // sg_draw_multi() maps to a native multi-draw call
+    bool draw_indirect;                 // sg_draw_indirect() maps to a native indirect multi-draw call
+    bool pass_timings;                  // GPU timings are supported (see sg_query_pass_timings())
+    bool image_upload;                  // sg_map_image_upload() is supported
+    bool image_read;                    // sg_read_image() and sg_read_image_async() are supported
+    bool generate_mipmaps;              // sg_generate_mipmaps() and sg_image_desc.generate_mipmaps are supported
+    bool compute;                       // compute passes and storage buffers are supported (see sg_begin_compute_pass())
 } sg_features;
 
 /*
@@ -1683,6 +2630,10 @@ typedef struct sg_limits {
     in the VALID state is attempted to be used for rendering, rendering
     operations will silently be dropped.
 
+    Shaders and pipelines may be in the PENDING state while the shader
+    is compiled in the background (see sg_desc.enable_async_shaders),
+    they go into the VALID or FAILED state in a later sg_commit().
+
     The special INVALID state is returned in sg_query_xxx_state() if no
     resource object exists for the provided resource id.
 */
@@ -1692,6 +2643,7 @@ typedef enum sg_resource_state {
     SG_RESOURCESTATE_VALID,
     SG_RESOURCESTATE_FAILED,
     SG_RESOURCESTATE_INVALID,
+    SG_RESOURCESTATE_PENDING,
     _SG_RESOURCESTATE_FORCE_U32 = 0x7FFFFFFF
 } sg_resource_state;
 
@@ -1712,6 +2664,10 @@ typedef enum sg_resource_state {
                             every frame")
     SG_USAGE_STREAM:        the resource will be updated each frame
                             with new content
+    SG_USAGE_STREAM_RING:   (buffers only) the buffer content will be
+                            written each frame through sg_map_buffer_range()
+                            or sg_append_buffer() (see the section
+                            STREAMING DATA WITH RING BUFFERS)
 
     The rendering backends use this hint to prevent that the
     CPU needs to wait for the GPU when attempting to update
@@ -1734,6 +2690,7 @@ typedef enum sg_usage {
     SG_USAGE_IMMUTABLE,
     SG_USAGE_DYNAMIC,
     SG_USAGE_STREAM,
+    SG_USAGE_STREAM_RING,
     _SG_USAGE_NUM,
     _SG_USAGE_FORCE_U32 = 0x7FFFFFFF
 } sg_usage;
@@ -1741,8 +2698,13 @@ typedef enum sg_usage {
 /*
     sg_buffer_type
 
-    This indicates whether a buffer contains vertex- or index-data,
-    used in the sg_buffer_desc.type member when creating a buffer.
+    This indicates whether a buffer contains vertex-, index-,
+    indirect-draw- or shader-storage-data, used in the sg_buffer_desc.type
+    member when creating a buffer.
+
+    Storage buffers can be read and written by shaders (see the section
+    COMPUTE SHADERS AND STORAGE BUFFERS), and may also be bound as
+    vertex buffers. They are only available if sg_features.compute is true.
 
     The default value is SG_BUFFERTYPE_VERTEXBUFFER.
 */
@@ -1750,6 +2712,8 @@ typedef enum sg_buffer_type {
     _SG_BUFFERTYPE_DEFAULT,         // value 0 reserved for default-init
     SG_BUFFERTYPE_VERTEXBUFFER,
     SG_BUFFERTYPE_INDEXBUFFER,
+    SG_BUFFERTYPE_INDIRECTBUFFER,
+    SG_BUFFERTYPE_STORAGEBUFFER,
     _SG_BUFFERTYPE_NUM,
     _SG_BUFFERTYPE_FORCE_U32 = 0x7FFFFFFF
 } sg_buffer_type;
@@ -1870,17 +2834,20 @@ typedef enum sg_cube_face {
 /*
     sg_shader_stage
 
-    There are 2 shader stages: vertex- and fragment-shader-stage.
+    There are 2 render shader stages: vertex- and fragment-shader-stage,
+    and the compute-shader-stage which is only used by compute shaders.
     Each shader stage consists of:
 
     - one slot for a shader function (provided as source- or byte-code)
     - SG_MAX_SHADERSTAGE_UBS slots for uniform blocks
     - SG_MAX_SHADERSTAGE_IMAGES slots for images used as textures by
       the shader function
+    - SG_MAX_SHADERSTAGE_STORAGEBUFFERS slots for storage buffers
 */
 typedef enum sg_shader_stage {
     SG_SHADERSTAGE_VS,
     SG_SHADERSTAGE_FS,
+    SG_SHADERSTAGE_CS,
     _SG_SHADERSTAGE_FORCE_U32 = 0x7FFFFFFF
 } sg_shader_stage;
 
@@ -2378,6 +3345,9 @@ typedef struct sg_pass_action {
     - 0..N vertex shader stage samplers
     - 0..N fragment shader stage images
     - 0..N fragment shader stage samplers
+    - 0..N storage buffers per shader stage
+    - compute shader stage images, samplers and storage buffers (only
+      in compute passes, where all other bindings must be empty)
 
     The max number of vertex buffer and shader stage images
     are defined by the SG_MAX_VERTEX_BUFFERS and
@@ -2389,6 +3359,7 @@ typedef struct sg_pass_action {
 typedef struct sg_stage_bindings {
     sg_image images[SG_MAX_SHADERSTAGE_IMAGES];
     sg_sampler samplers[SG_MAX_SHADERSTAGE_SAMPLERS];
+    sg_buffer storage_buffers[SG_MAX_SHADERSTAGE_STORAGEBUFFERS];
 } sg_stage_bindings;
 
 typedef struct sg_bindings {
@@ -2399,9 +3370,39 @@ typedef struct sg_bindings {
     int index_buffer_offset;
     sg_stage_bindings vs;
     sg_stage_bindings fs;
+    sg_stage_bindings cs;
     uint32_t _end_canary;
 } sg_bindings;
 
+/*
+    sg_draw_args
+
+    The draw parameters for one item in sg_draw_multi(), see
+    sg_draw() for the meaning of the struct members.
+*/
+typedef struct sg_draw_args {
+    int base_element;
+    int num_elements;
+    int num_instances;
+} sg_draw_args;
+
+/*
+    sg_draw_indirect_args
+
+    The draw parameters for one item in sg_draw_indirect(), an
+    SG_BUFFERTYPE_INDIRECTBUFFER contains a tightly packed array of
+    those. The memory layout is identical with GL's
+    DrawElementsIndirectCommand, the base_vertex and base_instance
+    members are reserved and must be zero.
+*/
+typedef struct sg_draw_indirect_args {
+    uint32_t num_elements;
+    uint32_t num_instances;
+    uint32_t base_element;
+    int32_t base_vertex;
+    uint32_t base_instance;
+} sg_draw_indirect_args;
+
 /*
     sg_buffer_desc
 
@@ -2470,6 +3471,72 @@ typedef struct sg_buffer_desc {
     uint32_t _end_canary;
 } sg_buffer_desc;
 
+/*
+    sg_mapped_range
+
+    The result of sg_map_buffer_range(), ptr and size describe the
+    writable memory range, and offset is the byte offset of the range
+    in the buffer (to be used in sg_bindings.vertex_buffer_offsets[]
+    or sg_bindings.index_buffer_offset).
+
+    If the buffer has run out of space, all members are zero.
+*/
+typedef struct sg_mapped_range {
+    void* ptr;
+    size_t size;
+    int offset;
+} sg_mapped_range;
+
+/*
+    sg_image_upload
+
+    The result of sg_unmap_image_upload(), pass this to
+    sg_query_image_upload_done() to check whether the GPU has
+    finished the upload. If the upload failed, the id is 0.
+*/
+typedef struct sg_image_upload {
+    uint32_t id;
+} sg_image_upload;
+
+/*
+    sg_read_desc, sg_read_result
+
+    Describes a read of pixel data with sg_read_image_async() and
+    sg_read_image(), see the section READING BACK IMAGE DATA.
+
+    A width or height of zero means up to the right or top edge
+    of the image, for the default framebuffer (.image is
+    SG_INVALID_ID) the width and height must be provided.
+
+    The sg_read_result struct is passed to the callback of
+    sg_read_image_async(). The pixel data in .data is only valid
+    until the callback returns. If the pixel data couldn't be read
+    back, .failed is true and .data is empty.
+*/
+typedef struct sg_read_result {
+    sg_image image;     // SG_INVALID_ID for the default framebuffer
+    int x;
+    int y;
+    int width;
+    int height;
+    sg_pixel_format pixel_format;
+    sg_range data;
+    void* user_data;
+    bool failed;
+} sg_read_result;
+
+typedef struct sg_read_desc {
+    uint32_t _start_canary;
+    sg_image image;
+    int x;
+    int y;
+    int width;
+    int height;
+    void (*callback)(const sg_read_result* result);
+    void* user_data;
+    uint32_t _end_canary;
+} sg_read_desc;
+
 /*
     sg_image_data
 
@@ -2494,6 +3561,7 @@ typedef struct sg_image_data {
     .height             0 (must be set to >0)
     .num_slices         1 (3D textures: depth; array textures: number of layers)
     .num_mipmaps:       1
+    .generate_mipmaps:  false (render targets only: generate mipmaps at the end of render passes)
     .usage:             SG_USAGE_IMMUTABLE
     .pixel_format:      SG_PIXELFORMAT_RGBA8 for textures, or sg_desc.context.color_format for render targets
     .sample_count:      1 for textures, or sg_desc.context.sample_count for render targets
@@ -2545,6 +3613,7 @@ typedef struct sg_image_desc {
     int height;
     int num_slices;
     int num_mipmaps;
+    bool generate_mipmaps;
     sg_usage usage;
     sg_pixel_format pixel_format;
     int sample_count;
@@ -2632,6 +3701,10 @@ typedef struct sg_sampler_desc {
             - the texture slot of the involved texture
             - the sampler slot of the involved sampler
             - for GLSL only: the name of the combined image-sampler object
+        - reflection info for each storage buffer used by the shader stage:
+            - whether the shader only reads from the storage buffer
+    - alternatively a compute shader stage (sg_shader_desc.cs), in this case
+      the vertex- and fragment-shader-stages must be empty
 
     For all GL backends, shader source-code must be provided. For D3D11 and Metal,
     either shader source-code or byte-code can be provided.
@@ -2657,6 +3730,7 @@ typedef struct sg_shader_uniform_desc {
 typedef struct sg_shader_uniform_block_desc {
     size_t size;
     sg_uniform_layout layout;
+    const char* glsl_name;
     sg_shader_uniform_desc uniforms[SG_MAX_UB_MEMBERS];
 } sg_shader_uniform_block_desc;
 
@@ -2679,6 +3753,10 @@ typedef struct sg_shader_image_sampler_pair_desc {
     const char* glsl_name;
 } sg_shader_image_sampler_pair_desc;
 
+typedef struct sg_shader_storage_buffer_desc {
+    bool used;
+} sg_shader_storage_buffer_desc;
+
 typedef struct sg_shader_stage_desc {
     const char* source;
     sg_range bytecode;
@@ -2688,6 +3766,7 @@ typedef struct sg_shader_stage_desc {
     sg_shader_image_desc images[SG_MAX_SHADERSTAGE_IMAGES];
     sg_shader_sampler_desc samplers[SG_MAX_SHADERSTAGE_SAMPLERS];
     sg_shader_image_sampler_pair_desc image_sampler_pairs[SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS];
+    sg_shader_storage_buffer_desc storage_buffers[SG_MAX_SHADERSTAGE_STORAGEBUFFERS];
 } sg_shader_stage_desc;
 
 typedef struct sg_shader_desc {
@@ -2695,6 +3774,7 @@ typedef struct sg_shader_desc {
     sg_shader_attr_desc attrs[SG_MAX_VERTEX_ATTRIBUTES];
     sg_shader_stage_desc vs;
     sg_shader_stage_desc fs;
+    sg_shader_stage_desc cs;
     const char* label;
     uint32_t _end_canary;
 } sg_shader_desc;
@@ -2711,6 +3791,9 @@ typedef struct sg_shader_desc {
     - the index type (none, 16- or 32-bit)
     - all the fixed-function-pipeline state (depth-, stencil-, blend-state, etc...)
 
+    Compute pipelines (.compute = true) only need a compute shader object,
+    the vertex layout and fixed-function state is ignored.
+
     If the vertex data has no gaps between vertex components, you can omit
     the .layout.buffers[].stride and layout.attrs[].offset items (leave them
     default-initialized to 0), sokol-gfx will then compute the offsets and
@@ -2766,6 +3849,7 @@ typedef struct sg_shader_desc {
     .sample_count:              sg_desc.context.sample_count
     .blend_color:               (sg_color) { 0.0f, 0.0f, 0.0f, 0.0f }
     .alpha_to_coverage_enabled: false
+    .compute:                   false
     .label  0       (optional string label for trace hooks)
 */
 typedef struct sg_vertex_buffer_layout_state {
@@ -2841,6 +3925,7 @@ typedef struct sg_pipeline_desc {
     int sample_count;
     sg_color blend_color;
     bool alpha_to_coverage_enabled;
+    bool compute;
     const char* label;
     uint32_t _end_canary;
 } sg_pipeline_desc;
@@ -2889,25 +3974,111 @@ typedef struct sg_pass_desc {
 } sg_pass_desc;
 
 /*
-    sg_trace_hooks
+    sg_transient_image_desc
 
-    Installable callback functions to keep track of the sokol-gfx calls,
-    this is useful for debugging, or keeping track of resource creation
-    and destruction.
+    Describes a transient render target image, used as argument to the
+    sg_acquire_transient_image() function (see the section
+    TRANSIENT RENDER TARGETS).
 
-    Trace hooks are installed with sg_install_trace_hooks(), this returns
-    another sg_trace_hooks struct with the previous set of
-    trace hook function pointers. These should be invoked by the
-    new trace hooks to form a proper call chain.
+    The default configuration is:
+
+    .width:         0 (must be set to value > 0)
+    .height:        0 (must be set to value > 0)
+    .pixel_format:  sg_desc.context.color_format
+    .sample_count:  sg_desc.context.sample_count
+    .label:         0 (only used when a new image is created)
 */
-typedef struct sg_trace_hooks {
-    void* user_data;
-    void (*reset_state_cache)(void* user_data);
-    void (*make_buffer)(const sg_buffer_desc* desc, sg_buffer result, void* user_data);
-    void (*make_image)(const sg_image_desc* desc, sg_image result, void* user_data);
-    void (*make_sampler)(const sg_sampler_desc* desc, sg_sampler result, void* user_data);
-    void (*make_shader)(const sg_shader_desc* desc, sg_shader result, void* user_data);
-    void (*make_pipeline)(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data);
+typedef struct sg_transient_image_desc {
+    int width;
+    int height;
+    sg_pixel_format pixel_format;
+    int sample_count;
+    const char* label;
+} sg_transient_image_desc;
+
+/*
+    sg_encoder_desc
+
+    Creation parameters for an sg_encoder object, used as argument to the
+    sg_make_encoder() function.
+
+    .size: the size in bytes of the encoder's command memory, this is
+        allocated once in sg_make_encoder() so that recording commands
+        on a worker thread never needs to allocate memory, the default
+        is 64 KBytes. Each command takes 32 bytes, plus the size of
+        the sg_bindings struct for sg_encoder_apply_bindings(), or the
+        uniform data size (rounded up to 16) for sg_encoder_apply_uniforms().
+*/
+typedef struct sg_encoder_desc {
+    uint32_t _start_canary;
+    int size;
+    const char* label;
+    uint32_t _end_canary;
+} sg_encoder_desc;
+
+/*
+    sg_binding_set_desc
+
+    Creation parameters for an sg_binding_set object, used as argument to
+    the sg_make_binding_set() function.
+
+    .bindings: the resource bindings, all resources must be alive and in
+        valid state when sg_make_binding_set() is called
+*/
+typedef struct sg_binding_set_desc {
+    uint32_t _start_canary;
+    sg_bindings bindings;
+    const char* label;
+    uint32_t _end_canary;
+} sg_binding_set_desc;
+
+/*
+    sg_queued_draw
+
+    The parameters of a draw call submitted with sg_queue_draw(). Queued
+    draws are executed in sg_end_pass(), sorted by key (see the section
+    SORTED DRAW QUEUE).
+
+    .sort_key: queued draws are executed in ascending key order, draws
+        with identical keys are executed in submission order
+    .pipeline: the pipeline object used by the draw call
+    .bindings: the resource bindings used by the draw call
+    .vs_uniforms, .fs_uniforms: optional uniform data for each uniform
+        block slot, the data is copied in sg_queue_draw()
+    .base_element, .num_elements, .num_instances: same as the sg_draw()
+        function arguments
+*/
+typedef struct sg_queued_draw {
+    uint64_t sort_key;
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    sg_range vs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    sg_range fs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    int base_element;
+    int num_elements;
+    int num_instances;
+} sg_queued_draw;
+
+/*
+    sg_trace_hooks
+
+    Installable callback functions to keep track of the sokol-gfx calls,
+    this is useful for debugging, or keeping track of resource creation
+    and destruction.
+
+    Trace hooks are installed with sg_install_trace_hooks(), this returns
+    another sg_trace_hooks struct with the previous set of
+    trace hook function pointers. These should be invoked by the
+    new trace hooks to form a proper call chain.
+*/
+typedef struct sg_trace_hooks {
+    void* user_data;
+    void (*reset_state_cache)(void* user_data);
+    void (*make_buffer)(const sg_buffer_desc* desc, sg_buffer result, void* user_data);
+    void (*make_image)(const sg_image_desc* desc, sg_image result, void* user_data);
+    void (*make_sampler)(const sg_sampler_desc* desc, sg_sampler result, void* user_data);
+    void (*make_shader)(const sg_shader_desc* desc, sg_shader result, void* user_data);
+    void (*make_pipeline)(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data);
     void (*make_pass)(const sg_pass_desc* desc, sg_pass result, void* user_data);
     void (*destroy_buffer)(sg_buffer buf, void* user_data);
     void (*destroy_image)(sg_image img, void* user_data);
@@ -2926,6 +4097,10 @@ typedef struct sg_trace_hooks {
     void (*apply_bindings)(const sg_bindings* bindings, void* user_data);
     void (*apply_uniforms)(sg_shader_stage stage, int ub_index, const sg_range* data, void* user_data);
     void (*draw)(int base_element, int num_elements, int num_instances, void* user_data);
+    void (*draw_multi)(const sg_draw_args* args, int count, void* user_data);
+    void (*draw_indirect)(sg_buffer buf, int offset, int count, void* user_data);
+    void (*begin_compute_pass)(void* user_data);
+    void (*dispatch)(int num_groups_x, int num_groups_y, int num_groups_z, void* user_data);
     void (*end_pass)(void* user_data);
     void (*commit)(void* user_data);
     void (*alloc_buffer)(sg_buffer result, void* user_data);
@@ -2999,6 +4174,7 @@ typedef struct sg_buffer_info {
     bool append_overflow;           // is buffer in overflow state (due to sg_append_buffer)
     int num_slots;                  // number of renaming-slots for dynamically updated buffers
     int active_slot;                // currently active write-slot for dynamically updated buffers
+    uint64_t memory_size;           // estimated GPU memory size in bytes (see RESOURCE MEMORY ACCOUNTING)
 } sg_buffer_info;
 
 typedef struct sg_image_info {
@@ -3006,6 +4182,7 @@ typedef struct sg_image_info {
     uint32_t upd_frame_index;       // frame index of last sg_update_image()
     int num_slots;                  // number of renaming-slots for dynamically updated images
     int active_slot;                // currently active write-slot for dynamically updated images
+    uint64_t memory_size;           // estimated GPU memory size in bytes (see RESOURCE MEMORY ACCOUNTING)
 } sg_image_info;
 
 typedef struct sg_sampler_info {
@@ -3043,6 +4220,9 @@ typedef struct sg_frame_stats_gl {
     uint32_t num_enable_vertex_attrib_array;
     uint32_t num_disable_vertex_attrib_array;
     uint32_t num_uniform;
+    uint32_t num_bind_uniform_buffer;
+    uint32_t num_upload_uniform_buffer;
+    uint32_t size_upload_uniform_buffer;
 } sg_frame_stats_gl;
 
 typedef struct sg_frame_stats_d3d11_pass {
@@ -3164,15 +4344,37 @@ typedef struct sg_frame_stats {
     uint32_t num_apply_pipeline;
     uint32_t num_apply_bindings;
     uint32_t num_apply_uniforms;
+    uint32_t num_skipped_apply_uniforms;
     uint32_t num_draw;
+    uint32_t num_draw_multi;
+    uint32_t num_draw_indirect;
     uint32_t num_update_buffer;
     uint32_t num_append_buffer;
     uint32_t num_update_image;
+    uint32_t num_map_buffer;
+    uint32_t num_image_upload;
+    uint32_t num_generate_mipmaps;
+    uint32_t num_dispatch;
+    uint32_t num_replay;
+    uint32_t num_replay_commands;
+    uint32_t num_submit_encoder;
+    uint32_t num_pipeline_cache_hits;
+    uint32_t num_pipeline_cache_misses;
+    uint32_t num_queue_draw;
+    uint32_t num_queue_saved_apply_pipeline;
+    uint32_t num_queue_saved_apply_bindings;
+    uint32_t num_shader_cache_hits;
+    uint32_t num_shader_cache_misses;
+    uint32_t num_apply_pending_pipeline;
+    uint32_t num_transient_hits;
+    uint32_t num_transient_misses;
 
     uint32_t size_apply_uniforms;
     uint32_t size_update_buffer;
     uint32_t size_append_buffer;
     uint32_t size_update_image;
+    uint32_t size_map_buffer;
+    uint32_t size_image_upload;
 
     sg_frame_stats_gl gl;
     sg_frame_stats_d3d11 d3d11;
@@ -3180,6 +4382,90 @@ typedef struct sg_frame_stats {
     sg_frame_stats_wgpu wgpu;
 } sg_frame_stats;
 
+/*
+    sg_pass_timings
+
+    GPU timings of the render passes and debug groups in a frame,
+    returned by sg_query_pass_timings() (see the section GPU TIMINGS).
+*/
+typedef enum sg_timing_type {
+    SG_TIMINGTYPE_PASS,
+    SG_TIMINGTYPE_DEBUG_GROUP,
+    _SG_TIMINGTYPE_FORCE_U32 = 0x7FFFFFFF
+} sg_timing_type;
+
+typedef struct sg_pass_timing {
+    sg_timing_type type;
+    sg_pass pass;           // the pass object (SG_INVALID_ID for the default pass and debug groups)
+    char name[32];          // debug group name (truncated), empty for passes
+    int depth;              // debug group nesting depth
+    uint64_t gpu_time_ns;   // GPU time in nanoseconds
+} sg_pass_timing;
+
+typedef struct sg_pass_timings {
+    uint32_t frame_index;   // frame the timings have been recorded in, 0 if no timings are available
+    int num_timings;
+    sg_pass_timing timings[SG_MAX_PASS_TIMINGS];
+} sg_pass_timings;
+
+/*
+    sg_pool_stats
+
+    The usage of the resource pools, returned by sg_query_pool_stats()
+    (see the section GROWABLE RESOURCE POOLS).
+*/
+typedef struct sg_pool_usage {
+    int size;               // current number of slots, including slots added by growing the pool
+    int num_used;           // number of currently allocated slots
+    int high_water_mark;    // max number of allocated slots since sg_setup()
+} sg_pool_usage;
+
+typedef struct sg_pool_stats {
+    sg_pool_usage buffers;
+    sg_pool_usage images;
+    sg_pool_usage samplers;
+    sg_pool_usage shaders;
+    sg_pool_usage pipelines;
+    sg_pool_usage passes;
+} sg_pool_stats;
+
+/*
+    sg_transient_stats
+
+    The usage of the transient render target pool, returned by
+    sg_query_transient_stats() (see the section TRANSIENT RENDER TARGETS).
+    Image sizes are estimated like in sg_image_info.memory_size.
+*/
+typedef struct sg_transient_stats {
+    int num_images;             // number of transient images in the pool
+    int num_images_in_use;      // number of transient images acquired in the current frame
+    int num_passes;             // number of transient passes in the pool
+    uint64_t size;              // estimated size of all transient images in bytes
+    uint64_t peak_size;         // max estimated size since sg_setup()
+} sg_transient_stats;
+
+/*
+    sg_memory_stats
+
+    The estimated GPU memory size of all buffers and images in bytes,
+    returned by sg_query_memory_stats() and passed to the memory budget
+    callback (see the section RESOURCE MEMORY ACCOUNTING).
+*/
+typedef struct sg_memory_usage {
+    uint64_t total;             // size of all resources of this type
+    uint64_t immutable;         // ...with SG_USAGE_IMMUTABLE (except render targets)
+    uint64_t dynamic;           // ...with SG_USAGE_DYNAMIC
+    uint64_t stream;            // ...with SG_USAGE_STREAM or SG_USAGE_STREAM_RING
+    uint64_t render_target;     // ...of render target images (always 0 for buffers)
+} sg_memory_usage;
+
+typedef struct sg_memory_stats {
+    sg_memory_usage buffers;
+    sg_memory_usage images;
+    uint64_t total;             // size of all buffers and images
+    uint64_t peak_total;        // max total size since sg_setup()
+} sg_memory_stats;
+
 /*
     sg_log_item
 
@@ -3194,6 +4480,7 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(GL_ARRAY_TEXTURES_NOT_SUPPORTED, "array textures not supported (gl)") \
     _SG_LOGITEM_XMACRO(GL_SHADER_COMPILATION_FAILED, "shader compilation failed (gl)") \
     _SG_LOGITEM_XMACRO(GL_SHADER_LINKING_FAILED, "shader linking failed (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNIFORMBUFFER_OVERFLOW, "uniform buffer overflow (gl: increase sg_desc.uniform_buffer_size)") \
     _SG_LOGITEM_XMACRO(GL_VERTEX_ATTRIBUTE_NOT_FOUND_IN_SHADER, "vertex attribute not found in shader (gl)") \
     _SG_LOGITEM_XMACRO(GL_TEXTURE_NAME_NOT_FOUND_IN_SHADER, "texture name not found in shader (gl)") \
     _SG_LOGITEM_XMACRO(GL_FRAMEBUFFER_STATUS_UNDEFINED, "framebuffer completeness check failed with GL_FRAMEBUFFER_UNDEFINED (gl)") \
@@ -3292,12 +4579,26 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(SHADER_POOL_EXHAUSTED, "shader pool exhausted") \
     _SG_LOGITEM_XMACRO(PIPELINE_POOL_EXHAUSTED, "pipeline pool exhausted") \
     _SG_LOGITEM_XMACRO(PASS_POOL_EXHAUSTED, "pass pool exhausted") \
+    _SG_LOGITEM_XMACRO(RECORDING_POOL_EXHAUSTED, "recording pool exhausted") \
+    _SG_LOGITEM_XMACRO(RECORDING_NOT_FINISHED, "sg_end_pass() called while recording, recording has been discarded") \
+    _SG_LOGITEM_XMACRO(ENCODER_POOL_EXHAUSTED, "encoder pool exhausted") \
+    _SG_LOGITEM_XMACRO(PASS_TIMINGS_OVERFLOW, "too many passes and debug groups in frame for GPU timings (SG_MAX_PASS_TIMINGS), remaining ones are not timed") \
+    _SG_LOGITEM_XMACRO(ENCODER_OVERFLOW, "sg_submit_encoder(): encoder has overflowed, commands have been dropped (increase sg_encoder_desc.size)") \
+    _SG_LOGITEM_XMACRO(BINDING_SET_POOL_EXHAUSTED, "binding set pool exhausted") \
+    _SG_LOGITEM_XMACRO(TRANSIENT_POOL_EXHAUSTED, "transient pool exhausted, all transient objects are in use (increase sg_desc.transient_pool_size)") \
+    _SG_LOGITEM_XMACRO(IMAGE_UPLOAD_TOO_BIG, "sg_map_image_upload(): image data doesn't fit into upload buffer (increase sg_desc.upload_buffer_size)") \
+    _SG_LOGITEM_XMACRO(IMAGE_READ_QUEUE_FULL, "sg_read_image_async(): too many pending reads") \
+    _SG_LOGITEM_XMACRO(IMAGE_READ_FAILED, "sg_read_image_async(): failed to map the read back pixel data") \
     _SG_LOGITEM_XMACRO(DRAW_WITHOUT_BINDINGS, "attempting to draw without resource bindings") \
+    _SG_LOGITEM_XMACRO(DRAW_IN_COMPUTE_PASS, "draw calls are not allowed in compute passes (draw call skipped)") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_CANARY, "sg_buffer_desc not initialized") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_SIZE, "sg_buffer_desc.size and .data.size cannot both be 0") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_DATA, "immutable buffers must be initialized with data (sg_buffer_desc.data.ptr and sg_buffer_desc.data.size)") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_DATA_SIZE, "immutable buffer data size differs from buffer size") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_NO_DATA, "dynamic/stream usage buffers cannot be initialized with data") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_RING_SIZE, "SG_USAGE_STREAM_RING buffers must be at least 4 * SG_NUM_INFLIGHT_FRAMES bytes big") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_RING_INJECTED, "SG_USAGE_STREAM_RING buffers cannot be injected") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_STORAGEBUFFER_FEATURE, "storage buffers not supported by backend (check sg_query_features().compute)") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDATA_NODATA, "sg_image_data: no data (.ptr and/or .size is zero)") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDATA_DATA_SIZE, "sg_image_data: data size doesn't match expected surface size") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_CANARY, "sg_image_desc not initialized") \
@@ -3311,10 +4612,15 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_MSAA_3D_IMAGE, "3D images cannot have a sample_count > 1") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_DEPTH_3D_IMAGE, "3D images cannot have a depth/stencil image format") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_RT_IMMUTABLE, "render target images must be SG_USAGE_IMMUTABLE") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_STREAM_RING, "SG_USAGE_STREAM_RING can only be used for buffers") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_RT_NO_DATA, "render target images cannot be initialized with data") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_INJECTED_NO_DATA, "images with injected textures cannot be initialized with data") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_DYNAMIC_NO_DATA, "dynamic/stream images cannot be initialized with data") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_COMPRESSED_IMMUTABLE, "compressed images must be immutable") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_GENMIPS_FEATURE, "sg_image_desc.generate_mipmaps: mipmap generation not supported by backend (check sg_query_features().generate_mipmaps)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_GENMIPS_NO_RT, "sg_image_desc.generate_mipmaps can only be used with render target images") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_GENMIPS_MSAA, "sg_image_desc.generate_mipmaps cannot be used with MSAA images (set it on the resolve image instead)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_GENMIPS_PIXELFORMAT, "sg_image_desc.generate_mipmaps requires a filterable and renderable color pixel format") \
     _SG_LOGITEM_XMACRO(VALIDATE_SAMPLERDESC_CANARY, "sg_sampler_desc not initialized") \
     _SG_LOGITEM_XMACRO(VALIDATE_SAMPLERDESC_MINFILTER_NONE, "sg_sampler_desc.min_filter cannot be SG_FILTER_NONE") \
     _SG_LOGITEM_XMACRO(VALIDATE_SAMPLERDESC_MAGFILTER_NONE, "sg_sampler_desc.mag_filter cannot be SG_FILTER_NONE") \
@@ -3331,6 +4637,7 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_SIZE_MISMATCH, "size of uniform block members doesn't match uniform block size") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_ARRAY_COUNT, "uniform array count must be >= 1") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_STD140_ARRAY_TYPE, "uniform arrays only allowed for FLOAT4, INT4, MAT4 in std140 layout") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_GLSL_NAME_STD140, "uniform blocks with a glsl_name must use SG_UNIFORMLAYOUT_STD140") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_NO_CONT_IMAGES, "shader stage images must occupy continuous slots (sg_shader_desc.vs|fs.images[])") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_NO_CONT_SAMPLERS, "shader stage samplers must occupy continuous slots (sg_shader_desc.vs|fs.samplers[])") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_IMAGE_SAMPLER_PAIR_IMAGE_SLOT_OUT_OF_RANGE, "shader stage: image-sampler-pair image slot index is out of range (sg_shader_desc.vs|fs.image_sampler_pairs[].image_slot)") \
@@ -3344,6 +4651,10 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_IMAGE_NOT_REFERENCED_BY_IMAGE_SAMPLER_PAIRS, "shader stage: one or more images are note referenced by  (sg_shader_desc.vs|fs.image_sampler_pairs[].image_slot)") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_SAMPLER_NOT_REFERENCED_BY_IMAGE_SAMPLER_PAIRS, "shader stage: one or more samplers are not referenced by image-sampler-pairs (sg_shader_desc.vs|fs.image_sampler_pairs[].sampler_slot)") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_NO_CONT_IMAGE_SAMPLER_PAIRS, "shader stage image-sampler-pairs must occupy continuous slots (sg_shader_desc.vs|fs.image_samplers[])") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_NO_CONT_STORAGEBUFFERS, "shader stage storage buffers must occupy continuous slots (sg_shader_desc.vs|fs|cs.storage_buffers[])") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_STORAGEBUFFER_FEATURE, "storage buffers not supported by backend (check sg_query_features().compute)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_COMPUTE_FEATURE, "compute shaders not supported by backend (check sg_query_features().compute)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_COMPUTE_STAGES, "compute shaders cannot have vertex or fragment shader stages (sg_shader_desc.vs and .fs must be empty)") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_ATTR_SEMANTICS, "D3D11 backend requires vertex attribute semantics") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG, "vertex attribute name/semantic string too long (max len 16)") \
     _SG_LOGITEM_XMACRO(VALIDATE_PIPELINEDESC_CANARY, "sg_pipeline_desc not initialized") \
@@ -3351,6 +4662,7 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(VALIDATE_PIPELINEDESC_NO_ATTRS, "sg_pipeline_desc.layout.attrs is empty or not continuous") \
     _SG_LOGITEM_XMACRO(VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4, "sg_pipeline_desc.layout.buffers[].stride must be multiple of 4") \
     _SG_LOGITEM_XMACRO(VALIDATE_PIPELINEDESC_ATTR_SEMANTICS, "D3D11 missing vertex attribute semantics in shader") \
+    _SG_LOGITEM_XMACRO(VALIDATE_PIPELINEDESC_COMPUTE, "sg_pipeline_desc.compute must be true for compute shaders and false for render shaders") \
     _SG_LOGITEM_XMACRO(VALIDATE_PASSDESC_CANARY, "sg_pass_desc not initialized") \
     _SG_LOGITEM_XMACRO(VALIDATE_PASSDESC_NO_ATTACHMENTS, "sg_pass_desc no color or depth-stencil attachments") \
     _SG_LOGITEM_XMACRO(VALIDATE_PASSDESC_NO_CONT_COLOR_ATTS, "color attachments must occupy continuous slots") \
@@ -3395,18 +4707,25 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(VALIDATE_APIP_COLOR_FORMAT, "sg_apply_pipeline: pipeline color attachment pixel format doesn't match pass color attachment pixel format") \
     _SG_LOGITEM_XMACRO(VALIDATE_APIP_DEPTH_FORMAT, "sg_apply_pipeline: pipeline depth pixel_format doesn't match pass depth attachment pixel format") \
     _SG_LOGITEM_XMACRO(VALIDATE_APIP_SAMPLE_COUNT, "sg_apply_pipeline: pipeline MSAA sample count doesn't match render pass attachment sample count") \
+    _SG_LOGITEM_XMACRO(VALIDATE_APIP_COMPUTE, "sg_apply_pipeline: compute pipelines can only be applied in compute passes, render pipelines only in render passes") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_PIPELINE, "sg_apply_bindings: must be called after sg_apply_pipeline") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_PIPELINE_EXISTS, "sg_apply_bindings: currently applied pipeline object no longer alive") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_PIPELINE_VALID, "sg_apply_bindings: currently applied pipeline object not in valid state") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_VBS, "sg_apply_bindings: number of vertex buffers doesn't match number of pipeline vertex layouts") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_VB_EXISTS, "sg_apply_bindings: vertex buffer no longer alive") \
-    _SG_LOGITEM_XMACRO(VALIDATE_ABND_VB_TYPE, "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_VB_TYPE, "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER or SG_BUFFERTYPE_STORAGEBUFFER") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_VB_OVERFLOW, "sg_apply_bindings: buffer in vertex buffer slot is overflown") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_NO_IB, "sg_apply_bindings: pipeline object defines indexed rendering, but no index buffer provided") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_IB, "sg_apply_bindings: pipeline object defines non-indexed rendering, but index buffer provided") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_IB_EXISTS, "sg_apply_bindings: index buffer no longer alive") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_IB_TYPE, "sg_apply_bindings: buffer in index buffer slot is not a SG_BUFFERTYPE_INDEXBUFFER") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_IB_OVERFLOW, "sg_apply_bindings: buffer in index buffer slot is overflown") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_EXPECTED_STORAGEBUFFER_BINDING, "sg_apply_bindings: storage buffer binding is missing or the buffer handle is invalid") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_UNEXPECTED_STORAGEBUFFER_BINDING, "sg_apply_bindings: unexpected storage buffer binding") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_STORAGEBUFFER_EXISTS, "sg_apply_bindings: storage buffer no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_STORAGEBUFFER_TYPE, "sg_apply_bindings: buffer in storage buffer slot is not a SG_BUFFERTYPE_STORAGEBUFFER") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_COMPUTE_BINDINGS, "sg_apply_bindings: only compute stage bindings (sg_bindings.cs) are allowed in compute passes") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABND_CS_IN_RENDER_PASS, "sg_apply_bindings: compute stage bindings (sg_bindings.cs) are only allowed in compute passes") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_VS_EXPECTED_IMAGE_BINDING, "sg_apply_bindings: image binding on vertex stage is missing or the image handle is invalid") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_VS_IMG_EXISTS, "sg_apply_bindings: image bound to vertex stage no longer alive") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_VS_IMAGE_TYPE_MISMATCH, "sg_apply_bindings: type of image bound to vertex stage doesn't match shader desc") \
@@ -3436,15 +4755,84 @@ typedef struct sg_frame_stats {
     _SG_LOGITEM_XMACRO(VALIDATE_AUB_NO_PIPELINE, "sg_apply_uniforms: must be called after sg_apply_pipeline()") \
     _SG_LOGITEM_XMACRO(VALIDATE_AUB_NO_UB_AT_SLOT, "sg_apply_uniforms: no uniform block declaration at this shader stage UB slot") \
     _SG_LOGITEM_XMACRO(VALIDATE_AUB_SIZE, "sg_apply_uniforms: data size doesn't match declared uniform block size") \
+    _SG_LOGITEM_XMACRO(VALIDATE_AUB_COMPUTE_STAGE, "sg_apply_uniforms: SG_SHADERSTAGE_CS must be used for compute pipelines, and only for compute pipelines") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DRAWINDIRECT_BUFFER_EXISTS, "sg_draw_indirect: indirect buffer no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DRAWINDIRECT_BUFFER_TYPE, "sg_draw_indirect: buffer is not a SG_BUFFERTYPE_INDIRECTBUFFER") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DRAWINDIRECT_OFFSET, "sg_draw_indirect: offset must be >= 0 and a multiple of 4") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DRAWINDIRECT_SIZE, "sg_draw_indirect: offset + count * sizeof(sg_draw_indirect_args) is bigger than buffer size") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DRAWINDIRECT_WHILE_RECORDING, "sg_draw_indirect: cannot be called while recording") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DRAWINDIRECT_RESERVED, "sg_draw_indirect: base_vertex and base_instance in sg_draw_indirect_args must be zero") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BEGINCOMPUTEPASS_FEATURE, "sg_begin_compute_pass: compute passes not supported by backend (check sg_query_features().compute)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DISPATCH_COMPUTE_PASS, "sg_dispatch: must be called inside a compute pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_DISPATCH_PIPELINE, "sg_dispatch: must be called after sg_apply_pipeline") \
     _SG_LOGITEM_XMACRO(VALIDATE_UPDATEBUF_USAGE, "sg_update_buffer: cannot update immutable buffer") \
     _SG_LOGITEM_XMACRO(VALIDATE_UPDATEBUF_SIZE, "sg_update_buffer: update size is bigger than buffer size") \
     _SG_LOGITEM_XMACRO(VALIDATE_UPDATEBUF_ONCE, "sg_update_buffer: only one update allowed per buffer and frame") \
     _SG_LOGITEM_XMACRO(VALIDATE_UPDATEBUF_APPEND, "sg_update_buffer: cannot call sg_update_buffer and sg_append_buffer in same frame") \
+    _SG_LOGITEM_XMACRO(VALIDATE_UPDATEBUF_RING, "sg_update_buffer: cannot update SG_USAGE_STREAM_RING buffers (use sg_append_buffer or sg_map_buffer_range)") \
     _SG_LOGITEM_XMACRO(VALIDATE_APPENDBUF_USAGE, "sg_append_buffer: cannot append to immutable buffer") \
     _SG_LOGITEM_XMACRO(VALIDATE_APPENDBUF_SIZE, "sg_append_buffer: overall appended size is bigger than buffer size") \
     _SG_LOGITEM_XMACRO(VALIDATE_APPENDBUF_UPDATE, "sg_append_buffer: cannot call sg_append_buffer and sg_update_buffer in same frame") \
+    _SG_LOGITEM_XMACRO(VALIDATE_APPENDBUF_MAPPED, "sg_append_buffer: cannot append to a buffer with a mapped range") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPBUF_USAGE, "sg_map_buffer_range: buffer must have SG_USAGE_STREAM_RING") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPBUF_MAPPED, "sg_map_buffer_range: buffer already has a mapped range (missing sg_unmap_buffer_range?)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_UNMAPBUF_NOT_MAPPED, "sg_unmap_buffer_range: buffer has no mapped range") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPIMG_FEATURE, "sg_map_image_upload: image uploads not supported by backend (check sg_query_features().image_upload)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPIMG_USAGE, "sg_map_image_upload: cannot upload to image with SG_USAGE_IMMUTABLE") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPIMG_COMPRESSED, "sg_map_image_upload: cannot upload to image with compressed pixel format") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPIMG_FACE, "sg_map_image_upload: face index out of range") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPIMG_MIPLEVEL, "sg_map_image_upload: mip level out of range") \
+    _SG_LOGITEM_XMACRO(VALIDATE_MAPIMG_MAPPED, "sg_map_image_upload: an image upload is already mapped (missing sg_unmap_image_upload?)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_UNMAPIMG_NOT_MAPPED, "sg_unmap_image_upload: image has no mapped upload") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_CANARY, "sg_read_desc not initialized") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_FEATURE, "sg_read_image: reading image data not supported by backend (check sg_query_features().image_read)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_IN_PASS, "sg_read_image: cannot read image data inside a pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_IMAGE, "sg_read_image: image is not valid") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_RENDERTARGET, "sg_read_image: image must be a render target") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_TYPE, "sg_read_image: image must be of type SG_IMAGETYPE_2D") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_MSAA, "sg_read_image: cannot read from MSAA image (read from the resolve image instead)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_DEPTH, "sg_read_image: cannot read from depth or depth-stencil image") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_DEFAULT_SIZE, "sg_read_image: sg_read_desc.width and .height must be > 0 when reading from the default framebuffer") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_RECT, "sg_read_image: read rectangle is outside the image") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_CALLBACK, "sg_read_image_async: sg_read_desc.callback must be set") \
+    _SG_LOGITEM_XMACRO(VALIDATE_READIMG_DATA_SIZE, "sg_read_image: data size is too small for the pixel data") \
+    _SG_LOGITEM_XMACRO(VALIDATE_GENMIPS_FEATURE, "sg_generate_mipmaps: mipmap generation not supported by backend (check sg_query_features().generate_mipmaps)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_GENMIPS_IN_PASS, "sg_generate_mipmaps: cannot generate mipmaps inside a pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_GENMIPS_USAGE, "sg_generate_mipmaps: image must be a render target or a dynamic or stream image") \
+    _SG_LOGITEM_XMACRO(VALIDATE_GENMIPS_MSAA, "sg_generate_mipmaps: cannot generate mipmaps for MSAA images") \
+    _SG_LOGITEM_XMACRO(VALIDATE_GENMIPS_PIXELFORMAT, "sg_generate_mipmaps: image must have a filterable and renderable color pixel format") \
     _SG_LOGITEM_XMACRO(VALIDATE_UPDIMG_USAGE, "sg_update_image: cannot update immutable image") \
     _SG_LOGITEM_XMACRO(VALIDATE_UPDIMG_ONCE, "sg_update_image: only one update allowed per image and frame") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ENCODERDESC_CANARY, "sg_encoder_desc not initialized") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ENCODERDESC_SIZE, "sg_encoder_desc.size must be > 0") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SUBMITENC_ENCODER, "sg_submit_encoder: encoder object no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BINDINGSETDESC_CANARY, "sg_binding_set_desc not initialized") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BINDINGSETDESC_BUFFER, "sg_binding_set_desc: buffer no longer alive or not in valid state") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BINDINGSETDESC_IMAGE, "sg_binding_set_desc: image no longer alive or not in valid state") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BINDINGSETDESC_SAMPLER, "sg_binding_set_desc: sampler no longer alive or not in valid state") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BINDINGSETDESC_COMPUTE, "sg_binding_set_desc: compute stage bindings (sg_bindings.cs) are not supported in binding sets") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABNDSET_EXISTS, "sg_apply_binding_set: binding set object no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABNDSET_VALID, "sg_apply_binding_set: binding set object not in valid state") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABNDSET_RESOURCE_EXISTS, "sg_apply_binding_set: resource used by binding set no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABNDSET_COMPUTE_PASS, "sg_apply_binding_set: binding sets cannot be applied in compute passes") \
+    _SG_LOGITEM_XMACRO(VALIDATE_QUEUEDRAW_PASS, "sg_queue_draw: must be called inside a valid render pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_QUEUEDRAW_RECORDING, "sg_queue_draw: cannot be called while recording") \
+    _SG_LOGITEM_XMACRO(VALIDATE_QUEUEDRAW_PIPELINE, "sg_queue_draw: pipeline object no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_QUEUEDRAW_UNIFORMS, "sg_queue_draw: uniform data range with size > 0 must have a valid pointer") \
+    _SG_LOGITEM_XMACRO(VALIDATE_QUEUEDRAW_COMPUTE_PASS, "sg_queue_draw: cannot be called in a compute pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BEGINREC_PASS, "sg_begin_recording: must be called inside a valid render pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BEGINREC_NESTED, "sg_begin_recording: recordings cannot be nested") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BEGINREC_COMPUTE_PASS, "sg_begin_recording: cannot record in a compute pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ENDREC_NOT_RECORDING, "sg_end_recording: no recording in progress (missing sg_begin_recording?)") \
+    _SG_LOGITEM_XMACRO(VALIDATE_REPLAY_RECORDING_EXISTS, "sg_replay: recording object no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_REPLAY_RECORDING_VALID, "sg_replay: recording object not in valid state") \
+    _SG_LOGITEM_XMACRO(VALIDATE_REPLAY_WHILE_RECORDING, "sg_replay: cannot be called while recording") \
+    _SG_LOGITEM_XMACRO(VALIDATE_REPLAY_COMPUTE_PASS, "sg_replay: cannot replay a recording in a compute pass") \
+    _SG_LOGITEM_XMACRO(VALIDATE_REPLAY_PASS_ATTRS, "sg_replay: current pass attachment formats or sample count don't match pass at recording time") \
+    _SG_LOGITEM_XMACRO(VALIDATE_REPLAY_RESOURCE_EXISTS, "sg_replay: resource used by recording no longer alive") \
+    _SG_LOGITEM_XMACRO(VALIDATE_TRANSIENT_IMAGE_SIZE, "sg_acquire_transient_image: width and height must be > 0") \
+    _SG_LOGITEM_XMACRO(VALIDATE_TRANSIENT_IMAGE_RENDERABLE, "sg_acquire_transient_image: pixel format must be renderable") \
+    _SG_LOGITEM_XMACRO(VALIDATE_TRANSIENT_IMAGE_RELEASE, "sg_release_transient_image: image is not a transient image acquired in the current frame") \
     _SG_LOGITEM_XMACRO(VALIDATION_FAILED, "validation layer checks failed") \
 
 #define _SG_LOGITEM_XMACRO(item,msg) SG_LOGITEM_##item,
@@ -3475,13 +4863,31 @@ typedef enum sg_log_item {
     .pipeline_pool_size     64
     .pass_pool_size         16
     .context_pool_size      16
+    .recording_pool_size    16
+    .encoder_pool_size      16
+    .binding_set_pool_size  128
+    .transient_pool_size    32
     .uniform_buffer_size    4 MB (4*1024*1024)
+    .upload_buffer_size     8 MB (8*1024*1024)
     .max_commit_listeners   1024
     .disable_validation     false
+    .disable_uniform_cache  false
+    .enable_pipeline_cache  false
+    .enable_pass_timings    false
+    .enable_async_shaders   false
+    .enable_growable_pools  false
     .mtl_force_managed_storage_mode false
     .wgpu_disable_bindgroups_cache  false
     .wgpu_bindgroups_cache_size     1024
 
+    .shader_cache.load_fn   0 (no shader program cache)
+    .shader_cache.store_fn  0
+    .shader_cache.user_data 0
+
+    .memory_budget.size         0 (no memory budget callback)
+    .memory_budget.callback     0
+    .memory_budget.user_data    0
+
     .allocator.alloc_fn     0 (in this case, malloc() will be called)
     .allocator.free_fn      0 (in this case, free() will be called)
     .allocator.user_data    0
@@ -3643,6 +5049,37 @@ typedef struct sg_commit_listener {
     void* user_data;
 } sg_commit_listener;
 
+/*
+    sg_shader_binary, sg_shader_cache_desc
+
+    Used in sg_desc to provide callbacks which load and store compiled
+    shader programs (see the section SHADER PROGRAM CACHE).
+*/
+typedef struct sg_shader_binary {
+    uint32_t format;    // backend-specific binary format
+    sg_range data;
+} sg_shader_binary;
+
+typedef struct sg_shader_cache_desc {
+    sg_shader_binary (*load_fn)(uint64_t key, void* user_data);
+    void (*store_fn)(uint64_t key, const sg_shader_binary* binary, void* user_data);
+    void* user_data;
+} sg_shader_cache_desc;
+
+/*
+    sg_memory_budget_desc
+
+    Used in sg_desc to provide a callback which is called when the
+    estimated GPU memory size of all buffers and images crosses a
+    threshold (see the section RESOURCE MEMORY ACCOUNTING). The callback
+    is disabled when size or callback is zero.
+*/
+typedef struct sg_memory_budget_desc {
+    uint64_t size;      // threshold in bytes
+    void (*callback)(const sg_memory_stats* stats, bool over_budget, void* user_data);
+    void* user_data;
+} sg_memory_budget_desc;
+
 /*
     sg_allocator
 
@@ -3688,12 +5125,24 @@ typedef struct sg_desc {
     int pipeline_pool_size;
     int pass_pool_size;
     int context_pool_size;
+    int recording_pool_size;
+    int encoder_pool_size;
+    int binding_set_pool_size;
+    int transient_pool_size;    // max number of transient images and passes (see TRANSIENT RENDER TARGETS)
     int uniform_buffer_size;
+    int upload_buffer_size;     // size of the ring-buffer for sg_map_image_upload(), allocated on first use
     int max_commit_listeners;
     bool disable_validation;    // disable validation layer even in debug mode, useful for tests
+    bool disable_uniform_cache; // don't skip sg_apply_uniforms() calls with unchanged uniform data
+    bool enable_pipeline_cache; // return existing pipelines for identical sg_pipeline_desc structs
+    bool enable_pass_timings;   // measure GPU time of passes and debug groups (see sg_query_pass_timings())
+    bool enable_async_shaders;  // don't wait for the shader compiler in sg_make_shader() (see ASYNCHRONOUS SHADER CREATION)
+    bool enable_growable_pools; // grow exhausted resource pools instead of failing (see GROWABLE RESOURCE POOLS)
     bool mtl_force_managed_storage_mode; // for debugging: use Metal managed storage mode for resources even with UMA
     bool wgpu_disable_bindgroups_cache;  // set to true to disable the WebGPU backend BindGroup cache
     int wgpu_bindgroups_cache_size;      // number of slots in the WebGPU bindgroup cache (must be 2^N)
+    sg_shader_cache_desc shader_cache;   // optional callbacks to load and store compiled shader programs
+    sg_memory_budget_desc memory_budget; // optional callback when resource memory crosses a threshold
     sg_allocator allocator;
     sg_logger logger; // optional log function override
     sg_context_desc context;
@@ -3727,6 +5176,14 @@ SOKOL_GFX_API_DECL void sg_destroy_pass(sg_pass pass);
 SOKOL_GFX_API_DECL void sg_update_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_update_image(sg_image img, const sg_image_data* data);
 SOKOL_GFX_API_DECL int sg_append_buffer(sg_buffer buf, const sg_range* data);
+SOKOL_GFX_API_DECL sg_mapped_range sg_map_buffer_range(sg_buffer buf, size_t size);
+SOKOL_GFX_API_DECL void sg_unmap_buffer_range(sg_buffer buf);
+SOKOL_GFX_API_DECL sg_mapped_range sg_map_image_upload(sg_image img, int face, int mip_level);
+SOKOL_GFX_API_DECL sg_image_upload sg_unmap_image_upload(sg_image img);
+SOKOL_GFX_API_DECL bool sg_query_image_upload_done(sg_image_upload upload);
+SOKOL_GFX_API_DECL bool sg_read_image_async(const sg_read_desc* desc);
+SOKOL_GFX_API_DECL bool sg_read_image(const sg_read_desc* desc, const sg_range* data);
+SOKOL_GFX_API_DECL void sg_generate_mipmaps(sg_image img);
 SOKOL_GFX_API_DECL bool sg_query_buffer_overflow(sg_buffer buf);
 SOKOL_GFX_API_DECL bool sg_query_buffer_will_overflow(sg_buffer buf, size_t size);
 
@@ -3742,9 +5199,43 @@ SOKOL_GFX_API_DECL void sg_apply_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_apply_bindings(const sg_bindings* bindings);
 SOKOL_GFX_API_DECL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_draw(int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_draw_multi(const sg_draw_args* args, int count);
+SOKOL_GFX_API_DECL void sg_draw_indirect(sg_buffer buf, int offset, int count);
+SOKOL_GFX_API_DECL void sg_begin_compute_pass(void);
+SOKOL_GFX_API_DECL void sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z);
 SOKOL_GFX_API_DECL void sg_end_pass(void);
 SOKOL_GFX_API_DECL void sg_commit(void);
 
+// recording and replaying rendering commands
+SOKOL_GFX_API_DECL void sg_begin_recording(void);
+SOKOL_GFX_API_DECL sg_recording sg_end_recording(void);
+SOKOL_GFX_API_DECL void sg_replay(sg_recording rec);
+SOKOL_GFX_API_DECL void sg_destroy_recording(sg_recording rec);
+SOKOL_GFX_API_DECL sg_resource_state sg_query_recording_state(sg_recording rec);
+
+// multithreaded command encoding (encoders are filled on worker threads, and submitted on the main thread)
+SOKOL_GFX_API_DECL sg_encoder sg_make_encoder(const sg_encoder_desc* desc);
+SOKOL_GFX_API_DECL void sg_destroy_encoder(sg_encoder enc);
+SOKOL_GFX_API_DECL void sg_encoder_apply_viewport(sg_encoder enc, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_GFX_API_DECL void sg_encoder_apply_scissor_rect(sg_encoder enc, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_GFX_API_DECL void sg_encoder_apply_pipeline(sg_encoder enc, sg_pipeline pip);
+SOKOL_GFX_API_DECL void sg_encoder_apply_bindings(sg_encoder enc, const sg_bindings* bindings);
+SOKOL_GFX_API_DECL void sg_encoder_apply_uniforms(sg_encoder enc, sg_shader_stage stage, int ub_index, const sg_range* data);
+SOKOL_GFX_API_DECL void sg_encoder_draw(sg_encoder enc, int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_encoder_rewind(sg_encoder enc);
+SOKOL_GFX_API_DECL bool sg_query_encoder_overflow(sg_encoder enc);
+SOKOL_GFX_API_DECL sg_resource_state sg_query_encoder_state(sg_encoder enc);
+SOKOL_GFX_API_DECL void sg_submit_encoder(sg_encoder enc);
+
+// pre-resolved resource bindings
+SOKOL_GFX_API_DECL sg_binding_set sg_make_binding_set(const sg_binding_set_desc* desc);
+SOKOL_GFX_API_DECL void sg_destroy_binding_set(sg_binding_set bset);
+SOKOL_GFX_API_DECL void sg_apply_binding_set(sg_binding_set bset);
+SOKOL_GFX_API_DECL sg_resource_state sg_query_binding_set_state(sg_binding_set bset);
+
+// sort-key ordered draw calls, executed in sg_end_pass()
+SOKOL_GFX_API_DECL void sg_queue_draw(const sg_queued_draw* draw);
+
 // getting information
 SOKOL_GFX_API_DECL sg_desc sg_query_desc(void);
 SOKOL_GFX_API_DECL sg_backend sg_query_backend(void);
@@ -3818,6 +5309,21 @@ SOKOL_GFX_API_DECL void sg_disable_frame_stats(void);
 SOKOL_GFX_API_DECL bool sg_frame_stats_enabled(void);
 SOKOL_GFX_API_DECL sg_frame_stats sg_query_frame_stats(void);
 
+// GPU timings of passes and debug groups
+SOKOL_GFX_API_DECL sg_pass_timings sg_query_pass_timings(void);
+
+// resource pool usage
+SOKOL_GFX_API_DECL sg_pool_stats sg_query_pool_stats(void);
+
+// estimated GPU memory size of buffers and images
+SOKOL_GFX_API_DECL sg_memory_stats sg_query_memory_stats(void);
+
+// transient render targets
+SOKOL_GFX_API_DECL sg_image sg_acquire_transient_image(const sg_transient_image_desc* desc);
+SOKOL_GFX_API_DECL sg_pass sg_acquire_transient_pass(const sg_pass_desc* desc);
+SOKOL_GFX_API_DECL void sg_release_transient_image(sg_image img);
+SOKOL_GFX_API_DECL sg_transient_stats sg_query_transient_stats(void);
+
 // rendering contexts (optional)
 SOKOL_GFX_API_DECL sg_context sg_setup_context(void);
 SOKOL_GFX_API_DECL void sg_activate_context(sg_context ctx_id);
@@ -4028,6 +5534,13 @@ inline void sg_begin_pass(sg_pass pass, const sg_pass_action& pass_action) { ret
 inline void sg_apply_bindings(const sg_bindings& bindings) { return sg_apply_bindings(&bindings); }
 inline void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range& data) { return sg_apply_uniforms(stage, ub_index, &data); }
 
+inline sg_encoder sg_make_encoder(const sg_encoder_desc& desc) { return sg_make_encoder(&desc); }
+inline void sg_encoder_apply_bindings(sg_encoder enc, const sg_bindings& bindings) { return sg_encoder_apply_bindings(enc, &bindings); }
+inline void sg_encoder_apply_uniforms(sg_encoder enc, sg_shader_stage stage, int ub_index, const sg_range& data) { return sg_encoder_apply_uniforms(enc, stage, ub_index, &data); }
+
+inline sg_binding_set sg_make_binding_set(const sg_binding_set_desc& desc) { return sg_make_binding_set(&desc); }
+inline void sg_queue_draw(const sg_queued_draw& draw) { return sg_queue_draw(&draw); }
+
 inline sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc& desc) { return sg_query_buffer_defaults(&desc); }
 inline sg_image_desc sg_query_image_defaults(const sg_image_desc& desc) { return sg_query_image_defaults(&desc); }
 inline sg_sampler_desc sg_query_sampler_defaults(const sg_sampler_desc& desc) { return sg_query_sampler_defaults(&desc); }
@@ -4246,6 +5759,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         typedef int64_t  GLint64;
         typedef float  GLfloat;
         typedef int  GLint;
+        typedef struct __GLsync* GLsync;
         #define GL_INT_2_10_10_10_REV 0x8D9F
         #define GL_R32F 0x822E
         #define GL_PROGRAM_POINT_SIZE 0x8642
@@ -4448,6 +5962,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_CURRENT_PROGRAM 0x8B8D
         #define GL_MAX_VERTEX_UNIFORM_VECTORS 0x8DFB
         #define GL_UNPACK_ALIGNMENT 0x0CF5
+        #define GL_PACK_ALIGNMENT 0x0D05
         #define GL_FRAMEBUFFER_SRGB 0x8DB9
         #define GL_TEXTURE_COMPARE_MODE 0x884C
         #define GL_TEXTURE_COMPARE_FUNC 0x884D
@@ -4545,6 +6060,96 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #ifndef GL_LUMINANCE
     #define GL_LUMINANCE 0x1909
     #endif
+    #ifndef GL_DRAW_INDIRECT_BUFFER
+    #define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+    #endif
+    #ifndef GL_UNIFORM_BUFFER
+    #define GL_UNIFORM_BUFFER 0x8A11
+    #endif
+    #ifndef GL_SHADER_STORAGE_BUFFER
+    #define GL_SHADER_STORAGE_BUFFER 0x90D2
+    #endif
+    #ifndef GL_COMPUTE_SHADER
+    #define GL_COMPUTE_SHADER 0x91B9
+    #endif
+    #ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+    #define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+    #endif
+    #ifndef GL_BUFFER_UPDATE_BARRIER_BIT
+    #define GL_BUFFER_UPDATE_BARRIER_BIT 0x00000200
+    #endif
+    #ifndef GL_SHADER_STORAGE_BARRIER_BIT
+    #define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+    #endif
+    #ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    #define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+    #endif
+    #ifndef GL_INVALID_INDEX
+    #define GL_INVALID_INDEX 0xFFFFFFFFu
+    #endif
+    #ifndef GL_TIMESTAMP
+    #define GL_TIMESTAMP 0x8E28
+    #endif
+    #ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+    #endif
+    #ifndef GL_PROGRAM_BINARY_LENGTH
+    #define GL_PROGRAM_BINARY_LENGTH 0x8741
+    #endif
+    #ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+    #endif
+    #ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+    #endif
+    #ifndef GL_QUERY_RESULT
+    #define GL_QUERY_RESULT 0x8866
+    #endif
+    #ifndef GL_QUERY_RESULT_AVAILABLE
+    #define GL_QUERY_RESULT_AVAILABLE 0x8867
+    #endif
+    #ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+    #endif
+    #ifndef GL_MAP_INVALIDATE_RANGE_BIT
+    #define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+    #endif
+    #ifndef GL_MAP_UNSYNCHRONIZED_BIT
+    #define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+    #endif
+    #ifndef GL_PIXEL_UNPACK_BUFFER
+    #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+    #endif
+    #ifndef GL_PIXEL_PACK_BUFFER
+    #define GL_PIXEL_PACK_BUFFER 0x88EB
+    #endif
+    #ifndef GL_MAP_READ_BIT
+    #define GL_MAP_READ_BIT 0x0001
+    #endif
+    #ifndef GL_STREAM_READ
+    #define GL_STREAM_READ 0x88E1
+    #endif
+    #ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED 0x911A
+    #endif
+    #ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED 0x911C
+    #endif
+    #ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+    #endif
+    #ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+    #endif
+    #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #endif
+    #ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #endif
+    #ifndef GL_TIMEOUT_EXPIRED
+    #define GL_TIMEOUT_EXPIRED 0x911B
+    #endif
     #ifndef _SG_GL_CHECK_ERROR
     #define _SG_GL_CHECK_ERROR() { SOKOL_ASSERT(glGetError() == GL_NO_ERROR); }
     #endif
@@ -4570,12 +6175,20 @@ typedef struct {
     int queue_top;
     uint32_t* gen_ctrs;
     int* free_queue;
+    int high_water_mark;    // max number of allocated slots
+    // growable pools: items past base_size live in separately allocated chunks of chunk_size items
+    int base_size;
+    int chunk_size;         // 0 if the pool can't grow
+    int num_chunks;
+    void** chunks;
 } _sg_pool_t;
 
 _SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num);
 _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool);
 _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool);
 _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index);
+_SOKOL_PRIVATE bool _sg_pool_grow(_sg_pool_t* pool, size_t item_size);
+_SOKOL_PRIVATE void* _sg_pool_item(const _sg_pool_t* pool, void* items, size_t item_size, int slot_index);
 _SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot);
 _SOKOL_PRIVATE uint32_t _sg_slot_alloc(_sg_pool_t* pool, _sg_slot_t* slot, int slot_index);
 _SOKOL_PRIVATE int _sg_slot_index(uint32_t id);
@@ -4593,9 +6206,22 @@ enum {
     _SG_DEFAULT_PIPELINE_POOL_SIZE = 64,
     _SG_DEFAULT_PASS_POOL_SIZE = 16,
     _SG_DEFAULT_CONTEXT_POOL_SIZE = 16,
+    _SG_DEFAULT_RECORDING_POOL_SIZE = 16,
+    _SG_DEFAULT_ENCODER_POOL_SIZE = 16,
+    _SG_DEFAULT_BINDING_SET_POOL_SIZE = 128,
+    _SG_DEFAULT_TRANSIENT_POOL_SIZE = 32,
+    _SG_TRANSIENT_MAX_IDLE_FRAMES = 16,     // transient objects not acquired for this many frames are destroyed
+    _SG_DEFAULT_ENCODER_SIZE = 64 * 1024,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
+    _SG_DEFAULT_UPLOAD_BUFFER_SIZE = 8 * 1024 * 1024,
+    _SG_MAX_PENDING_UPLOADS = 64,   // max number of image uploads not yet finished by the GPU
+    _SG_MAX_PENDING_READS = 16,     // max number of sg_read_image_async() calls waiting for the GPU
     _SG_DEFAULT_MAX_COMMIT_LISTENERS = 1024,
     _SG_DEFAULT_WGPU_BINDGROUP_CACHE_SIZE = 1024,
+    _SG_GL_MAX_MULTI_DRAW = 64,     // max draws per glMultiDraw*() call
+    _SG_DUMMY_SHADER_BINARY_FORMAT = 0x594D5544,   // 'DUMY'
+    _SG_NUM_TIMING_FRAMES = 4,      // number of frames in flight for GPU timestamp queries
+    _SG_MAX_TIMESTAMP_QUERIES = _SG_NUM_TIMING_FRAMES * 2 * SG_MAX_PASS_TIMINGS,
 };
 
 // fixed-size string
@@ -4627,18 +6253,53 @@ typedef struct {
     int active_slot;
     sg_buffer_type type;
     sg_usage usage;
+    uint8_t* indirect_data;     // CPU-side copy of indirect buffer content
+    uint8_t* ring_data;         // CPU-side staging memory for ring buffers which can't be mapped
+    uint32_t map_frame_index;
+    bool mapped;
+    int map_offset;
+    int map_size;
 } _sg_buffer_common_t;
 
+// size of the per-frame region in SG_USAGE_STREAM_RING buffers
+_SOKOL_PRIVATE int _sg_ring_region_size(int size) {
+    return (size / SG_NUM_INFLIGHT_FRAMES) & ~3;
+}
+
 _SOKOL_PRIVATE void _sg_buffer_common_init(_sg_buffer_common_t* cmn, const sg_buffer_desc* desc) {
     cmn->size = (int)desc->size;
     cmn->append_pos = 0;
     cmn->append_overflow = false;
     cmn->update_frame_index = 0;
     cmn->append_frame_index = 0;
-    cmn->num_slots = (desc->usage == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
+    // ring buffers use one frame region per inflight frame instead of rotating buffers
+    cmn->num_slots = ((desc->usage == SG_USAGE_IMMUTABLE) || (desc->usage == SG_USAGE_STREAM_RING)) ? 1 : SG_NUM_INFLIGHT_FRAMES;
     cmn->active_slot = 0;
     cmn->type = desc->type;
     cmn->usage = desc->usage;
+    cmn->indirect_data = 0;
+    cmn->ring_data = 0;
+    cmn->map_frame_index = 0;
+    cmn->mapped = false;
+    cmn->map_offset = 0;
+    cmn->map_size = 0;
+    if (desc->type == SG_BUFFERTYPE_INDIRECTBUFFER) {
+        cmn->indirect_data = (uint8_t*) _sg_malloc_clear((size_t)cmn->size);
+        if (desc->data.ptr) {
+            memcpy(cmn->indirect_data, desc->data.ptr, desc->data.size);
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_buffer_common_discard(_sg_buffer_common_t* cmn) {
+    if (cmn->indirect_data) {
+        _sg_free(cmn->indirect_data);
+        cmn->indirect_data = 0;
+    }
+    if (cmn->ring_data) {
+        _sg_free(cmn->ring_data);
+        cmn->ring_data = 0;
+    }
 }
 
 typedef struct {
@@ -4651,6 +6312,7 @@ typedef struct {
     int height;
     int num_slices;
     int num_mipmaps;
+    bool generate_mipmaps;  // generate mipmaps at the end of render passes
     sg_usage usage;
     sg_pixel_format pixel_format;
     int sample_count;
@@ -4666,6 +6328,7 @@ _SOKOL_PRIVATE void _sg_image_common_init(_sg_image_common_t* cmn, const sg_imag
     cmn->height = desc->height;
     cmn->num_slices = desc->num_slices;
     cmn->num_mipmaps = desc->num_mipmaps;
+    cmn->generate_mipmaps = desc->generate_mipmaps;
     cmn->usage = desc->usage;
     cmn->pixel_format = desc->pixel_format;
     cmn->sample_count = desc->sample_count;
@@ -4724,16 +6387,29 @@ typedef struct {
     int num_images;
     int num_samplers;
     int num_image_samplers;
+    int num_storage_buffers;
     _sg_shader_uniform_block_t uniform_blocks[SG_MAX_SHADERSTAGE_UBS];
     _sg_shader_image_t images[SG_MAX_SHADERSTAGE_IMAGES];
     _sg_shader_sampler_t samplers[SG_MAX_SHADERSTAGE_SAMPLERS];
     _sg_shader_image_sampler_t image_samplers[SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS];
 } _sg_shader_stage_t;
 
+// NOTE: compute shaders occupy the vertex stage slot
 typedef struct {
+    bool is_compute;
     _sg_shader_stage_t stage[SG_NUM_SHADER_STAGES];
 } _sg_shader_common_t;
 
+// a shader desc describes a compute shader if the compute stage has code
+_SOKOL_PRIVATE bool _sg_shader_desc_is_compute(const sg_shader_desc* desc) {
+    return (0 != desc->cs.source) || (0 != desc->cs.bytecode.ptr);
+}
+
+// maps SG_SHADERSTAGE_CS to the vertex stage slot used internally by compute shaders
+_SOKOL_PRIVATE sg_shader_stage _sg_shader_stage_slot(sg_shader_stage stage) {
+    return (stage == SG_SHADERSTAGE_CS) ? SG_SHADERSTAGE_VS : stage;
+}
+
 _SOKOL_PRIVATE void _sg_shader_common_init(_sg_shader_common_t* cmn, const sg_shader_desc* desc) {
     for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
         const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS) ? &desc->vs : &desc->fs;
@@ -4779,25 +6455,37 @@ _SOKOL_PRIVATE void _sg_shader_common_init(_sg_shader_common_t* cmn, const sg_sh
             stage->image_samplers[img_smp_index].sampler_slot = img_smp_desc->sampler_slot;
             stage->num_image_samplers++;
         }
+        SOKOL_ASSERT(stage->num_storage_buffers == 0);
+        for (int sbuf_index = 0; sbuf_index < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; sbuf_index++) {
+            if (!stage_desc->storage_buffers[sbuf_index].used) {
+                break;
+            }
+            stage->num_storage_buffers++;
+        }
     }
 }
 
+// NOTE: the fields checked in sg_apply_pipeline/bindings() and sg_draw() come
+// first, the creation-time state which is only needed for validation and
+// debug inspection is kept at the end
 typedef struct {
-    bool vertex_buffer_layout_active[SG_MAX_VERTEX_BUFFERS];
-    bool use_instanced_draw;
     sg_shader shader_id;
-    sg_vertex_layout_state layout;
-    sg_depth_state depth;
-    sg_stencil_state stencil;
+    bool is_compute;
+    bool use_instanced_draw;
+    bool vertex_buffer_layout_active[SG_MAX_VERTEX_BUFFERS];
+    sg_index_type index_type;
+    sg_primitive_type primitive_type;
     int color_count;
+    int sample_count;
     sg_color_target_state colors[SG_MAX_COLOR_ATTACHMENTS];
-    sg_primitive_type primitive_type;
-    sg_index_type index_type;
+    sg_depth_state depth;
+    sg_vertex_layout_state layout;
+    sg_stencil_state stencil;
     sg_cull_mode cull_mode;
     sg_face_winding face_winding;
-    int sample_count;
     sg_color blend_color;
     bool alpha_to_coverage_enabled;
+    sg_pipeline_desc* pending_desc; // copy of the desc while the shader is PENDING
 } _sg_pipeline_common_t;
 
 _SOKOL_PRIVATE void _sg_pipeline_common_init(_sg_pipeline_common_t* cmn, const sg_pipeline_desc* desc) {
@@ -4807,6 +6495,7 @@ _SOKOL_PRIVATE void _sg_pipeline_common_init(_sg_pipeline_common_t* cmn, const s
     }
     cmn->use_instanced_draw = false;
     cmn->shader_id = desc->shader;
+    cmn->is_compute = desc->compute;
     cmn->layout = desc->layout;
     cmn->depth = desc->depth;
     cmn->stencil = desc->stencil;
@@ -4913,6 +6602,18 @@ typedef struct {
 } _sg_dummy_context_t;
 typedef _sg_dummy_context_t _sg_context_t;
 
+typedef struct {
+    uint64_t timestamp_counter;
+    uint64_t timestamp_completed;   // if not zero, only timestamps up to this value are available (for testing)
+    uint64_t timestamps[_SG_MAX_TIMESTAMP_QUERIES];
+    uint32_t upload_frame_index[_SG_MAX_PENDING_UPLOADS];  // frame in which an upload was issued
+    uint32_t read_frame_index[_SG_MAX_PENDING_READS];      // frame in which a read was issued
+    uint8_t* read_data[_SG_MAX_PENDING_READS];
+    bool fail_reads;                // if true, finished reads fail (for testing)
+    int num_staged_uniforms;        // uniform updates staged since the last draw or dispatch
+    int num_flushed_uniforms;       // staged uniform updates seen by a draw or dispatch
+} _sg_dummy_backend_t;
+
 #elif defined(_SOKOL_ANY_GL)
 typedef struct {
     _sg_slot_t slot;
@@ -4920,19 +6621,22 @@ typedef struct {
     struct {
         GLuint buf[SG_NUM_INFLIGHT_FRAMES];
         bool injected;  // if true, external buffers were injected with sg_buffer_desc.gl_buffers
+        uint8_t* ring_ptr;  // persistently mapped memory of SG_USAGE_STREAM_RING buffers
+        int ring_region;    // frame region written last, or -1
+        GLsync ring_fences[SG_NUM_INFLIGHT_FRAMES];
     } gl;
 } _sg_gl_buffer_t;
 typedef _sg_gl_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         GLenum target;
         GLuint msaa_render_buffer;
         GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         bool injected;  // if true, external textures were injected with sg_image_desc.gl_textures
     } gl;
+    _sg_image_common_t cmn;
 } _sg_gl_image_t;
 typedef _sg_gl_image_t _sg_image_t;
 
@@ -4956,6 +6660,8 @@ typedef struct {
 typedef struct {
     int num_uniforms;
     _sg_gl_uniform_t uniforms[SG_MAX_UB_MEMBERS];
+    bool use_ubo;
+    GLuint ubo_binding;
 } _sg_gl_uniform_block_t;
 
 typedef struct {
@@ -4978,6 +6684,14 @@ typedef struct {
         GLuint prog;
         _sg_gl_shader_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
         _sg_gl_shader_stage_t stage[SG_NUM_SHADER_STAGES];
+        // state of a program which is still being compiled (see sg_desc.enable_async_shaders)
+        struct {
+            GLuint vs;
+            GLuint fs;
+            bool store_binary;
+            uint64_t cache_key;
+            sg_shader_desc* desc;   // copy of the shader desc with the names needed to resolve uniforms
+        } pending;
     } gl;
 } _sg_gl_shader_t;
 typedef _sg_gl_shader_t _sg_shader_t;
@@ -4994,7 +6708,6 @@ typedef struct {
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_pipeline_common_t cmn;
     _sg_shader_t* shader;
     struct {
         _sg_gl_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
@@ -5008,6 +6721,7 @@ typedef struct {
         int sample_count;
         bool alpha_to_coverage_enabled;
     } gl;
+    _sg_pipeline_common_t cmn;
 } _sg_gl_pipeline_t;
 typedef _sg_gl_pipeline_t _sg_pipeline_t;
 
@@ -5076,6 +6790,19 @@ typedef struct {
     sg_pipeline cur_pipeline_id;
 } _sg_gl_state_cache_t;
 
+// per-frame uniform buffer for uniform blocks with a GLSL block name
+typedef struct {
+    GLuint buf;
+    uint8_t* staging;
+    int size;
+    int align;
+    int offset;         // next free (aligned) offset in the current frame
+    int upload_pos;     // start of the data not yet uploaded
+    int upload_end;     // end of the data not yet uploaded
+    uint32_t frame_index;
+    bool orphan;
+} _sg_gl_uniform_buffer_t;
+
 typedef struct {
     bool valid;
     bool in_pass;
@@ -5085,7 +6812,18 @@ typedef struct {
     _sg_pass_t* cur_pass;
     sg_pass cur_pass_id;
     _sg_gl_state_cache_t cache;
+    _sg_gl_uniform_buffer_t ub;
+    GLuint upload_buf;      // GL_PIXEL_UNPACK_BUFFER for sg_map_image_upload(), created on first use
+    GLsync upload_fences[_SG_MAX_PENDING_UPLOADS];  // indexed by upload queue slot
+    GLuint read_bufs[_SG_MAX_PENDING_READS];        // GL_PIXEL_PACK_BUFFERs for sg_read_image_async(), indexed by read slot
+    GLsync read_fences[_SG_MAX_PENDING_READS];
+    bool read_mapped[_SG_MAX_PENDING_READS];
+    uint8_t* read_data[_SG_MAX_PENDING_READS];      // only used on WebGL2 which can't map buffers
+    GLuint timestamp_queries[_SG_MAX_TIMESTAMP_QUERIES];    // created on first use
     bool ext_anisotropic;
+    bool ext_buffer_storage;
+    bool ext_program_binary;
+    bool ext_parallel_shader_compile;
     GLint max_anisotropy;
     sg_store_action color_store_actions[SG_MAX_COLOR_ATTACHMENTS];
     sg_store_action depth_store_action;
@@ -5108,7 +6846,6 @@ typedef _sg_d3d11_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         DXGI_FORMAT format;
         ID3D11Texture2D* tex2d;
@@ -5116,6 +6853,7 @@ typedef struct {
         ID3D11Resource* res;    // either tex2d or tex3d
         ID3D11ShaderResourceView* srv;
     } d3d11;
+    _sg_image_common_t cmn;
 } _sg_d3d11_image_t;
 typedef _sg_d3d11_image_t _sg_image_t;
 
@@ -5153,7 +6891,6 @@ typedef _sg_d3d11_shader_t _sg_shader_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_pipeline_common_t cmn;
     _sg_shader_t* shader;
     struct {
         UINT stencil_ref;
@@ -5165,6 +6902,7 @@ typedef struct {
         ID3D11DepthStencilState* dss;
         ID3D11BlendState* bs;
     } d3d11;
+    _sg_pipeline_common_t cmn;
 } _sg_d3d11_pipeline_t;
 typedef _sg_d3d11_pipeline_t _sg_pipeline_t;
 
@@ -5257,10 +6995,10 @@ typedef _sg_mtl_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         int tex[SG_NUM_INFLIGHT_FRAMES];
     } mtl;
+    _sg_image_common_t cmn;
 } _sg_mtl_image_t;
 typedef _sg_mtl_image_t _sg_image_t;
 
@@ -5289,7 +7027,6 @@ typedef _sg_mtl_shader_t _sg_shader_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_pipeline_common_t cmn;
     _sg_shader_t* shader;
     struct {
         MTLPrimitiveType prim_type;
@@ -5301,6 +7038,7 @@ typedef struct {
         int rps;
         int dss;
     } mtl;
+    _sg_pipeline_common_t cmn;
 } _sg_mtl_pipeline_t;
 typedef _sg_mtl_pipeline_t _sg_pipeline_t;
 
@@ -5390,11 +7128,11 @@ typedef _sg_wgpu_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         WGPUTexture tex;
         WGPUTextureView view;
     } wgpu;
+    _sg_image_common_t cmn;
 } _sg_wgpu_image_t;
 typedef _sg_wgpu_image_t _sg_image_t;
 
@@ -5424,12 +7162,12 @@ typedef _sg_wgpu_shader_t _sg_shader_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_pipeline_common_t cmn;
     _sg_shader_t* shader;
     struct {
         WGPURenderPipeline pip;
         WGPUColor blend_color;
     } wgpu;
+    _sg_pipeline_common_t cmn;
 } _sg_wgpu_pipeline_t;
 typedef _sg_wgpu_pipeline_t _sg_pipeline_t;
 
@@ -5536,6 +7274,190 @@ typedef struct {
 } _sg_wgpu_backend_t;
 #endif
 
+// resolved resource bindings struct
+typedef struct {
+    _sg_pipeline_t* pip;
+    int num_vbs;
+    int num_vs_imgs;
+    int num_vs_smps;
+    int num_fs_imgs;
+    int num_fs_smps;
+    int num_vs_sbufs;
+    int num_fs_sbufs;
+    int vb_offsets[SG_MAX_VERTEX_BUFFERS];
+    int ib_offset;
+    _sg_buffer_t* vbs[SG_MAX_VERTEX_BUFFERS];
+    _sg_buffer_t* ib;
+    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    _sg_sampler_t* vs_smps[SG_MAX_SHADERSTAGE_SAMPLERS];
+    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    _sg_sampler_t* fs_smps[SG_MAX_SHADERSTAGE_SAMPLERS];
+    _sg_buffer_t* vs_sbufs[SG_MAX_SHADERSTAGE_STORAGEBUFFERS];
+    _sg_buffer_t* fs_sbufs[SG_MAX_SHADERSTAGE_STORAGEBUFFERS];
+} _sg_bindings_t;
+
+// RECORDING STRUCTS
+
+typedef enum {
+    _SG_RECCMD_APPLY_VIEWPORT,
+    _SG_RECCMD_APPLY_SCISSOR_RECT,
+    _SG_RECCMD_APPLY_PIPELINE,
+    _SG_RECCMD_APPLY_BINDINGS,
+    _SG_RECCMD_APPLY_UNIFORMS,
+    _SG_RECCMD_DRAW,
+} _sg_reccmd_type_t;
+
+typedef struct {
+    int x, y, width, height;
+    bool origin_top_left;
+} _sg_cmd_rect_t;
+
+typedef struct {
+    int base_element;
+    int num_elements;
+    int num_instances;
+} _sg_cmd_draw_t;
+
+typedef struct {
+    _sg_reccmd_type_t type;
+    union {
+        _sg_cmd_rect_t rect;
+        _sg_pipeline_t* pip;
+        int bindings_index;     // index into _sg_recording_t.bindings
+        struct {
+            sg_shader_stage stage;
+            int ub_index;
+            int offset;         // offset into _sg_recording_t.ub_data
+            int size;
+        } uniforms;
+        _sg_cmd_draw_t draw;
+    } args;
+} _sg_reccmd_t;
+
+// a resource referenced by a recording, checked for liveness before replay
+typedef struct {
+    const _sg_slot_t* slot;
+    uint32_t id;
+} _sg_recref_t;
+
+// pass attachment attributes which recorded pipelines must be compatible with
+typedef struct {
+    int num_color_atts;
+    sg_pixel_format color_formats[SG_MAX_COLOR_ATTACHMENTS];
+    sg_pixel_format depth_format;
+    int sample_count;
+} _sg_pass_attrs_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_pass_attrs_t pass_attrs;
+    sg_pipeline last_pipeline;
+    int num_cmds;
+    int max_cmds;
+    _sg_reccmd_t* cmds;
+    int num_bindings;
+    int max_bindings;
+    _sg_bindings_t* bindings;
+    int num_refs;
+    int max_refs;
+    _sg_recref_t* refs;
+    int ub_pos;
+    int ub_size;
+    uint8_t* ub_data;
+} _sg_recording_t;
+
+// ENCODER STRUCTS
+
+/*  an encoder command header, followed by payload_size bytes of
+    data (an sg_bindings struct, or uniform data)
+*/
+typedef struct {
+    _sg_reccmd_type_t type;
+    int payload_size;
+    union {
+        _sg_cmd_rect_t rect;
+        sg_pipeline pip;
+        struct {
+            sg_shader_stage stage;
+            int ub_index;
+            int size;
+        } uniforms;
+        _sg_cmd_draw_t draw;
+    } args;
+} _sg_enccmd_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    int size;
+    int pos;
+    bool overflow;
+    uint8_t* data;
+} _sg_encoder_t;
+
+// BINDING SET STRUCTS
+
+#define _SG_MAX_BINDING_SET_REFS (SG_MAX_VERTEX_BUFFERS + 1 + SG_NUM_SHADER_STAGES * (SG_MAX_SHADERSTAGE_IMAGES + SG_MAX_SHADERSTAGE_SAMPLERS + SG_MAX_SHADERSTAGE_STORAGEBUFFERS))
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_bindings_t bnd;         // bnd.pip is patched in sg_apply_binding_set()
+    int num_refs;
+    _sg_recref_t refs[_SG_MAX_BINDING_SET_REFS];
+    #if defined(SOKOL_DEBUG)
+    sg_bindings bindings;       // for validating against the current pipeline
+    uint32_t validated_pip_id;  // last pipeline the binding set has been validated against
+    #endif
+} _sg_binding_set_t;
+
+// DRAW QUEUE STRUCTS
+
+typedef struct {
+    uint64_t key;
+    int index;      // index into _sg_draw_queue_t.items
+} _sg_draw_queue_key_t;
+
+typedef struct {
+    sg_pipeline pip;
+    sg_bindings bindings;
+    int ub_offset[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];  // offset into _sg_draw_queue_t.ub_data
+    int ub_size[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    _sg_cmd_draw_t draw;
+} _sg_draw_queue_item_t;
+
+typedef struct {
+    int num_items;
+    int max_items;
+    _sg_draw_queue_item_t* items;
+    int max_keys;
+    _sg_draw_queue_key_t* keys;
+    int max_tmp_keys;
+    _sg_draw_queue_key_t* tmp_keys;     // scratch space for the radix sort
+    int ub_pos;
+    int ub_size;
+    uint8_t* ub_data;
+} _sg_draw_queue_t;
+
+// GPU TIMING STRUCTS
+
+typedef struct {
+    uint32_t frame_index;
+    bool pending;       // waiting for timestamp query results
+    bool overflow;
+    int num_scopes;
+    int last_query;     // the timestamp query which was written last in this frame
+    sg_pass_timing scopes[SG_MAX_PASS_TIMINGS];
+} _sg_timing_frame_t;
+
+typedef struct {
+    bool enabled;
+    int cur;            // current frame slot
+    int pass_scope;     // scope index of the current pass, or -1
+    int group_depth;
+    int group_scopes[SG_MAX_PASS_TIMINGS];  // scope index of each open debug group, or -1
+    _sg_timing_frame_t frames[_SG_NUM_TIMING_FRAMES];
+    sg_pass_timings result;
+} _sg_timings_t;
+
 // POOL STRUCTS
 
 // this *MUST* remain 0
@@ -5549,6 +7471,9 @@ typedef struct {
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
     _sg_pool_t context_pool;
+    _sg_pool_t recording_pool;
+    _sg_pool_t encoder_pool;
+    _sg_pool_t binding_set_pool;
     _sg_buffer_t* buffers;
     _sg_image_t* images;
     _sg_sampler_t* samplers;
@@ -5556,6 +7481,9 @@ typedef struct {
     _sg_pipeline_t* pipelines;
     _sg_pass_t* passes;
     _sg_context_t* contexts;
+    _sg_recording_t* recordings;
+    _sg_encoder_t* encoders;
+    _sg_binding_set_t* binding_sets;
 } _sg_pools_t;
 
 typedef struct {
@@ -5564,34 +7492,133 @@ typedef struct {
     sg_commit_listener* items;
 } _sg_commit_listeners_t;
 
-// resolved resource bindings struct
+// copy of the last applied uniform data per shader stage and uniform block slot
+#define _SG_UNIFORM_CACHE_MAX_SIZE (256)
 typedef struct {
-    _sg_pipeline_t* pip;
-    int num_vbs;
-    int num_vs_imgs;
-    int num_vs_smps;
-    int num_fs_imgs;
-    int num_fs_smps;
-    int vb_offsets[SG_MAX_VERTEX_BUFFERS];
-    int ib_offset;
-    _sg_buffer_t* vbs[SG_MAX_VERTEX_BUFFERS];
-    _sg_buffer_t* ib;
-    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
-    _sg_sampler_t* vs_smps[SG_MAX_SHADERSTAGE_SAMPLERS];
-    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
-    _sg_sampler_t* fs_smps[SG_MAX_SHADERSTAGE_SAMPLERS];
-} _sg_bindings_t;
+    bool valid;
+    uint32_t size;
+    uint8_t data[_SG_UNIFORM_CACHE_MAX_SIZE];
+} _sg_uniform_cache_item_t;
 
 typedef struct {
-    bool valid;
-    sg_desc desc;       // original desc with default values patched in
-    uint32_t frame_index;
+    _sg_uniform_cache_item_t items[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+} _sg_uniform_cache_t;
+
+// pipeline cache items are indexed by pipeline pool slot index
+typedef struct {
+    uint32_t pip_id;
+    int ref_count;
+    uint64_t hash;
+    sg_pipeline_desc desc;  // defaults-patched desc without label
+} _sg_pipeline_cache_item_t;
+
+// the hash table is an open-addressing table of pipeline slot indices,
+// with linear probing and tombstones for removed entries
+#define _SG_PIPELINE_CACHE_EMPTY (0)
+#define _SG_PIPELINE_CACHE_REMOVED (-1)
+
+typedef struct {
+    int num_items;  // indexable by pipeline slot index, grows with the pipeline pool
+    _sg_pipeline_cache_item_t* items;
+    int table_size; // power of two, at least twice the number of items
+    int num_used;   // occupied table entries, including tombstones
+    int* table;
+} _sg_pipeline_cache_t;
+
+// a transient image or pass, the key is the normalized desc without label
+typedef struct {
+    uint32_t id;                // image or pass id, SG_INVALID_ID for free items
+    bool is_pass;
+    bool in_use;                // acquired in the current frame
+    uint32_t last_frame_index;  // frame index of the last acquisition
+    uint64_t size;              // estimated image size in bytes, 0 for passes
+    uint64_t hash;
+    sg_transient_image_desc img_key;
+    sg_pass_desc pass_key;
+} _sg_transient_item_t;
+
+typedef struct {
+    int num_items;
+    _sg_transient_item_t* items;
+    uint64_t size;
+    uint64_t peak_size;
+} _sg_transients_t;
+
+// an image upload which may not have been finished by the GPU yet
+typedef struct {
+    uint32_t id;
+    int offset;         // byte range in the upload buffer
+    int size;
+} _sg_upload_item_t;
+
+// ring-buffer of upload memory for sg_map_image_upload(), pending uploads
+// are kept in a FIFO queue, the backend tracks GPU completion per queue slot
+typedef struct {
+    int size;           // size of the upload buffer in bytes
+    int pos;            // next free byte in the upload buffer
+    uint8_t* staging;   // CPU-side memory if the backend can't map the upload buffer
+    uint32_t next_id;
+    uint32_t done_id;   // all uploads up to and including this id are finished
+    int queue_head;     // oldest pending upload
+    int queue_count;
+    _sg_upload_item_t queue[_SG_MAX_PENDING_UPLOADS];
+    // the currently mapped upload
+    bool mapped;
+    uint32_t map_img_id;
+    int map_face;
+    int map_mip_level;
+    int map_offset;
+    int map_size;
+    bool map_staged;    // true if the mapped range is in staging memory
+} _sg_upload_buffer_t;
+
+// a pending sg_read_image_async() call, the backend tracks the GPU side
+// of the read in its own arrays indexed by the same slot index
+typedef struct {
+    bool active;
+    sg_read_result result;  // .data is filled in when the read is done
+    void (*callback)(const sg_read_result* result);
+} _sg_read_item_t;
+
+typedef struct {
+    int num_pending;
+    _sg_read_item_t items[_SG_MAX_PENDING_READS];
+} _sg_reads_t;
+
+typedef struct {
+    bool valid;
+    sg_desc desc;       // original desc with default values patched in
+    uint32_t frame_index;
     sg_context active_context;
     sg_pass cur_pass;
     sg_pipeline cur_pipeline;
+    bool in_pass;       // true between sg_begin_*pass() and sg_end_pass(), even if the pass isn't valid
+    bool compute_pass;  // true between sg_begin_compute_pass() and sg_end_pass()
     bool pass_valid;
     bool bindings_applied;
     bool next_draw_valid;
+    bool cur_pipeline_pending;  // draws are silently skipped while the current pipeline is PENDING
+    struct {
+        bool active;
+        sg_recording id;
+        // rendering state at sg_begin_recording(), restored in sg_end_recording()
+        sg_pipeline cur_pipeline;
+        bool bindings_applied;
+        bool next_draw_valid;
+        bool cur_pipeline_pending;
+    } rec;
+    _sg_uniform_cache_t uniform_cache;
+    _sg_pipeline_cache_t pipeline_cache;
+    _sg_transients_t transients;
+    struct {
+        sg_memory_stats stats;
+        bool over_budget;
+        int budget_lock;    // the budget callback is deferred while > 0
+    } memory;
+    _sg_upload_buffer_t upload;
+    _sg_reads_t reads;
+    _sg_draw_queue_t draw_queue;
+    _sg_timings_t timings;
     #if defined(SOKOL_DEBUG)
     sg_log_item validate_error;
     #endif
@@ -5611,6 +7638,8 @@ typedef struct {
     _sg_d3d11_backend_t d3d11;
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_backend_t wgpu;
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_backend_t dummy;
     #endif
     #if defined(SOKOL_TRACE_HOOKS)
     sg_trace_hooks hooks;
@@ -5925,6 +7954,12 @@ _SOKOL_PRIVATE bool _sg_is_depth_or_depth_stencil_format(sg_pixel_format fmt) {
     return (SG_PIXELFORMAT_DEPTH == fmt) || (SG_PIXELFORMAT_DEPTH_STENCIL == fmt);
 }
 
+// mipmap generation downsamples by rendering, so the format must be filterable and renderable
+_SOKOL_PRIVATE bool _sg_is_mipmap_generation_format(sg_pixel_format fmt) {
+    SOKOL_ASSERT(((int)fmt >= 0) && ((int)fmt < _SG_PIXELFORMAT_NUM));
+    return _sg.formats[fmt].filter && _sg.formats[fmt].render && !_sg_is_depth_or_depth_stencil_format(fmt);
+}
+
 _SOKOL_PRIVATE bool _sg_is_depth_stencil_format(sg_pixel_format fmt) {
     return (SG_PIXELFORMAT_DEPTH_STENCIL == fmt);
 }
@@ -5995,10 +8030,91 @@ _SOKOL_PRIVATE uint64_t _sg_roundup_u64(uint64_t val, uint64_t round_to) {
     return (val+(round_to-1)) & ~(round_to-1);
 }
 
+// MurmurHash64B (see: https://github.com/aappleby/smhasher/blob/61a0530f28277f2e850bfc39600ce61d02b518de/src/MurmurHash2.cpp#L142)
+_SOKOL_PRIVATE uint64_t _sg_hash(const void* key, int len, uint64_t seed) {
+    const uint32_t m = 0x5bd1e995;
+    const int r = 24;
+    uint32_t h1 = (uint32_t)seed ^ (uint32_t)len;
+    uint32_t h2 = (uint32_t)(seed >> 32);
+    const uint32_t * data = (const uint32_t *)key;
+    while (len >= 8) {
+        uint32_t k1 = *data++;
+        k1 *= m; k1 ^= k1 >> r; k1 *= m;
+        h1 *= m; h1 ^= k1;
+        len -= 4;
+        uint32_t k2 = *data++;
+        k2 *= m; k2 ^= k2 >> r; k2 *= m;
+        h2 *= m; h2 ^= k2;
+        len -= 4;
+    }
+    if (len >= 4) {
+        uint32_t k1 = *data++;
+        k1 *= m; k1 ^= k1 >> r; k1 *= m;
+        h1 *= m; h1 ^= k1;
+        len -= 4;
+    }
+    // remaining 0..3 bytes (same as the original fallthrough switch)
+    if (len >= 3) {
+        h2 ^= (uint32_t)(((const uint8_t*)data)[2] << 16);
+    }
+    if (len >= 2) {
+        h2 ^= (uint32_t)(((const uint8_t*)data)[1] << 8);
+    }
+    if (len >= 1) {
+        h2 ^= ((const uint8_t*)data)[0];
+        h2 *= m;
+    }
+    h1 ^= h2 >> 18; h1 *= m;
+    h2 ^= h1 >> 22; h2 *= m;
+    h1 ^= h2 >> 17; h1 *= m;
+    h2 ^= h1 >> 19; h2 *= m;
+    uint64_t h = h1;
+    h = (h << 32) | h2;
+    return h;
+}
+
+_SOKOL_PRIVATE bool _sg_shader_cache_enabled(void) {
+    return (0 != _sg.desc.shader_cache.load_fn) && (0 != _sg.desc.shader_cache.store_fn);
+}
+
+// the shader cache key is a hash over the shader source code (or bytecode) of both stages
+_SOKOL_PRIVATE uint64_t _sg_shader_cache_key(const sg_shader_desc* desc) {
+    uint64_t key = 0x1234567887654321;
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS) ? &desc->vs : &desc->fs;
+        if (stage_desc->source) {
+            key = _sg_hash(stage_desc->source, (int)strlen(stage_desc->source), key);
+        } else if (stage_desc->bytecode.ptr) {
+            key = _sg_hash(stage_desc->bytecode.ptr, (int)stage_desc->bytecode.size, key);
+        } else {
+            key = _sg_hash(&stage_index, (int)sizeof(stage_index), key);
+        }
+    }
+    return key;
+}
+
+// returns a zero-initialized struct if there's no binary for the key
+_SOKOL_PRIVATE sg_shader_binary _sg_shader_cache_load(uint64_t key) {
+    SOKOL_ASSERT(_sg_shader_cache_enabled());
+    return _sg.desc.shader_cache.load_fn(key, _sg.desc.shader_cache.user_data);
+}
+
+_SOKOL_PRIVATE void _sg_shader_cache_store(uint64_t key, const sg_shader_binary* bin) {
+    SOKOL_ASSERT(_sg_shader_cache_enabled());
+    SOKOL_ASSERT(bin && bin->data.ptr && (bin->data.size > 0));
+    _sg.desc.shader_cache.store_fn(key, bin, _sg.desc.shader_cache.user_data);
+}
+
 _SOKOL_PRIVATE bool _sg_multiple_u64(uint64_t val, uint64_t of) {
     return (val & (of-1)) == 0;
 }
 
+// sg_draw_multi() items with zero elements or instances are skipped, and
+// invalid items must also be skipped in release mode
+_SOKOL_PRIVATE bool _sg_draw_args_drawable(const sg_draw_args* args) {
+    return (args->base_element >= 0) && (args->num_elements > 0) && (args->num_instances > 0);
+}
+
 /* return row pitch for an image
 
     see ComputePitch in https://github.com/microsoft/DirectXTex/blob/master/DirectXTex/DirectXTexUtil.cpp
@@ -6218,6 +8334,11 @@ _SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
     SOKOL_ASSERT(desc);
     _SOKOL_UNUSED(desc);
     _sg.backend = SG_BACKEND_DUMMY;
+    _sg.features.pass_timings = true;
+    _sg.features.image_upload = true;
+    _sg.features.image_read = true;
+    _sg.features.generate_mipmaps = true;
+    _sg.features.compute = true;
     for (int i = SG_PIXELFORMAT_R8; i < SG_PIXELFORMAT_BC1_RGBA; i++) {
         _sg.formats[i].sample = true;
         _sg.formats[i].filter = true;
@@ -6249,7 +8370,7 @@ _SOKOL_PRIVATE void _sg_dummy_discard_context(_sg_context_t* ctx) {
 }
 
 _SOKOL_PRIVATE void _sg_dummy_activate_context(_sg_context_t* ctx) {
-    SOKOL_ASSERT(ctx);
+    // NOTE: ctx can be 0 to unset the current context
     _SOKOL_UNUSED(ctx);
 }
 
@@ -6292,7 +8413,26 @@ _SOKOL_PRIVATE void _sg_dummy_discard_sampler(_sg_sampler_t* smp) {
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
     SOKOL_ASSERT(shd && desc);
     _SOKOL_UNUSED(shd);
-    _SOKOL_UNUSED(desc);
+    // emulate program binaries with the cache key as binary data, so that the shader cache can be tested
+    if (_sg_shader_cache_enabled()) {
+        const uint64_t key = _sg_shader_cache_key(desc);
+        const sg_shader_binary bin = _sg_shader_cache_load(key);
+        if ((bin.format == _SG_DUMMY_SHADER_BINARY_FORMAT) && (bin.data.size == sizeof(key)) && (0 == memcmp(bin.data.ptr, &key, sizeof(key)))) {
+            // a shader loaded from a binary is never pending
+            _sg_stats_add(num_shader_cache_hits, 1);
+            return SG_RESOURCESTATE_VALID;
+        }
+        _sg_stats_add(num_shader_cache_misses, 1);
+        const sg_shader_binary new_bin = { _SG_DUMMY_SHADER_BINARY_FORMAT, { &key, sizeof(key) } };
+        _sg_shader_cache_store(key, &new_bin);
+    }
+    // emulate async shader compilation, pending shaders are finished in the next sg_commit()
+    return _sg.desc.enable_async_shaders ? SG_RESOURCESTATE_PENDING : SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_dummy_poll_shader(_sg_shader_t* shd) {
+    SOKOL_ASSERT(shd);
+    _SOKOL_UNUSED(shd);
     return SG_RESOURCESTATE_VALID;
 }
 
@@ -6388,6 +8528,25 @@ _SOKOL_PRIVATE void _sg_dummy_commit(void) {
     // empty
 }
 
+// synthetic GPU timestamps, each timestamp is 1000 nanoseconds after the previous one
+_SOKOL_PRIVATE void _sg_dummy_write_timestamp(int query_index) {
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_MAX_TIMESTAMP_QUERIES));
+    _sg.dummy.timestamp_counter += 1000;
+    _sg.dummy.timestamps[query_index] = _sg.dummy.timestamp_counter;
+}
+
+// like a GPU, the dummy backend completes timestamps in the order they were written
+_SOKOL_PRIVATE bool _sg_dummy_timestamp_available(int query_index) {
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_MAX_TIMESTAMP_QUERIES));
+    return (0 == _sg.dummy.timestamp_completed) || (_sg.dummy.timestamps[query_index] <= _sg.dummy.timestamp_completed);
+}
+
+_SOKOL_PRIVATE uint64_t _sg_dummy_read_timestamp(int query_index) {
+    // reading a timestamp which isn't available would stall on a real GPU
+    SOKOL_ASSERT(_sg_dummy_timestamp_available(query_index));
+    return _sg.dummy.timestamps[query_index];
+}
+
 _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
     _SOKOL_UNUSED(x);
     _SOKOL_UNUSED(y);
@@ -6416,13 +8575,21 @@ _SOKOL_PRIVATE bool _sg_dummy_apply_bindings(_sg_bindings_t* bnd) {
     return true;
 }
 
+// like the GL backend, uniform updates are staged and flushed by the next draw or dispatch
 _SOKOL_PRIVATE void _sg_dummy_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     _SOKOL_UNUSED(stage_index);
     _SOKOL_UNUSED(ub_index);
     _SOKOL_UNUSED(data);
+    _sg.dummy.num_staged_uniforms++;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_flush_uniforms(void) {
+    _sg.dummy.num_flushed_uniforms += _sg.dummy.num_staged_uniforms;
+    _sg.dummy.num_staged_uniforms = 0;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_draw(int base_element, int num_elements, int num_instances) {
+    _sg_dummy_flush_uniforms();
     _SOKOL_UNUSED(base_element);
     _SOKOL_UNUSED(num_elements);
     _SOKOL_UNUSED(num_instances);
@@ -6447,6 +8614,111 @@ _SOKOL_PRIVATE bool _sg_dummy_append_buffer(_sg_buffer_t* buf, const sg_range* d
     return true;
 }
 
+_SOKOL_PRIVATE void* _sg_dummy_map_buffer(_sg_buffer_t* buf, int offset, int size, bool new_frame) {
+    SOKOL_ASSERT(buf && (size > 0));
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(size);
+    _SOKOL_UNUSED(new_frame);
+    // writes go into CPU-side staging memory
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_unmap_buffer(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && (data->size > 0));
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(data);
+}
+
+_SOKOL_PRIVATE void* _sg_dummy_map_upload_buffer(int offset, int size) {
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(size);
+    // writes go into CPU-side staging memory
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_unmap_upload_buffer(_sg_image_t* img, int face, int mip_level, int offset, const sg_range* data, int queue_index) {
+    SOKOL_ASSERT(data && (data->size > 0));
+    _SOKOL_UNUSED(face);
+    _SOKOL_UNUSED(mip_level);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(data);
+    if (img) {
+        SOKOL_ASSERT((queue_index >= 0) && (queue_index < _SG_MAX_PENDING_UPLOADS));
+        _sg.dummy.upload_frame_index[queue_index] = _sg.frame_index;
+    }
+}
+
+// uploads are done once the frame they were issued in has been committed
+_SOKOL_PRIVATE bool _sg_dummy_query_upload_done(int queue_index) {
+    SOKOL_ASSERT((queue_index >= 0) && (queue_index < _SG_MAX_PENDING_UPLOADS));
+    return _sg.dummy.upload_frame_index[queue_index] != _sg.frame_index;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_generate_mipmaps(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    _SOKOL_UNUSED(img);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    _sg_dummy_flush_uniforms();
+    _SOKOL_UNUSED(num_groups_x);
+    _SOKOL_UNUSED(num_groups_y);
+    _SOKOL_UNUSED(num_groups_z);
+}
+
+// deterministic pixel data for tests: the first byte of each pixel is its x coordinate,
+// the second byte its y coordinate, all remaining bytes are 0xFF
+_SOKOL_PRIVATE void _sg_dummy_read_image(_sg_image_t* img, const sg_read_result* res, void* ptr) {
+    SOKOL_ASSERT(res && ptr && (res->data.size > 0));
+    _SOKOL_UNUSED(img);
+    const int bpp = _sg_pixelformat_bytesize(res->pixel_format);
+    uint8_t* dst = (uint8_t*) ptr;
+    for (int y = 0; y < res->height; y++) {
+        for (int x = 0; x < res->width; x++) {
+            memset(dst, 0xFF, (size_t)bpp);
+            dst[0] = (uint8_t)(res->x + x);
+            if (bpp > 1) {
+                dst[1] = (uint8_t)(res->y + y);
+            }
+            dst += bpp;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_dummy_start_read(_sg_image_t* img, const sg_read_result* res, int read_index) {
+    SOKOL_ASSERT(res && (res->data.size > 0));
+    SOKOL_ASSERT((read_index >= 0) && (read_index < _SG_MAX_PENDING_READS));
+    SOKOL_ASSERT(0 == _sg.dummy.read_data[read_index]);
+    _sg.dummy.read_data[read_index] = (uint8_t*) _sg_malloc(res->data.size);
+    _sg_dummy_read_image(img, res, _sg.dummy.read_data[read_index]);
+    _sg.dummy.read_frame_index[read_index] = _sg.frame_index;
+}
+
+// reads are done once the frame they were issued in has been committed
+_SOKOL_PRIVATE const void* _sg_dummy_map_read(int read_index, int size, bool* out_failed) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < _SG_MAX_PENDING_READS));
+    SOKOL_ASSERT(out_failed);
+    _SOKOL_UNUSED(size);
+    if (_sg.dummy.read_frame_index[read_index] == _sg.frame_index) {
+        return 0;
+    }
+    if (_sg.dummy.fail_reads) {
+        *out_failed = true;
+        return 0;
+    }
+    return _sg.dummy.read_data[read_index];
+}
+
+_SOKOL_PRIVATE void _sg_dummy_discard_read(int read_index) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < _SG_MAX_PENDING_READS));
+    if (_sg.dummy.read_data[read_index]) {
+        _sg_free(_sg.dummy.read_data[read_index]);
+        _sg.dummy.read_data[read_index] = 0;
+    }
+}
+
 _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     _SOKOL_UNUSED(data);
@@ -6464,6 +8736,27 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
 // >>opengl backend
 #elif defined(_SOKOL_ANY_GL)
 
+// native multi-draw is only available on desktop GL, native indirect multi-draw
+// additionally requires GL 4.3 or GL_ARB_multi_draw_indirect (not on macOS)
+#if defined(SOKOL_GLCORE33)
+#define _SG_GL_MULTI_DRAW (1)
+#if !defined(__APPLE__) && !defined(SOKOL_EXTERNAL_GL_LOADER)
+#define _SG_GL_MULTI_DRAW_INDIRECT (1)
+#define _SG_GL_BUFFER_STORAGE (1)
+#endif
+#endif
+
+// compute shaders and storage buffers require GL 4.3 or GL_ARB_compute_shader
+// and GL_ARB_shader_storage_buffer_object (not on macOS, GLES3 or WebGL2)
+#if defined(SOKOL_GLCORE33) && !defined(__APPLE__) && !defined(SOKOL_EXTERNAL_GL_LOADER)
+#define _SG_GL_COMPUTE (1)
+#endif
+
+// program binaries need GLES3, GL 4.1 or GL_ARB_get_program_binary (not on WebGL2)
+#if (defined(SOKOL_GLES3) && !defined(__EMSCRIPTEN__)) || (defined(SOKOL_GLCORE33) && !defined(SOKOL_EXTERNAL_GL_LOADER))
+#define _SG_GL_PROGRAM_BINARY (1)
+#endif
+
 // optional GL loader for win32
 #if defined(_SOKOL_USE_WIN32_GL_LOADER)
 
@@ -6473,6 +8766,7 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glFramebufferTextureLayer,         void, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)) \
     _SG_XMACRO(glGenFramebuffers,                 void, (GLsizei n, GLuint * framebuffers)) \
     _SG_XMACRO(glBindFramebuffer,                 void, (GLenum target, GLuint framebuffer)) \
+    _SG_XMACRO(glGenerateMipmap,                  void, (GLenum target)) \
     _SG_XMACRO(glBindRenderbuffer,                void, (GLenum target, GLuint renderbuffer)) \
     _SG_XMACRO(glGetStringi,                      const GLubyte *, (GLenum name, GLuint index)) \
     _SG_XMACRO(glClearBufferfi,                   void, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil)) \
@@ -6561,6 +8855,7 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glEnableVertexAttribArray,         void, (GLuint index)) \
     _SG_XMACRO(glBlendFunc,                       void, (GLenum sfactor, GLenum dfactor)) \
     _SG_XMACRO(glReadBuffer,                      void, (GLenum src)) \
+    _SG_XMACRO(glReadPixels,                      void, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* data)) \
     _SG_XMACRO(glTexImage2D,                      void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)) \
     _SG_XMACRO(glGenVertexArrays,                 void, (GLsizei n, GLuint * arrays)) \
     _SG_XMACRO(glFrontFace,                       void, (GLenum mode)) \
@@ -6571,16 +8866,45 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glSamplerParameteri,               void, (GLuint sampler, GLenum pname, GLint param)) \
     _SG_XMACRO(glSamplerParameterf,               void, (GLuint sampler, GLenum pname, GLfloat param)) \
     _SG_XMACRO(glSamplerParameterfv,              void, (GLuint sampler, GLenum pname, const GLfloat* params)) \
-    _SG_XMACRO(glDeleteSamplers,                  void, (GLsizei n, const GLuint* samplers))
+    _SG_XMACRO(glDeleteSamplers,                  void, (GLsizei n, const GLuint* samplers)) \
+    _SG_XMACRO(glMultiDrawArrays,                 void, (GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount)) \
+    _SG_XMACRO(glMultiDrawElements,               void, (GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount)) \
+    _SG_XMACRO(glMapBufferRange,                  void*, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    _SG_XMACRO(glUnmapBuffer,                     GLboolean, (GLenum target)) \
+    _SG_XMACRO(glFenceSync,                       GLsync, (GLenum condition, GLbitfield flags)) \
+    _SG_XMACRO(glClientWaitSync,                  GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    _SG_XMACRO(glDeleteSync,                      void, (GLsync sync)) \
+    _SG_XMACRO(glGetUniformBlockIndex,            GLuint, (GLuint program, const GLchar* uniformBlockName)) \
+    _SG_XMACRO(glUniformBlockBinding,             void, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)) \
+    _SG_XMACRO(glBindBufferRange,                 void, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    _SG_XMACRO(glBindBufferBase,                  void, (GLenum target, GLuint index, GLuint buffer)) \
+    _SG_XMACRO(glGenQueries,                      void, (GLsizei n, GLuint* ids)) \
+    _SG_XMACRO(glDeleteQueries,                   void, (GLsizei n, const GLuint* ids)) \
+    _SG_XMACRO(glQueryCounter,                    void, (GLuint id, GLenum target)) \
+    _SG_XMACRO(glGetQueryObjectiv,                void, (GLuint id, GLenum pname, GLint* params)) \
+    _SG_XMACRO(glGetQueryObjectui64v,             void, (GLuint id, GLenum pname, GLuint64* params))
+
+// X Macro list of optional GL functions which may be missing in the GL context
+#define _SG_GL_OPT_FUNCS \
+    _SG_XMACRO(glMultiDrawArraysIndirect,         void, (GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride)) \
+    _SG_XMACRO(glMultiDrawElementsIndirect,       void, (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)) \
+    _SG_XMACRO(glBufferStorage,                   void, (GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)) \
+    _SG_XMACRO(glGetProgramBinary,                void, (GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)) \
+    _SG_XMACRO(glProgramBinary,                   void, (GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)) \
+    _SG_XMACRO(glProgramParameteri,               void, (GLuint program, GLenum pname, GLint value)) \
+    _SG_XMACRO(glDispatchCompute,                 void, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)) \
+    _SG_XMACRO(glMemoryBarrier,                   void, (GLbitfield barriers))
 
 // generate GL function pointer typedefs
 #define _SG_XMACRO(name, ret, args) typedef ret (GL_APIENTRY* PFN_ ## name) args;
 _SG_GL_FUNCS
+_SG_GL_OPT_FUNCS
 #undef _SG_XMACRO
 
 // generate GL function pointers
 #define _SG_XMACRO(name, ret, args) static PFN_ ## name name;
 _SG_GL_FUNCS
+_SG_GL_OPT_FUNCS
 #undef _SG_XMACRO
 
 // helper function to lookup GL functions in GL DLL
@@ -6604,6 +8928,10 @@ _SOKOL_PRIVATE  void _sg_gl_load_opengl(void) {
     #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr(#name, wgl_getprocaddress);
     _SG_GL_FUNCS
     #undef _SG_XMACRO
+    // optional functions are allowed to be missing
+    #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) wgl_getprocaddress(#name);
+    _SG_GL_OPT_FUNCS
+    #undef _SG_XMACRO
 }
 
 _SOKOL_PRIVATE void _sg_gl_unload_opengl(void) {
@@ -6618,6 +8946,11 @@ _SOKOL_PRIVATE GLenum _sg_gl_buffer_target(sg_buffer_type t) {
     switch (t) {
         case SG_BUFFERTYPE_VERTEXBUFFER:    return GL_ARRAY_BUFFER;
         case SG_BUFFERTYPE_INDEXBUFFER:     return GL_ELEMENT_ARRAY_BUFFER;
+        // GL buffer objects are untyped, indirect buffers are bound to
+        // GL_DRAW_INDIRECT_BUFFER only for the duration of an indirect draw,
+        // and storage buffers to GL_SHADER_STORAGE_BUFFER in _sg_gl_apply_bindings()
+        case SG_BUFFERTYPE_INDIRECTBUFFER:  return GL_ARRAY_BUFFER;
+        case SG_BUFFERTYPE_STORAGEBUFFER:   return GL_ARRAY_BUFFER;
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -6637,6 +8970,7 @@ _SOKOL_PRIVATE GLenum _sg_gl_usage(sg_usage u) {
         case SG_USAGE_IMMUTABLE:    return GL_STATIC_DRAW;
         case SG_USAGE_DYNAMIC:      return GL_DYNAMIC_DRAW;
         case SG_USAGE_STREAM:       return GL_STREAM_DRAW;
+        case SG_USAGE_STREAM_RING:  return GL_STREAM_DRAW;
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -6645,6 +8979,7 @@ _SOKOL_PRIVATE GLenum _sg_gl_shader_stage(sg_shader_stage stage) {
     switch (stage) {
         case SG_SHADERSTAGE_VS:     return GL_VERTEX_SHADER;
         case SG_SHADERSTAGE_FS:     return GL_FRAGMENT_SHADER;
+        case SG_SHADERSTAGE_CS:     return GL_COMPUTE_SHADER;
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -7253,8 +9588,16 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.multi_draw = true;
+    _sg.features.pass_timings = true;
+    _sg.features.image_upload = true;
+    _sg.features.image_read = true;
+    _sg.features.generate_mipmaps = true;
 
     // scan extensions
+    bool has_multi_draw_indirect = false;
+    bool has_compute_shader = false;
+    bool has_storage_buffer = false;
     bool has_s3tc = false;  // BC1..BC3
     bool has_rgtc = false;  // BC4 and BC5
     bool has_bptc = false;  // BC6H and BC7
@@ -7277,9 +9620,47 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
                 has_etc2 = true;
             } else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
+            } else if (strstr(ext, "_multi_draw_indirect")) {
+                has_multi_draw_indirect = true;
+            } else if (strstr(ext, "_compute_shader")) {
+                has_compute_shader = true;
+            } else if (strstr(ext, "_shader_storage_buffer_object")) {
+                has_storage_buffer = true;
+            } else if (strstr(ext, "_buffer_storage")) {
+                _sg.gl.ext_buffer_storage = true;
+            } else if (strstr(ext, "_get_program_binary")) {
+                _sg.gl.ext_program_binary = true;
+            } else if (strstr(ext, "_parallel_shader_compile")) {
+                _sg.gl.ext_parallel_shader_compile = true;
             }
         }
     }
+    #if defined(_SG_GL_BUFFER_STORAGE)
+        #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+        _sg.gl.ext_buffer_storage &= (0 != glBufferStorage);
+        #endif
+    #else
+        _sg.gl.ext_buffer_storage = false;
+    #endif
+    #if defined(_SG_GL_MULTI_DRAW_INDIRECT)
+        #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+        has_multi_draw_indirect &= (0 != glMultiDrawArraysIndirect) && (0 != glMultiDrawElementsIndirect);
+        #endif
+        _sg.features.draw_indirect = has_multi_draw_indirect;
+    #else
+        _SOKOL_UNUSED(has_multi_draw_indirect);
+        _sg.features.draw_indirect = false;
+    #endif
+    #if defined(_SG_GL_COMPUTE)
+        #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+        has_compute_shader &= (0 != glDispatchCompute) && (0 != glMemoryBarrier);
+        #endif
+        _sg.features.compute = has_compute_shader && has_storage_buffer;
+    #else
+        _SOKOL_UNUSED(has_compute_shader);
+        _SOKOL_UNUSED(has_storage_buffer);
+        _sg.features.compute = false;
+    #endif
 
     // limits
     _sg_gl_init_limits();
@@ -7319,6 +9700,11 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     _sg.features.image_clamp_to_border = false;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = false;
+    _sg.features.multi_draw = false;
+    _sg.features.draw_indirect = false;
+    _sg.features.image_upload = true;
+    _sg.features.image_read = true;
+    _sg.features.generate_mipmaps = true;
 
     bool has_s3tc = false;  // BC1..BC3
     bool has_rgtc = false;  // BC4 and BC5
@@ -7362,6 +9748,8 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
                 has_float_blend = true;
             } else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
+            } else if (strstr(ext, "_parallel_shader_compile")) {
+                _sg.gl.ext_parallel_shader_compile = true;
             }
         }
     }
@@ -7711,11 +10099,59 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
         _sg_gl_init_caps_glcore33();
     #elif defined(SOKOL_GLES3)
         _sg_gl_init_caps_gles3();
+        _sg.gl.ext_program_binary = true;
+    #endif
+
+    // program binaries are only usable if the driver supports at least one binary format
+    #if defined(_SG_GL_PROGRAM_BINARY)
+    if (_sg.gl.ext_program_binary) {
+        GLint num_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+        _SG_GL_CHECK_ERROR();
+        _sg.gl.ext_program_binary = num_formats > 0;
+        #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+        _sg.gl.ext_program_binary &= (0 != glGetProgramBinary) && (0 != glProgramBinary) && (0 != glProgramParameteri);
+        #endif
+    }
+    #else
+    _sg.gl.ext_program_binary = false;
     #endif
+
+    // the uniform buffer itself is created on first use
+    SOKOL_ASSERT(desc->uniform_buffer_size > 0);
+    GLint ub_align = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &ub_align);
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.ub.size = desc->uniform_buffer_size;
+    _sg.gl.ub.align = (ub_align > 0) ? ub_align : 256;
 }
 
 _SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
     SOKOL_ASSERT(_sg.gl.valid);
+    if (_sg.gl.ub.buf) {
+        glDeleteBuffers(1, &_sg.gl.ub.buf);
+        _sg.gl.ub.buf = 0;
+    }
+    if (_sg.gl.ub.staging) {
+        _sg_free(_sg.gl.ub.staging);
+        _sg.gl.ub.staging = 0;
+    }
+    if (_sg.gl.upload_buf) {
+        glDeleteBuffers(1, &_sg.gl.upload_buf);
+        _sg.gl.upload_buf = 0;
+    }
+    for (int i = 0; i < _SG_MAX_PENDING_UPLOADS; i++) {
+        if (_sg.gl.upload_fences[i]) {
+            glDeleteSync(_sg.gl.upload_fences[i]);
+            _sg.gl.upload_fences[i] = 0;
+        }
+    }
+    #if defined(SOKOL_GLCORE33)
+    if (_sg.gl.timestamp_queries[0]) {
+        glDeleteQueries(_SG_MAX_TIMESTAMP_QUERIES, _sg.gl.timestamp_queries);
+        _sg_clear(_sg.gl.timestamp_queries, sizeof(_sg.gl.timestamp_queries));
+    }
+    #endif
     _sg.gl.valid = false;
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_unload_opengl();
@@ -7729,6 +10165,34 @@ _SOKOL_PRIVATE void _sg_gl_activate_context(_sg_context_t* ctx) {
     _sg_gl_reset_state_cache();
 }
 
+//-- GL backend GPU timestamp queries (GL_TIMESTAMP is not available in GLES3) -
+#if defined(SOKOL_GLCORE33)
+_SOKOL_PRIVATE void _sg_gl_write_timestamp(int query_index) {
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_MAX_TIMESTAMP_QUERIES));
+    if (0 == _sg.gl.timestamp_queries[0]) {
+        glGenQueries(_SG_MAX_TIMESTAMP_QUERIES, _sg.gl.timestamp_queries);
+    }
+    glQueryCounter(_sg.gl.timestamp_queries[query_index], GL_TIMESTAMP);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE bool _sg_gl_timestamp_available(int query_index) {
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_MAX_TIMESTAMP_QUERIES));
+    GLint available = 0;
+    glGetQueryObjectiv(_sg.gl.timestamp_queries[query_index], GL_QUERY_RESULT_AVAILABLE, &available);
+    _SG_GL_CHECK_ERROR();
+    return 0 != available;
+}
+
+_SOKOL_PRIVATE uint64_t _sg_gl_read_timestamp(int query_index) {
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_MAX_TIMESTAMP_QUERIES));
+    GLuint64 ts = 0;
+    glGetQueryObjectui64v(_sg.gl.timestamp_queries[query_index], GL_QUERY_RESULT, &ts);
+    _SG_GL_CHECK_ERROR();
+    return (uint64_t)ts;
+}
+#endif
+
 //-- GL backend resource creation and destruction ------------------------------
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(ctx);
@@ -7740,8 +10204,9 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
     glGenVertexArrays(1, &ctx->vao);
     glBindVertexArray(ctx->vao);
     _SG_GL_CHECK_ERROR();
-    // incoming texture data is generally expected to be packed tightly
+    // incoming and read back texture data is generally expected to be packed tightly
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
     #if defined(SOKOL_GLCORE33)
         // enable seamless cubemap sampling (only desktop GL)
         glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
@@ -7757,10 +10222,29 @@ _SOKOL_PRIVATE void _sg_gl_discard_context(_sg_context_t* ctx) {
     _SG_GL_CHECK_ERROR();
 }
 
+// allocate immutable storage for ring buffers and map it persistently
+_SOKOL_PRIVATE bool _sg_gl_buffer_storage(_sg_buffer_t* buf, GLenum gl_target) {
+    #if defined(_SG_GL_BUFFER_STORAGE)
+        if ((buf->cmn.usage != SG_USAGE_STREAM_RING) || !_sg.gl.ext_buffer_storage) {
+            return false;
+        }
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(gl_target, buf->cmn.size, 0, flags);
+        buf->gl.ring_ptr = (uint8_t*) glMapBufferRange(gl_target, 0, buf->cmn.size, flags);
+        SOKOL_ASSERT(buf->gl.ring_ptr);
+        return true;
+    #else
+        _SOKOL_UNUSED(buf);
+        _SOKOL_UNUSED(gl_target);
+        return false;
+    #endif
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf && desc);
     _SG_GL_CHECK_ERROR();
     buf->gl.injected = (0 != desc->gl_buffers[0]);
+    buf->gl.ring_region = -1;
     const GLenum gl_target = _sg_gl_buffer_target(buf->cmn.type);
     const GLenum gl_usage  = _sg_gl_usage(buf->cmn.usage);
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
@@ -7773,7 +10257,9 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
             SOKOL_ASSERT(gl_buf);
             _sg_gl_cache_store_buffer_binding(gl_target);
             _sg_gl_cache_bind_buffer(gl_target, gl_buf);
-            glBufferData(gl_target, buf->cmn.size, 0, gl_usage);
+            if (!_sg_gl_buffer_storage(buf, gl_target)) {
+                glBufferData(gl_target, buf->cmn.size, 0, gl_usage);
+            }
             if (buf->cmn.usage == SG_USAGE_IMMUTABLE) {
                 SOKOL_ASSERT(desc->data.ptr);
                 glBufferSubData(gl_target, 0, buf->cmn.size, desc->data.ptr);
@@ -7789,6 +10275,12 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
 _SOKOL_PRIVATE void _sg_gl_discard_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
     _SG_GL_CHECK_ERROR();
+    // NOTE: deleting a persistently mapped buffer also unmaps it
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        if (buf->gl.ring_fences[i]) {
+            glDeleteSync(buf->gl.ring_fences[i]);
+        }
+    }
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         if (buf->gl.buf[slot]) {
             _sg_gl_cache_invalidate_buffer(buf->gl.buf[slot]);
@@ -7972,16 +10464,22 @@ _SOKOL_PRIVATE void _sg_gl_discard_sampler(_sg_sampler_t* smp) {
     _SG_GL_CHECK_ERROR();
 }
 
+// starts compiling a GL shader, the compile status is checked in _sg_gl_shader_compiled()
 _SOKOL_PRIVATE GLuint _sg_gl_compile_shader(sg_shader_stage stage, const char* src) {
     SOKOL_ASSERT(src);
     _SG_GL_CHECK_ERROR();
     GLuint gl_shd = glCreateShader(_sg_gl_shader_stage(stage));
     glShaderSource(gl_shd, 1, &src, 0);
     glCompileShader(gl_shd);
+    _SG_GL_CHECK_ERROR();
+    return gl_shd;
+}
+
+_SOKOL_PRIVATE bool _sg_gl_shader_compiled(GLuint gl_shd) {
     GLint compile_status = 0;
     glGetShaderiv(gl_shd, GL_COMPILE_STATUS, &compile_status);
     if (!compile_status) {
-        // compilation failed, log error and delete shader
+        // compilation failed, log error
         GLint log_len = 0;
         glGetShaderiv(gl_shd, GL_INFO_LOG_LENGTH, &log_len);
         if (log_len > 0) {
@@ -7991,36 +10489,51 @@ _SOKOL_PRIVATE GLuint _sg_gl_compile_shader(sg_shader_stage stage, const char* s
             _SG_LOGMSG(GL_SHADER_COMPILATION_FAILED, log_buf);
             _sg_free(log_buf);
         }
-        glDeleteShader(gl_shd);
-        gl_shd = 0;
     }
     _SG_GL_CHECK_ERROR();
-    return gl_shd;
+    return 0 != compile_status;
 }
 
-_SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
-    SOKOL_ASSERT(shd && desc);
-    SOKOL_ASSERT(!shd->gl.prog);
-    _SG_GL_CHECK_ERROR();
-
-    // copy the optional vertex attribute names over
-    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
-        _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
-    }
-
-    GLuint gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
-    GLuint gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
-    if (!(gl_vs && gl_fs)) {
-        return SG_RESOURCESTATE_FAILED;
+// starts compiling and linking a GL program from source code without waiting for the result,
+// for compute shaders the compute shader source is in desc->vs and out_gl_fs will be 0
+_SOKOL_PRIVATE GLuint _sg_gl_start_link_program(const sg_shader_desc* desc, GLuint* out_gl_vs, GLuint* out_gl_fs) {
+    SOKOL_ASSERT(out_gl_vs && out_gl_fs);
+    GLuint gl_vs = 0;
+    GLuint gl_fs = 0;
+    if (_sg_shader_desc_is_compute(desc)) {
+        gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_CS, desc->vs.source);
+    } else {
+        gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
+        gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
     }
     GLuint gl_prog = glCreateProgram();
+    #if defined(_SG_GL_PROGRAM_BINARY)
+    if (_sg_shader_cache_enabled() && _sg.gl.ext_program_binary) {
+        glProgramParameteri(gl_prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    #endif
     glAttachShader(gl_prog, gl_vs);
-    glAttachShader(gl_prog, gl_fs);
+    if (gl_fs) {
+        glAttachShader(gl_prog, gl_fs);
+    }
     glLinkProgram(gl_prog);
-    glDeleteShader(gl_vs);
-    glDeleteShader(gl_fs);
     _SG_GL_CHECK_ERROR();
+    *out_gl_vs = gl_vs;
+    *out_gl_fs = gl_fs;
+    return gl_prog;
+}
 
+// checks the result of _sg_gl_start_link_program(), deletes the program on failure
+_SOKOL_PRIVATE bool _sg_gl_finish_link_program(GLuint gl_prog, GLuint gl_vs, GLuint gl_fs) {
+    // NOTE: both shaders are checked so that all compile errors are logged
+    const bool vs_compiled = _sg_gl_shader_compiled(gl_vs);
+    const bool fs_compiled = (0 == gl_fs) || _sg_gl_shader_compiled(gl_fs);
+    glDeleteShader(gl_vs);
+    glDeleteShader(gl_fs);
+    if (!(vs_compiled && fs_compiled)) {
+        glDeleteProgram(gl_prog);
+        return false;
+    }
     GLint link_status;
     glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
     if (!link_status) {
@@ -8034,11 +10547,117 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             _sg_free(log_buf);
         }
         glDeleteProgram(gl_prog);
-        return SG_RESOURCESTATE_FAILED;
+        return false;
     }
-    shd->gl.prog = gl_prog;
+    return true;
+}
 
-    // resolve uniforms
+// compiles and links a GL program from source code, returns 0 on failure
+_SOKOL_PRIVATE GLuint _sg_gl_link_program(const sg_shader_desc* desc) {
+    GLuint gl_vs = 0;
+    GLuint gl_fs = 0;
+    GLuint gl_prog = _sg_gl_start_link_program(desc, &gl_vs, &gl_fs);
+    if (!_sg_gl_finish_link_program(gl_prog, gl_vs, gl_fs)) {
+        return 0;
+    }
+    return gl_prog;
+}
+
+#if defined(_SG_GL_PROGRAM_BINARY)
+// creates a GL program from a cached program binary, returns 0 if the binary is rejected
+_SOKOL_PRIVATE GLuint _sg_gl_load_program_binary(const sg_shader_binary* bin) {
+    SOKOL_ASSERT(bin && bin->data.ptr && (bin->data.size > 0));
+    _SG_GL_CHECK_ERROR();
+    GLuint gl_prog = glCreateProgram();
+    glProgramBinary(gl_prog, (GLenum)bin->format, bin->data.ptr, (GLsizei)bin->data.size);
+    GLint link_status = 0;
+    glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
+    // an unsupported binary format results in a GL error, which is expected here
+    while (glGetError() != GL_NO_ERROR);
+    if (!link_status) {
+        glDeleteProgram(gl_prog);
+        return 0;
+    }
+    return gl_prog;
+}
+
+_SOKOL_PRIVATE void _sg_gl_store_program_binary(uint64_t key, GLuint gl_prog) {
+    GLint size = 0;
+    glGetProgramiv(gl_prog, GL_PROGRAM_BINARY_LENGTH, &size);
+    _SG_GL_CHECK_ERROR();
+    if (size <= 0) {
+        return;
+    }
+    void* data = _sg_malloc((size_t)size);
+    GLsizei length = 0;
+    GLenum format = 0;
+    glGetProgramBinary(gl_prog, size, &length, &format, data);
+    _SG_GL_CHECK_ERROR();
+    if (length > 0) {
+        const sg_shader_binary bin = { (uint32_t)format, { data, (size_t)length } };
+        _sg_shader_cache_store(key, &bin);
+    }
+    _sg_free(data);
+}
+#endif
+
+_SOKOL_PRIVATE void _sg_gl_clone_str(const char** str, char** buf, size_t* num_bytes) {
+    if (*str) {
+        const size_t len = strlen(*str) + 1;
+        if (*buf) {
+            memcpy(*buf, *str, len);
+            *str = *buf;
+            *buf += len;
+        }
+        *num_bytes += len;
+    }
+}
+
+// counts (buf == 0) or copies the uniform block and image-sampler names of a shader desc into buf
+_SOKOL_PRIVATE size_t _sg_gl_clone_shader_desc_names(sg_shader_desc* desc, char* buf) {
+    size_t num_bytes = 0;
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
+            _sg_gl_clone_str(&ub_desc->glsl_name, &buf, &num_bytes);
+            for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+                _sg_gl_clone_str(&ub_desc->uniforms[u_index].name, &buf, &num_bytes);
+            }
+        }
+        for (int img_smp_index = 0; img_smp_index < SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS; img_smp_index++) {
+            _sg_gl_clone_str(&stage_desc->image_sampler_pairs[img_smp_index].glsl_name, &buf, &num_bytes);
+        }
+    }
+    return num_bytes;
+}
+
+// creates a heap copy of a shader desc which outlives the sg_make_shader() call, must be freed with _sg_free()
+_SOKOL_PRIVATE sg_shader_desc* _sg_gl_clone_shader_desc(const sg_shader_desc* src) {
+    sg_shader_desc tmp = *src;
+    // the shader sources and attribute names are no longer needed when a program is pending
+    tmp.vs.source = 0;
+    tmp.fs.source = 0;
+    tmp.cs.source = 0;
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        tmp.attrs[i].name = 0;
+        tmp.attrs[i].sem_name = 0;
+    }
+    tmp.label = 0;
+    const size_t num_bytes = _sg_gl_clone_shader_desc_names(&tmp, 0);
+    sg_shader_desc* dst = (sg_shader_desc*) _sg_malloc(sizeof(sg_shader_desc) + num_bytes);
+    *dst = tmp;
+    _sg_gl_clone_shader_desc_names(dst, (char*)(dst + 1));
+    return dst;
+}
+
+// resolves uniform locations, uniform block bindings and texture slots of a linked program
+_SOKOL_PRIVATE void _sg_gl_resolve_shader_bindings(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd && desc);
+    const GLuint gl_prog = shd->gl.prog;
+    SOKOL_ASSERT(gl_prog);
+
+    // resolve uniforms
     _SG_GL_CHECK_ERROR();
     for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
         const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
@@ -8070,6 +10689,14 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
                 }
                 ub->num_uniforms++;
             }
+            if (ub_desc->glsl_name) {
+                const GLuint gl_ub_index = glGetUniformBlockIndex(gl_prog, ub_desc->glsl_name);
+                if (gl_ub_index != GL_INVALID_INDEX) {
+                    ub->use_ubo = true;
+                    ub->ubo_binding = (GLuint)(stage_index * SG_MAX_SHADERSTAGE_UBS + ub_index);
+                    glUniformBlockBinding(gl_prog, gl_ub_index, ub->ubo_binding);
+                }
+            }
             if (ub_desc->layout == SG_UNIFORMLAYOUT_STD140) {
                 cur_uniform_offset = _sg_align_u32(cur_uniform_offset, 16);
             }
@@ -8106,12 +10733,95 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
     // it's legal to call glUseProgram with 0
     glUseProgram(cur_prog);
     _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd && desc);
+    SOKOL_ASSERT(!shd->gl.prog);
+    _SG_GL_CHECK_ERROR();
+
+    // copy the optional vertex attribute names over
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
+    }
+
+    GLuint gl_prog = 0;
+    bool use_cache = false;
+    uint64_t cache_key = 0;
+    #if defined(_SG_GL_PROGRAM_BINARY)
+    use_cache = _sg_shader_cache_enabled() && _sg.gl.ext_program_binary;
+    if (use_cache) {
+        cache_key = _sg_shader_cache_key(desc);
+        const sg_shader_binary bin = _sg_shader_cache_load(cache_key);
+        if (bin.data.ptr && (bin.data.size > 0)) {
+            gl_prog = _sg_gl_load_program_binary(&bin);
+        }
+        if (gl_prog) {
+            _sg_stats_add(num_shader_cache_hits, 1);
+        } else {
+            _sg_stats_add(num_shader_cache_misses, 1);
+        }
+    }
+    #endif
+    if (0 == gl_prog) {
+        if (_sg.desc.enable_async_shaders) {
+            // don't wait for the compiler, the program is finished in _sg_gl_poll_shader()
+            shd->gl.prog = _sg_gl_start_link_program(desc, &shd->gl.pending.vs, &shd->gl.pending.fs);
+            shd->gl.pending.store_binary = use_cache;
+            shd->gl.pending.cache_key = cache_key;
+            shd->gl.pending.desc = _sg_gl_clone_shader_desc(desc);
+            return SG_RESOURCESTATE_PENDING;
+        }
+        gl_prog = _sg_gl_link_program(desc);
+        if (0 == gl_prog) {
+            return SG_RESOURCESTATE_FAILED;
+        }
+        #if defined(_SG_GL_PROGRAM_BINARY)
+        if (use_cache) {
+            _sg_gl_store_program_binary(cache_key, gl_prog);
+        }
+        #endif
+    }
+    shd->gl.prog = gl_prog;
+    _sg_gl_resolve_shader_bindings(shd, desc);
     return SG_RESOURCESTATE_VALID;
 }
 
+_SOKOL_PRIVATE sg_resource_state _sg_gl_poll_shader(_sg_shader_t* shd) {
+    SOKOL_ASSERT(shd && shd->gl.prog && shd->gl.pending.desc);
+    if (_sg.gl.ext_parallel_shader_compile) {
+        GLint completed = 0;
+        glGetProgramiv(shd->gl.prog, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) {
+            return SG_RESOURCESTATE_PENDING;
+        }
+    }
+    sg_resource_state state = SG_RESOURCESTATE_FAILED;
+    if (_sg_gl_finish_link_program(shd->gl.prog, shd->gl.pending.vs, shd->gl.pending.fs)) {
+        #if defined(_SG_GL_PROGRAM_BINARY)
+        if (shd->gl.pending.store_binary) {
+            _sg_gl_store_program_binary(shd->gl.pending.cache_key, shd->gl.prog);
+        }
+        #endif
+        _sg_gl_resolve_shader_bindings(shd, shd->gl.pending.desc);
+        state = SG_RESOURCESTATE_VALID;
+    } else {
+        shd->gl.prog = 0;
+    }
+    _sg_free(shd->gl.pending.desc);
+    _sg_clear(&shd->gl.pending, sizeof(shd->gl.pending));
+    return state;
+}
+
 _SOKOL_PRIVATE void _sg_gl_discard_shader(_sg_shader_t* shd) {
     SOKOL_ASSERT(shd);
     _SG_GL_CHECK_ERROR();
+    if (shd->gl.pending.desc) {
+        glDeleteShader(shd->gl.pending.vs);
+        glDeleteShader(shd->gl.pending.fs);
+        _sg_free(shd->gl.pending.desc);
+        _sg_clear(&shd->gl.pending, sizeof(shd->gl.pending));
+    }
     if (shd->gl.prog) {
         _sg_gl_cache_invalidate_program(shd->gl.prog);
         glDeleteProgram(shd->gl.prog);
@@ -8856,6 +11566,20 @@ _SOKOL_PRIVATE bool _sg_gl_apply_bindings(_sg_bindings_t* bnd) {
     }
     _SG_GL_CHECK_ERROR();
 
+    // bind storage buffers, the GLSL binding point is 'stage * SG_MAX_SHADERSTAGE_STORAGEBUFFERS + slot'
+    #if defined(_SG_GL_COMPUTE)
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        _sg_buffer_t** sbufs = (stage_index == SG_SHADERSTAGE_VS) ? bnd->vs_sbufs : bnd->fs_sbufs;
+        const int num_sbufs = (stage_index == SG_SHADERSTAGE_VS) ? bnd->num_vs_sbufs : bnd->num_fs_sbufs;
+        for (int sbuf_index = 0; sbuf_index < num_sbufs; sbuf_index++) {
+            const _sg_buffer_t* sbuf = sbufs[sbuf_index];
+            const GLuint binding = (GLuint)(stage_index * SG_MAX_SHADERSTAGE_STORAGEBUFFERS + sbuf_index);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, sbuf->gl.buf[sbuf->cmn.active_slot]);
+        }
+    }
+    _SG_GL_CHECK_ERROR();
+    #endif
+
     // index buffer (can be 0)
     const GLuint gl_ib = bnd->ib ? bnd->ib->gl.buf[bnd->ib->cmn.active_slot] : 0;
     _sg_gl_cache_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
@@ -8913,6 +11637,54 @@ _SOKOL_PRIVATE bool _sg_gl_apply_bindings(_sg_bindings_t* bnd) {
     return true;
 }
 
+_SOKOL_PRIVATE void _sg_gl_apply_uniform_buffer(GLuint binding, const sg_range* data) {
+    _sg_gl_uniform_buffer_t* ub = &_sg.gl.ub;
+    if (0 == ub->buf) {
+        glGenBuffers(1, &ub->buf);
+        glBindBuffer(GL_UNIFORM_BUFFER, ub->buf);
+        glBufferData(GL_UNIFORM_BUFFER, ub->size, 0, GL_STREAM_DRAW);
+        ub->staging = (uint8_t*) _sg_malloc_clear((size_t)ub->size);
+        _SG_GL_CHECK_ERROR();
+    }
+    // rewind at the start of a new frame, the GL buffer storage will
+    // be orphaned before the first upload
+    if (ub->frame_index != _sg.frame_index) {
+        ub->frame_index = _sg.frame_index;
+        ub->offset = 0;
+        ub->upload_pos = 0;
+        ub->upload_end = 0;
+        ub->orphan = true;
+    }
+    const int size = (int)data->size;
+    if ((ub->offset + size) > ub->size) {
+        _SG_ERROR(GL_UNIFORMBUFFER_OVERFLOW);
+        return;
+    }
+    memcpy(ub->staging + ub->offset, data->ptr, data->size);
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, ub->buf, ub->offset, size);
+    _sg_stats_add(gl.num_bind_uniform_buffer, 1);
+    ub->upload_end = ub->offset + size;
+    ub->offset = _sg_roundup(ub->upload_end, ub->align);
+}
+
+// upload all uniform data written since the last draw call with a single copy
+_SOKOL_PRIVATE void _sg_gl_flush_uniform_buffer(void) {
+    _sg_gl_uniform_buffer_t* ub = &_sg.gl.ub;
+    if (ub->upload_end > ub->upload_pos) {
+        glBindBuffer(GL_UNIFORM_BUFFER, ub->buf);
+        if (ub->orphan) {
+            ub->orphan = false;
+            glBufferData(GL_UNIFORM_BUFFER, ub->size, 0, GL_STREAM_DRAW);
+        }
+        const int num_bytes = ub->upload_end - ub->upload_pos;
+        glBufferSubData(GL_UNIFORM_BUFFER, ub->upload_pos, num_bytes, ub->staging + ub->upload_pos);
+        _sg_stats_add(gl.num_upload_uniform_buffer, 1);
+        _sg_stats_add(gl.size_upload_uniform_buffer, (uint32_t)num_bytes);
+        ub->upload_pos = ub->offset;
+        ub->upload_end = ub->offset;
+    }
+}
+
 _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->slot.id == _sg.gl.cache.cur_pipeline_id.id);
@@ -8921,6 +11693,10 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size == data->size);
     const _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
     const _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    if (gl_ub->use_ubo) {
+        _sg_gl_apply_uniform_buffer(gl_ub->ubo_binding, data);
+        return;
+    }
     for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
         const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
         SOKOL_ASSERT(u->type != SG_UNIFORMTYPE_INVALID);
@@ -8969,6 +11745,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
 
 _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances) {
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
+    _sg_gl_flush_uniform_buffer();
     const GLenum i_type = _sg.gl.cache.cur_index_type;
     const GLenum p_type = _sg.gl.cache.cur_primitive_type;
     if (0 != i_type) {
@@ -8991,6 +11768,80 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
     }
 }
 
+// returns false if the draws need to be issued one by one
+_SOKOL_PRIVATE bool _sg_gl_draw_multi(const sg_draw_args* args, int count) {
+    SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
+    #if defined(_SG_GL_MULTI_DRAW)
+        // there's no instanced variant of glMultiDraw*()
+        if (_sg.gl.cache.cur_pipeline->cmn.use_instanced_draw) {
+            return false;
+        }
+        _sg_gl_flush_uniform_buffer();
+        const GLenum i_type = _sg.gl.cache.cur_index_type;
+        const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+        const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
+        const int ib_offset = _sg.gl.cache.cur_ib_offset;
+        GLsizei counts[_SG_GL_MAX_MULTI_DRAW];
+        GLint firsts[_SG_GL_MAX_MULTI_DRAW];
+        const GLvoid* indices[_SG_GL_MAX_MULTI_DRAW];
+        int i = 0;
+        while (i < count) {
+            GLsizei n = 0;
+            for (; (i < count) && (n < _SG_GL_MAX_MULTI_DRAW); i++) {
+                if (_sg_draw_args_drawable(&args[i])) {
+                    counts[n] = args[i].num_elements;
+                    firsts[n] = args[i].base_element;
+                    indices[n] = (const GLvoid*)(GLintptr)(args[i].base_element*i_size+ib_offset);
+                    n++;
+                }
+            }
+            if (n > 0) {
+                if (0 != i_type) {
+                    glMultiDrawElements(p_type, counts, i_type, indices, n);
+                } else {
+                    glMultiDrawArrays(p_type, firsts, counts, n);
+                }
+            }
+        }
+        return true;
+    #else
+        _SOKOL_UNUSED(args);
+        _SOKOL_UNUSED(count);
+        return false;
+    #endif
+}
+
+// returns false if the draws need to be issued from the CPU-side buffer copy
+_SOKOL_PRIVATE bool _sg_gl_draw_indirect(_sg_buffer_t* buf, int offset, int count) {
+    SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
+    SOKOL_ASSERT(buf && (buf->cmn.type == SG_BUFFERTYPE_INDIRECTBUFFER));
+    #if defined(_SG_GL_MULTI_DRAW_INDIRECT)
+        // the index buffer offset can't be applied to indirect draw arguments
+        if (!_sg.features.draw_indirect || (0 != _sg.gl.cache.cur_ib_offset)) {
+            return false;
+        }
+        _sg_gl_flush_uniform_buffer();
+        const GLenum i_type = _sg.gl.cache.cur_index_type;
+        const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+        const GLvoid* indirect = (const GLvoid*)(GLintptr)offset;
+        const GLsizei stride = (GLsizei)sizeof(sg_draw_indirect_args);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buf->gl.buf[buf->cmn.active_slot]);
+        if (0 != i_type) {
+            glMultiDrawElementsIndirect(p_type, i_type, indirect, count, stride);
+        } else {
+            glMultiDrawArraysIndirect(p_type, indirect, count, stride);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        _SG_GL_CHECK_ERROR();
+        return true;
+    #else
+        _SOKOL_UNUSED(buf);
+        _SOKOL_UNUSED(offset);
+        _SOKOL_UNUSED(count);
+        return false;
+    #endif
+}
+
 _SOKOL_PRIVATE void _sg_gl_commit(void) {
     SOKOL_ASSERT(!_sg.gl.in_pass);
     // "soft" clear bindings (only those that are actually bound)
@@ -9035,6 +11886,292 @@ _SOKOL_PRIVATE void _sg_gl_append_buffer(_sg_buffer_t* buf, const sg_range* data
     _SG_GL_CHECK_ERROR();
 }
 
+_SOKOL_PRIVATE void* _sg_gl_map_buffer(_sg_buffer_t* buf, int offset, int size, bool new_frame) {
+    SOKOL_ASSERT(buf && (size > 0));
+    _SOKOL_UNUSED(size);
+    if (0 == buf->gl.ring_ptr) {
+        // not persistently mapped, writes go into CPU-side staging memory
+        return 0;
+    }
+    if (new_frame) {
+        const int region = offset / _sg_ring_region_size(buf->cmn.size);
+        SOKOL_ASSERT((region >= 0) && (region < SG_NUM_INFLIGHT_FRAMES));
+        // fence the frame region which was written last...
+        if (buf->gl.ring_region >= 0) {
+            GLsync* last_fence = &buf->gl.ring_fences[buf->gl.ring_region];
+            if (*last_fence) {
+                glDeleteSync(*last_fence);
+            }
+            *last_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        // ...and wait until the GPU is done reading the new frame region
+        GLsync* fence = &buf->gl.ring_fences[region];
+        if (*fence) {
+            GLenum res;
+            do {
+                res = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            } while (res == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(*fence);
+            *fence = 0;
+        }
+        buf->gl.ring_region = region;
+        _SG_GL_CHECK_ERROR();
+    }
+    return buf->gl.ring_ptr + offset;
+}
+
+_SOKOL_PRIVATE void _sg_gl_unmap_buffer(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && (data->size > 0));
+    // persistently mapped memory is coherent, only staged data needs to be copied
+    if (data->ptr) {
+        GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
+        GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
+        SOKOL_ASSERT(gl_buf);
+        _SG_GL_CHECK_ERROR();
+        _sg_gl_cache_store_buffer_binding(gl_tgt);
+        _sg_gl_cache_bind_buffer(gl_tgt, gl_buf);
+        glBufferSubData(gl_tgt, offset, (GLsizeiptr)data->size, data->ptr);
+        _sg_gl_cache_restore_buffer_binding(gl_tgt);
+        _SG_GL_CHECK_ERROR();
+    }
+}
+
+_SOKOL_PRIVATE void* _sg_gl_map_upload_buffer(int offset, int size) {
+    SOKOL_ASSERT((offset >= 0) && (size > 0));
+    _SG_GL_CHECK_ERROR();
+    if (0 == _sg.gl.upload_buf) {
+        glGenBuffers(1, &_sg.gl.upload_buf);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.upload_buf);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, _sg.upload.size, 0, GL_STREAM_DRAW);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        _SG_GL_CHECK_ERROR();
+    }
+    #if defined(__EMSCRIPTEN__)
+        // WebGL2 can't map buffers, writes go into CPU-side staging memory
+        _SOKOL_UNUSED(offset);
+        _SOKOL_UNUSED(size);
+        return 0;
+    #else
+        // the range isn't used by any pending upload, so no need to synchronize with the GPU
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.upload_buf);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        void* ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, size, flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        _SG_GL_CHECK_ERROR();
+        return ptr;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_gl_unmap_upload_buffer(_sg_image_t* img, int face, int mip_level, int offset, const sg_range* data, int queue_index) {
+    SOKOL_ASSERT(_sg.gl.upload_buf);
+    SOKOL_ASSERT(data && (data->size > 0));
+    _SG_GL_CHECK_ERROR();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.upload_buf);
+    if (data->ptr) {
+        // data was written into staging memory
+        glBufferSubData(GL_PIXEL_UNPACK_BUFFER, offset, (GLsizeiptr)data->size, data->ptr);
+    } else {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    if (img) {
+        SOKOL_ASSERT((queue_index >= 0) && (queue_index < _SG_MAX_PENDING_UPLOADS));
+        SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+        _sg_gl_cache_store_texture_sampler_binding(0);
+        _sg_gl_cache_bind_texture_sampler(0, img->gl.target, img->gl.tex[img->cmn.active_slot], 0);
+        const GLenum gl_img_format = _sg_gl_teximage_format(img->cmn.pixel_format);
+        const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
+        const GLenum gl_img_target = (SG_IMAGETYPE_CUBE == img->cmn.type) ? _sg_gl_cubeface_target(face) : img->gl.target;
+        // with a bound pixel unpack buffer, the data pointer is an offset into the buffer
+        const GLvoid* data_offset = (const GLvoid*)(GLintptr)offset;
+        const int mip_width = _sg_miplevel_dim(img->cmn.width, mip_level);
+        const int mip_height = _sg_miplevel_dim(img->cmn.height, mip_level);
+        if ((SG_IMAGETYPE_2D == img->cmn.type) || (SG_IMAGETYPE_CUBE == img->cmn.type)) {
+            glTexSubImage2D(gl_img_target, mip_level, 0, 0, mip_width, mip_height, gl_img_format, gl_img_type, data_offset);
+        } else {
+            int mip_depth = img->cmn.num_slices;
+            if (SG_IMAGETYPE_3D == img->cmn.type) {
+                mip_depth = _sg_miplevel_dim(img->cmn.num_slices, mip_level);
+            }
+            glTexSubImage3D(gl_img_target, mip_level, 0, 0, 0, mip_width, mip_height, mip_depth, gl_img_format, gl_img_type, data_offset);
+        }
+        _sg_gl_cache_restore_texture_sampler_binding(0);
+        GLsync* fence = &_sg.gl.upload_fences[queue_index];
+        if (*fence) {
+            glDeleteSync(*fence);
+        }
+        *fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE bool _sg_gl_query_upload_done(int queue_index) {
+    SOKOL_ASSERT((queue_index >= 0) && (queue_index < _SG_MAX_PENDING_UPLOADS));
+    GLsync* fence = &_sg.gl.upload_fences[queue_index];
+    if (0 == *fence) {
+        return true;
+    }
+    // don't wait, only check the fence status
+    const GLenum res = glClientWaitSync(*fence, 0, 0);
+    if ((res == GL_ALREADY_SIGNALED) || (res == GL_CONDITION_SATISFIED)) {
+        glDeleteSync(*fence);
+        *fence = 0;
+        return true;
+    }
+    return false;
+}
+
+_SOKOL_PRIVATE void _sg_gl_generate_mipmaps(_sg_image_t* img) {
+    SOKOL_ASSERT(img && (img->cmn.num_mipmaps > 1));
+    SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+    _SG_GL_CHECK_ERROR();
+    _sg_gl_cache_store_texture_sampler_binding(0);
+    _sg_gl_cache_bind_texture_sampler(0, img->gl.target, img->gl.tex[img->cmn.active_slot], 0);
+    glGenerateMipmap(img->gl.target);
+    _sg_gl_cache_restore_texture_sampler_binding(0);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    #if defined(_SG_GL_COMPUTE)
+    _sg_gl_flush_uniform_buffer();
+    _SG_GL_CHECK_ERROR();
+    glDispatchCompute((GLuint)num_groups_x, (GLuint)num_groups_y, (GLuint)num_groups_z);
+    // make storage buffer writes visible to following dispatches, draws and buffer updates
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    _SG_GL_CHECK_ERROR();
+    #else
+    // sg_features.compute is false when compute shaders can't be used
+    _SOKOL_UNUSED(num_groups_x);
+    _SOKOL_UNUSED(num_groups_y);
+    _SOKOL_UNUSED(num_groups_z);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+// binds the framebuffer to read pixels from, for render target images this is a
+// temporary framebuffer which must be deleted with _sg_gl_end_read_pixels()
+_SOKOL_PRIVATE GLuint _sg_gl_begin_read_pixels(_sg_image_t* img) {
+    SOKOL_ASSERT(_sg.gl.cur_context);
+    GLuint gl_fb = 0;
+    if (img) {
+        SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+        glGenFramebuffers(1, &gl_fb);
+        glBindFramebuffer(GL_FRAMEBUFFER, gl_fb);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, img->gl.tex[img->cmn.active_slot], 0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, _sg.gl.cur_context->default_framebuffer);
+    }
+    return gl_fb;
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_read_pixels(GLuint gl_fb) {
+    glBindFramebuffer(GL_FRAMEBUFFER, _sg.gl.cur_context->default_framebuffer);
+    if (gl_fb) {
+        glDeleteFramebuffers(1, &gl_fb);
+    }
+}
+
+// with a bound pixel pack buffer, ptr is an offset into the buffer
+_SOKOL_PRIVATE void _sg_gl_read_pixels(_sg_image_t* img, const sg_read_result* res, void* ptr) {
+    const GLenum gl_format = _sg_gl_teximage_format(res->pixel_format);
+    const GLenum gl_type = _sg_gl_teximage_type(res->pixel_format);
+    const GLuint gl_fb = _sg_gl_begin_read_pixels(img);
+    glReadPixels(res->x, res->y, res->width, res->height, gl_format, gl_type, ptr);
+    _sg_gl_end_read_pixels(gl_fb);
+}
+
+_SOKOL_PRIVATE void _sg_gl_read_image(_sg_image_t* img, const sg_read_result* res, void* ptr) {
+    SOKOL_ASSERT(res && ptr && (res->data.size > 0));
+    _SG_GL_CHECK_ERROR();
+    _sg_gl_read_pixels(img, res, ptr);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_start_read(_sg_image_t* img, const sg_read_result* res, int read_index) {
+    SOKOL_ASSERT(res && (res->data.size > 0));
+    SOKOL_ASSERT((read_index >= 0) && (read_index < _SG_MAX_PENDING_READS));
+    _SG_GL_CHECK_ERROR();
+    #if defined(__EMSCRIPTEN__)
+        // WebGL2 can't map buffers, read synchronously into CPU memory
+        SOKOL_ASSERT(0 == _sg.gl.read_data[read_index]);
+        _sg.gl.read_data[read_index] = (uint8_t*) _sg_malloc(res->data.size);
+        _sg_gl_read_pixels(img, res, _sg.gl.read_data[read_index]);
+    #else
+        GLuint* gl_buf = &_sg.gl.read_bufs[read_index];
+        SOKOL_ASSERT(0 == *gl_buf);
+        glGenBuffers(1, gl_buf);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, *gl_buf);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)res->data.size, 0, GL_STREAM_READ);
+        _sg_gl_read_pixels(img, res, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        SOKOL_ASSERT(0 == _sg.gl.read_fences[read_index]);
+        _sg.gl.read_fences[read_index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    #endif
+    _SG_GL_CHECK_ERROR();
+}
+
+// returns a null pointer while the GPU hasn't finished writing the pixel data,
+// or with out_failed set to true if the pixel data couldn't be mapped
+_SOKOL_PRIVATE const void* _sg_gl_map_read(int read_index, int size, bool* out_failed) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < _SG_MAX_PENDING_READS));
+    SOKOL_ASSERT(out_failed);
+    #if defined(__EMSCRIPTEN__)
+        _SOKOL_UNUSED(size);
+        _SOKOL_UNUSED(out_failed);
+        return _sg.gl.read_data[read_index];
+    #else
+        SOKOL_ASSERT(_sg.gl.read_bufs[read_index] && !_sg.gl.read_mapped[read_index]);
+        GLsync* fence = &_sg.gl.read_fences[read_index];
+        if (*fence) {
+            // don't wait, only check the fence status
+            const GLenum res = glClientWaitSync(*fence, 0, 0);
+            if ((res != GL_ALREADY_SIGNALED) && (res != GL_CONDITION_SATISFIED)) {
+                return 0;
+            }
+            glDeleteSync(*fence);
+            *fence = 0;
+        }
+        _SG_GL_CHECK_ERROR();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _sg.gl.read_bufs[read_index]);
+        void* ptr = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        _sg.gl.read_mapped[read_index] = (0 != ptr);
+        if (0 == ptr) {
+            // the fence has been signalled, so mapping won't succeed on a later try either
+            *out_failed = true;
+            while (glGetError() != GL_NO_ERROR);
+        }
+        _SG_GL_CHECK_ERROR();
+        return ptr;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_read(int read_index) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < _SG_MAX_PENDING_READS));
+    _SG_GL_CHECK_ERROR();
+    if (_sg.gl.read_bufs[read_index]) {
+        if (_sg.gl.read_mapped[read_index]) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, _sg.gl.read_bufs[read_index]);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            _sg.gl.read_mapped[read_index] = false;
+        }
+        glDeleteBuffers(1, &_sg.gl.read_bufs[read_index]);
+        _sg.gl.read_bufs[read_index] = 0;
+    }
+    if (_sg.gl.read_fences[read_index]) {
+        glDeleteSync(_sg.gl.read_fences[read_index]);
+        _sg.gl.read_fences[read_index] = 0;
+    }
+    if (_sg.gl.read_data[read_index]) {
+        _sg_free(_sg.gl.read_data[read_index]);
+        _sg.gl.read_data[read_index] = 0;
+    }
+    _SG_GL_CHECK_ERROR();
+}
+
 _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     // only one update per image per frame allowed
@@ -9479,6 +12616,9 @@ _SOKOL_PRIVATE D3D11_USAGE _sg_d3d11_usage(sg_usage usg) {
         case SG_USAGE_DYNAMIC:
         case SG_USAGE_STREAM:
             return D3D11_USAGE_DYNAMIC;
+        case SG_USAGE_STREAM_RING:
+            // written with UpdateSubresource() from CPU-side staging memory
+            return D3D11_USAGE_DEFAULT;
         default:
             SOKOL_UNREACHABLE;
             return (D3D11_USAGE) 0;
@@ -9488,6 +12628,7 @@ _SOKOL_PRIVATE D3D11_USAGE _sg_d3d11_usage(sg_usage usg) {
 _SOKOL_PRIVATE UINT _sg_d3d11_cpu_access_flags(sg_usage usg) {
     switch (usg) {
         case SG_USAGE_IMMUTABLE:
+        case SG_USAGE_STREAM_RING:
             return 0;
         case SG_USAGE_DYNAMIC:
         case SG_USAGE_STREAM:
@@ -9878,7 +13019,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_buffer(_sg_buffer_t* buf, cons
         _sg_clear(&d3d11_desc, sizeof(d3d11_desc));
         d3d11_desc.ByteWidth = (UINT)buf->cmn.size;
         d3d11_desc.Usage = _sg_d3d11_usage(buf->cmn.usage);
-        d3d11_desc.BindFlags = buf->cmn.type == SG_BUFFERTYPE_VERTEXBUFFER ? D3D11_BIND_VERTEX_BUFFER : D3D11_BIND_INDEX_BUFFER;
+        // NOTE: indirect buffers are only read through the CPU-side copy in sg_draw_indirect()
+        d3d11_desc.BindFlags = buf->cmn.type == SG_BUFFERTYPE_INDEXBUFFER ? D3D11_BIND_INDEX_BUFFER : D3D11_BIND_VERTEX_BUFFER;
         d3d11_desc.CPUAccessFlags = _sg_d3d11_cpu_access_flags(buf->cmn.usage);
         D3D11_SUBRESOURCE_DATA* init_data_ptr = 0;
         D3D11_SUBRESOURCE_DATA init_data;
@@ -10916,6 +14058,29 @@ _SOKOL_PRIVATE void _sg_d3d11_append_buffer(_sg_buffer_t* buf, const sg_range* d
     }
 }
 
+_SOKOL_PRIVATE void* _sg_d3d11_map_buffer(_sg_buffer_t* buf, int offset, int size, bool new_frame) {
+    SOKOL_ASSERT(buf && (size > 0));
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(size);
+    _SOKOL_UNUSED(new_frame);
+    // writes go into CPU-side staging memory
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_d3d11_unmap_buffer(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
+    SOKOL_ASSERT(_sg.d3d11.ctx);
+    SOKOL_ASSERT(buf->d3d11.buf);
+    D3D11_BOX box;
+    _sg_clear(&box, sizeof(box));
+    box.left = (UINT)offset;
+    box.right = (UINT)offset + (UINT)data->size;
+    box.bottom = 1;
+    box.back = 1;
+    _sg_d3d11_UpdateSubresource(_sg.d3d11.ctx, (ID3D11Resource*)buf->d3d11.buf, 0, &box, data->ptr, 0, 0);
+}
+
 _SOKOL_PRIVATE void _sg_d3d11_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     SOKOL_ASSERT(_sg.d3d11.ctx);
@@ -11028,6 +14193,7 @@ _SOKOL_PRIVATE MTLResourceOptions _sg_mtl_buffer_resource_options(sg_usage usg)
             return _sg_mtl_resource_options_storage_mode_managed_or_shared();
         case SG_USAGE_DYNAMIC:
         case SG_USAGE_STREAM:
+        case SG_USAGE_STREAM_RING:
             return MTLResourceCPUCacheModeWriteCombined | _sg_mtl_resource_options_storage_mode_managed_or_shared();
         default:
             SOKOL_UNREACHABLE;
@@ -11377,8 +14543,43 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_pool(void) {
     _SG_OBJC_RELEASE(_sg.mtl.idpool.pool);
 }
 
+// double the number of slots when all are in use, this may happen with growable resource pools
+_SOKOL_PRIVATE void _sg_mtl_grow_pool(void) {
+    _sg_mtl_idpool_t* p = &_sg.mtl.idpool;
+    SOKOL_ASSERT(0 == p->free_queue_top);
+    const int old_num_slots = p->num_slots;
+    const int new_num_slots = 2 * old_num_slots;
+    NSNull* null = [NSNull null];
+    for (int i = old_num_slots; i < new_num_slots; i++) {
+        [p->pool addObject:null];
+    }
+    _sg_free(p->free_queue);
+    p->free_queue = (int*)_sg_malloc_clear((size_t)new_num_slots * sizeof(int));
+    for (int i = new_num_slots-1; i >= old_num_slots; i--) {
+        p->free_queue[p->free_queue_top++] = i;
+    }
+    // copy the circular release queue in order to the start of the new queue
+    _sg_mtl_release_item_t* release_queue = (_sg_mtl_release_item_t*)_sg_malloc_clear((size_t)new_num_slots * sizeof(_sg_mtl_release_item_t));
+    int num_items = 0;
+    for (int i = p->release_queue_back; i != p->release_queue_front; i = (i + 1) % old_num_slots) {
+        release_queue[num_items++] = p->release_queue[i];
+    }
+    for (int i = num_items; i < new_num_slots; i++) {
+        release_queue[i].frame_index = 0;
+        release_queue[i].slot_index = _SG_MTL_INVALID_SLOT_INDEX;
+    }
+    _sg_free(p->release_queue);
+    p->release_queue = release_queue;
+    p->release_queue_back = 0;
+    p->release_queue_front = num_items;
+    p->num_slots = new_num_slots;
+}
+
 // get a new free resource pool slot
 _SOKOL_PRIVATE int _sg_mtl_alloc_pool_slot(void) {
+    if (0 == _sg.mtl.idpool.free_queue_top) {
+        _sg_mtl_grow_pool();
+    }
     SOKOL_ASSERT(_sg.mtl.idpool.free_queue_top > 0);
     const int slot_index = _sg.mtl.idpool.free_queue[--_sg.mtl.idpool.free_queue_top];
     SOKOL_ASSERT((slot_index > 0) && (slot_index < _sg.mtl.idpool.num_slots));
@@ -11480,6 +14681,7 @@ _SOKOL_PRIVATE void _sg_mtl_init_caps(void) {
     _sg.features.origin_top_left = true;
     _sg.features.mrt_independent_blend_state = true;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.generate_mipmaps = true;
 
     _sg.features.image_clamp_to_border = false;
     #if (MAC_OS_X_VERSION_MAX_ALLOWED >= 120000) || (__IPHONE_OS_VERSION_MAX_ALLOWED >= 140000)
@@ -12276,28 +15478,19 @@ _SOKOL_PRIVATE _sg_image_t* _sg_mtl_pass_ds_image(const _sg_pass_t* pass) {
     return pass->mtl.ds_att.image;
 }
 
-_SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
-    SOKOL_ASSERT(action);
-    SOKOL_ASSERT(!_sg.mtl.in_pass);
-    SOKOL_ASSERT(_sg.mtl.cmd_queue);
-    SOKOL_ASSERT(nil == _sg.mtl.cmd_encoder);
-    SOKOL_ASSERT(_sg.mtl.renderpass_descriptor_cb || _sg.mtl.renderpass_descriptor_userdata_cb);
-    _sg.mtl.in_pass = true;
-    _sg.mtl.cur_width = w;
-    _sg.mtl.cur_height = h;
-    _sg_mtl_clear_state_cache();
-
-    /*
-        if this is the first pass in the frame, create command buffers
+/*
+    if this is the first pass (or mipmap generation) in the frame, create the command buffer
 
-        NOTE: we're creating two command buffers here, one with unretained references
-        for storing the regular commands, and one with retained references for
-        storing the presentDrawable call (this needs to hold on the drawable until
-        presentation has happened - and the easiest way to do this is to let the
-        command buffer manage the lifetime of the drawable).
+    NOTE: we're creating two command buffers here, one with unretained references
+    for storing the regular commands, and one with retained references for
+    storing the presentDrawable call (this needs to hold on the drawable until
+    presentation has happened - and the easiest way to do this is to let the
+    command buffer manage the lifetime of the drawable).
 
-        Also see: https://github.com/floooh/sokol/issues/762
-    */
+    Also see: https://github.com/floooh/sokol/issues/762
+*/
+_SOKOL_PRIVATE void _sg_mtl_begin_cmd_buffer(void) {
+    SOKOL_ASSERT(_sg.mtl.cmd_queue);
     if (nil == _sg.mtl.cmd_buffer) {
         // block until the oldest frame in flight has finished
         dispatch_semaphore_wait(_sg.mtl.sem, DISPATCH_TIME_FOREVER);
@@ -12309,6 +15502,29 @@ _SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* a
             dispatch_semaphore_signal(_sg.mtl.sem);
         }];
     }
+}
+
+_SOKOL_PRIVATE void _sg_mtl_generate_mipmaps(_sg_image_t* img) {
+    SOKOL_ASSERT(img && (img->cmn.num_mipmaps > 1));
+    SOKOL_ASSERT(!_sg.mtl.in_pass);
+    _sg_mtl_begin_cmd_buffer();
+    id<MTLBlitCommandEncoder> blit_encoder = [_sg.mtl.cmd_buffer blitCommandEncoder];
+    [blit_encoder generateMipmapsForTexture:_sg_mtl_id(img->mtl.tex[img->cmn.active_slot])];
+    [blit_encoder endEncoding];
+    // NOTE: MTLBlitCommandEncoder is autoreleased
+}
+
+_SOKOL_PRIVATE void _sg_mtl_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+    SOKOL_ASSERT(action);
+    SOKOL_ASSERT(!_sg.mtl.in_pass);
+    SOKOL_ASSERT(_sg.mtl.cmd_queue);
+    SOKOL_ASSERT(nil == _sg.mtl.cmd_encoder);
+    SOKOL_ASSERT(_sg.mtl.renderpass_descriptor_cb || _sg.mtl.renderpass_descriptor_userdata_cb);
+    _sg.mtl.in_pass = true;
+    _sg.mtl.cur_width = w;
+    _sg.mtl.cur_height = h;
+    _sg_mtl_clear_state_cache();
+    _sg_mtl_begin_cmd_buffer();
 
     // if this is first pass in frame, get uniform buffer base pointer
     if (0 == _sg.mtl.cur_ub_base_ptr) {
@@ -12729,11 +15945,34 @@ _SOKOL_PRIVATE void _sg_mtl_append_buffer(_sg_buffer_t* buf, const sg_range* dat
     #endif
 }
 
-_SOKOL_PRIVATE void _sg_mtl_update_image(_sg_image_t* img, const sg_image_data* data) {
-    SOKOL_ASSERT(img && data);
-    if (++img->cmn.active_slot >= img->cmn.num_slots) {
-        img->cmn.active_slot = 0;
-    }
+_SOKOL_PRIVATE void* _sg_mtl_map_buffer(_sg_buffer_t* buf, int offset, int size, bool new_frame) {
+    SOKOL_ASSERT(buf && (size > 0));
+    _SOKOL_UNUSED(size);
+    _SOKOL_UNUSED(new_frame);
+    __unsafe_unretained id<MTLBuffer> mtl_buf = _sg_mtl_id(buf->mtl.buf[buf->cmn.active_slot]);
+    return ((uint8_t*) [mtl_buf contents]) + offset;
+}
+
+_SOKOL_PRIVATE void _sg_mtl_unmap_buffer(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && (data->size > 0));
+    SOKOL_ASSERT(0 == data->ptr);
+    #if defined(_SG_TARGET_MACOS)
+    if (_sg_mtl_resource_options_storage_mode_managed_or_shared() == MTLStorageModeManaged) {
+        __unsafe_unretained id<MTLBuffer> mtl_buf = _sg_mtl_id(buf->mtl.buf[buf->cmn.active_slot]);
+        [mtl_buf didModifyRange:NSMakeRange((NSUInteger)offset, (NSUInteger)data->size)];
+    }
+    #else
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(data);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_mtl_update_image(_sg_image_t* img, const sg_image_data* data) {
+    SOKOL_ASSERT(img && data);
+    if (++img->cmn.active_slot >= img->cmn.num_slots) {
+        img->cmn.active_slot = 0;
+    }
     __unsafe_unretained id<MTLTexture> mtl_tex = _sg_mtl_id(img->mtl.tex[img->cmn.active_slot]);
     _sg_mtl_copy_image_data(img, mtl_tex, data);
 }
@@ -12765,8 +16004,10 @@ _SOKOL_PRIVATE WGPUBufferUsageFlags _sg_wgpu_buffer_usage(sg_buffer_type t, sg_u
     WGPUBufferUsageFlags res = 0;
     if (SG_BUFFERTYPE_VERTEXBUFFER == t) {
         res |= WGPUBufferUsage_Vertex;
-    } else {
+    } else if (SG_BUFFERTYPE_INDEXBUFFER == t) {
         res |= WGPUBufferUsage_Index;
+    } else {
+        res |= WGPUBufferUsage_Indirect;
     }
     if (SG_USAGE_IMMUTABLE != u) {
         res |= WGPUBufferUsage_CopyDst;
@@ -13395,44 +16636,6 @@ _SOKOL_PRIVATE void _sg_wgpu_reset_bindgroup_to_alloc_state(_sg_wgpu_bindgroup_t
     bg->slot.state = SG_RESOURCESTATE_ALLOC;
 }
 
-// MurmurHash64B (see: https://github.com/aappleby/smhasher/blob/61a0530f28277f2e850bfc39600ce61d02b518de/src/MurmurHash2.cpp#L142)
-_SOKOL_PRIVATE uint64_t _sg_wgpu_hash(const void* key, int len, uint64_t seed) {
-    const uint32_t m = 0x5bd1e995;
-    const int r = 24;
-    uint32_t h1 = (uint32_t)seed ^ (uint32_t)len;
-    uint32_t h2 = (uint32_t)(seed >> 32);
-    const uint32_t * data = (const uint32_t *)key;
-    while (len >= 8) {
-        uint32_t k1 = *data++;
-        k1 *= m; k1 ^= k1 >> r; k1 *= m;
-        h1 *= m; h1 ^= k1;
-        len -= 4;
-        uint32_t k2 = *data++;
-        k2 *= m; k2 ^= k2 >> r; k2 *= m;
-        h2 *= m; h2 ^= k2;
-        len -= 4;
-    }
-    if (len >= 4) {
-        uint32_t k1 = *data++;
-        k1 *= m; k1 ^= k1 >> r; k1 *= m;
-        h1 *= m; h1 ^= k1;
-        len -= 4;
-    }
-    switch(len) {
-        case 3: h2 ^= (uint32_t)(((unsigned char*)data)[2] << 16);
-        case 2: h2 ^= (uint32_t)(((unsigned char*)data)[1] << 8);
-        case 1: h2 ^= ((unsigned char*)data)[0];
-        h2 *= m;
-    };
-    h1 ^= h2 >> 18; h1 *= m;
-    h2 ^= h1 >> 22; h2 *= m;
-    h1 ^= h2 >> 17; h1 *= m;
-    h2 ^= h1 >> 19; h2 *= m;
-    uint64_t h = h1;
-    h = (h << 32) | h2;
-    return h;
-}
-
 _SOKOL_PRIVATE void _sg_wgpu_init_bindgroups_cache_key(_sg_wgpu_bindgroups_cache_key_t* key, const _sg_bindings_t* bnd) {
     SOKOL_ASSERT(bnd);
     SOKOL_ASSERT(bnd->pip);
@@ -13464,7 +16667,7 @@ _SOKOL_PRIVATE void _sg_wgpu_init_bindgroups_cache_key(_sg_wgpu_bindgroups_cache
         SOKOL_ASSERT(bnd->fs_smps[i]);
         key->items[fs_smps_offset + i] = bnd->fs_smps[i]->slot.id;
     }
-    key->hash = _sg_wgpu_hash(&key->items, (int)sizeof(key->items), 0x1234567887654321);
+    key->hash = _sg_hash(&key->items, (int)sizeof(key->items), 0x1234567887654321);
 }
 
 _SOKOL_PRIVATE bool _sg_wgpu_compare_bindgroups_cache_key(_sg_wgpu_bindgroups_cache_key_t* k0, _sg_wgpu_bindgroups_cache_key_t* k1) {
@@ -14624,6 +17827,21 @@ _SOKOL_PRIVATE void _sg_wgpu_append_buffer(_sg_buffer_t* buf, const sg_range* da
     _sg_wgpu_copy_buffer_data(buf, (uint64_t)buf->cmn.append_pos, data);
 }
 
+_SOKOL_PRIVATE void* _sg_wgpu_map_buffer(_sg_buffer_t* buf, int offset, int size, bool new_frame) {
+    SOKOL_ASSERT(buf && (size > 0));
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(size);
+    _SOKOL_UNUSED(new_frame);
+    // writes go into CPU-side staging memory
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_unmap_buffer(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
+    _sg_wgpu_copy_buffer_data(buf, (uint64_t)offset, data);
+}
+
 _SOKOL_PRIVATE void _sg_wgpu_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     _sg_wgpu_copy_image_data(img, img->wgpu.tex, data);
@@ -14845,6 +18063,18 @@ static inline sg_resource_state _sg_create_shader(_sg_shader_t* shd, const sg_sh
     #endif
 }
 
+static inline sg_resource_state _sg_poll_shader(_sg_shader_t* shd) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_poll_shader(shd);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_poll_shader(shd);
+    #else
+    // only the GL and dummy backends create pending shaders
+    SOKOL_UNREACHABLE;
+    return shd->slot.state;
+    #endif
+}
+
 static inline void _sg_discard_shader(_sg_shader_t* shd) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_discard_shader(shd);
@@ -15101,6 +18331,37 @@ static inline void _sg_draw(int base_element, int num_elements, int num_instance
     #endif
 }
 
+static inline void _sg_draw_multi(const sg_draw_args* args, int count) {
+    #if defined(_SOKOL_ANY_GL)
+    if (_sg_gl_draw_multi(args, count)) {
+        return;
+    }
+    #endif
+    // fallback: loop over the per-backend draw function
+    for (int i = 0; i < count; i++) {
+        if (_sg_draw_args_drawable(&args[i])) {
+            _sg_draw(args[i].base_element, args[i].num_elements, args[i].num_instances);
+        }
+    }
+}
+
+static inline void _sg_draw_indirect(_sg_buffer_t* buf, int offset, int count) {
+    #if defined(_SOKOL_ANY_GL)
+    if (_sg_gl_draw_indirect(buf, offset, count)) {
+        return;
+    }
+    #endif
+    // fallback: loop over the per-backend draw function with the CPU-side buffer copy,
+    // items with a non-zero base_vertex or base_instance can't be emulated and are skipped
+    SOKOL_ASSERT(buf->cmn.indirect_data);
+    const sg_draw_indirect_args* args = (const sg_draw_indirect_args*) (buf->cmn.indirect_data + offset);
+    for (int i = 0; i < count; i++) {
+        if ((args[i].num_elements > 0) && (args[i].num_instances > 0) && (0 == args[i].base_vertex) && (0 == args[i].base_instance)) {
+            _sg_draw((int)args[i].base_element, (int)args[i].num_elements, (int)args[i].num_instances);
+        }
+    }
+}
+
 static inline void _sg_commit(void) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_commit();
@@ -15149,6 +18410,165 @@ static inline void _sg_append_buffer(_sg_buffer_t* buf, const sg_range* data, bo
     #endif
 }
 
+static inline void* _sg_map_buffer(_sg_buffer_t* buf, int offset, int size, bool new_frame) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_map_buffer(buf, offset, size, new_frame);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_map_buffer(buf, offset, size, new_frame);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_map_buffer(buf, offset, size, new_frame);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_map_buffer(buf, offset, size, new_frame);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_map_buffer(buf, offset, size, new_frame);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_unmap_buffer(_sg_buffer_t* buf, int offset, const sg_range* data) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_unmap_buffer(buf, offset, data);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_unmap_buffer(buf, offset, data);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_unmap_buffer(buf, offset, data);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_unmap_buffer(buf, offset, data);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_unmap_buffer(buf, offset, data);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void* _sg_map_upload_buffer(int offset, int size) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_map_upload_buffer(offset, size);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_map_upload_buffer(offset, size);
+    #else
+    // only the GL and dummy backends support image uploads
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(size);
+    SOKOL_UNREACHABLE;
+    return 0;
+    #endif
+}
+
+static inline void _sg_unmap_upload_buffer(_sg_image_t* img, int face, int mip_level, int offset, const sg_range* data, int queue_index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_unmap_upload_buffer(img, face, mip_level, offset, data, queue_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_unmap_upload_buffer(img, face, mip_level, offset, data, queue_index);
+    #else
+    // only the GL and dummy backends support image uploads
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(face);
+    _SOKOL_UNUSED(mip_level);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(data);
+    _SOKOL_UNUSED(queue_index);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline bool _sg_query_upload_done(int queue_index) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_query_upload_done(queue_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_query_upload_done(queue_index);
+    #else
+    // only the GL and dummy backends support image uploads
+    _SOKOL_UNUSED(queue_index);
+    SOKOL_UNREACHABLE;
+    return true;
+    #endif
+}
+
+static inline void _sg_generate_mipmaps(_sg_image_t* img) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_generate_mipmaps(img);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_generate_mipmaps(img);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_generate_mipmaps(img);
+    #else
+    // mipmap generation not yet supported on D3D11 and WebGPU
+    _SOKOL_UNUSED(img);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline void _sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_dispatch(num_groups_x, num_groups_y, num_groups_z);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_dispatch(num_groups_x, num_groups_y, num_groups_z);
+    #else
+    // only the GL and dummy backends support compute passes
+    _SOKOL_UNUSED(num_groups_x);
+    _SOKOL_UNUSED(num_groups_y);
+    _SOKOL_UNUSED(num_groups_z);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline void _sg_read_image(_sg_image_t* img, const sg_read_result* res, void* ptr) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_read_image(img, res, ptr);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_read_image(img, res, ptr);
+    #else
+    // only the GL and dummy backends support reading image data
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(res);
+    _SOKOL_UNUSED(ptr);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline void _sg_start_read(_sg_image_t* img, const sg_read_result* res, int read_index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_start_read(img, res, read_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_start_read(img, res, read_index);
+    #else
+    // only the GL and dummy backends support reading image data
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(res);
+    _SOKOL_UNUSED(read_index);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline const void* _sg_map_read(int read_index, int size, bool* out_failed) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_map_read(read_index, size, out_failed);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_map_read(read_index, size, out_failed);
+    #else
+    // only the GL and dummy backends support reading image data
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(size);
+    _SOKOL_UNUSED(out_failed);
+    SOKOL_UNREACHABLE;
+    return 0;
+    #endif
+}
+
+static inline void _sg_discard_read(int read_index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_discard_read(read_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_discard_read(read_index);
+    #else
+    // only the GL and dummy backends support reading image data
+    _SOKOL_UNUSED(read_index);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
 static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_update_image(img, data);
@@ -15179,6 +18599,38 @@ static inline void _sg_pop_debug_group(void) {
     #endif
 }
 
+static inline void _sg_write_timestamp(int query_index) {
+    #if defined(SOKOL_GLCORE33)
+    _sg_gl_write_timestamp(query_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_write_timestamp(query_index);
+    #else
+    _SOKOL_UNUSED(query_index);
+    #endif
+}
+
+static inline bool _sg_timestamp_available(int query_index) {
+    #if defined(SOKOL_GLCORE33)
+    return _sg_gl_timestamp_available(query_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_timestamp_available(query_index);
+    #else
+    _SOKOL_UNUSED(query_index);
+    return false;
+    #endif
+}
+
+static inline uint64_t _sg_read_timestamp(int query_index) {
+    #if defined(SOKOL_GLCORE33)
+    return _sg_gl_read_timestamp(query_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_read_timestamp(query_index);
+    #else
+    _SOKOL_UNUSED(query_index);
+    return 0;
+    #endif
+}
+
 // ██████   ██████   ██████  ██
 // ██   ██ ██    ██ ██    ██ ██
 // ██████  ██    ██ ██    ██ ██
@@ -15200,10 +18652,21 @@ _SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
     for (int i = pool->size-1; i >= 1; i--) {
         pool->free_queue[pool->queue_top++] = i;
     }
+    pool->high_water_mark = 0;
+    pool->base_size = pool->size;
+    pool->chunk_size = 0;
+    pool->num_chunks = 0;
+    pool->chunks = 0;
 }
 
 _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
+    for (int i = 0; i < pool->num_chunks; i++) {
+        _sg_free(pool->chunks[i]);
+    }
+    _sg_free(pool->chunks);
+    pool->chunks = 0;
+    pool->num_chunks = 0;
     SOKOL_ASSERT(pool->free_queue);
     _sg_free(pool->free_queue);
     pool->free_queue = 0;
@@ -15220,6 +18683,10 @@ _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
     if (pool->queue_top > 0) {
         int slot_index = pool->free_queue[--pool->queue_top];
         SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
+        const int num_used = (pool->size - 1) - pool->queue_top;
+        if (num_used > pool->high_water_mark) {
+            pool->high_water_mark = num_used;
+        }
         return slot_index;
     } else {
         // pool exhausted
@@ -15242,6 +18709,68 @@ _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
     SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
 }
 
+// adds a chunk of items to an exhausted growable pool, existing items are not moved
+_SOKOL_PRIVATE bool _sg_pool_grow(_sg_pool_t* pool, size_t item_size) {
+    SOKOL_ASSERT(pool && (pool->queue_top == 0));
+    if (0 == pool->chunk_size) {
+        return false;
+    }
+    const int new_size = pool->size + pool->chunk_size;
+    if (new_size > _SG_MAX_POOL_SIZE) {
+        return false;
+    }
+    uint32_t* gen_ctrs = (uint32_t*) _sg_malloc_clear(sizeof(uint32_t) * (size_t)new_size);
+    memcpy(gen_ctrs, pool->gen_ctrs, sizeof(uint32_t) * (size_t)pool->size);
+    _sg_free(pool->gen_ctrs);
+    pool->gen_ctrs = gen_ctrs;
+    // the free queue is empty, but needs room for all slots
+    _sg_free(pool->free_queue);
+    pool->free_queue = (int*) _sg_malloc_clear(sizeof(int) * (size_t)(new_size - 1));
+    for (int i = new_size-1; i >= pool->size; i--) {
+        pool->free_queue[pool->queue_top++] = i;
+    }
+    void** chunks = (void**) _sg_malloc(sizeof(void*) * (size_t)(pool->num_chunks + 1));
+    if (pool->chunks) {
+        memcpy(chunks, pool->chunks, sizeof(void*) * (size_t)pool->num_chunks);
+        _sg_free(pool->chunks);
+    }
+    chunks[pool->num_chunks++] = _sg_malloc_clear(item_size * (size_t)pool->chunk_size);
+    pool->chunks = chunks;
+    pool->size = new_size;
+    return true;
+}
+
+// like _sg_pool_alloc_index(), but grows an exhausted pool if possible
+_SOKOL_PRIVATE int _sg_pool_alloc_index_grow(_sg_pool_t* pool, size_t item_size) {
+    if (0 == pool->queue_top) {
+        _sg_pool_grow(pool, item_size);
+    }
+    return _sg_pool_alloc_index(pool);
+}
+
+// returns the address of a pool item, items of grown pools are found in the chunks
+_SOKOL_PRIVATE void* _sg_pool_item(const _sg_pool_t* pool, void* items, size_t item_size, int slot_index) {
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    if (slot_index < pool->base_size) {
+        return (uint8_t*)items + item_size * (size_t)slot_index;
+    }
+    SOKOL_ASSERT(pool->chunk_size > 0);
+    const int chunk_index = (slot_index - pool->base_size) / pool->chunk_size;
+    const int item_index = (slot_index - pool->base_size) % pool->chunk_size;
+    SOKOL_ASSERT(chunk_index < pool->num_chunks);
+    return (uint8_t*)pool->chunks[chunk_index] + item_size * (size_t)item_index;
+}
+
+_SOKOL_PRIVATE sg_pool_usage _sg_pool_usage(const _sg_pool_t* pool) {
+    sg_pool_usage res;
+    _sg_clear(&res, sizeof(res));
+    // slot 0 is reserved
+    res.size = pool->size - 1;
+    res.num_used = res.size - pool->queue_top;
+    res.high_water_mark = pool->high_water_mark;
+    return res;
+}
+
 _SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot) {
     SOKOL_ASSERT(slot);
     _sg_clear(slot, sizeof(_sg_slot_t));
@@ -15341,10 +18870,38 @@ _SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
     _sg_init_pool(&p->context_pool, desc->context_pool_size);
     size_t context_pool_byte_size = sizeof(_sg_context_t) * (size_t)p->context_pool.size;
     p->contexts = (_sg_context_t*) _sg_malloc_clear(context_pool_byte_size);
+
+    SOKOL_ASSERT((desc->recording_pool_size > 0) && (desc->recording_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->recording_pool, desc->recording_pool_size);
+    size_t recording_pool_byte_size = sizeof(_sg_recording_t) * (size_t)p->recording_pool.size;
+    p->recordings = (_sg_recording_t*) _sg_malloc_clear(recording_pool_byte_size);
+
+    SOKOL_ASSERT((desc->encoder_pool_size > 0) && (desc->encoder_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->encoder_pool, desc->encoder_pool_size);
+    size_t encoder_pool_byte_size = sizeof(_sg_encoder_t) * (size_t)p->encoder_pool.size;
+    p->encoders = (_sg_encoder_t*) _sg_malloc_clear(encoder_pool_byte_size);
+
+    SOKOL_ASSERT((desc->binding_set_pool_size > 0) && (desc->binding_set_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->binding_set_pool, desc->binding_set_pool_size);
+    size_t binding_set_pool_byte_size = sizeof(_sg_binding_set_t) * (size_t)p->binding_set_pool.size;
+    p->binding_sets = (_sg_binding_set_t*) _sg_malloc_clear(binding_set_pool_byte_size);
+
+    // exhausted pools grow by their initial size
+    if (desc->enable_growable_pools) {
+        p->buffer_pool.chunk_size = desc->buffer_pool_size;
+        p->image_pool.chunk_size = desc->image_pool_size;
+        p->sampler_pool.chunk_size = desc->sampler_pool_size;
+        p->shader_pool.chunk_size = desc->shader_pool_size;
+        p->pipeline_pool.chunk_size = desc->pipeline_pool_size;
+        p->pass_pool.chunk_size = desc->pass_pool_size;
+    }
 }
 
 _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     SOKOL_ASSERT(p);
+    _sg_free(p->binding_sets); p->binding_sets = 0;
+    _sg_free(p->encoders);    p->encoders = 0;
+    _sg_free(p->recordings);  p->recordings = 0;
     _sg_free(p->contexts);    p->contexts = 0;
     _sg_free(p->passes);      p->passes = 0;
     _sg_free(p->pipelines);   p->pipelines = 0;
@@ -15352,6 +18909,9 @@ _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     _sg_free(p->samplers);    p->samplers = 0;
     _sg_free(p->images);      p->images = 0;
     _sg_free(p->buffers);     p->buffers = 0;
+    _sg_discard_pool(&p->binding_set_pool);
+    _sg_discard_pool(&p->encoder_pool);
+    _sg_discard_pool(&p->recording_pool);
     _sg_discard_pool(&p->context_pool);
     _sg_discard_pool(&p->pass_pool);
     _sg_discard_pool(&p->pipeline_pool);
@@ -15391,46 +18951,58 @@ _SOKOL_PRIVATE int _sg_slot_index(uint32_t id) {
 }
 
 // returns pointer to resource by id without matching id check
+_SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at_index(const _sg_pools_t* p, int slot_index) {
+    return (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, p->buffers, sizeof(_sg_buffer_t), slot_index);
+}
+
 _SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
-    int slot_index = _sg_slot_index(buf_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
-    return &p->buffers[slot_index];
+    return _sg_buffer_at_index(p, _sg_slot_index(buf_id));
+}
+
+_SOKOL_PRIVATE _sg_image_t* _sg_image_at_index(const _sg_pools_t* p, int slot_index) {
+    return (_sg_image_t*) _sg_pool_item(&p->image_pool, p->images, sizeof(_sg_image_t), slot_index);
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
-    int slot_index = _sg_slot_index(img_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
-    return &p->images[slot_index];
+    return _sg_image_at_index(p, _sg_slot_index(img_id));
+}
+
+_SOKOL_PRIVATE _sg_sampler_t* _sg_sampler_at_index(const _sg_pools_t* p, int slot_index) {
+    return (_sg_sampler_t*) _sg_pool_item(&p->sampler_pool, p->samplers, sizeof(_sg_sampler_t), slot_index);
 }
 
 _SOKOL_PRIVATE _sg_sampler_t* _sg_sampler_at(const _sg_pools_t* p, uint32_t smp_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != smp_id));
-    int slot_index = _sg_slot_index(smp_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->sampler_pool.size));
-    return &p->samplers[slot_index];
+    return _sg_sampler_at_index(p, _sg_slot_index(smp_id));
+}
+
+_SOKOL_PRIVATE _sg_shader_t* _sg_shader_at_index(const _sg_pools_t* p, int slot_index) {
+    return (_sg_shader_t*) _sg_pool_item(&p->shader_pool, p->shaders, sizeof(_sg_shader_t), slot_index);
 }
 
 _SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
-    int slot_index = _sg_slot_index(shd_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
-    return &p->shaders[slot_index];
+    return _sg_shader_at_index(p, _sg_slot_index(shd_id));
+}
+
+_SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at_index(const _sg_pools_t* p, int slot_index) {
+    return (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, p->pipelines, sizeof(_sg_pipeline_t), slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
-    int slot_index = _sg_slot_index(pip_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
-    return &p->pipelines[slot_index];
+    return _sg_pipeline_at_index(p, _sg_slot_index(pip_id));
+}
+
+_SOKOL_PRIVATE _sg_pass_t* _sg_pass_at_index(const _sg_pools_t* p, int slot_index) {
+    return (_sg_pass_t*) _sg_pool_item(&p->pass_pool, p->passes, sizeof(_sg_pass_t), slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
-    int slot_index = _sg_slot_index(pass_id);
-    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
-    return &p->passes[slot_index];
+    return _sg_pass_at_index(p, _sg_slot_index(pass_id));
 }
 
 _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
@@ -15440,6 +19012,27 @@ _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t cont
     return &p->contexts[slot_index];
 }
 
+_SOKOL_PRIVATE _sg_recording_t* _sg_recording_at(const _sg_pools_t* p, uint32_t rec_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != rec_id));
+    int slot_index = _sg_slot_index(rec_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->recording_pool.size));
+    return &p->recordings[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_encoder_t* _sg_encoder_at(const _sg_pools_t* p, uint32_t enc_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != enc_id));
+    int slot_index = _sg_slot_index(enc_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->encoder_pool.size));
+    return &p->encoders[slot_index];
+}
+
+_SOKOL_PRIVATE _sg_binding_set_t* _sg_binding_set_at(const _sg_pools_t* p, uint32_t bs_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != bs_id));
+    int slot_index = _sg_slot_index(bs_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->binding_set_pool.size));
+    return &p->binding_sets[slot_index];
+}
+
 // returns pointer to resource with matching id check, may return 0
 _SOKOL_PRIVATE _sg_buffer_t* _sg_lookup_buffer(const _sg_pools_t* p, uint32_t buf_id) {
     if (SG_INVALID_ID != buf_id) {
@@ -15515,62 +19108,37 @@ _SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t
     return 0;
 }
 
-_SOKOL_PRIVATE void _sg_discard_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
-    /*  this is a bit dumb since it loops over all pool slots to
-        find the occupied slots, on the other hand it is only ever
-        executed at shutdown
-        NOTE: ONLY EXECUTE THIS AT SHUTDOWN
-              ...because the free queues will not be reset
-              and the resource slots not be cleared!
-    */
-    for (int i = 1; i < p->buffer_pool.size; i++) {
-        if (p->buffers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->buffers[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_buffer(&p->buffers[i]);
-            }
+_SOKOL_PRIVATE _sg_recording_t* _sg_lookup_recording(const _sg_pools_t* p, uint32_t rec_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != rec_id) {
+        _sg_recording_t* rec = _sg_recording_at(p, rec_id);
+        if (rec->slot.id == rec_id) {
+            return rec;
         }
     }
-    for (int i = 1; i < p->image_pool.size; i++) {
-        if (p->images[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->images[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_image(&p->images[i]);
-            }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_encoder_t* _sg_lookup_encoder(const _sg_pools_t* p, uint32_t enc_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != enc_id) {
+        _sg_encoder_t* enc = _sg_encoder_at(p, enc_id);
+        if (enc->slot.id == enc_id) {
+            return enc;
         }
     }
-    for (int i = 1; i < p->sampler_pool.size; i++) {
-        if (p->samplers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->samplers[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_sampler(&p->samplers[i]);
-            }
-        }
-    }
-    for (int i = 1; i < p->shader_pool.size; i++) {
-        if (p->shaders[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->shaders[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_shader(&p->shaders[i]);
-            }
-        }
-    }
-    for (int i = 1; i < p->pipeline_pool.size; i++) {
-        if (p->pipelines[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->pipelines[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_pipeline(&p->pipelines[i]);
-            }
-        }
-    }
-    for (int i = 1; i < p->pass_pool.size; i++) {
-        if (p->passes[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->passes[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_pass(&p->passes[i]);
-            }
+    return 0;
+}
+
+_SOKOL_PRIVATE _sg_binding_set_t* _sg_lookup_binding_set(const _sg_pools_t* p, uint32_t bs_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != bs_id) {
+        _sg_binding_set_t* bs = _sg_binding_set_at(p, bs_id);
+        if (bs->slot.id == bs_id) {
+            return bs;
         }
     }
+    return 0;
 }
 
 // ██    ██  █████  ██      ██ ██████   █████  ████████ ██  ██████  ███    ██
@@ -15622,6 +19190,13 @@ _SOKOL_PRIVATE bool _sg_validate_buffer_desc(const sg_buffer_desc* desc) {
         } else {
             _SG_VALIDATE(0 == desc->data.ptr, VALIDATE_BUFFERDESC_NO_DATA);
         }
+        if (desc->usage == SG_USAGE_STREAM_RING) {
+            _SG_VALIDATE(!injected, VALIDATE_BUFFERDESC_RING_INJECTED);
+            _SG_VALIDATE(desc->size >= (4 * SG_NUM_INFLIGHT_FRAMES), VALIDATE_BUFFERDESC_RING_SIZE);
+        }
+        if (desc->type == SG_BUFFERTYPE_STORAGEBUFFER) {
+            _SG_VALIDATE(_sg.features.compute, VALIDATE_BUFFERDESC_STORAGEBUFFER_FEATURE);
+        }
         return _sg_validate_end();
     #endif
 }
@@ -15671,6 +19246,7 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
                               (0 != desc->mtl_textures[0]) ||
                               (0 != desc->d3d11_texture) ||
                               (0 != desc->wgpu_texture);
+        _SG_VALIDATE(usage != SG_USAGE_STREAM_RING, VALIDATE_IMAGEDESC_STREAM_RING);
         if (_sg_is_depth_or_depth_stencil_format(fmt)) {
             _SG_VALIDATE(desc->type != SG_IMAGETYPE_3D, VALIDATE_IMAGEDESC_DEPTH_3D_IMAGE);
         }
@@ -15684,7 +19260,13 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
                 _SG_VALIDATE(desc->num_mipmaps == 1, VALIDATE_IMAGEDESC_MSAA_NUM_MIPMAPS);
                 _SG_VALIDATE(desc->type != SG_IMAGETYPE_3D, VALIDATE_IMAGEDESC_MSAA_3D_IMAGE);
             }
+            if (desc->generate_mipmaps) {
+                _SG_VALIDATE(_sg.features.generate_mipmaps, VALIDATE_IMAGEDESC_GENMIPS_FEATURE);
+                _SG_VALIDATE(desc->sample_count == 1, VALIDATE_IMAGEDESC_GENMIPS_MSAA);
+                _SG_VALIDATE(_sg_is_mipmap_generation_format(fmt), VALIDATE_IMAGEDESC_GENMIPS_PIXELFORMAT);
+            }
         } else {
+            _SG_VALIDATE(!desc->generate_mipmaps, VALIDATE_IMAGEDESC_GENMIPS_NO_RT);
             _SG_VALIDATE(desc->sample_count == 1, VALIDATE_IMAGEDESC_MSAA_BUT_NO_RT);
             const bool valid_nonrt_fmt = !_sg_is_valid_rendertarget_depth_format(fmt);
             _SG_VALIDATE(valid_nonrt_fmt, VALIDATE_IMAGEDESC_NONRT_PIXELFORMAT);
@@ -15759,20 +19341,28 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
         _sg_validate_begin();
         _SG_VALIDATE(desc->_start_canary == 0, VALIDATE_SHADERDESC_CANARY);
         _SG_VALIDATE(desc->_end_canary == 0, VALIDATE_SHADERDESC_CANARY);
-        #if defined(SOKOL_D3D11)
-            _SG_VALIDATE(0 != desc->attrs[0].sem_name, VALIDATE_SHADERDESC_ATTR_SEMANTICS);
-        #endif
-        #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES3) || defined(SOKOL_WGPU)
-            // on GL or WebGPU, must provide shader source code
-            _SG_VALIDATE(0 != desc->vs.source, VALIDATE_SHADERDESC_SOURCE);
-            _SG_VALIDATE(0 != desc->fs.source, VALIDATE_SHADERDESC_SOURCE);
-        #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
-            // on Metal or D3D11, must provide shader source code or byte code
-            _SG_VALIDATE((0 != desc->vs.source)||(0 != desc->vs.bytecode.ptr), VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
-            _SG_VALIDATE((0 != desc->fs.source)||(0 != desc->fs.bytecode.ptr), VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
-        #else
-            // Dummy Backend, don't require source or bytecode
-        #endif
+        const bool is_compute = _sg_shader_desc_is_compute(desc);
+        if (is_compute) {
+            _SG_VALIDATE(_sg.features.compute, VALIDATE_SHADERDESC_COMPUTE_FEATURE);
+            const bool has_vs = (0 != desc->vs.source) || (0 != desc->vs.bytecode.ptr);
+            const bool has_fs = (0 != desc->fs.source) || (0 != desc->fs.bytecode.ptr);
+            _SG_VALIDATE(!has_vs && !has_fs, VALIDATE_SHADERDESC_COMPUTE_STAGES);
+        } else {
+            #if defined(SOKOL_D3D11)
+                _SG_VALIDATE(0 != desc->attrs[0].sem_name, VALIDATE_SHADERDESC_ATTR_SEMANTICS);
+            #endif
+            #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES3) || defined(SOKOL_WGPU)
+                // on GL or WebGPU, must provide shader source code
+                _SG_VALIDATE(0 != desc->vs.source, VALIDATE_SHADERDESC_SOURCE);
+                _SG_VALIDATE(0 != desc->fs.source, VALIDATE_SHADERDESC_SOURCE);
+            #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
+                // on Metal or D3D11, must provide shader source code or byte code
+                _SG_VALIDATE((0 != desc->vs.source)||(0 != desc->vs.bytecode.ptr), VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
+                _SG_VALIDATE((0 != desc->fs.source)||(0 != desc->fs.bytecode.ptr), VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE);
+            #else
+                // Dummy Backend, don't require source or bytecode
+            #endif
+        }
         for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
             if (desc->attrs[i].name) {
                 _SG_VALIDATE(strlen(desc->attrs[i].name) < _SG_STRING_SIZE, VALIDATE_SHADERDESC_ATTR_STRING_TOO_LONG);
@@ -15788,13 +19378,19 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
         if (0 != desc->fs.bytecode.ptr) {
             _SG_VALIDATE(desc->fs.bytecode.size > 0, VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
         }
-        for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-            const sg_shader_stage_desc* stage_desc = (stage_index == 0)? &desc->vs : &desc->fs;
+        if (0 != desc->cs.bytecode.ptr) {
+            _SG_VALIDATE(desc->cs.bytecode.size > 0, VALIDATE_SHADERDESC_NO_BYTECODE_SIZE);
+        }
+        for (int stage_index = 0; stage_index <= SG_SHADERSTAGE_CS; stage_index++) {
+            const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS) ? &desc->vs : ((stage_index == SG_SHADERSTAGE_FS) ? &desc->fs : &desc->cs);
             bool uniform_blocks_continuous = true;
             for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
                 const sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
                 if (ub_desc->size > 0) {
                     _SG_VALIDATE(uniform_blocks_continuous, VALIDATE_SHADERDESC_NO_CONT_UBS);
+                    if (ub_desc->glsl_name) {
+                        _SG_VALIDATE(ub_desc->layout == SG_UNIFORMLAYOUT_STD140, VALIDATE_SHADERDESC_UB_GLSL_NAME_STD140);
+                    }
                     #if defined(_SOKOL_ANY_GL)
                     bool uniforms_continuous = true;
                     uint32_t uniform_offset = 0;
@@ -15902,6 +19498,15 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
             }
             _SG_VALIDATE(expected_img_slot_mask == actual_img_slot_mask, VALIDATE_SHADERDESC_IMAGE_NOT_REFERENCED_BY_IMAGE_SAMPLER_PAIRS);
             _SG_VALIDATE(expected_smp_slot_mask == actual_smp_slot_mask, VALIDATE_SHADERDESC_SAMPLER_NOT_REFERENCED_BY_IMAGE_SAMPLER_PAIRS);
+            bool storage_buffers_continuous = true;
+            for (int sbuf_index = 0; sbuf_index < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; sbuf_index++) {
+                if (stage_desc->storage_buffers[sbuf_index].used) {
+                    _SG_VALIDATE(storage_buffers_continuous, VALIDATE_SHADERDESC_NO_CONT_STORAGEBUFFERS);
+                    _SG_VALIDATE(_sg.features.compute, VALIDATE_SHADERDESC_STORAGEBUFFER_FEATURE);
+                } else {
+                    storage_buffers_continuous = false;
+                }
+            }
         }
         return _sg_validate_end();
     #endif
@@ -15927,11 +19532,14 @@ _SOKOL_PRIVATE bool _sg_validate_pipeline_desc(const sg_pipeline_desc* desc) {
             }
             _SG_VALIDATE(_sg_multiple_u64((uint64_t)l_state->stride, 4), VALIDATE_PIPELINEDESC_LAYOUT_STRIDE4);
         }
-        _SG_VALIDATE(desc->layout.attrs[0].format != SG_VERTEXFORMAT_INVALID, VALIDATE_PIPELINEDESC_NO_ATTRS);
+        if (!desc->compute) {
+            _SG_VALIDATE(desc->layout.attrs[0].format != SG_VERTEXFORMAT_INVALID, VALIDATE_PIPELINEDESC_NO_ATTRS);
+        }
         const _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
         _SG_VALIDATE(0 != shd, VALIDATE_PIPELINEDESC_SHADER);
         if (shd) {
-            _SG_VALIDATE(shd->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_PIPELINEDESC_SHADER);
+            _SG_VALIDATE((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_PENDING), VALIDATE_PIPELINEDESC_SHADER);
+            _SG_VALIDATE(desc->compute == shd->cmn.is_compute, VALIDATE_PIPELINEDESC_COMPUTE);
             bool attrs_cont = true;
             for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
                 const sg_vertex_attr_state* a_state = &desc->layout.attrs[attr_index];
@@ -16109,6 +19717,11 @@ _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
         SOKOL_ASSERT(pip->shader);
         _SG_VALIDATE(pip->shader->slot.id == pip->cmn.shader_id.id, VALIDATE_APIP_SHADER_EXISTS);
         _SG_VALIDATE(pip->shader->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_APIP_SHADER_VALID);
+        _SG_VALIDATE(pip->cmn.is_compute == _sg.compute_pass, VALIDATE_APIP_COMPUTE);
+        if (_sg.compute_pass) {
+            // compute passes have no attachments
+            return _sg_validate_end();
+        }
         // check that pipeline attributes match current pass attributes
         const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
         if (pass) {
@@ -16136,6 +19749,47 @@ _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
     #endif
 }
 
+#if defined(SOKOL_DEBUG)
+_SOKOL_PRIVATE bool _sg_stage_bindings_empty(const sg_stage_bindings* stage) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (stage->images[i].id != SG_INVALID_ID) {
+            return false;
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++) {
+        if (stage->samplers[i].id != SG_INVALID_ID) {
+            return false;
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++) {
+        if (stage->storage_buffers[i].id != SG_INVALID_ID) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+_SOKOL_PRIVATE bool _sg_validate_apply_compute_bindings(const sg_bindings* bindings) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bindings);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        bool has_render_bindings = (bindings->index_buffer.id != SG_INVALID_ID);
+        for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++) {
+            has_render_bindings |= (bindings->vertex_buffers[i].id != SG_INVALID_ID);
+        }
+        has_render_bindings |= !_sg_stage_bindings_empty(&bindings->vs);
+        has_render_bindings |= !_sg_stage_bindings_empty(&bindings->fs);
+        _SG_VALIDATE(!has_render_bindings, VALIDATE_ABND_COMPUTE_BINDINGS);
+        return _sg_validate_end();
+    #endif
+}
+
 _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(bindings);
@@ -16156,6 +19810,9 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
         _SG_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_ABND_PIPELINE_VALID);
         SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
 
+        // compute stage bindings have been moved into the vertex stage slot in compute passes
+        _SG_VALIDATE(_sg_stage_bindings_empty(&bindings->cs), VALIDATE_ABND_CS_IN_RENDER_PASS);
+
         // has expected vertex buffers, and vertex buffers still exist
         for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++) {
             if (bindings->vertex_buffers[i].id != SG_INVALID_ID) {
@@ -16164,7 +19821,7 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
                 _SG_VALIDATE(buf != 0, VALIDATE_ABND_VB_EXISTS);
                 if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
-                    _SG_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, VALIDATE_ABND_VB_TYPE);
+                    _SG_VALIDATE((SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type) || (SG_BUFFERTYPE_STORAGEBUFFER == buf->cmn.type), VALIDATE_ABND_VB_TYPE);
                     _SG_VALIDATE(!buf->cmn.append_overflow, VALIDATE_ABND_VB_OVERFLOW);
                 }
             } else {
@@ -16302,6 +19959,27 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 _SG_VALIDATE(bindings->fs.samplers[i].id == SG_INVALID_ID, VALIDATE_ABND_FS_UNEXPECTED_SAMPLER_BINDING);
             }
         }
+
+        // has expected storage buffers
+        for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+            const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
+            const sg_stage_bindings* stage_bnd = (stage_index == SG_SHADERSTAGE_VS) ? &bindings->vs : &bindings->fs;
+            for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++) {
+                const sg_buffer sbuf_id = stage_bnd->storage_buffers[i];
+                if (i < stage->num_storage_buffers) {
+                    _SG_VALIDATE(sbuf_id.id != SG_INVALID_ID, VALIDATE_ABND_EXPECTED_STORAGEBUFFER_BINDING);
+                    if (sbuf_id.id != SG_INVALID_ID) {
+                        const _sg_buffer_t* sbuf = _sg_lookup_buffer(&_sg.pools, sbuf_id.id);
+                        _SG_VALIDATE(sbuf != 0, VALIDATE_ABND_STORAGEBUFFER_EXISTS);
+                        if (sbuf && (sbuf->slot.state == SG_RESOURCESTATE_VALID)) {
+                            _SG_VALIDATE(SG_BUFFERTYPE_STORAGEBUFFER == sbuf->cmn.type, VALIDATE_ABND_STORAGEBUFFER_TYPE);
+                        }
+                    }
+                } else {
+                    _SG_VALIDATE(sbuf_id.id == SG_INVALID_ID, VALIDATE_ABND_UNEXPECTED_STORAGEBUFFER_BINDING);
+                }
+            }
+        }
         return _sg_validate_end();
     #endif
 }
@@ -16316,16 +19994,17 @@ _SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int
         if (_sg.desc.disable_validation) {
             return true;
         }
-        SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS));
+        SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS) || (stage_index == SG_SHADERSTAGE_CS));
         SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
         _sg_validate_begin();
         _SG_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, VALIDATE_AUB_NO_PIPELINE);
         const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
         SOKOL_ASSERT(pip && (pip->slot.id == _sg.cur_pipeline.id));
         SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
+        _SG_VALIDATE((stage_index == SG_SHADERSTAGE_CS) == pip->cmn.is_compute, VALIDATE_AUB_COMPUTE_STAGE);
 
         // check that there is a uniform block at 'stage' and 'ub_index'
-        const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
+        const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[_sg_shader_stage_slot(stage_index)];
         _SG_VALIDATE(ub_index < stage->num_uniform_blocks, VALIDATE_AUB_NO_UB_AT_SLOT);
 
         // check that the provided data size matches the uniform block size
@@ -16335,6 +20014,98 @@ _SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_draw_indirect(sg_buffer buf_id, int offset, int count) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf_id);
+        _SOKOL_UNUSED(offset);
+        _SOKOL_UNUSED(count);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(count >= 0);
+        _sg_validate_begin();
+        _SG_VALIDATE(!_sg.rec.active, VALIDATE_DRAWINDIRECT_WHILE_RECORDING);
+        const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+        _SG_VALIDATE(buf != 0, VALIDATE_DRAWINDIRECT_BUFFER_EXISTS);
+        if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+            _SG_VALIDATE(SG_BUFFERTYPE_INDIRECTBUFFER == buf->cmn.type, VALIDATE_DRAWINDIRECT_BUFFER_TYPE);
+            _SG_VALIDATE((offset >= 0) && _sg_multiple_u64((uint64_t)offset, 4), VALIDATE_DRAWINDIRECT_OFFSET);
+            if ((SG_BUFFERTYPE_INDIRECTBUFFER == buf->cmn.type) && (offset >= 0)) {
+                const size_t end = (size_t)offset + (size_t)count * sizeof(sg_draw_indirect_args);
+                _SG_VALIDATE(end <= (size_t)buf->cmn.size, VALIDATE_DRAWINDIRECT_SIZE);
+                if ((end <= (size_t)buf->cmn.size) && _sg_multiple_u64((uint64_t)offset, 4) && buf->cmn.indirect_data) {
+                    const sg_draw_indirect_args* args = (const sg_draw_indirect_args*) (buf->cmn.indirect_data + offset);
+                    for (int i = 0; i < count; i++) {
+                        if ((0 != args[i].base_vertex) || (0 != args[i].base_instance)) {
+                            _SG_VALIDATE(false, VALIDATE_DRAWINDIRECT_RESERVED);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_compute_pass(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.features.compute, VALIDATE_BEGINCOMPUTEPASS_FEATURE);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_dispatch(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.compute_pass, VALIDATE_DISPATCH_COMPUTE_PASS);
+        _SG_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, VALIDATE_DISPATCH_PIPELINE);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_acquire_transient_image(const sg_transient_image_desc* key) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(key);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE((key->width > 0) && (key->height > 0), VALIDATE_TRANSIENT_IMAGE_SIZE);
+        _SG_VALIDATE(_sg_is_valid_rendertarget_color_format(key->pixel_format) || _sg_is_valid_rendertarget_depth_format(key->pixel_format), VALIDATE_TRANSIENT_IMAGE_RENDERABLE);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_release_transient_image(const _sg_transient_item_t* item) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(item);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(item && item->in_use, VALIDATE_TRANSIENT_IMAGE_RELEASE);
+        return _sg_validate_end();
+    #endif
+}
+
 _SOKOL_PRIVATE bool _sg_validate_update_buffer(const _sg_buffer_t* buf, const sg_range* data) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(buf);
@@ -16347,6 +20118,7 @@ _SOKOL_PRIVATE bool _sg_validate_update_buffer(const _sg_buffer_t* buf, const sg
         SOKOL_ASSERT(buf && data && data->ptr);
         _sg_validate_begin();
         _SG_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, VALIDATE_UPDATEBUF_USAGE);
+        _SG_VALIDATE(buf->cmn.usage != SG_USAGE_STREAM_RING, VALIDATE_UPDATEBUF_RING);
         _SG_VALIDATE(buf->cmn.size >= (int)data->size, VALIDATE_UPDATEBUF_SIZE);
         _SG_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, VALIDATE_UPDATEBUF_ONCE);
         _SG_VALIDATE(buf->cmn.append_frame_index != _sg.frame_index, VALIDATE_UPDATEBUF_APPEND);
@@ -16366,12 +20138,130 @@ _SOKOL_PRIVATE bool _sg_validate_append_buffer(const _sg_buffer_t* buf, const sg
         SOKOL_ASSERT(buf && data && data->ptr);
         _sg_validate_begin();
         _SG_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, VALIDATE_APPENDBUF_USAGE);
-        _SG_VALIDATE(buf->cmn.size >= (buf->cmn.append_pos + (int)data->size), VALIDATE_APPENDBUF_SIZE);
+        if (buf->cmn.usage == SG_USAGE_STREAM_RING) {
+            // ring buffer overflow is handled like an overflow in sg_map_buffer_range()
+            _SG_VALIDATE(!buf->cmn.mapped, VALIDATE_APPENDBUF_MAPPED);
+        } else {
+            _SG_VALIDATE(buf->cmn.size >= (buf->cmn.append_pos + (int)data->size), VALIDATE_APPENDBUF_SIZE);
+        }
         _SG_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, VALIDATE_APPENDBUF_UPDATE);
         return _sg_validate_end();
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_map_buffer(const _sg_buffer_t* buf) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(buf);
+        _sg_validate_begin();
+        _SG_VALIDATE(buf->cmn.usage == SG_USAGE_STREAM_RING, VALIDATE_MAPBUF_USAGE);
+        _SG_VALIDATE(!buf->cmn.mapped, VALIDATE_MAPBUF_MAPPED);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_unmap_buffer(const _sg_buffer_t* buf) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(buf);
+        _sg_validate_begin();
+        _SG_VALIDATE(buf->cmn.mapped, VALIDATE_UNMAPBUF_NOT_MAPPED);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_map_image_upload(const _sg_image_t* img, int face, int mip_level) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(face);
+        _SOKOL_UNUSED(mip_level);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(img);
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.features.image_upload, VALIDATE_MAPIMG_FEATURE);
+        _SG_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, VALIDATE_MAPIMG_USAGE);
+        _SG_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), VALIDATE_MAPIMG_COMPRESSED);
+        const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+        _SG_VALIDATE((face >= 0) && (face < num_faces), VALIDATE_MAPIMG_FACE);
+        _SG_VALIDATE((mip_level >= 0) && (mip_level < img->cmn.num_mipmaps), VALIDATE_MAPIMG_MIPLEVEL);
+        _SG_VALIDATE(!_sg.upload.mapped, VALIDATE_MAPIMG_MAPPED);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_unmap_image_upload(uint32_t img_id) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img_id);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.upload.mapped && (_sg.upload.map_img_id == img_id), VALIDATE_UNMAPIMG_NOT_MAPPED);
+        return _sg_validate_end();
+    #endif
+}
+
+// img is the resolved image (null for the default framebuffer or an invalid image),
+// data is null for sg_read_image_async()
+_SOKOL_PRIVATE bool _sg_validate_read_image(const sg_read_desc* desc, const _sg_image_t* img, const sg_read_result* res, const sg_range* data) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(res);
+        _SOKOL_UNUSED(data);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(desc && res);
+        _sg_validate_begin();
+        _SG_VALIDATE(desc->_start_canary == 0, VALIDATE_READIMG_CANARY);
+        _SG_VALIDATE(desc->_end_canary == 0, VALIDATE_READIMG_CANARY);
+        _SG_VALIDATE(_sg.features.image_read, VALIDATE_READIMG_FEATURE);
+        _SG_VALIDATE(!_sg.in_pass, VALIDATE_READIMG_IN_PASS);
+        if (desc->image.id != SG_INVALID_ID) {
+            _SG_VALIDATE(0 != img, VALIDATE_READIMG_IMAGE);
+            if (img) {
+                _SG_VALIDATE(img->cmn.render_target, VALIDATE_READIMG_RENDERTARGET);
+                _SG_VALIDATE(img->cmn.type == SG_IMAGETYPE_2D, VALIDATE_READIMG_TYPE);
+                _SG_VALIDATE(img->cmn.sample_count == 1, VALIDATE_READIMG_MSAA);
+                _SG_VALIDATE(!_sg_is_depth_or_depth_stencil_format(img->cmn.pixel_format), VALIDATE_READIMG_DEPTH);
+                _SG_VALIDATE((desc->x >= 0) && (desc->y >= 0) && (desc->width >= 0) && (desc->height >= 0) &&
+                             (res->width > 0) && (res->height > 0) &&
+                             ((res->x + res->width) <= img->cmn.width) &&
+                             ((res->y + res->height) <= img->cmn.height), VALIDATE_READIMG_RECT);
+            }
+        } else {
+            _SG_VALIDATE((desc->width > 0) && (desc->height > 0), VALIDATE_READIMG_DEFAULT_SIZE);
+            _SG_VALIDATE(_sg.desc.context.sample_count == 1, VALIDATE_READIMG_MSAA);
+            _SG_VALIDATE((desc->x >= 0) && (desc->y >= 0), VALIDATE_READIMG_RECT);
+        }
+        if (data) {
+            _SG_VALIDATE(data->ptr && (data->size >= res->data.size), VALIDATE_READIMG_DATA_SIZE);
+        } else {
+            _SG_VALIDATE(0 != desc->callback, VALIDATE_READIMG_CALLBACK);
+        }
+        return _sg_validate_end();
+    #endif
+}
+
 _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_image_data* data) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(img);
@@ -16396,43 +20286,295 @@ _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_i
     #endif
 }
 
-// ██████  ███████ ███████  ██████  ██    ██ ██████   ██████ ███████ ███████
-// ██   ██ ██      ██      ██    ██ ██    ██ ██   ██ ██      ██      ██
-// ██████  █████   ███████ ██    ██ ██    ██ ██████  ██      █████   ███████
-// ██   ██ ██           ██ ██    ██ ██    ██ ██   ██ ██      ██           ██
-// ██   ██ ███████ ███████  ██████   ██████  ██   ██  ██████ ███████ ███████
-//
-// >>resources
-_SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
-    sg_buffer_desc def = *desc;
-    def.type = _sg_def(def.type, SG_BUFFERTYPE_VERTEXBUFFER);
-    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
-    if (def.size == 0) {
-        def.size = def.data.size;
-    } else if (def.data.size == 0) {
-        def.data.size = def.size;
-    }
-    return def;
+_SOKOL_PRIVATE bool _sg_validate_generate_mipmaps(const _sg_image_t* img) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(img);
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.features.generate_mipmaps, VALIDATE_GENMIPS_FEATURE);
+        _SG_VALIDATE(!_sg.in_pass, VALIDATE_GENMIPS_IN_PASS);
+        _SG_VALIDATE(img->cmn.render_target || (img->cmn.usage != SG_USAGE_IMMUTABLE), VALIDATE_GENMIPS_USAGE);
+        _SG_VALIDATE(img->cmn.sample_count == 1, VALIDATE_GENMIPS_MSAA);
+        _SG_VALIDATE(_sg_is_mipmap_generation_format(img->cmn.pixel_format), VALIDATE_GENMIPS_PIXELFORMAT);
+        return _sg_validate_end();
+    #endif
 }
 
-_SOKOL_PRIVATE sg_image_desc _sg_image_desc_defaults(const sg_image_desc* desc) {
-    sg_image_desc def = *desc;
-    def.type = _sg_def(def.type, SG_IMAGETYPE_2D);
-    def.num_slices = _sg_def(def.num_slices, 1);
-    def.num_mipmaps = _sg_def(def.num_mipmaps, 1);
-    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
-    if (desc->render_target) {
-        def.pixel_format = _sg_def(def.pixel_format, _sg.desc.context.color_format);
-        def.sample_count = _sg_def(def.sample_count, _sg.desc.context.sample_count);
+_SOKOL_PRIVATE void _sg_current_pass_attrs(_sg_pass_attrs_t* attrs) {
+    SOKOL_ASSERT(attrs);
+    _sg_clear(attrs, sizeof(_sg_pass_attrs_t));
+    const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
+    if (pass) {
+        // an offscreen pass
+        attrs->num_color_atts = pass->cmn.num_color_atts;
+        for (int i = 0; i < pass->cmn.num_color_atts; i++) {
+            const _sg_image_t* att_img = _sg_pass_color_image(pass, i);
+            attrs->color_formats[i] = att_img->cmn.pixel_format;
+            attrs->sample_count = att_img->cmn.sample_count;
+        }
+        const _sg_image_t* att_dsimg = _sg_pass_ds_image(pass);
+        if (att_dsimg) {
+            attrs->depth_format = att_dsimg->cmn.pixel_format;
+            attrs->sample_count = att_dsimg->cmn.sample_count;
+        } else {
+            attrs->depth_format = SG_PIXELFORMAT_NONE;
+        }
     } else {
-        def.pixel_format = _sg_def(def.pixel_format, SG_PIXELFORMAT_RGBA8);
-        def.sample_count = _sg_def(def.sample_count, 1);
+        // default pass
+        attrs->num_color_atts = 1;
+        attrs->color_formats[0] = _sg.desc.context.color_format;
+        attrs->depth_format = _sg.desc.context.depth_format;
+        attrs->sample_count = _sg.desc.context.sample_count;
     }
-    return def;
 }
 
-_SOKOL_PRIVATE sg_sampler_desc _sg_sampler_desc_defaults(const sg_sampler_desc* desc) {
-    sg_sampler_desc def = *desc;
+_SOKOL_PRIVATE bool _sg_validate_encoder_desc(const sg_encoder_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(desc);
+        _sg_validate_begin();
+        _SG_VALIDATE(desc->_start_canary == 0, VALIDATE_ENCODERDESC_CANARY);
+        _SG_VALIDATE(desc->_end_canary == 0, VALIDATE_ENCODERDESC_CANARY);
+        _SG_VALIDATE(desc->size > 0, VALIDATE_ENCODERDESC_SIZE);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_submit_encoder(sg_encoder enc_id) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(enc_id);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        const _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+        _SG_VALIDATE((enc != 0) && (enc->slot.state == SG_RESOURCESTATE_VALID), VALIDATE_SUBMITENC_ENCODER);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_queue_draw(const sg_queued_draw* draw) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(draw);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.pass_valid, VALIDATE_QUEUEDRAW_PASS);
+        _SG_VALIDATE(!_sg.rec.active, VALIDATE_QUEUEDRAW_RECORDING);
+        _SG_VALIDATE(!_sg.compute_pass, VALIDATE_QUEUEDRAW_COMPUTE_PASS);
+        _SG_VALIDATE(0 != _sg_lookup_pipeline(&_sg.pools, draw->pipeline.id), VALIDATE_QUEUEDRAW_PIPELINE);
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+            _SG_VALIDATE((draw->vs_uniforms[i].size == 0) || (draw->vs_uniforms[i].ptr != 0), VALIDATE_QUEUEDRAW_UNIFORMS);
+            _SG_VALIDATE((draw->fs_uniforms[i].size == 0) || (draw->fs_uniforms[i].ptr != 0), VALIDATE_QUEUEDRAW_UNIFORMS);
+        }
+        return _sg_validate_end();
+    #endif
+}
+
+#if defined(SOKOL_DEBUG)
+_SOKOL_PRIVATE bool _sg_validate_binding_set_buffer(sg_buffer buf_id) {
+    const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    return buf && (buf->slot.state == SG_RESOURCESTATE_VALID);
+}
+
+_SOKOL_PRIVATE void _sg_validate_binding_set_stage(const sg_stage_bindings* stage) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (stage->images[i].id != SG_INVALID_ID) {
+            const _sg_image_t* img = _sg_lookup_image(&_sg.pools, stage->images[i].id);
+            _SG_VALIDATE(img && (img->slot.state == SG_RESOURCESTATE_VALID), VALIDATE_BINDINGSETDESC_IMAGE);
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++) {
+        if (stage->samplers[i].id != SG_INVALID_ID) {
+            const _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, stage->samplers[i].id);
+            _SG_VALIDATE(smp && (smp->slot.state == SG_RESOURCESTATE_VALID), VALIDATE_BINDINGSETDESC_SAMPLER);
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++) {
+        if (stage->storage_buffers[i].id != SG_INVALID_ID) {
+            _SG_VALIDATE(_sg_validate_binding_set_buffer(stage->storage_buffers[i]), VALIDATE_BINDINGSETDESC_BUFFER);
+        }
+    }
+}
+#endif
+
+_SOKOL_PRIVATE bool _sg_validate_binding_set_desc(const sg_binding_set_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(desc);
+        _sg_validate_begin();
+        _SG_VALIDATE(desc->_start_canary == 0, VALIDATE_BINDINGSETDESC_CANARY);
+        _SG_VALIDATE(desc->_end_canary == 0, VALIDATE_BINDINGSETDESC_CANARY);
+        const sg_bindings* bindings = &desc->bindings;
+        for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++) {
+            if (bindings->vertex_buffers[i].id != SG_INVALID_ID) {
+                _SG_VALIDATE(_sg_validate_binding_set_buffer(bindings->vertex_buffers[i]), VALIDATE_BINDINGSETDESC_BUFFER);
+            }
+        }
+        if (bindings->index_buffer.id != SG_INVALID_ID) {
+            _SG_VALIDATE(_sg_validate_binding_set_buffer(bindings->index_buffer), VALIDATE_BINDINGSETDESC_BUFFER);
+        }
+        _sg_validate_binding_set_stage(&bindings->vs);
+        _sg_validate_binding_set_stage(&bindings->fs);
+        _SG_VALIDATE(_sg_stage_bindings_empty(&bindings->cs), VALIDATE_BINDINGSETDESC_COMPUTE);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_apply_binding_set(_sg_binding_set_t* bs) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bs);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(!_sg.compute_pass, VALIDATE_ABNDSET_COMPUTE_PASS);
+        _SG_VALIDATE(bs != 0, VALIDATE_ABNDSET_EXISTS);
+        if (bs) {
+            _SG_VALIDATE(bs->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_ABNDSET_VALID);
+            for (int i = 0; i < bs->num_refs; i++) {
+                const _sg_recref_t* ref = &bs->refs[i];
+                _SG_VALIDATE(ref->slot->id == ref->id, VALIDATE_ABNDSET_RESOURCE_EXISTS);
+            }
+        }
+        if (!_sg_validate_end()) {
+            return false;
+        }
+        // the checks against the current pipeline only run when the binding
+        // set is applied with a pipeline for the first time
+        if ((_sg.cur_pipeline.id == SG_INVALID_ID) || (bs->validated_pip_id != _sg.cur_pipeline.id)) {
+            if (!_sg_validate_apply_bindings(&bs->bindings)) {
+                return false;
+            }
+            bs->validated_pip_id = _sg.cur_pipeline.id;
+        }
+        return true;
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_begin_recording(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.pass_valid, VALIDATE_BEGINREC_PASS);
+        _SG_VALIDATE(!_sg.rec.active, VALIDATE_BEGINREC_NESTED);
+        _SG_VALIDATE(!_sg.compute_pass, VALIDATE_BEGINREC_COMPUTE_PASS);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_end_recording(void) {
+    #if !defined(SOKOL_DEBUG)
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(_sg.rec.active, VALIDATE_ENDREC_NOT_RECORDING);
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_replay(sg_recording rec_id) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(rec_id);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(!_sg.rec.active, VALIDATE_REPLAY_WHILE_RECORDING);
+        _SG_VALIDATE(!_sg.compute_pass, VALIDATE_REPLAY_COMPUTE_PASS);
+        const _sg_recording_t* rec = _sg_lookup_recording(&_sg.pools, rec_id.id);
+        _SG_VALIDATE(rec != 0, VALIDATE_REPLAY_RECORDING_EXISTS);
+        if (!rec) {
+            return _sg_validate_end();
+        }
+        _SG_VALIDATE(rec->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_REPLAY_RECORDING_VALID);
+        if (_sg.pass_valid) {
+            _sg_pass_attrs_t attrs;
+            _sg_current_pass_attrs(&attrs);
+            bool attrs_match = (attrs.num_color_atts == rec->pass_attrs.num_color_atts)
+                && (attrs.depth_format == rec->pass_attrs.depth_format)
+                && (attrs.sample_count == rec->pass_attrs.sample_count);
+            for (int i = 0; i < attrs.num_color_atts; i++) {
+                attrs_match &= attrs.color_formats[i] == rec->pass_attrs.color_formats[i];
+            }
+            _SG_VALIDATE(attrs_match, VALIDATE_REPLAY_PASS_ATTRS);
+        }
+        for (int i = 0; i < rec->num_refs; i++) {
+            const _sg_recref_t* ref = &rec->refs[i];
+            _SG_VALIDATE(ref->slot->id == ref->id, VALIDATE_REPLAY_RESOURCE_EXISTS);
+        }
+        return _sg_validate_end();
+    #endif
+}
+
+// ██████  ███████ ███████  ██████  ██    ██ ██████   ██████ ███████ ███████
+// ██   ██ ██      ██      ██    ██ ██    ██ ██   ██ ██      ██      ██
+// ██████  █████   ███████ ██    ██ ██    ██ ██████  ██      █████   ███████
+// ██   ██ ██           ██ ██    ██ ██    ██ ██   ██ ██      ██           ██
+// ██   ██ ███████ ███████  ██████   ██████  ██   ██  ██████ ███████ ███████
+//
+// >>resources
+_SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
+    sg_buffer_desc def = *desc;
+    def.type = _sg_def(def.type, SG_BUFFERTYPE_VERTEXBUFFER);
+    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
+    if (def.size == 0) {
+        def.size = def.data.size;
+    } else if (def.data.size == 0) {
+        def.data.size = def.size;
+    }
+    return def;
+}
+
+_SOKOL_PRIVATE sg_image_desc _sg_image_desc_defaults(const sg_image_desc* desc) {
+    sg_image_desc def = *desc;
+    def.type = _sg_def(def.type, SG_IMAGETYPE_2D);
+    def.num_slices = _sg_def(def.num_slices, 1);
+    def.num_mipmaps = _sg_def(def.num_mipmaps, 1);
+    def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
+    if (desc->render_target) {
+        def.pixel_format = _sg_def(def.pixel_format, _sg.desc.context.color_format);
+        def.sample_count = _sg_def(def.sample_count, _sg.desc.context.sample_count);
+    } else {
+        def.pixel_format = _sg_def(def.pixel_format, SG_PIXELFORMAT_RGBA8);
+        def.sample_count = _sg_def(def.sample_count, 1);
+    }
+    return def;
+}
+
+_SOKOL_PRIVATE sg_sampler_desc _sg_sampler_desc_defaults(const sg_sampler_desc* desc) {
+    sg_sampler_desc def = *desc;
     def.min_filter = _sg_def(def.min_filter, SG_FILTER_NEAREST);
     def.mag_filter = _sg_def(def.mag_filter, SG_FILTER_NEAREST);
     def.mipmap_filter = _sg_def(def.mipmap_filter, SG_FILTER_NONE);
@@ -16451,9 +20593,11 @@ _SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* des
     #if defined(SOKOL_METAL)
         def.vs.entry = _sg_def(def.vs.entry, "_main");
         def.fs.entry = _sg_def(def.fs.entry, "_main");
+        def.cs.entry = _sg_def(def.cs.entry, "_main");
     #else
         def.vs.entry = _sg_def(def.vs.entry, "main");
         def.fs.entry = _sg_def(def.fs.entry, "main");
+        def.cs.entry = _sg_def(def.cs.entry, "main");
     #endif
     #if defined(SOKOL_D3D11)
         if (def.vs.source) {
@@ -16463,8 +20607,8 @@ _SOKOL_PRIVATE sg_shader_desc _sg_shader_desc_defaults(const sg_shader_desc* des
             def.fs.d3d11_target = _sg_def(def.fs.d3d11_target, "ps_4_0");
         }
     #endif
-    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
-        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &def.vs : &def.fs;
+    for (int stage_index = 0; stage_index <= SG_SHADERSTAGE_CS; stage_index++) {
+        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS) ? &def.vs : ((stage_index == SG_SHADERSTAGE_FS) ? &def.fs : &def.cs);
         for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
             sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
             if (0 == ub_desc->size) {
@@ -16589,11 +20733,176 @@ _SOKOL_PRIVATE sg_pass_desc _sg_pass_desc_defaults(const sg_pass_desc* desc) {
     return def;
 }
 
+// estimated GPU memory size of a buffer, dynamic buffers have one backend buffer per slot
+_SOKOL_PRIVATE uint64_t _sg_buffer_memory_size(const _sg_buffer_common_t* cmn) {
+    #if defined(SOKOL_D3D11)
+    const uint64_t num_slots = 1;
+    #else
+    const uint64_t num_slots = (uint64_t)cmn->num_slots;
+    #endif
+    return (uint64_t)cmn->size * num_slots;
+}
+
+// estimated GPU memory size of an image, ignores driver-specific alignment and padding
+_SOKOL_PRIVATE uint64_t _sg_image_memory_size(const _sg_image_common_t* cmn) {
+    const sg_pixel_format fmt = cmn->pixel_format;
+    const bool is_depth = _sg_is_depth_or_depth_stencil_format(fmt);
+    uint64_t size = 0;
+    for (int mip_index = 0; mip_index < cmn->num_mipmaps; mip_index++) {
+        const int width = _sg_miplevel_dim(cmn->width, mip_index);
+        const int height = _sg_miplevel_dim(cmn->height, mip_index);
+        const int num_slices = (cmn->type == SG_IMAGETYPE_3D) ? _sg_miplevel_dim(cmn->num_slices, mip_index) : cmn->num_slices;
+        const uint64_t surface_size = is_depth ? ((uint64_t)width * (uint64_t)height * 4) : (uint64_t)_sg_surface_pitch(fmt, width, height, 1);
+        size += surface_size * (uint64_t)num_slices;
+    }
+    const uint64_t num_faces = (cmn->type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    #if defined(SOKOL_D3D11)
+    const uint64_t num_slots = 1;
+    #else
+    const uint64_t num_slots = (uint64_t)cmn->num_slots;
+    #endif
+    return size * num_faces * (uint64_t)cmn->sample_count * num_slots;
+}
+
+_SOKOL_PRIVATE void _sg_memory_check_budget(void) {
+    const sg_memory_budget_desc* budget = &_sg.desc.memory_budget;
+    if ((0 == budget->size) || (0 == budget->callback) || (_sg.memory.budget_lock > 0)) {
+        return;
+    }
+    const bool over_budget = _sg.memory.stats.total > budget->size;
+    if (over_budget != _sg.memory.over_budget) {
+        // update the flag first, the callback may create or destroy resources
+        _sg.memory.over_budget = over_budget;
+        budget->callback(&_sg.memory.stats, over_budget, budget->user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_memory_track(sg_memory_usage* mem, sg_usage usage, bool render_target, uint64_t size, bool add) {
+    uint64_t* usage_size;
+    if (render_target) {
+        usage_size = &mem->render_target;
+    } else if (usage == SG_USAGE_IMMUTABLE) {
+        usage_size = &mem->immutable;
+    } else if (usage == SG_USAGE_DYNAMIC) {
+        usage_size = &mem->dynamic;
+    } else {
+        usage_size = &mem->stream;
+    }
+    if (add) {
+        *usage_size += size;
+        mem->total += size;
+        _sg.memory.stats.total += size;
+        if (_sg.memory.stats.total > _sg.memory.stats.peak_total) {
+            _sg.memory.stats.peak_total = _sg.memory.stats.total;
+        }
+    } else {
+        SOKOL_ASSERT((*usage_size >= size) && (mem->total >= size) && (_sg.memory.stats.total >= size));
+        *usage_size -= size;
+        mem->total -= size;
+        _sg.memory.stats.total -= size;
+    }
+}
+
+// the budget callback is only called when a resource has been completely created
+// or destroyed, and never from inside sokol-gfx housekeeping or sg_shutdown()
+_SOKOL_PRIVATE void _sg_memory_lock_budget(void) {
+    _sg.memory.budget_lock++;
+}
+
+_SOKOL_PRIVATE void _sg_memory_unlock_budget(void) {
+    SOKOL_ASSERT(_sg.memory.budget_lock > 0);
+    if (--_sg.memory.budget_lock == 0) {
+        _sg_memory_check_budget();
+    }
+}
+
+_SOKOL_PRIVATE void _sg_memory_track_buffer(const _sg_buffer_common_t* cmn, bool add) {
+    _sg_memory_track(&_sg.memory.stats.buffers, cmn->usage, false, _sg_buffer_memory_size(cmn), add);
+}
+
+_SOKOL_PRIVATE void _sg_memory_track_image(const _sg_image_common_t* cmn, bool add) {
+    _sg_memory_track(&_sg.memory.stats.images, cmn->usage, cmn->render_target, _sg_image_memory_size(cmn), add);
+}
+
+_SOKOL_PRIVATE void _sg_discard_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
+    /*  this is a bit dumb since it loops over all pool slots to
+        find the occupied slots, on the other hand it is only ever
+        executed at shutdown
+        NOTE: ONLY EXECUTE THIS AT SHUTDOWN
+              ...because the free queues will not be reset
+              and the resource slots not be cleared!
+    */
+    for (int i = 1; i < p->buffer_pool.size; i++) {
+        _sg_buffer_t* buf = _sg_buffer_at_index(p, i);
+        if (buf->slot.ctx_id == ctx_id) {
+            sg_resource_state state = buf->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                if (state == SG_RESOURCESTATE_VALID) {
+                    _sg_memory_track_buffer(&buf->cmn, false);
+                }
+                _sg_discard_buffer(buf);
+                _sg_buffer_common_discard(&buf->cmn);
+            }
+        }
+    }
+    for (int i = 1; i < p->image_pool.size; i++) {
+        _sg_image_t* img = _sg_image_at_index(p, i);
+        if (img->slot.ctx_id == ctx_id) {
+            sg_resource_state state = img->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                if (state == SG_RESOURCESTATE_VALID) {
+                    _sg_memory_track_image(&img->cmn, false);
+                }
+                _sg_discard_image(img);
+            }
+        }
+    }
+    for (int i = 1; i < p->sampler_pool.size; i++) {
+        _sg_sampler_t* smp = _sg_sampler_at_index(p, i);
+        if (smp->slot.ctx_id == ctx_id) {
+            sg_resource_state state = smp->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                _sg_discard_sampler(smp);
+            }
+        }
+    }
+    for (int i = 1; i < p->shader_pool.size; i++) {
+        _sg_shader_t* shd = _sg_shader_at_index(p, i);
+        if (shd->slot.ctx_id == ctx_id) {
+            sg_resource_state state = shd->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED) || (state == SG_RESOURCESTATE_PENDING)) {
+                _sg_discard_shader(shd);
+            }
+        }
+    }
+    for (int i = 1; i < p->pipeline_pool.size; i++) {
+        _sg_pipeline_t* pip = _sg_pipeline_at_index(p, i);
+        if (pip->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pip->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                _sg_discard_pipeline(pip);
+            } else if (state == SG_RESOURCESTATE_PENDING) {
+                _sg_free(pip->cmn.pending_desc);
+                pip->cmn.pending_desc = 0;
+            }
+        }
+    }
+    for (int i = 1; i < p->pass_pool.size; i++) {
+        _sg_pass_t* pass = _sg_pass_at_index(p, i);
+        if (pass->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pass->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
+                _sg_discard_pass(pass);
+            }
+        }
+    }
+}
+
 _SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
     sg_buffer res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
+    int slot_index = _sg_pool_alloc_index_grow(&_sg.pools.buffer_pool, sizeof(_sg_buffer_t));
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg_buffer_at_index(&_sg.pools, slot_index)->slot, slot_index);
     } else {
         res.id = SG_INVALID_ID;
         _SG_ERROR(BUFFER_POOL_EXHAUSTED);
@@ -16603,9 +20912,9 @@ _SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
 
 _SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
     sg_image res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
+    int slot_index = _sg_pool_alloc_index_grow(&_sg.pools.image_pool, sizeof(_sg_image_t));
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg_image_at_index(&_sg.pools, slot_index)->slot, slot_index);
     } else {
         res.id = SG_INVALID_ID;
         _SG_ERROR(IMAGE_POOL_EXHAUSTED);
@@ -16615,9 +20924,9 @@ _SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
 
 _SOKOL_PRIVATE sg_sampler _sg_alloc_sampler(void) {
     sg_sampler res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.sampler_pool);
+    int slot_index = _sg_pool_alloc_index_grow(&_sg.pools.sampler_pool, sizeof(_sg_sampler_t));
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.sampler_pool, &_sg.pools.samplers[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.sampler_pool, &_sg_sampler_at_index(&_sg.pools, slot_index)->slot, slot_index);
     } else {
         res.id = SG_INVALID_ID;
         _SG_ERROR(SAMPLER_POOL_EXHAUSTED);
@@ -16627,9 +20936,9 @@ _SOKOL_PRIVATE sg_sampler _sg_alloc_sampler(void) {
 
 _SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
     sg_shader res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
+    int slot_index = _sg_pool_alloc_index_grow(&_sg.pools.shader_pool, sizeof(_sg_shader_t));
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg_shader_at_index(&_sg.pools, slot_index)->slot, slot_index);
     } else {
         res.id = SG_INVALID_ID;
         _SG_ERROR(SHADER_POOL_EXHAUSTED);
@@ -16639,9 +20948,9 @@ _SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
 
 _SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
     sg_pipeline res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
+    int slot_index = _sg_pool_alloc_index_grow(&_sg.pools.pipeline_pool, sizeof(_sg_pipeline_t));
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
+        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg_pipeline_at_index(&_sg.pools, slot_index)->slot, slot_index);
     } else {
         res.id = SG_INVALID_ID;
         _SG_ERROR(PIPELINE_POOL_EXHAUSTED);
@@ -16651,9 +20960,9 @@ _SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
 
 _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     sg_pass res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
+    int slot_index = _sg_pool_alloc_index_grow(&_sg.pools.pass_pool, sizeof(_sg_pass_t));
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg_pass_at_index(&_sg.pools, slot_index)->slot, slot_index);
     } else {
         res.id = SG_INVALID_ID;
         _SG_ERROR(PASS_POOL_EXHAUSTED);
@@ -16704,6 +21013,9 @@ _SOKOL_PRIVATE void _sg_init_buffer(_sg_buffer_t* buf, const sg_buffer_desc* des
     if (_sg_validate_buffer_desc(desc)) {
         _sg_buffer_common_init(&buf->cmn, desc);
         buf->slot.state = _sg_create_buffer(buf, desc);
+        if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+            _sg_memory_track_buffer(&buf->cmn, true);
+        }
     } else {
         buf->slot.state = SG_RESOURCESTATE_FAILED;
     }
@@ -16717,6 +21029,9 @@ _SOKOL_PRIVATE void _sg_init_image(_sg_image_t* img, const sg_image_desc* desc)
     if (_sg_validate_image_desc(desc)) {
         _sg_image_common_init(&img->cmn, desc);
         img->slot.state = _sg_create_image(img, desc);
+        if (img->slot.state == SG_RESOURCESTATE_VALID) {
+            _sg_memory_track_image(&img->cmn, true);
+        }
     } else {
         img->slot.state = SG_RESOURCESTATE_FAILED;
     }
@@ -16741,12 +21056,22 @@ _SOKOL_PRIVATE void _sg_init_shader(_sg_shader_t* shd, const sg_shader_desc* des
     SOKOL_ASSERT(desc);
     shd->slot.ctx_id = _sg.active_context.id;
     if (_sg_validate_shader_desc(desc)) {
-        _sg_shader_common_init(&shd->cmn, desc);
-        shd->slot.state = _sg_create_shader(shd, desc);
+        if (_sg_shader_desc_is_compute(desc)) {
+            // compute shaders occupy the vertex stage slot in the backends
+            sg_shader_desc cs_desc = *desc;
+            cs_desc.vs = desc->cs;
+            _sg_clear(&cs_desc.fs, sizeof(cs_desc.fs));
+            _sg_shader_common_init(&shd->cmn, &cs_desc);
+            shd->cmn.is_compute = true;
+            shd->slot.state = _sg_create_shader(shd, &cs_desc);
+        } else {
+            _sg_shader_common_init(&shd->cmn, desc);
+            shd->slot.state = _sg_create_shader(shd, desc);
+        }
     } else {
         shd->slot.state = SG_RESOURCESTATE_FAILED;
     }
-    SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID)||(shd->slot.state == SG_RESOURCESTATE_FAILED));
+    SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID)||(shd->slot.state == SG_RESOURCESTATE_FAILED)||(shd->slot.state == SG_RESOURCESTATE_PENDING));
 }
 
 _SOKOL_PRIVATE void _sg_init_pipeline(_sg_pipeline_t* pip, const sg_pipeline_desc* desc) {
@@ -16758,13 +21083,51 @@ _SOKOL_PRIVATE void _sg_init_pipeline(_sg_pipeline_t* pip, const sg_pipeline_des
         if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID)) {
             _sg_pipeline_common_init(&pip->cmn, desc);
             pip->slot.state = _sg_create_pipeline(pip, shd, desc);
+        } else if (shd && (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
+            // the backend pipeline is created in sg_commit() once the shader is ready
+            _sg_pipeline_common_init(&pip->cmn, desc);
+            pip->cmn.pending_desc = (sg_pipeline_desc*) _sg_malloc(sizeof(sg_pipeline_desc));
+            *pip->cmn.pending_desc = *desc;
+            pip->cmn.pending_desc->label = 0;
+            pip->slot.state = SG_RESOURCESTATE_PENDING;
         } else {
             pip->slot.state = SG_RESOURCESTATE_FAILED;
         }
     } else {
         pip->slot.state = SG_RESOURCESTATE_FAILED;
     }
-    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED));
+    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED)||(pip->slot.state == SG_RESOURCESTATE_PENDING));
+}
+
+// called from sg_commit() to finish shaders and pipelines which are waiting for the shader compiler
+_SOKOL_PRIVATE void _sg_update_pending_resources(void) {
+    _sg_pools_t* p = &_sg.pools;
+    for (int i = 1; i < p->shader_pool.size; i++) {
+        _sg_shader_t* shd = _sg_shader_at_index(p, i);
+        if ((shd->slot.state == SG_RESOURCESTATE_PENDING) && (shd->slot.ctx_id == _sg.active_context.id)) {
+            shd->slot.state = _sg_poll_shader(shd);
+        }
+    }
+    for (int i = 1; i < p->pipeline_pool.size; i++) {
+        _sg_pipeline_t* pip = _sg_pipeline_at_index(p, i);
+        if ((pip->slot.state != SG_RESOURCESTATE_PENDING) || (pip->slot.ctx_id != _sg.active_context.id)) {
+            continue;
+        }
+        _sg_shader_t* shd = _sg_lookup_shader(p, pip->cmn.shader_id.id);
+        if (shd && (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
+            continue;
+        }
+        sg_pipeline_desc* desc = pip->cmn.pending_desc;
+        SOKOL_ASSERT(desc);
+        pip->cmn.pending_desc = 0;
+        if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID)) {
+            pip->slot.state = _sg_create_pipeline(pip, shd, desc);
+        } else {
+            // the shader has failed or was destroyed
+            pip->slot.state = SG_RESOURCESTATE_FAILED;
+        }
+        _sg_free(desc);
+    }
 }
 
 _SOKOL_PRIVATE void _sg_init_pass(_sg_pass_t* pass, const sg_pass_desc* desc) {
@@ -16819,7 +21182,11 @@ _SOKOL_PRIVATE void _sg_init_pass(_sg_pass_t* pass, const sg_pass_desc* desc) {
 _SOKOL_PRIVATE void _sg_uninit_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf && ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)));
     if (buf->slot.ctx_id == _sg.active_context.id) {
-        _sg_discard_buffer(buf);
+        if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+            _sg_memory_track_buffer(&buf->cmn, false);
+        }
+        _sg_discard_buffer(buf);
+        _sg_buffer_common_discard(&buf->cmn);
         _sg_reset_buffer_to_alloc_state(buf);
     } else {
         _SG_WARN(UNINIT_BUFFER_ACTIVE_CONTEXT_MISMATCH);
@@ -16829,6 +21196,9 @@ _SOKOL_PRIVATE void _sg_uninit_buffer(_sg_buffer_t* buf) {
 _SOKOL_PRIVATE void _sg_uninit_image(_sg_image_t* img) {
     SOKOL_ASSERT(img && ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)));
     if (img->slot.ctx_id == _sg.active_context.id) {
+        if (img->slot.state == SG_RESOURCESTATE_VALID) {
+            _sg_memory_track_image(&img->cmn, false);
+        }
         _sg_discard_image(img);
         _sg_reset_image_to_alloc_state(img);
     } else {
@@ -16847,7 +21217,7 @@ _SOKOL_PRIVATE void _sg_uninit_sampler(_sg_sampler_t* smp) {
 }
 
 _SOKOL_PRIVATE void _sg_uninit_shader(_sg_shader_t* shd) {
-    SOKOL_ASSERT(shd && ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)));
+    SOKOL_ASSERT(shd && ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING)));
     if (shd->slot.ctx_id == _sg.active_context.id) {
         _sg_discard_shader(shd);
         _sg_reset_shader_to_alloc_state(shd);
@@ -16857,9 +21227,15 @@ _SOKOL_PRIVATE void _sg_uninit_shader(_sg_shader_t* shd) {
 }
 
 _SOKOL_PRIVATE void _sg_uninit_pipeline(_sg_pipeline_t* pip) {
-    SOKOL_ASSERT(pip && ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)));
+    SOKOL_ASSERT(pip && ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING)));
     if (pip->slot.ctx_id == _sg.active_context.id) {
-        _sg_discard_pipeline(pip);
+        if (pip->slot.state == SG_RESOURCESTATE_PENDING) {
+            // the backend pipeline hasn't been created yet
+            _sg_free(pip->cmn.pending_desc);
+            pip->cmn.pending_desc = 0;
+        } else {
+            _sg_discard_pipeline(pip);
+        }
         _sg_reset_pipeline_to_alloc_state(pip);
     } else {
         _SG_WARN(UNINIT_PIPELINE_ACTIVE_CONTEXT_MISMATCH);
@@ -16952,1030 +21328,3298 @@ _SOKOL_PRIVATE bool _sg_remove_commit_listener(const sg_commit_listener* listene
     return false;
 }
 
-_SOKOL_PRIVATE sg_desc _sg_desc_defaults(const sg_desc* desc) {
-    /*
-        NOTE: on WebGPU, the default color pixel format MUST be provided,
-        cannot be a default compile-time constant.
-    */
-    sg_desc res = *desc;
-    #if defined(SOKOL_WGPU)
-        SOKOL_ASSERT(SG_PIXELFORMAT_NONE != res.context.color_format);
-    #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
-        res.context.color_format = _sg_def(res.context.color_format, SG_PIXELFORMAT_BGRA8);
-    #else
-        res.context.color_format = _sg_def(res.context.color_format, SG_PIXELFORMAT_RGBA8);
-    #endif
-    res.context.depth_format = _sg_def(res.context.depth_format, SG_PIXELFORMAT_DEPTH_STENCIL);
-    res.context.sample_count = _sg_def(res.context.sample_count, 1);
-    res.buffer_pool_size = _sg_def(res.buffer_pool_size, _SG_DEFAULT_BUFFER_POOL_SIZE);
-    res.image_pool_size = _sg_def(res.image_pool_size, _SG_DEFAULT_IMAGE_POOL_SIZE);
-    res.sampler_pool_size = _sg_def(res.sampler_pool_size, _SG_DEFAULT_SAMPLER_POOL_SIZE);
-    res.shader_pool_size = _sg_def(res.shader_pool_size, _SG_DEFAULT_SHADER_POOL_SIZE);
-    res.pipeline_pool_size = _sg_def(res.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
-    res.pass_pool_size = _sg_def(res.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
-    res.context_pool_size = _sg_def(res.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
-    res.uniform_buffer_size = _sg_def(res.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
-    res.max_commit_listeners = _sg_def(res.max_commit_listeners, _SG_DEFAULT_MAX_COMMIT_LISTENERS);
-    res.wgpu_bindgroups_cache_size = _sg_def(res.wgpu_bindgroups_cache_size, _SG_DEFAULT_WGPU_BINDGROUP_CACHE_SIZE);
-    return res;
+_SOKOL_PRIVATE void _sg_uniform_cache_reset(void) {
+    _sg_clear(&_sg.uniform_cache, sizeof(_sg.uniform_cache));
 }
 
-// ██████  ██    ██ ██████  ██      ██  ██████
-// ██   ██ ██    ██ ██   ██ ██      ██ ██
-// ██████  ██    ██ ██████  ██      ██ ██
-// ██      ██    ██ ██   ██ ██      ██ ██
-// ██       ██████  ██████  ███████ ██  ██████
-//
-// >>public
-SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
-    SOKOL_ASSERT(desc);
-    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
-    SOKOL_ASSERT((desc->allocator.alloc_fn && desc->allocator.free_fn) || (!desc->allocator.alloc_fn && !desc->allocator.free_fn));
-    _SG_CLEAR_ARC_STRUCT(_sg_state_t, _sg);
-    _sg.desc = _sg_desc_defaults(desc);
-    _sg_setup_pools(&_sg.pools, &_sg.desc);
-    _sg_setup_commit_listeners(&_sg.desc);
-    _sg.frame_index = 1;
-    _sg.stats_enabled = true;
-    _sg_setup_backend(&_sg.desc);
-    _sg.valid = true;
-    sg_setup_context();
+// returns true if the uniform data is identical with the data of the previous
+// sg_apply_uniforms() call on the same stage and slot since the last pipeline
+// change, otherwise the data is copied into the cache and false is returned
+_SOKOL_PRIVATE bool _sg_uniform_cache_test_and_set(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    if (_sg.desc.disable_uniform_cache) {
+        return false;
+    }
+    _sg_uniform_cache_item_t* item = &_sg.uniform_cache.items[stage][ub_index];
+    if (data->size > _SG_UNIFORM_CACHE_MAX_SIZE) {
+        item->valid = false;
+        return false;
+    }
+    if (item->valid && (item->size == data->size) && (0 == memcmp(item->data, data->ptr, data->size))) {
+        return true;
+    }
+    item->valid = true;
+    item->size = (uint32_t)data->size;
+    memcpy(item->data, data->ptr, data->size);
+    return false;
 }
 
-SOKOL_API_IMPL void sg_shutdown(void) {
-    /* can only delete resources for the currently set context here, if multiple
-    contexts are used, the app code must take care of properly releasing them
-    (since only the app code can switch between 3D-API contexts)
-    */
-    if (_sg.active_context.id != SG_INVALID_ID) {
-        _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, _sg.active_context.id);
-        if (ctx) {
-            _sg_discard_all_resources(&_sg.pools, _sg.active_context.id);
-            _sg_discard_context(ctx);
+// (re-)build the hash table from the cache items, this also drops all tombstones
+_SOKOL_PRIVATE void _sg_pipeline_cache_rebuild_table(void) {
+    _sg_pipeline_cache_t* cache = &_sg.pipeline_cache;
+    int table_size = 16;
+    while (table_size < (2 * cache->num_items)) {
+        table_size *= 2;
+    }
+    if (table_size != cache->table_size) {
+        if (cache->table) {
+            _sg_free(cache->table);
+        }
+        cache->table_size = table_size;
+        cache->table = (int*) _sg_malloc(sizeof(int) * (size_t)table_size);
+    }
+    _sg_clear(cache->table, sizeof(int) * (size_t)cache->table_size);
+    cache->num_used = 0;
+    const uint32_t mask = (uint32_t)(cache->table_size - 1);
+    for (int slot_index = 1; slot_index < cache->num_items; slot_index++) {
+        const _sg_pipeline_cache_item_t* item = &cache->items[slot_index];
+        if (item->pip_id != SG_INVALID_ID) {
+            uint32_t i = (uint32_t)item->hash & mask;
+            while (cache->table[i] != _SG_PIPELINE_CACHE_EMPTY) {
+                i = (i + 1) & mask;
+            }
+            cache->table[i] = slot_index;
+            cache->num_used++;
         }
     }
-    _sg_discard_backend();
-    _sg_discard_commit_listeners();
-    _sg_discard_pools(&_sg.pools);
-    _SG_CLEAR_ARC_STRUCT(_sg_state_t, _sg);
-}
-
-SOKOL_API_IMPL bool sg_isvalid(void) {
-    return _sg.valid;
-}
-
-SOKOL_API_IMPL sg_desc sg_query_desc(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.desc;
-}
-
-SOKOL_API_IMPL sg_backend sg_query_backend(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.backend;
 }
 
-SOKOL_API_IMPL sg_features sg_query_features(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.features;
-}
-
-SOKOL_API_IMPL sg_limits sg_query_limits(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.limits;
+_SOKOL_PRIVATE void _sg_setup_pipeline_cache(const sg_desc* desc) {
+    SOKOL_ASSERT(0 == _sg.pipeline_cache.items);
+    if (desc->enable_pipeline_cache) {
+        _sg.pipeline_cache.num_items = _sg.pools.pipeline_pool.size;
+        const size_t size = sizeof(_sg_pipeline_cache_item_t) * (size_t)_sg.pipeline_cache.num_items;
+        _sg.pipeline_cache.items = (_sg_pipeline_cache_item_t*) _sg_malloc_clear(size);
+        _sg_pipeline_cache_rebuild_table();
+    }
 }
 
-SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
-    SOKOL_ASSERT(_sg.valid);
-    int fmt_index = (int) fmt;
-    SOKOL_ASSERT((fmt_index > SG_PIXELFORMAT_NONE) && (fmt_index < _SG_PIXELFORMAT_NUM));
-    return _sg.formats[fmt_index];
+_SOKOL_PRIVATE void _sg_discard_pipeline_cache(void) {
+    if (_sg.pipeline_cache.items) {
+        _sg_free(_sg.pipeline_cache.items);
+        _sg_free(_sg.pipeline_cache.table);
+        _sg_clear(&_sg.pipeline_cache, sizeof(_sg.pipeline_cache));
+    }
 }
 
-SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
-    SOKOL_ASSERT(_sg.valid);
-    return _sg.prev_stats;
+// returns the hash table index of a cached pipeline slot index
+_SOKOL_PRIVATE int _sg_pipeline_cache_find_entry(int slot_index) {
+    _sg_pipeline_cache_t* cache = &_sg.pipeline_cache;
+    const uint32_t mask = (uint32_t)(cache->table_size - 1);
+    uint32_t i = (uint32_t)cache->items[slot_index].hash & mask;
+    while (cache->table[i] != _SG_PIPELINE_CACHE_EMPTY) {
+        if (cache->table[i] == slot_index) {
+            return (int)i;
+        }
+        i = (i + 1) & mask;
+    }
+    SOKOL_UNREACHABLE;
+    return -1;
 }
 
-SOKOL_API_IMPL sg_context sg_setup_context(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_context res;
-    int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
-    if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &_sg.pools.contexts[slot_index].slot, slot_index);
-        _sg_context_t* ctx = _sg_context_at(&_sg.pools, res.id);
-        ctx->slot.state = _sg_create_context(ctx);
-        SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
-        _sg_activate_context(ctx);
-    } else {
-        // pool is exhausted
-        res.id = SG_INVALID_ID;
+// removes an item from the hash table and clears it
+_SOKOL_PRIVATE void _sg_pipeline_cache_remove(int slot_index) {
+    _sg_pipeline_cache_t* cache = &_sg.pipeline_cache;
+    const int entry_index = _sg_pipeline_cache_find_entry(slot_index);
+    if (entry_index >= 0) {
+        cache->table[entry_index] = _SG_PIPELINE_CACHE_REMOVED;
     }
-    _sg.active_context = res;
-    return res;
+    _sg_clear(&cache->items[slot_index], sizeof(_sg_pipeline_cache_item_t));
 }
 
-SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_discard_all_resources(&_sg.pools, ctx_id.id);
-    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
-    if (ctx) {
-        _sg_discard_context(ctx);
-        _sg_reset_context_to_alloc_state(ctx);
-        _sg_reset_slot(&ctx->slot);
-        _sg_pool_free_index(&_sg.pools.context_pool, _sg_slot_index(ctx_id.id));
+// the cache key is the defaults-patched desc without the label, copied
+// member by member into a zeroed struct so that padding bytes are zero
+_SOKOL_PRIVATE uint64_t _sg_pipeline_cache_key(const sg_pipeline_desc* desc_def, sg_pipeline_desc* key) {
+    _sg_clear(key, sizeof(sg_pipeline_desc));
+    key->shader.id = desc_def->shader.id;
+    for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++) {
+        const sg_vertex_buffer_layout_state* src = &desc_def->layout.buffers[i];
+        sg_vertex_buffer_layout_state* dst = &key->layout.buffers[i];
+        dst->stride = src->stride;
+        dst->step_func = src->step_func;
+        dst->step_rate = src->step_rate;
     }
-    _sg.active_context.id = SG_INVALID_ID;
-    _sg_activate_context(0);
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        const sg_vertex_attr_state* src = &desc_def->layout.attrs[i];
+        sg_vertex_attr_state* dst = &key->layout.attrs[i];
+        dst->buffer_index = src->buffer_index;
+        dst->offset = src->offset;
+        dst->format = src->format;
+    }
+    key->depth.pixel_format = desc_def->depth.pixel_format;
+    key->depth.compare = desc_def->depth.compare;
+    key->depth.write_enabled = desc_def->depth.write_enabled;
+    key->depth.bias = desc_def->depth.bias;
+    key->depth.bias_slope_scale = desc_def->depth.bias_slope_scale;
+    key->depth.bias_clamp = desc_def->depth.bias_clamp;
+    key->stencil.enabled = desc_def->stencil.enabled;
+    key->stencil.front.compare = desc_def->stencil.front.compare;
+    key->stencil.front.fail_op = desc_def->stencil.front.fail_op;
+    key->stencil.front.depth_fail_op = desc_def->stencil.front.depth_fail_op;
+    key->stencil.front.pass_op = desc_def->stencil.front.pass_op;
+    key->stencil.back.compare = desc_def->stencil.back.compare;
+    key->stencil.back.fail_op = desc_def->stencil.back.fail_op;
+    key->stencil.back.depth_fail_op = desc_def->stencil.back.depth_fail_op;
+    key->stencil.back.pass_op = desc_def->stencil.back.pass_op;
+    key->stencil.read_mask = desc_def->stencil.read_mask;
+    key->stencil.write_mask = desc_def->stencil.write_mask;
+    key->stencil.ref = desc_def->stencil.ref;
+    key->color_count = desc_def->color_count;
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        const sg_color_target_state* src = &desc_def->colors[i];
+        sg_color_target_state* dst = &key->colors[i];
+        dst->pixel_format = src->pixel_format;
+        dst->write_mask = src->write_mask;
+        dst->blend.enabled = src->blend.enabled;
+        dst->blend.src_factor_rgb = src->blend.src_factor_rgb;
+        dst->blend.dst_factor_rgb = src->blend.dst_factor_rgb;
+        dst->blend.op_rgb = src->blend.op_rgb;
+        dst->blend.src_factor_alpha = src->blend.src_factor_alpha;
+        dst->blend.dst_factor_alpha = src->blend.dst_factor_alpha;
+        dst->blend.op_alpha = src->blend.op_alpha;
+    }
+    key->primitive_type = desc_def->primitive_type;
+    key->index_type = desc_def->index_type;
+    key->cull_mode = desc_def->cull_mode;
+    key->face_winding = desc_def->face_winding;
+    key->sample_count = desc_def->sample_count;
+    key->blend_color.r = desc_def->blend_color.r;
+    key->blend_color.g = desc_def->blend_color.g;
+    key->blend_color.b = desc_def->blend_color.b;
+    key->blend_color.a = desc_def->blend_color.a;
+    key->alpha_to_coverage_enabled = desc_def->alpha_to_coverage_enabled;
+    key->compute = desc_def->compute;
+    return _sg_hash(key, (int)sizeof(sg_pipeline_desc), 0x8765432112345678);
+}
+
+// returns the id of a cached pipeline and increments its reference count, or SG_INVALID_ID
+_SOKOL_PRIVATE uint32_t _sg_pipeline_cache_get(const sg_pipeline_desc* key, uint64_t hash) {
+    _sg_pipeline_cache_t* cache = &_sg.pipeline_cache;
+    SOKOL_ASSERT(cache->items && cache->table);
+    const uint32_t mask = (uint32_t)(cache->table_size - 1);
+    uint32_t i = (uint32_t)hash & mask;
+    while (cache->table[i] != _SG_PIPELINE_CACHE_EMPTY) {
+        const int slot_index = cache->table[i];
+        i = (i + 1) & mask;
+        if (slot_index == _SG_PIPELINE_CACHE_REMOVED) {
+            continue;
+        }
+        _sg_pipeline_cache_item_t* item = &cache->items[slot_index];
+        if ((item->hash == hash) && (0 == memcmp(&item->desc, key, sizeof(sg_pipeline_desc)))) {
+            // the pipeline might have been destroyed through sg_uninit_pipeline() / sg_dealloc_pipeline()
+            const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, item->pip_id);
+            if (pip && (pip->slot.state == SG_RESOURCESTATE_VALID)) {
+                item->ref_count++;
+                return item->pip_id;
+            }
+            _sg_pipeline_cache_remove(slot_index);
+        }
+    }
+    return SG_INVALID_ID;
+}
+
+_SOKOL_PRIVATE void _sg_pipeline_cache_add(uint32_t pip_id, const sg_pipeline_desc* key, uint64_t hash) {
+    SOKOL_ASSERT(_sg.pipeline_cache.items && (pip_id != SG_INVALID_ID));
+    const int slot_index = _sg_slot_index(pip_id);
+    if (slot_index >= _sg.pipeline_cache.num_items) {
+        // the pipeline pool has grown
+        const int num_items = _sg.pools.pipeline_pool.size;
+        SOKOL_ASSERT(slot_index < num_items);
+        _sg_pipeline_cache_item_t* items = (_sg_pipeline_cache_item_t*) _sg_malloc_clear(sizeof(_sg_pipeline_cache_item_t) * (size_t)num_items);
+        memcpy(items, _sg.pipeline_cache.items, sizeof(_sg_pipeline_cache_item_t) * (size_t)_sg.pipeline_cache.num_items);
+        _sg_free(_sg.pipeline_cache.items);
+        _sg.pipeline_cache.items = items;
+        _sg.pipeline_cache.num_items = num_items;
+        _sg_pipeline_cache_rebuild_table();
+    }
+    _sg_pipeline_cache_t* cache = &_sg.pipeline_cache;
+    _sg_pipeline_cache_item_t* item = &cache->items[slot_index];
+    if (item->pip_id != SG_INVALID_ID) {
+        // a stale item of a pipeline destroyed through sg_uninit_pipeline() / sg_dealloc_pipeline()
+        _sg_pipeline_cache_remove(slot_index);
+    }
+    if ((4 * (cache->num_used + 1)) > (3 * cache->table_size)) {
+        // too many tombstones
+        _sg_pipeline_cache_rebuild_table();
+    }
+    item->pip_id = pip_id;
+    item->ref_count = 1;
+    item->hash = hash;
+    memcpy(&item->desc, key, sizeof(sg_pipeline_desc));
+    const uint32_t mask = (uint32_t)(cache->table_size - 1);
+    uint32_t i = (uint32_t)hash & mask;
+    while ((cache->table[i] != _SG_PIPELINE_CACHE_EMPTY) && (cache->table[i] != _SG_PIPELINE_CACHE_REMOVED)) {
+        i = (i + 1) & mask;
+    }
+    if (cache->table[i] == _SG_PIPELINE_CACHE_EMPTY) {
+        cache->num_used++;
+    }
+    cache->table[i] = slot_index;
+}
+
+// releases a reference to a cached pipeline, returns true if the pipeline is still in use
+_SOKOL_PRIVATE bool _sg_pipeline_cache_release(uint32_t pip_id) {
+    if (0 == _sg.pipeline_cache.items) {
+        return false;
+    }
+    const int slot_index = _sg_slot_index(pip_id);
+    if (slot_index >= _sg.pipeline_cache.num_items) {
+        return false;
+    }
+    _sg_pipeline_cache_item_t* item = &_sg.pipeline_cache.items[slot_index];
+    if (item->pip_id != pip_id) {
+        return false;
+    }
+    SOKOL_ASSERT(item->ref_count > 0);
+    if (--item->ref_count > 0) {
+        return true;
+    }
+    _sg_pipeline_cache_remove(slot_index);
+    return false;
 }
 
-SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg.active_context = ctx_id;
-    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
-    // NOTE: ctx can be 0 here if the context is no longer valid
-    _sg_activate_context(ctx);
+_SOKOL_PRIVATE void _sg_setup_transients(const sg_desc* desc) {
+    SOKOL_ASSERT(0 == _sg.transients.items);
+    SOKOL_ASSERT(desc->transient_pool_size > 0);
+    _sg.transients.num_items = desc->transient_pool_size;
+    const size_t size = sizeof(_sg_transient_item_t) * (size_t)_sg.transients.num_items;
+    _sg.transients.items = (_sg_transient_item_t*) _sg_malloc_clear(size);
 }
 
-SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(trace_hooks);
-    _SOKOL_UNUSED(trace_hooks);
-    #if defined(SOKOL_TRACE_HOOKS)
-        sg_trace_hooks old_hooks = _sg.hooks;
-        _sg.hooks = *trace_hooks;
-    #else
-        static sg_trace_hooks old_hooks;
-        _SG_WARN(TRACE_HOOKS_NOT_ENABLED);
-    #endif
-    return old_hooks;
+// NOTE: the transient images and passes themselves are destroyed with all other resources
+_SOKOL_PRIVATE void _sg_discard_transients(void) {
+    if (_sg.transients.items) {
+        _sg_free(_sg.transients.items);
+    }
+    _sg_clear(&_sg.transients, sizeof(_sg.transients));
 }
 
-SOKOL_API_IMPL sg_buffer sg_alloc_buffer(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_buffer res = _sg_alloc_buffer();
-    _SG_TRACE_ARGS(alloc_buffer, res);
-    return res;
+_SOKOL_PRIVATE sg_transient_image_desc _sg_transient_image_key(const sg_transient_image_desc* desc, uint64_t* out_hash) {
+    sg_transient_image_desc key;
+    _sg_clear(&key, sizeof(key));
+    key.width = desc->width;
+    key.height = desc->height;
+    key.pixel_format = _sg_def(desc->pixel_format, _sg.desc.context.color_format);
+    key.sample_count = _sg_def(desc->sample_count, _sg.desc.context.sample_count);
+    *out_hash = _sg_hash(&key, (int)sizeof(key), 0x1234567887654321);
+    return key;
 }
 
-SOKOL_API_IMPL sg_image sg_alloc_image(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_image res = _sg_alloc_image();
-    _SG_TRACE_ARGS(alloc_image, res);
-    return res;
+// copied attachment by attachment so that struct padding doesn't end up in the key
+_SOKOL_PRIVATE sg_pass_desc _sg_transient_pass_key(const sg_pass_desc* desc, uint64_t* out_hash) {
+    sg_pass_desc key;
+    _sg_clear(&key, sizeof(key));
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        key.color_attachments[i] = desc->color_attachments[i];
+        key.resolve_attachments[i] = desc->resolve_attachments[i];
+    }
+    key.depth_stencil_attachment = desc->depth_stencil_attachment;
+    *out_hash = _sg_hash(&key, (int)sizeof(key), 0x1234567887654321);
+    return key;
 }
 
-SOKOL_API_IMPL sg_sampler sg_alloc_sampler(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_sampler res = _sg_alloc_sampler();
-    _SG_TRACE_ARGS(alloc_sampler, res);
-    return res;
+_SOKOL_PRIVATE bool _sg_transient_pass_uses_image(const sg_pass_desc* key, uint32_t img_id) {
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        if ((key->color_attachments[i].image.id == img_id) || (key->resolve_attachments[i].image.id == img_id)) {
+            return true;
+        }
+    }
+    return key->depth_stencil_attachment.image.id == img_id;
 }
 
-SOKOL_API_IMPL sg_shader sg_alloc_shader(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_shader res = _sg_alloc_shader();
-    _SG_TRACE_ARGS(alloc_shader, res);
-    return res;
+// checks that the image or pass of a transient item hasn't been destroyed from the outside
+_SOKOL_PRIVATE bool _sg_transient_item_alive(const _sg_transient_item_t* item) {
+    if (item->is_pass) {
+        const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, item->id);
+        return pass && (pass->slot.state == SG_RESOURCESTATE_VALID);
+    } else {
+        const _sg_image_t* img = _sg_lookup_image(&_sg.pools, item->id);
+        return img && (img->slot.state == SG_RESOURCESTATE_VALID);
+    }
 }
 
-SOKOL_API_IMPL sg_pipeline sg_alloc_pipeline(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_pipeline res = _sg_alloc_pipeline();
-    _SG_TRACE_ARGS(alloc_pipeline, res);
-    return res;
+_SOKOL_PRIVATE void _sg_transient_free_item(_sg_transient_item_t* item) {
+    SOKOL_ASSERT(item->id != SG_INVALID_ID);
+    SOKOL_ASSERT(_sg.transients.size >= item->size);
+    _sg.transients.size -= item->size;
+    _sg_clear(item, sizeof(_sg_transient_item_t));
 }
 
-SOKOL_API_IMPL sg_pass sg_alloc_pass(void) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_pass res = _sg_alloc_pass();
-    _SG_TRACE_ARGS(alloc_pass, res);
-    return res;
+_SOKOL_PRIVATE void _sg_transient_destroy_item(_sg_transient_item_t* item) {
+    SOKOL_ASSERT(item->id != SG_INVALID_ID);
+    if (item->is_pass) {
+        const sg_pass pass_id = { item->id };
+        sg_destroy_pass(pass_id);
+    } else {
+        // passes which render into the image must go too, those are never in use
+        // (see _sg_transient_image_evictable())
+        const sg_image img_id = { item->id };
+        for (int i = 0; i < _sg.transients.num_items; i++) {
+            _sg_transient_item_t* pass_item = &_sg.transients.items[i];
+            if ((pass_item->id != SG_INVALID_ID) && pass_item->is_pass && _sg_transient_pass_uses_image(&pass_item->pass_key, img_id.id)) {
+                SOKOL_ASSERT(!pass_item->in_use);
+                const sg_pass pass_id = { pass_item->id };
+                sg_destroy_pass(pass_id);
+                _sg_transient_free_item(pass_item);
+            }
+        }
+        sg_destroy_image(img_id);
+    }
+    _sg_transient_free_item(item);
 }
 
-SOKOL_API_IMPL void sg_dealloc_buffer(sg_buffer buf_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    if (buf) {
-        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_buffer(buf);
-        } else {
-            _SG_ERROR(DEALLOC_BUFFER_INVALID_STATE);
+// returns the index of a matching transient image which is not in use, or -1
+_SOKOL_PRIVATE int _sg_transient_find_image(const sg_transient_image_desc* key, uint64_t hash) {
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        _sg_transient_item_t* item = &_sg.transients.items[i];
+        if ((item->id != SG_INVALID_ID) && !item->is_pass && !item->in_use && (item->hash == hash) && (0 == memcmp(&item->img_key, key, sizeof(sg_transient_image_desc)))) {
+            if (_sg_transient_item_alive(item)) {
+                return i;
+            }
+            _sg_transient_free_item(item);
         }
     }
-    _SG_TRACE_ARGS(dealloc_buffer, buf_id);
+    return -1;
 }
 
-SOKOL_API_IMPL void sg_dealloc_image(sg_image img_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    if (img) {
-        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_image(img);
-        } else {
-            _SG_ERROR(DEALLOC_IMAGE_INVALID_STATE);
+// returns the index of a transient pass with identical attachments, or -1
+_SOKOL_PRIVATE int _sg_transient_find_pass(const sg_pass_desc* key, uint64_t hash) {
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        _sg_transient_item_t* item = &_sg.transients.items[i];
+        if ((item->id != SG_INVALID_ID) && item->is_pass && (item->hash == hash) && (0 == memcmp(&item->pass_key, key, sizeof(sg_pass_desc)))) {
+            if (_sg_transient_item_alive(item)) {
+                return i;
+            }
+            _sg_transient_free_item(item);
         }
     }
-    _SG_TRACE_ARGS(dealloc_image, img_id);
+    return -1;
 }
 
-SOKOL_API_IMPL void sg_dealloc_sampler(sg_sampler smp_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
-    if (smp) {
-        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_sampler(smp);
-        } else {
-            _SG_ERROR(DEALLOC_SAMPLER_INVALID_STATE);
+// an unused transient image can't be evicted while a transient pass which renders into it is in use
+_SOKOL_PRIVATE bool _sg_transient_image_evictable(const _sg_transient_item_t* img_item) {
+    SOKOL_ASSERT(!img_item->is_pass);
+    if (img_item->in_use) {
+        return false;
+    }
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        const _sg_transient_item_t* pass_item = &_sg.transients.items[i];
+        if ((pass_item->id != SG_INVALID_ID) && pass_item->is_pass && pass_item->in_use && _sg_transient_pass_uses_image(&pass_item->pass_key, img_item->id)) {
+            return false;
         }
     }
-    _SG_TRACE_ARGS(dealloc_sampler, smp_id);
+    return true;
 }
 
-SOKOL_API_IMPL void sg_dealloc_shader(sg_shader shd_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    if (shd) {
-        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_shader(shd);
-        } else {
-            _SG_ERROR(DEALLOC_SHADER_INVALID_STATE);
+// returns the index of a free item, evicts the least recently used item if necessary, or -1
+_SOKOL_PRIVATE int _sg_transient_alloc_item(void) {
+    int lru_index = -1;
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        const _sg_transient_item_t* item = &_sg.transients.items[i];
+        if (item->id == SG_INVALID_ID) {
+            return i;
+        }
+        if (item->is_pass ? !item->in_use : _sg_transient_image_evictable(item)) {
+            if ((lru_index < 0) || (item->last_frame_index < _sg.transients.items[lru_index].last_frame_index)) {
+                lru_index = i;
+            }
         }
     }
-    _SG_TRACE_ARGS(dealloc_shader, shd_id);
+    if (lru_index >= 0) {
+        _sg_transient_destroy_item(&_sg.transients.items[lru_index]);
+    }
+    return lru_index;
 }
 
-SOKOL_API_IMPL void sg_dealloc_pipeline(sg_pipeline pip_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    if (pip) {
-        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_pipeline(pip);
-        } else {
-            _SG_ERROR(DEALLOC_PIPELINE_INVALID_STATE);
+// called from sg_commit(), hands back all transient objects and destroys unused ones
+_SOKOL_PRIVATE void _sg_transient_commit(void) {
+    // hand back everything first, so that no pass is in use when its image is destroyed
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        _sg.transients.items[i].in_use = false;
+    }
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        _sg_transient_item_t* item = &_sg.transients.items[i];
+        if (item->id == SG_INVALID_ID) {
+            continue;
+        }
+        if (!_sg_transient_item_alive(item)) {
+            _sg_transient_free_item(item);
+        } else if ((_sg.frame_index - item->last_frame_index) >= _SG_TRANSIENT_MAX_IDLE_FRAMES) {
+            _sg_transient_destroy_item(item);
         }
     }
-    _SG_TRACE_ARGS(dealloc_pipeline, pip_id);
 }
 
-SOKOL_API_IMPL void sg_dealloc_pass(sg_pass pass_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass) {
-        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_pass(pass);
-        } else {
-            _SG_ERROR(DEALLOC_PASS_INVALID_STATE);
-        }
+// grow a recording array so that at least num_required items fit into it
+_SOKOL_PRIVATE void* _sg_recording_grow(void* items, int num_items, int* max_items, int num_required, size_t item_size) {
+    SOKOL_ASSERT(max_items && (num_items <= *max_items) && (item_size > 0));
+    if (num_required <= *max_items) {
+        return items;
     }
-    _SG_TRACE_ARGS(dealloc_pass, pass_id);
+    int new_max_items = (*max_items > 0) ? *max_items : 16;
+    while (new_max_items < num_required) {
+        new_max_items *= 2;
+    }
+    void* new_items = _sg_malloc((size_t)new_max_items * item_size);
+    if (items) {
+        memcpy(new_items, items, (size_t)num_items * item_size);
+        _sg_free(items);
+    }
+    *max_items = new_max_items;
+    return new_items;
 }
 
-SOKOL_API_IMPL void sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_buffer_desc desc_def = _sg_buffer_desc_defaults(desc);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    if (buf) {
-        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_init_buffer(buf, &desc_def);
-            SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED));
-        } else {
-            _SG_ERROR(INIT_BUFFER_INVALID_STATE);
+_SOKOL_PRIVATE _sg_recording_t* _sg_current_recording(void) {
+    SOKOL_ASSERT(_sg.rec.active);
+    // NOTE: may return 0 if the recording pool was exhausted in sg_begin_recording()
+    return _sg_lookup_recording(&_sg.pools, _sg.rec.id.id);
+}
+
+_SOKOL_PRIVATE _sg_reccmd_t* _sg_recording_next_cmd(_sg_recording_t* rec, _sg_reccmd_type_t type) {
+    SOKOL_ASSERT(rec && (rec->slot.state == SG_RESOURCESTATE_ALLOC));
+    rec->cmds = (_sg_reccmd_t*) _sg_recording_grow(rec->cmds, rec->num_cmds, &rec->max_cmds, rec->num_cmds + 1, sizeof(_sg_reccmd_t));
+    _sg_reccmd_t* cmd = &rec->cmds[rec->num_cmds++];
+    _sg_clear(cmd, sizeof(_sg_reccmd_t));
+    cmd->type = type;
+    return cmd;
+}
+
+_SOKOL_PRIVATE void _sg_recording_add_ref(_sg_recording_t* rec, const _sg_slot_t* slot) {
+    SOKOL_ASSERT(rec && slot);
+    // skip the most common duplicates (e.g. the same buffer bound in consecutive draws)
+    for (int i = rec->num_refs - 1; (i >= 0) && (i >= (rec->num_refs - 8)); i--) {
+        if (rec->refs[i].slot == slot) {
+            return;
         }
     }
-    _SG_TRACE_ARGS(init_buffer, buf_id, &desc_def);
+    rec->refs = (_sg_recref_t*) _sg_recording_grow(rec->refs, rec->num_refs, &rec->max_refs, rec->num_refs + 1, sizeof(_sg_recref_t));
+    _sg_recref_t* ref = &rec->refs[rec->num_refs++];
+    ref->slot = slot;
+    ref->id = slot->id;
 }
 
-SOKOL_API_IMPL void sg_init_image(sg_image img_id, const sg_image_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_image_desc desc_def = _sg_image_desc_defaults(desc);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    if (img) {
-        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_init_image(img, &desc_def);
-            SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED));
-        } else {
-            _SG_ERROR(INIT_IMAGE_INVALID_STATE);
-        }
+_SOKOL_PRIVATE void _sg_record_rect(_sg_reccmd_type_t type, int x, int y, int w, int h, bool origin_top_left) {
+    _sg_recording_t* rec = _sg_current_recording();
+    if (rec) {
+        _sg_reccmd_t* cmd = _sg_recording_next_cmd(rec, type);
+        cmd->args.rect.x = x;
+        cmd->args.rect.y = y;
+        cmd->args.rect.width = w;
+        cmd->args.rect.height = h;
+        cmd->args.rect.origin_top_left = origin_top_left;
     }
-    _SG_TRACE_ARGS(init_image, img_id, &desc_def);
 }
 
-SOKOL_API_IMPL void sg_init_sampler(sg_sampler smp_id, const sg_sampler_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_sampler_desc desc_def = _sg_sampler_desc_defaults(desc);
-    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
-    if (smp) {
-        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_init_sampler(smp, &desc_def);
-            SOKOL_ASSERT((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED));
-        } else {
-            _SG_ERROR(INIT_SAMPLER_INVALID_STATE);
-        }
+_SOKOL_PRIVATE void _sg_record_apply_pipeline(_sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip && pip->shader);
+    _sg_recording_t* rec = _sg_current_recording();
+    if (rec && (pip->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_recording_add_ref(rec, &pip->slot);
+        _sg_recording_add_ref(rec, &pip->shader->slot);
+        _sg_reccmd_t* cmd = _sg_recording_next_cmd(rec, _SG_RECCMD_APPLY_PIPELINE);
+        cmd->args.pip = pip;
+        rec->last_pipeline.id = pip->slot.id;
     }
-    _SG_TRACE_ARGS(init_sampler, smp_id, &desc_def);
 }
 
-SOKOL_API_IMPL void sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_shader_desc desc_def = _sg_shader_desc_defaults(desc);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    if (shd) {
-        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_init_shader(shd, &desc_def);
-            SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED));
-        } else {
-            _SG_ERROR(INIT_SHADER_INVALID_STATE);
+_SOKOL_PRIVATE void _sg_record_apply_bindings(const _sg_bindings_t* bnd) {
+    SOKOL_ASSERT(bnd && bnd->pip);
+    _sg_recording_t* rec = _sg_current_recording();
+    if (rec) {
+        // the pipeline may have been applied before sg_begin_recording(), record it
+        // too so that the replayed bindings don't depend on the pipeline applied at
+        // replay time (this also keeps a liveness reference on the pipeline and shader)
+        if (rec->last_pipeline.id != bnd->pip->slot.id) {
+            _sg_record_apply_pipeline(bnd->pip);
+        }
+        for (int i = 0; i < bnd->num_vbs; i++) {
+            _sg_recording_add_ref(rec, &bnd->vbs[i]->slot);
+        }
+        if (bnd->ib) {
+            _sg_recording_add_ref(rec, &bnd->ib->slot);
+        }
+        for (int i = 0; i < bnd->num_vs_imgs; i++) {
+            _sg_recording_add_ref(rec, &bnd->vs_imgs[i]->slot);
+        }
+        for (int i = 0; i < bnd->num_vs_smps; i++) {
+            _sg_recording_add_ref(rec, &bnd->vs_smps[i]->slot);
+        }
+        for (int i = 0; i < bnd->num_fs_imgs; i++) {
+            _sg_recording_add_ref(rec, &bnd->fs_imgs[i]->slot);
+        }
+        for (int i = 0; i < bnd->num_fs_smps; i++) {
+            _sg_recording_add_ref(rec, &bnd->fs_smps[i]->slot);
+        }
+        for (int i = 0; i < bnd->num_vs_sbufs; i++) {
+            _sg_recording_add_ref(rec, &bnd->vs_sbufs[i]->slot);
+        }
+        for (int i = 0; i < bnd->num_fs_sbufs; i++) {
+            _sg_recording_add_ref(rec, &bnd->fs_sbufs[i]->slot);
         }
+        rec->bindings = (_sg_bindings_t*) _sg_recording_grow(rec->bindings, rec->num_bindings, &rec->max_bindings, rec->num_bindings + 1, sizeof(_sg_bindings_t));
+        rec->bindings[rec->num_bindings] = *bnd;
+        _sg_reccmd_t* cmd = _sg_recording_next_cmd(rec, _SG_RECCMD_APPLY_BINDINGS);
+        cmd->args.bindings_index = rec->num_bindings++;
     }
-    _SG_TRACE_ARGS(init_shader, shd_id, &desc_def);
 }
 
-SOKOL_API_IMPL void sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(desc);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    if (pip) {
-        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_init_pipeline(pip, &desc_def);
-            SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED));
-        } else {
-            _SG_ERROR(INIT_PIPELINE_INVALID_STATE);
+_SOKOL_PRIVATE void _sg_record_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_recording_t* rec = _sg_current_recording();
+    if (rec) {
+        // keep uniform blocks 16-byte aligned so that backends can read them as float vectors
+        const int offset = _sg_roundup(rec->ub_pos, 16);
+        const int size = (int)data->size;
+        rec->ub_data = (uint8_t*) _sg_recording_grow(rec->ub_data, rec->ub_pos, &rec->ub_size, offset + size, 1);
+        memcpy(rec->ub_data + offset, data->ptr, data->size);
+        rec->ub_pos = offset + size;
+        _sg_reccmd_t* cmd = _sg_recording_next_cmd(rec, _SG_RECCMD_APPLY_UNIFORMS);
+        cmd->args.uniforms.stage = stage;
+        cmd->args.uniforms.ub_index = ub_index;
+        cmd->args.uniforms.offset = offset;
+        cmd->args.uniforms.size = size;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_record_draw(int base_element, int num_elements, int num_instances) {
+    _sg_recording_t* rec = _sg_current_recording();
+    if (rec) {
+        _sg_reccmd_t* cmd = _sg_recording_next_cmd(rec, _SG_RECCMD_DRAW);
+        cmd->args.draw.base_element = base_element;
+        cmd->args.draw.num_elements = num_elements;
+        cmd->args.draw.num_instances = num_instances;
+    }
+}
+
+// check that all resources referenced by a recording are still alive and valid
+_SOKOL_PRIVATE bool _sg_recording_resources_valid(const _sg_recording_t* rec) {
+    SOKOL_ASSERT(rec);
+    for (int i = 0; i < rec->num_refs; i++) {
+        const _sg_recref_t* ref = &rec->refs[i];
+        if ((ref->slot->id != ref->id) || (ref->slot->state != SG_RESOURCESTATE_VALID)) {
+            return false;
         }
     }
-    _SG_TRACE_ARGS(init_pipeline, pip_id, &desc_def);
+    return true;
 }
 
-SOKOL_API_IMPL void sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    sg_pass_desc desc_def = _sg_pass_desc_defaults(desc);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass) {
-        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_init_pass(pass, &desc_def);
-            SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED));
-        } else {
-            _SG_ERROR(INIT_PASS_INVALID_STATE);
+_SOKOL_PRIVATE void _sg_replay(_sg_recording_t* rec) {
+    SOKOL_ASSERT(rec && (rec->slot.state == SG_RESOURCESTATE_VALID));
+    bool draw_valid = false;
+    for (int i = 0; i < rec->num_cmds; i++) {
+        const _sg_reccmd_t* cmd = &rec->cmds[i];
+        switch (cmd->type) {
+            case _SG_RECCMD_APPLY_VIEWPORT:
+                _sg_apply_viewport(cmd->args.rect.x, cmd->args.rect.y, cmd->args.rect.width, cmd->args.rect.height, cmd->args.rect.origin_top_left);
+                break;
+            case _SG_RECCMD_APPLY_SCISSOR_RECT:
+                _sg_apply_scissor_rect(cmd->args.rect.x, cmd->args.rect.y, cmd->args.rect.width, cmd->args.rect.height, cmd->args.rect.origin_top_left);
+                break;
+            case _SG_RECCMD_APPLY_PIPELINE:
+                _sg_apply_pipeline(cmd->args.pip);
+                draw_valid = false;
+                break;
+            case _SG_RECCMD_APPLY_BINDINGS:
+                draw_valid = _sg_apply_bindings(&rec->bindings[cmd->args.bindings_index]);
+                break;
+            case _SG_RECCMD_APPLY_UNIFORMS:
+                if (draw_valid) {
+                    const sg_range data = { rec->ub_data + cmd->args.uniforms.offset, (size_t)cmd->args.uniforms.size };
+                    _sg_apply_uniforms(cmd->args.uniforms.stage, cmd->args.uniforms.ub_index, &data);
+                }
+                break;
+            case _SG_RECCMD_DRAW:
+                if (draw_valid) {
+                    _sg_draw(cmd->args.draw.base_element, cmd->args.draw.num_elements, cmd->args.draw.num_instances);
+                }
+                break;
+            default:
+                SOKOL_UNREACHABLE;
+                break;
         }
     }
-    _SG_TRACE_ARGS(init_pass, pass_id, &desc_def);
+    // the replayed commands bypass the uniform cache
+    _sg_uniform_cache_reset();
 }
 
-SOKOL_API_IMPL void sg_uninit_buffer(sg_buffer buf_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    if (buf) {
-        if ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_buffer(buf);
-            SOKOL_ASSERT(buf->slot.state == SG_RESOURCESTATE_ALLOC);
-        } else {
-            _SG_ERROR(UNINIT_BUFFER_INVALID_STATE);
-        }
+_SOKOL_PRIVATE void _sg_discard_recording(_sg_recording_t* rec) {
+    SOKOL_ASSERT(rec);
+    if (rec->cmds) {
+        _sg_free(rec->cmds);
     }
-    _SG_TRACE_ARGS(uninit_buffer, buf_id);
+    if (rec->bindings) {
+        _sg_free(rec->bindings);
+    }
+    if (rec->refs) {
+        _sg_free(rec->refs);
+    }
+    if (rec->ub_data) {
+        _sg_free(rec->ub_data);
+    }
+    _sg_pool_free_index(&_sg.pools.recording_pool, _sg_slot_index(rec->slot.id));
+    _sg_clear(rec, sizeof(_sg_recording_t));
 }
 
-SOKOL_API_IMPL void sg_uninit_image(sg_image img_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    if (img) {
-        if ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_image(img);
-            SOKOL_ASSERT(img->slot.state == SG_RESOURCESTATE_ALLOC);
-        } else {
-            _SG_ERROR(UNINIT_IMAGE_INVALID_STATE);
+_SOKOL_PRIVATE void _sg_discard_all_recordings(void) {
+    for (int i = 1; i < _sg.pools.recording_pool.size; i++) {
+        _sg_recording_t* rec = &_sg.pools.recordings[i];
+        if (rec->slot.state != SG_RESOURCESTATE_INITIAL) {
+            _sg_discard_recording(rec);
         }
     }
-    _SG_TRACE_ARGS(uninit_image, img_id);
 }
 
-SOKOL_API_IMPL void sg_uninit_sampler(sg_sampler smp_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
-    if (smp) {
-        if ((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_sampler(smp);
-            SOKOL_ASSERT(smp->slot.state == SG_RESOURCESTATE_ALLOC);
-        } else {
-            _SG_ERROR(UNINIT_SAMPLER_INVALID_STATE);
-        }
+_SOKOL_PRIVATE sg_encoder_desc _sg_encoder_desc_defaults(const sg_encoder_desc* desc) {
+    sg_encoder_desc def = *desc;
+    def.size = _sg_def(def.size, _SG_DEFAULT_ENCODER_SIZE);
+    return def;
+}
+
+_SOKOL_PRIVATE void _sg_init_encoder(_sg_encoder_t* enc, const sg_encoder_desc* desc) {
+    SOKOL_ASSERT(enc && (enc->slot.state == SG_RESOURCESTATE_ALLOC));
+    SOKOL_ASSERT(desc);
+    enc->slot.ctx_id = _sg.active_context.id;
+    if (_sg_validate_encoder_desc(desc)) {
+        enc->size = _sg_roundup(desc->size, 16);
+        enc->data = (uint8_t*) _sg_malloc((size_t)enc->size);
+        enc->slot.state = SG_RESOURCESTATE_VALID;
+    } else {
+        enc->slot.state = SG_RESOURCESTATE_FAILED;
     }
-    _SG_TRACE_ARGS(uninit_sampler, smp_id);
 }
 
-SOKOL_API_IMPL void sg_uninit_shader(sg_shader shd_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    if (shd) {
-        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_shader(shd);
-            SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_ALLOC);
-        } else {
-            _SG_ERROR(UNINIT_SHADER_INVALID_STATE);
-        }
+_SOKOL_PRIVATE void _sg_discard_encoder(_sg_encoder_t* enc) {
+    SOKOL_ASSERT(enc);
+    if (enc->data) {
+        _sg_free(enc->data);
     }
-    _SG_TRACE_ARGS(uninit_shader, shd_id);
+    _sg_pool_free_index(&_sg.pools.encoder_pool, _sg_slot_index(enc->slot.id));
+    _sg_clear(enc, sizeof(_sg_encoder_t));
 }
 
-SOKOL_API_IMPL void sg_uninit_pipeline(sg_pipeline pip_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    if (pip) {
-        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_pipeline(pip);
-            SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_ALLOC);
-        } else {
-            _SG_ERROR(UNINIT_PIPELINE_INVALID_STATE);
+_SOKOL_PRIVATE void _sg_discard_all_encoders(void) {
+    for (int i = 1; i < _sg.pools.encoder_pool.size; i++) {
+        _sg_encoder_t* enc = &_sg.pools.encoders[i];
+        if (enc->slot.state != SG_RESOURCESTATE_INITIAL) {
+            _sg_discard_encoder(enc);
         }
     }
-    _SG_TRACE_ARGS(uninit_pipeline, pip_id);
 }
 
-SOKOL_API_IMPL void sg_uninit_pass(sg_pass pass_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass) {
-        if ((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_pass(pass);
-            SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_ALLOC);
-        } else {
-            _SG_ERROR(UNINIT_PASS_INVALID_STATE);
-        }
+// resolve a resource id for a binding set, returns false if the resource isn't usable
+_SOKOL_PRIVATE bool _sg_binding_set_add_ref(_sg_binding_set_t* bs, const _sg_slot_t* slot) {
+    if ((0 == slot) || (slot->state != SG_RESOURCESTATE_VALID)) {
+        return false;
     }
-    _SG_TRACE_ARGS(uninit_pass, pass_id);
+    SOKOL_ASSERT(bs->num_refs < _SG_MAX_BINDING_SET_REFS);
+    _sg_recref_t* ref = &bs->refs[bs->num_refs++];
+    ref->slot = slot;
+    ref->id = slot->id;
+    return true;
 }
 
-SOKOL_API_IMPL void sg_fail_buffer(sg_buffer buf_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    if (buf) {
-        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
-            buf->slot.ctx_id = _sg.active_context.id;
-            buf->slot.state = SG_RESOURCESTATE_FAILED;
+_SOKOL_PRIVATE void _sg_init_binding_set(_sg_binding_set_t* bs, const sg_binding_set_desc* desc) {
+    SOKOL_ASSERT(bs && (bs->slot.state == SG_RESOURCESTATE_ALLOC));
+    SOKOL_ASSERT(desc);
+    bs->slot.ctx_id = _sg.active_context.id;
+    if (!_sg_validate_binding_set_desc(desc)) {
+        bs->slot.state = SG_RESOURCESTATE_FAILED;
+        return;
+    }
+    const sg_bindings* bindings = &desc->bindings;
+    _sg_bindings_t* bnd = &bs->bnd;
+    bool valid = true;
+    for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++, bnd->num_vbs++) {
+        if (bindings->vertex_buffers[i].id) {
+            bnd->vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+            bnd->vb_offsets[i] = bindings->vertex_buffer_offsets[i];
+            valid &= _sg_binding_set_add_ref(bs, bnd->vbs[i] ? &bnd->vbs[i]->slot : 0);
         } else {
-            _SG_ERROR(FAIL_BUFFER_INVALID_STATE);
+            break;
         }
     }
-    _SG_TRACE_ARGS(fail_buffer, buf_id);
-}
-
-SOKOL_API_IMPL void sg_fail_image(sg_image img_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    if (img) {
-        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
-            img->slot.ctx_id = _sg.active_context.id;
-            img->slot.state = SG_RESOURCESTATE_FAILED;
+    if (bindings->index_buffer.id) {
+        bnd->ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        bnd->ib_offset = bindings->index_buffer_offset;
+        valid &= _sg_binding_set_add_ref(bs, bnd->ib ? &bnd->ib->slot : 0);
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, bnd->num_vs_imgs++) {
+        if (bindings->vs.images[i].id) {
+            bnd->vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs.images[i].id);
+            valid &= _sg_binding_set_add_ref(bs, bnd->vs_imgs[i] ? &bnd->vs_imgs[i]->slot : 0);
         } else {
-            _SG_ERROR(FAIL_IMAGE_INVALID_STATE);
+            break;
         }
     }
-    _SG_TRACE_ARGS(fail_image, img_id);
-}
-
-SOKOL_API_IMPL void sg_fail_sampler(sg_sampler smp_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
-    if (smp) {
-        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
-            smp->slot.ctx_id = _sg.active_context.id;
-            smp->slot.state = SG_RESOURCESTATE_FAILED;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++, bnd->num_vs_smps++) {
+        if (bindings->vs.samplers[i].id) {
+            bnd->vs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->vs.samplers[i].id);
+            valid &= _sg_binding_set_add_ref(bs, bnd->vs_smps[i] ? &bnd->vs_smps[i]->slot : 0);
         } else {
-            _SG_ERROR(FAIL_SAMPLER_INVALID_STATE);
+            break;
         }
     }
-    _SG_TRACE_ARGS(fail_sampler, smp_id);
-}
-
-SOKOL_API_IMPL void sg_fail_shader(sg_shader shd_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    if (shd) {
-        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
-            shd->slot.ctx_id = _sg.active_context.id;
-            shd->slot.state = SG_RESOURCESTATE_FAILED;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, bnd->num_fs_imgs++) {
+        if (bindings->fs.images[i].id) {
+            bnd->fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs.images[i].id);
+            valid &= _sg_binding_set_add_ref(bs, bnd->fs_imgs[i] ? &bnd->fs_imgs[i]->slot : 0);
         } else {
-            _SG_ERROR(FAIL_SHADER_INVALID_STATE);
+            break;
         }
     }
-    _SG_TRACE_ARGS(fail_shader, shd_id);
-}
-
-SOKOL_API_IMPL void sg_fail_pipeline(sg_pipeline pip_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    if (pip) {
-        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
-            pip->slot.ctx_id = _sg.active_context.id;
-            pip->slot.state = SG_RESOURCESTATE_FAILED;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++, bnd->num_fs_smps++) {
+        if (bindings->fs.samplers[i].id) {
+            bnd->fs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->fs.samplers[i].id);
+            valid &= _sg_binding_set_add_ref(bs, bnd->fs_smps[i] ? &bnd->fs_smps[i]->slot : 0);
         } else {
-            _SG_ERROR(FAIL_PIPELINE_INVALID_STATE);
+            break;
         }
     }
-    _SG_TRACE_ARGS(fail_pipeline, pip_id);
-}
-
-SOKOL_API_IMPL void sg_fail_pass(sg_pass pass_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass) {
-        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
-            pass->slot.ctx_id = _sg.active_context.id;
-            pass->slot.state = SG_RESOURCESTATE_FAILED;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++, bnd->num_vs_sbufs++) {
+        if (bindings->vs.storage_buffers[i].id) {
+            bnd->vs_sbufs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vs.storage_buffers[i].id);
+            valid &= _sg_binding_set_add_ref(bs, bnd->vs_sbufs[i] ? &bnd->vs_sbufs[i]->slot : 0);
         } else {
-            _SG_ERROR(FAIL_PASS_INVALID_STATE);
+            break;
         }
     }
-    _SG_TRACE_ARGS(fail_pass, pass_id);
-}
-
-SOKOL_API_IMPL sg_resource_state sg_query_buffer_state(sg_buffer buf_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    sg_resource_state res = buf ? buf->slot.state : SG_RESOURCESTATE_INVALID;
-    return res;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++, bnd->num_fs_sbufs++) {
+        if (bindings->fs.storage_buffers[i].id) {
+            bnd->fs_sbufs[i] = _sg_lookup_buffer(&_sg.pools, bindings->fs.storage_buffers[i].id);
+            valid &= _sg_binding_set_add_ref(bs, bnd->fs_sbufs[i] ? &bnd->fs_sbufs[i]->slot : 0);
+        } else {
+            break;
+        }
+    }
+    #if defined(SOKOL_DEBUG)
+    bs->bindings = *bindings;
+    #endif
+    bs->slot.state = valid ? SG_RESOURCESTATE_VALID : SG_RESOURCESTATE_FAILED;
 }
 
-SOKOL_API_IMPL sg_resource_state sg_query_image_state(sg_image img_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    sg_resource_state res = img ? img->slot.state : SG_RESOURCESTATE_INVALID;
-    return res;
+_SOKOL_PRIVATE void _sg_discard_binding_set(_sg_binding_set_t* bs) {
+    SOKOL_ASSERT(bs);
+    _sg_pool_free_index(&_sg.pools.binding_set_pool, _sg_slot_index(bs->slot.id));
+    _sg_clear(bs, sizeof(_sg_binding_set_t));
 }
 
-SOKOL_API_IMPL sg_resource_state sg_query_sampler_state(sg_sampler smp_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
-    sg_resource_state res = smp ? smp->slot.state : SG_RESOURCESTATE_INVALID;
-    return res;
+_SOKOL_PRIVATE void _sg_discard_all_binding_sets(void) {
+    for (int i = 1; i < _sg.pools.binding_set_pool.size; i++) {
+        _sg_binding_set_t* bs = &_sg.pools.binding_sets[i];
+        if (bs->slot.state != SG_RESOURCESTATE_INITIAL) {
+            _sg_discard_binding_set(bs);
+        }
+    }
 }
 
-SOKOL_API_IMPL sg_resource_state sg_query_shader_state(sg_shader shd_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    sg_resource_state res = shd ? shd->slot.state : SG_RESOURCESTATE_INVALID;
-    return res;
+// check that all resources referenced by a binding set are still alive
+_SOKOL_PRIVATE bool _sg_binding_set_resources_valid(const _sg_binding_set_t* bs) {
+    SOKOL_ASSERT(bs);
+    for (int i = 0; i < bs->num_refs; i++) {
+        const _sg_recref_t* ref = &bs->refs[i];
+        if ((ref->slot->id != ref->id) || (ref->slot->state != SG_RESOURCESTATE_VALID)) {
+            return false;
+        }
+    }
+    return true;
 }
 
-SOKOL_API_IMPL sg_resource_state sg_query_pipeline_state(sg_pipeline pip_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    sg_resource_state res = pip ? pip->slot.state : SG_RESOURCESTATE_INVALID;
-    return res;
+/*  reserve space for a command plus payload in the encoder's memory,
+    NOTE: this may be called from a worker thread, so must only touch the encoder!
+*/
+_SOKOL_PRIVATE _sg_enccmd_t* _sg_encoder_next_cmd(_sg_encoder_t* enc, _sg_reccmd_type_t type, int payload_size) {
+    SOKOL_ASSERT(enc && (enc->slot.state == SG_RESOURCESTATE_VALID));
+    const int hdr_size = _sg_roundup((int)sizeof(_sg_enccmd_t), 16);
+    payload_size = _sg_roundup(payload_size, 16);
+    if (enc->overflow || ((enc->pos + hdr_size + payload_size) > enc->size)) {
+        enc->overflow = true;
+        return 0;
+    }
+    _sg_enccmd_t* cmd = (_sg_enccmd_t*) (enc->data + enc->pos);
+    enc->pos += hdr_size + payload_size;
+    _sg_clear(cmd, sizeof(_sg_enccmd_t));
+    cmd->type = type;
+    cmd->payload_size = payload_size;
+    return cmd;
 }
 
-SOKOL_API_IMPL sg_resource_state sg_query_pass_state(sg_pass pass_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    sg_resource_state res = pass ? pass->slot.state : SG_RESOURCESTATE_INVALID;
-    return res;
+_SOKOL_PRIVATE void* _sg_enccmd_payload(_sg_enccmd_t* cmd) {
+    SOKOL_ASSERT(cmd && (cmd->payload_size > 0));
+    return ((uint8_t*)cmd) + _sg_roundup((int)sizeof(_sg_enccmd_t), 16);
 }
 
-SOKOL_API_IMPL sg_buffer sg_make_buffer(const sg_buffer_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(desc);
-    sg_buffer_desc desc_def = _sg_buffer_desc_defaults(desc);
-    sg_buffer buf_id = _sg_alloc_buffer();
-    if (buf_id.id != SG_INVALID_ID) {
-        _sg_buffer_t* buf = _sg_buffer_at(&_sg.pools, buf_id.id);
-        SOKOL_ASSERT(buf && (buf->slot.state == SG_RESOURCESTATE_ALLOC));
-        _sg_init_buffer(buf, &desc_def);
-        SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED));
+_SOKOL_PRIVATE void _sg_encoder_rect(sg_encoder enc_id, _sg_reccmd_type_t type, int x, int y, int w, int h, bool origin_top_left) {
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc && (enc->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_enccmd_t* cmd = _sg_encoder_next_cmd(enc, type, 0);
+        if (cmd) {
+            cmd->args.rect.x = x;
+            cmd->args.rect.y = y;
+            cmd->args.rect.width = w;
+            cmd->args.rect.height = h;
+            cmd->args.rect.origin_top_left = origin_top_left;
+        }
     }
-    _SG_TRACE_ARGS(make_buffer, &desc_def, buf_id);
-    return buf_id;
 }
 
-SOKOL_API_IMPL sg_image sg_make_image(const sg_image_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(desc);
-    sg_image_desc desc_def = _sg_image_desc_defaults(desc);
-    sg_image img_id = _sg_alloc_image();
-    if (img_id.id != SG_INVALID_ID) {
-        _sg_image_t* img = _sg_image_at(&_sg.pools, img_id.id);
-        SOKOL_ASSERT(img && (img->slot.state == SG_RESOURCESTATE_ALLOC));
-        _sg_init_image(img, &desc_def);
-        SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED));
+// execute encoded commands through the regular rendering functions, this happens on the main thread
+_SOKOL_PRIVATE void _sg_submit_encoder(_sg_encoder_t* enc) {
+    SOKOL_ASSERT(enc && (enc->slot.state == SG_RESOURCESTATE_VALID));
+    const int hdr_size = _sg_roundup((int)sizeof(_sg_enccmd_t), 16);
+    int pos = 0;
+    while (pos < enc->pos) {
+        _sg_enccmd_t* cmd = (_sg_enccmd_t*) (enc->data + pos);
+        switch (cmd->type) {
+            case _SG_RECCMD_APPLY_VIEWPORT:
+                sg_apply_viewport(cmd->args.rect.x, cmd->args.rect.y, cmd->args.rect.width, cmd->args.rect.height, cmd->args.rect.origin_top_left);
+                break;
+            case _SG_RECCMD_APPLY_SCISSOR_RECT:
+                sg_apply_scissor_rect(cmd->args.rect.x, cmd->args.rect.y, cmd->args.rect.width, cmd->args.rect.height, cmd->args.rect.origin_top_left);
+                break;
+            case _SG_RECCMD_APPLY_PIPELINE:
+                sg_apply_pipeline(cmd->args.pip);
+                break;
+            case _SG_RECCMD_APPLY_BINDINGS:
+                sg_apply_bindings((const sg_bindings*)_sg_enccmd_payload(cmd));
+                break;
+            case _SG_RECCMD_APPLY_UNIFORMS:
+                {
+                    const sg_range data = { _sg_enccmd_payload(cmd), (size_t)cmd->args.uniforms.size };
+                    sg_apply_uniforms(cmd->args.uniforms.stage, cmd->args.uniforms.ub_index, &data);
+                }
+                break;
+            case _SG_RECCMD_DRAW:
+                sg_draw(cmd->args.draw.base_element, cmd->args.draw.num_elements, cmd->args.draw.num_instances);
+                break;
+            default:
+                SOKOL_UNREACHABLE;
+                break;
+        }
+        pos += hdr_size + cmd->payload_size;
     }
-    _SG_TRACE_ARGS(make_image, &desc_def, img_id);
-    return img_id;
 }
 
-SOKOL_API_IMPL sg_sampler sg_make_sampler(const sg_sampler_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(desc);
-    sg_sampler_desc desc_def = _sg_sampler_desc_defaults(desc);
-    sg_sampler smp_id = _sg_alloc_sampler();
-    if (smp_id.id != SG_INVALID_ID) {
-        _sg_sampler_t* smp = _sg_sampler_at(&_sg.pools, smp_id.id);
-        SOKOL_ASSERT(smp && (smp->slot.state == SG_RESOURCESTATE_ALLOC));
-        _sg_init_sampler(smp, &desc_def);
-        SOKOL_ASSERT((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED));
+_SOKOL_PRIVATE void _sg_discard_draw_queue(void) {
+    _sg_draw_queue_t* q = &_sg.draw_queue;
+    if (q->items) {
+        _sg_free(q->items);
     }
-    _SG_TRACE_ARGS(make_sampler, &desc_def, smp_id);
-    return smp_id;
-}
-
-SOKOL_API_IMPL sg_shader sg_make_shader(const sg_shader_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(desc);
-    sg_shader_desc desc_def = _sg_shader_desc_defaults(desc);
-    sg_shader shd_id = _sg_alloc_shader();
-    if (shd_id.id != SG_INVALID_ID) {
-        _sg_shader_t* shd = _sg_shader_at(&_sg.pools, shd_id.id);
-        SOKOL_ASSERT(shd && (shd->slot.state == SG_RESOURCESTATE_ALLOC));
-        _sg_init_shader(shd, &desc_def);
-        SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED));
+    if (q->keys) {
+        _sg_free(q->keys);
     }
-    _SG_TRACE_ARGS(make_shader, &desc_def, shd_id);
-    return shd_id;
-}
-
-SOKOL_API_IMPL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(desc);
-    sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(desc);
-    sg_pipeline pip_id = _sg_alloc_pipeline();
-    if (pip_id.id != SG_INVALID_ID) {
-        _sg_pipeline_t* pip = _sg_pipeline_at(&_sg.pools, pip_id.id);
-        SOKOL_ASSERT(pip && (pip->slot.state == SG_RESOURCESTATE_ALLOC));
-        _sg_init_pipeline(pip, &desc_def);
-        SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED));
+    if (q->tmp_keys) {
+        _sg_free(q->tmp_keys);
     }
-    _SG_TRACE_ARGS(make_pipeline, &desc_def, pip_id);
-    return pip_id;
+    if (q->ub_data) {
+        _sg_free(q->ub_data);
+    }
+    _sg_clear(q, sizeof(_sg_draw_queue_t));
 }
 
-SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(desc);
-    sg_pass_desc desc_def = _sg_pass_desc_defaults(desc);
-    sg_pass pass_id = _sg_alloc_pass();
-    if (pass_id.id != SG_INVALID_ID) {
-        _sg_pass_t* pass = _sg_pass_at(&_sg.pools, pass_id.id);
-        SOKOL_ASSERT(pass && (pass->slot.state == SG_RESOURCESTATE_ALLOC));
-        _sg_init_pass(pass, &desc_def);
-        SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED));
+_SOKOL_PRIVATE void _sg_queue_draw(const sg_queued_draw* draw) {
+    _sg_draw_queue_t* q = &_sg.draw_queue;
+    const int n = q->num_items;
+    q->items = (_sg_draw_queue_item_t*) _sg_recording_grow(q->items, n, &q->max_items, n + 1, sizeof(_sg_draw_queue_item_t));
+    q->keys = (_sg_draw_queue_key_t*) _sg_recording_grow(q->keys, n, &q->max_keys, n + 1, sizeof(_sg_draw_queue_key_t));
+    _sg_draw_queue_item_t* item = &q->items[n];
+    _sg_clear(item, sizeof(_sg_draw_queue_item_t));
+    item->pip = draw->pipeline;
+    item->bindings = draw->bindings;
+    for (int stage = 0; stage < SG_NUM_SHADER_STAGES; stage++) {
+        const sg_range* ubs = (stage == SG_SHADERSTAGE_VS) ? draw->vs_uniforms : draw->fs_uniforms;
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            const int size = (int)ubs[ub_index].size;
+            if (size > 0) {
+                // keep uniform blocks 16-byte aligned so that backends can read them as float vectors
+                const int offset = _sg_roundup(q->ub_pos, 16);
+                q->ub_data = (uint8_t*) _sg_recording_grow(q->ub_data, q->ub_pos, &q->ub_size, offset + size, 1);
+                memcpy(q->ub_data + offset, ubs[ub_index].ptr, (size_t)size);
+                q->ub_pos = offset + size;
+                item->ub_offset[stage][ub_index] = offset;
+                item->ub_size[stage][ub_index] = size;
+            }
+        }
     }
-    _SG_TRACE_ARGS(make_pass, &desc_def, pass_id);
-    return pass_id;
+    item->draw.base_element = draw->base_element;
+    item->draw.num_elements = draw->num_elements;
+    item->draw.num_instances = draw->num_instances;
+    q->keys[n].key = draw->sort_key;
+    q->keys[n].index = n;
+    q->num_items = n + 1;
 }
 
-SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_buffer, buf_id);
-    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
-    if (buf) {
-        if ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_buffer(buf);
-            SOKOL_ASSERT(buf->slot.state == SG_RESOURCESTATE_ALLOC);
+/*  stable LSD radix sort of the queued draw keys with 8 bits per pass,
+    passes where all keys have the same value in the current byte are skipped,
+    returns a pointer to the sorted keys (either q->keys or q->tmp_keys)
+*/
+_SOKOL_PRIVATE const _sg_draw_queue_key_t* _sg_sort_draw_queue(void) {
+    _sg_draw_queue_t* q = &_sg.draw_queue;
+    const int num = q->num_items;
+    q->tmp_keys = (_sg_draw_queue_key_t*) _sg_recording_grow(q->tmp_keys, 0, &q->max_tmp_keys, num, sizeof(_sg_draw_queue_key_t));
+    _sg_draw_queue_key_t* src = q->keys;
+    _sg_draw_queue_key_t* dst = q->tmp_keys;
+    int counts[256];
+    for (int shift = 0; shift < 64; shift += 8) {
+        _sg_clear(counts, sizeof(counts));
+        for (int i = 0; i < num; i++) {
+            counts[(src[i].key >> shift) & 0xFF]++;
+        }
+        if (counts[(src[0].key >> shift) & 0xFF] == num) {
+            continue;
         }
-        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_buffer(buf);
-            SOKOL_ASSERT(buf->slot.state == SG_RESOURCESTATE_INITIAL);
+        int sum = 0;
+        for (int i = 0; i < 256; i++) {
+            const int c = counts[i];
+            counts[i] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < num; i++) {
+            dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
         }
+        _sg_draw_queue_key_t* tmp = src;
+        src = dst;
+        dst = tmp;
     }
+    return src;
 }
 
-SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_image, img_id);
-    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
-    if (img) {
-        if ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_image(img);
-            SOKOL_ASSERT(img->slot.state == SG_RESOURCESTATE_ALLOC);
+// count the pipeline and bindings changes needed to execute the queued draws in the given order
+_SOKOL_PRIVATE void _sg_count_draw_queue_changes(const _sg_draw_queue_key_t* keys, uint32_t* out_num_pip, uint32_t* out_num_bnd) {
+    const _sg_draw_queue_t* q = &_sg.draw_queue;
+    const _sg_draw_queue_item_t* prev = 0;
+    uint32_t num_pip = 0;
+    uint32_t num_bnd = 0;
+    for (int i = 0; i < q->num_items; i++) {
+        const _sg_draw_queue_item_t* item = &q->items[keys ? keys[i].index : i];
+        const bool pip_changed = (0 == prev) || (prev->pip.id != item->pip.id);
+        if (pip_changed) {
+            num_pip++;
         }
-        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_image(img);
-            SOKOL_ASSERT(img->slot.state == SG_RESOURCESTATE_INITIAL);
+        if (pip_changed || (0 != memcmp(&prev->bindings, &item->bindings, sizeof(sg_bindings)))) {
+            num_bnd++;
         }
+        prev = item;
     }
+    *out_num_pip = num_pip;
+    *out_num_bnd = num_bnd;
 }
 
-SOKOL_API_IMPL void sg_destroy_sampler(sg_sampler smp_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_sampler, smp_id);
-    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
-    if (smp) {
-        if ((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_sampler(smp);
-            SOKOL_ASSERT(smp->slot.state == SG_RESOURCESTATE_ALLOC);
+_SOKOL_PRIVATE void _sg_flush_draw_queue(void) {
+    _sg_draw_queue_t* q = &_sg.draw_queue;
+    if (0 == q->num_items) {
+        return;
+    }
+    const _sg_draw_queue_key_t* keys = _sg_sort_draw_queue();
+    if (_sg.stats_enabled) {
+        uint32_t num_pip_unsorted, num_bnd_unsorted, num_pip_sorted, num_bnd_sorted;
+        _sg_count_draw_queue_changes(0, &num_pip_unsorted, &num_bnd_unsorted);
+        _sg_count_draw_queue_changes(keys, &num_pip_sorted, &num_bnd_sorted);
+        _sg_stats_add(num_queue_draw, (uint32_t)q->num_items);
+        if (num_pip_unsorted > num_pip_sorted) {
+            _sg_stats_add(num_queue_saved_apply_pipeline, num_pip_unsorted - num_pip_sorted);
         }
-        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_sampler(smp);
-            SOKOL_ASSERT(smp->slot.state == SG_RESOURCESTATE_INITIAL);
+        if (num_bnd_unsorted > num_bnd_sorted) {
+            _sg_stats_add(num_queue_saved_apply_bindings, num_bnd_unsorted - num_bnd_sorted);
         }
     }
-}
-
-SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_shader, shd_id);
-    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
-    if (shd) {
-        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_shader(shd);
-            SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_ALLOC);
+    const _sg_draw_queue_item_t* prev = 0;
+    for (int i = 0; i < q->num_items; i++) {
+        const _sg_draw_queue_item_t* item = &q->items[keys[i].index];
+        const bool pip_changed = (0 == prev) || (prev->pip.id != item->pip.id);
+        if (pip_changed) {
+            sg_apply_pipeline(item->pip);
         }
-        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_shader(shd);
-            SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_INITIAL);
+        if (pip_changed || (0 != memcmp(&prev->bindings, &item->bindings, sizeof(sg_bindings)))) {
+            sg_apply_bindings(&item->bindings);
         }
+        for (int stage = 0; stage < SG_NUM_SHADER_STAGES; stage++) {
+            for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+                const int size = item->ub_size[stage][ub_index];
+                if (size > 0) {
+                    const sg_range data = { q->ub_data + item->ub_offset[stage][ub_index], (size_t)size };
+                    sg_apply_uniforms((sg_shader_stage)stage, ub_index, &data);
+                }
+            }
+        }
+        sg_draw(item->draw.base_element, item->draw.num_elements, item->draw.num_instances);
+        prev = item;
     }
+    q->num_items = 0;
+    q->ub_pos = 0;
 }
 
-SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_pipeline, pip_id);
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    if (pip) {
-        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_pipeline(pip);
-            SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_ALLOC);
+_SOKOL_PRIVATE void _sg_setup_timings(const sg_desc* desc) {
+    _sg.timings.enabled = desc->enable_pass_timings && _sg.features.pass_timings;
+    _sg.timings.pass_scope = -1;
+}
+
+// each timing scope has a begin and end timestamp query, queries are grouped by frame slot
+_SOKOL_PRIVATE int _sg_timestamp_query_index(int frame_slot, int scope_index, bool end) {
+    SOKOL_ASSERT((frame_slot >= 0) && (frame_slot < _SG_NUM_TIMING_FRAMES));
+    SOKOL_ASSERT((scope_index >= 0) && (scope_index < SG_MAX_PASS_TIMINGS));
+    return (frame_slot * SG_MAX_PASS_TIMINGS + scope_index) * 2 + (end ? 1 : 0);
+}
+
+// starts a timing scope in the current frame, returns the scope index or -1
+_SOKOL_PRIVATE int _sg_timing_begin(sg_timing_type type, sg_pass pass, const char* name) {
+    SOKOL_ASSERT(_sg.timings.enabled);
+    _sg_timing_frame_t* frame = &_sg.timings.frames[_sg.timings.cur];
+    if (frame->num_scopes >= SG_MAX_PASS_TIMINGS) {
+        if (!frame->overflow) {
+            frame->overflow = true;
+            _SG_WARN(PASS_TIMINGS_OVERFLOW);
         }
-        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_pipeline(pip);
-            SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_INITIAL);
+        return -1;
+    }
+    const int scope_index = frame->num_scopes++;
+    sg_pass_timing* scope = &frame->scopes[scope_index];
+    _sg_clear(scope, sizeof(sg_pass_timing));
+    scope->type = type;
+    scope->pass = pass;
+    scope->depth = _sg.timings.group_depth;
+    if (name) {
+        size_t len = strlen(name);
+        if (len >= sizeof(scope->name)) {
+            len = sizeof(scope->name) - 1;
         }
+        memcpy(scope->name, name, len);
     }
+    frame->last_query = _sg_timestamp_query_index(_sg.timings.cur, scope_index, false);
+    _sg_write_timestamp(frame->last_query);
+    return scope_index;
 }
 
-SOKOL_API_IMPL void sg_destroy_pass(sg_pass pass_id) {
-    SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_pass, pass_id);
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass) {
-        if ((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED)) {
-            _sg_uninit_pass(pass);
-            SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_ALLOC);
-        }
-        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
-            _sg_dealloc_pass(pass);
-            SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_INITIAL);
-        }
+_SOKOL_PRIVATE void _sg_timing_end(int scope_index) {
+    if (scope_index >= 0) {
+        _sg_timing_frame_t* frame = &_sg.timings.frames[_sg.timings.cur];
+        frame->last_query = _sg_timestamp_query_index(_sg.timings.cur, scope_index, true);
+        _sg_write_timestamp(frame->last_query);
     }
 }
 
-SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(pass_action);
-    SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
-    sg_pass_action pa;
-    _sg_resolve_default_pass_action(pass_action, &pa);
-    _sg.cur_pass.id = SG_INVALID_ID;
-    _sg.pass_valid = true;
-    _sg_begin_pass(0, &pa, width, height);
-    _SG_TRACE_ARGS(begin_default_pass, &pa, width, height);
+_SOKOL_PRIVATE void _sg_timings_begin_pass(sg_pass pass_id) {
+    if (_sg.timings.enabled) {
+        _sg.timings.pass_scope = _sg_timing_begin(SG_TIMINGTYPE_PASS, pass_id, 0);
+    }
 }
 
-SOKOL_API_IMPL void sg_begin_default_passf(const sg_pass_action* pass_action, float width, float height) {
-    sg_begin_default_pass(pass_action, (int)width, (int)height);
+_SOKOL_PRIVATE void _sg_timings_end_pass(void) {
+    if (_sg.timings.enabled) {
+        _sg_timing_end(_sg.timings.pass_scope);
+        _sg.timings.pass_scope = -1;
+    }
 }
 
-SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_action) {
-    SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(pass_action);
-    SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
-    _sg.cur_pass = pass_id;
-    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
-    if (pass && _sg_validate_begin_pass(pass)) {
-        _sg.pass_valid = true;
-        sg_pass_action pa;
-        _sg_resolve_default_pass_action(pass_action, &pa);
+_SOKOL_PRIVATE void _sg_timings_push_debug_group(const char* name) {
+    if (_sg.timings.enabled) {
+        _sg_timings_t* t = &_sg.timings;
+        if (t->group_depth < SG_MAX_PASS_TIMINGS) {
+            const sg_pass no_pass = { SG_INVALID_ID };
+            t->group_scopes[t->group_depth] = _sg_timing_begin(SG_TIMINGTYPE_DEBUG_GROUP, no_pass, name);
+        }
+        t->group_depth++;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_timings_pop_debug_group(void) {
+    if (_sg.timings.enabled && (_sg.timings.group_depth > 0)) {
+        _sg_timings_t* t = &_sg.timings;
+        t->group_depth--;
+        if (t->group_depth < SG_MAX_PASS_TIMINGS) {
+            _sg_timing_end(t->group_scopes[t->group_depth]);
+            t->group_scopes[t->group_depth] = -1;
+        }
+    }
+}
+
+/*  called in sg_commit(): finishes the current frame, and reads back the
+    timestamp query results of all frames which are available without waiting
+    for the GPU (oldest frame first)
+*/
+_SOKOL_PRIVATE void _sg_timings_commit(void) {
+    if (!_sg.timings.enabled) {
+        return;
+    }
+    _sg_timings_t* t = &_sg.timings;
+    // scopes which are still open end here
+    _sg_timing_end(t->pass_scope);
+    t->pass_scope = -1;
+    for (int i = 0; (i < t->group_depth) && (i < SG_MAX_PASS_TIMINGS); i++) {
+        _sg_timing_end(t->group_scopes[i]);
+        t->group_scopes[i] = -1;
+    }
+    _sg_timing_frame_t* cur_frame = &t->frames[t->cur];
+    cur_frame->frame_index = _sg.frame_index;
+    cur_frame->pending = cur_frame->num_scopes > 0;
+    for (int i = 1; i <= _SG_NUM_TIMING_FRAMES; i++) {
+        const int slot = (t->cur + i) % _SG_NUM_TIMING_FRAMES;
+        _sg_timing_frame_t* frame = &t->frames[slot];
+        if (!frame->pending) {
+            continue;
+        }
+        // timestamp queries complete in the order they were written, so checking the
+        // query which was written last is enough (this is usually the end of an outer
+        // scope, not the end of the scope which was started last)
+        if (!_sg_timestamp_available(frame->last_query)) {
+            continue;
+        }
+        t->result.frame_index = frame->frame_index;
+        t->result.num_timings = frame->num_scopes;
+        for (int scope_index = 0; scope_index < frame->num_scopes; scope_index++) {
+            sg_pass_timing* dst = &t->result.timings[scope_index];
+            *dst = frame->scopes[scope_index];
+            const uint64_t t0 = _sg_read_timestamp(_sg_timestamp_query_index(slot, scope_index, false));
+            const uint64_t t1 = _sg_read_timestamp(_sg_timestamp_query_index(slot, scope_index, true));
+            dst->gpu_time_ns = (t1 > t0) ? (t1 - t0) : 0;
+        }
+        frame->pending = false;
+    }
+    // advance to the next frame slot, results which are still not available are dropped
+    t->cur = (t->cur + 1) % _SG_NUM_TIMING_FRAMES;
+    _sg_timing_frame_t* next_frame = &t->frames[t->cur];
+    next_frame->pending = false;
+    next_frame->overflow = false;
+    next_frame->num_scopes = 0;
+    next_frame->last_query = 0;
+    // debug groups which are still open continue in the next frame, but are no longer timed
+}
+
+_SOKOL_PRIVATE sg_mapped_range _sg_map_ring_buffer(_sg_buffer_t* buf, size_t size) {
+    SOKOL_ASSERT(buf && (buf->cmn.usage == SG_USAGE_STREAM_RING) && !buf->cmn.mapped);
+    SOKOL_ASSERT(size > 0);
+    sg_mapped_range res;
+    _sg_clear(&res, sizeof(res));
+    // rewind write cursor in a new frame
+    if (buf->cmn.append_frame_index != _sg.frame_index) {
+        buf->cmn.append_pos = 0;
+        buf->cmn.append_overflow = false;
+        buf->cmn.append_frame_index = _sg.frame_index;
+    }
+    const int region_size = _sg_ring_region_size(buf->cmn.size);
+    if (((size_t)buf->cmn.append_pos + size) > (size_t)region_size) {
+        buf->cmn.append_overflow = true;
+    }
+    if (buf->cmn.append_overflow) {
+        return res;
+    }
+    const int region = (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES);
+    const int offset = region * region_size + buf->cmn.append_pos;
+    const bool new_frame = buf->cmn.map_frame_index != _sg.frame_index;
+    uint8_t* ptr = (uint8_t*) _sg_map_buffer(buf, offset, (int)size, new_frame);
+    if (0 == ptr) {
+        // backend can't map buffer memory, write into staging memory instead
+        if (0 == buf->cmn.ring_data) {
+            buf->cmn.ring_data = (uint8_t*) _sg_malloc((size_t)buf->cmn.size);
+        }
+        ptr = buf->cmn.ring_data + offset;
+    }
+    buf->cmn.map_frame_index = _sg.frame_index;
+    buf->cmn.append_pos += (int) _sg_roundup_u64(size, 4);
+    buf->cmn.mapped = true;
+    buf->cmn.map_offset = offset;
+    buf->cmn.map_size = (int)size;
+    res.ptr = ptr;
+    res.size = size;
+    res.offset = offset;
+    return res;
+}
+
+_SOKOL_PRIVATE void _sg_unmap_ring_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf && buf->cmn.mapped);
+    sg_range data;
+    data.ptr = buf->cmn.ring_data ? (buf->cmn.ring_data + buf->cmn.map_offset) : 0;
+    data.size = (size_t)buf->cmn.map_size;
+    _sg_unmap_buffer(buf, buf->cmn.map_offset, &data);
+    buf->cmn.mapped = false;
+}
+
+_SOKOL_PRIVATE int _sg_append_ring_buffer(_sg_buffer_t* buf, const sg_range* data) {
+    SOKOL_ASSERT(buf && data && data->ptr);
+    int result = 0;
+    if ((buf->slot.state == SG_RESOURCESTATE_VALID) && _sg_validate_append_buffer(buf, data)) {
+        if ((data->size > 0) && !buf->cmn.mapped) {
+            const sg_mapped_range range = _sg_map_ring_buffer(buf, data->size);
+            if (range.ptr) {
+                memcpy(range.ptr, data->ptr, data->size);
+                _sg_unmap_ring_buffer(buf);
+                result = range.offset;
+            }
+        }
+    }
+    return result;
+}
+
+_SOKOL_PRIVATE void _sg_setup_upload_buffer(const sg_desc* desc) {
+    SOKOL_ASSERT(desc->upload_buffer_size > 0);
+    // keep all upload offsets 16-byte aligned
+    _sg.upload.size = desc->upload_buffer_size & ~15;
+}
+
+_SOKOL_PRIVATE void _sg_discard_upload_buffer(void) {
+    // NOTE: backend upload resources are destroyed in _sg_discard_backend()
+    if (_sg.upload.staging) {
+        _sg_free(_sg.upload.staging);
+        _sg.upload.staging = 0;
+    }
+}
+
+// size of one mip level of one cube face, including all slices
+_SOKOL_PRIVATE int _sg_image_upload_size(const _sg_image_t* img, int mip_level) {
+    const int mip_width = _sg_miplevel_dim(img->cmn.width, mip_level);
+    const int mip_height = _sg_miplevel_dim(img->cmn.height, mip_level);
+    int num_slices = 1;
+    if (SG_IMAGETYPE_3D == img->cmn.type) {
+        num_slices = _sg_miplevel_dim(img->cmn.num_slices, mip_level);
+    } else if (SG_IMAGETYPE_ARRAY == img->cmn.type) {
+        num_slices = img->cmn.num_slices;
+    }
+    return _sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1) * num_slices;
+}
+
+// pop all uploads from the front of the queue which the GPU has finished
+_SOKOL_PRIVATE void _sg_retire_uploads(void) {
+    _sg_upload_buffer_t* ub = &_sg.upload;
+    while (ub->queue_count > 0) {
+        if (!_sg_query_upload_done(ub->queue_head)) {
+            break;
+        }
+        ub->done_id = ub->queue[ub->queue_head].id;
+        ub->queue_head = (ub->queue_head + 1) % _SG_MAX_PENDING_UPLOADS;
+        ub->queue_count--;
+    }
+}
+
+// returns the offset of a free range in the upload buffer, or -1 if
+// the range is still in use by pending uploads
+_SOKOL_PRIVATE int _sg_alloc_upload_range(int size) {
+    _sg_upload_buffer_t* ub = &_sg.upload;
+    SOKOL_ASSERT((size > 0) && (size <= ub->size));
+    _sg_retire_uploads();
+    if (0 == ub->queue_count) {
+        ub->pos = 0;
+        return 0;
+    }
+    if (ub->queue_count == _SG_MAX_PENDING_UPLOADS) {
+        return -1;
+    }
+    const int tail = ub->queue[ub->queue_head].offset;
+    if (ub->pos > tail) {
+        // free space behind the newest and in front of the oldest pending upload
+        if ((ub->pos + size) <= ub->size) {
+            return ub->pos;
+        } else if (size <= tail) {
+            return 0;
+        } else {
+            return -1;
+        }
+    } else {
+        // wrapped around, free space between the newest and oldest pending upload
+        return ((ub->pos + size) <= tail) ? ub->pos : -1;
+    }
+}
+
+_SOKOL_PRIVATE sg_mapped_range _sg_map_image_upload(_sg_image_t* img, int face, int mip_level) {
+    SOKOL_ASSERT(img && !_sg.upload.mapped);
+    _sg_upload_buffer_t* ub = &_sg.upload;
+    sg_mapped_range res;
+    _sg_clear(&res, sizeof(res));
+    const int size = _sg_image_upload_size(img, mip_level);
+    if (size > ub->size) {
+        _SG_ERROR(IMAGE_UPLOAD_TOO_BIG);
+        return res;
+    }
+    const int offset = _sg_alloc_upload_range(size);
+    if (offset < 0) {
+        // upload buffer is full, don't wait for the GPU
+        return res;
+    }
+    uint8_t* ptr = (uint8_t*) _sg_map_upload_buffer(offset, size);
+    ub->map_staged = (0 == ptr);
+    if (0 == ptr) {
+        // backend can't map the upload buffer, write into staging memory instead
+        if (0 == ub->staging) {
+            ub->staging = (uint8_t*) _sg_malloc((size_t)ub->size);
+        }
+        ptr = ub->staging + offset;
+    }
+    ub->pos = _sg_roundup(offset + size, 16);
+    ub->mapped = true;
+    ub->map_img_id = img->slot.id;
+    ub->map_face = face;
+    ub->map_mip_level = mip_level;
+    ub->map_offset = offset;
+    ub->map_size = size;
+    res.ptr = ptr;
+    res.size = (size_t)size;
+    res.offset = offset;
+    return res;
+}
+
+// img is 0 if the image has been destroyed while the upload was mapped
+_SOKOL_PRIVATE sg_image_upload _sg_unmap_image_upload(_sg_image_t* img) {
+    _sg_upload_buffer_t* ub = &_sg.upload;
+    SOKOL_ASSERT(ub->mapped);
+    sg_image_upload res;
+    _sg_clear(&res, sizeof(res));
+    sg_range data;
+    data.ptr = ub->map_staged ? (ub->staging + ub->map_offset) : 0;
+    data.size = (size_t)ub->map_size;
+    ub->mapped = false;
+    if (img && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+        SOKOL_ASSERT(ub->queue_count < _SG_MAX_PENDING_UPLOADS);
+        const int queue_index = (ub->queue_head + ub->queue_count) % _SG_MAX_PENDING_UPLOADS;
+        _sg_upload_item_t* item = &ub->queue[queue_index];
+        item->id = ++ub->next_id;
+        item->offset = ub->map_offset;
+        item->size = ub->map_size;
+        ub->queue_count++;
+        _sg_unmap_upload_buffer(img, ub->map_face, ub->map_mip_level, ub->map_offset, &data, queue_index);
+        _sg_stats_add(num_image_upload, 1);
+        _sg_stats_add(size_image_upload, (uint32_t)ub->map_size);
+        res.id = item->id;
+    } else {
+        // only release the mapping and give back the upload buffer range
+        _sg_unmap_upload_buffer(0, 0, 0, ub->map_offset, &data, -1);
+        ub->pos = ub->map_offset;
+    }
+    return res;
+}
+
+// same checks as in validation layer, but also needed in release mode
+_SOKOL_PRIVATE bool _sg_can_generate_mipmaps(const _sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    return _sg.features.generate_mipmaps
+        && !_sg.in_pass
+        && (img->cmn.num_mipmaps > 1)
+        && (img->cmn.sample_count == 1)
+        && (img->cmn.render_target || (img->cmn.usage != SG_USAGE_IMMUTABLE))
+        && _sg_is_mipmap_generation_format(img->cmn.pixel_format);
+}
+
+// generates mipmaps for images created with sg_image_desc.generate_mipmaps
+// which have been rendered into at mip level 0 in the pass that just ended
+_SOKOL_PRIVATE void _sg_generate_pass_mipmaps(const _sg_pass_t* pass) {
+    SOKOL_ASSERT(pass);
+    for (int i = 0; i < pass->cmn.num_color_atts; i++) {
+        _sg_image_t* color_img = _sg_pass_color_image(pass, i);
+        if (color_img && color_img->cmn.generate_mipmaps && (0 == pass->cmn.color_atts[i].mip_level)) {
+            if (_sg_can_generate_mipmaps(color_img)) {
+                _sg_stats_add(num_generate_mipmaps, 1);
+                _sg_generate_mipmaps(color_img);
+            }
+        }
+        _sg_image_t* resolve_img = _sg_pass_resolve_image(pass, i);
+        if (resolve_img && resolve_img->cmn.generate_mipmaps && (0 == pass->cmn.resolve_atts[i].mip_level)) {
+            if (_sg_can_generate_mipmaps(resolve_img)) {
+                _sg_stats_add(num_generate_mipmaps, 1);
+                _sg_generate_mipmaps(resolve_img);
+            }
+        }
+    }
+}
+
+// resolves the read rectangle and pixel format, returns the image to read from,
+// or a null pointer for the default framebuffer and for invalid images
+_SOKOL_PRIVATE _sg_image_t* _sg_resolve_read_desc(const sg_read_desc* desc, sg_read_result* res) {
+    SOKOL_ASSERT(desc && res);
+    _sg_clear(res, sizeof(sg_read_result));
+    res->image = desc->image;
+    res->x = desc->x;
+    res->y = desc->y;
+    res->width = desc->width;
+    res->height = desc->height;
+    res->user_data = desc->user_data;
+    _sg_image_t* img = 0;
+    if (desc->image.id != SG_INVALID_ID) {
+        img = _sg_lookup_image(&_sg.pools, desc->image.id);
+        if (img && (img->slot.state != SG_RESOURCESTATE_VALID)) {
+            img = 0;
+        }
+        if (!img) {
+            return 0;
+        }
+        if (0 == res->width) {
+            res->width = img->cmn.width - res->x;
+        }
+        if (0 == res->height) {
+            res->height = img->cmn.height - res->y;
+        }
+        res->pixel_format = img->cmn.pixel_format;
+    } else {
+        res->pixel_format = _sg.desc.context.color_format;
+    }
+    if ((res->width > 0) && (res->height > 0)) {
+        res->data.size = (size_t)(_sg_row_pitch(res->pixel_format, res->width, 1) * res->height);
+    }
+    return img;
+}
+
+// same checks as in validation layer, but also needed in release mode
+_SOKOL_PRIVATE bool _sg_read_desc_valid(const sg_read_desc* desc, const _sg_image_t* img, const sg_read_result* res) {
+    if (!_sg.features.image_read || _sg.in_pass || (res->data.size == 0) || (res->x < 0) || (res->y < 0)) {
+        return false;
+    }
+    if (desc->image.id == SG_INVALID_ID) {
+        if (_sg.desc.context.sample_count != 1) {
+            return false;
+        }
+    }
+    else {
+        if (!img || !img->cmn.render_target || (img->cmn.type != SG_IMAGETYPE_2D) || (img->cmn.sample_count != 1)) {
+            return false;
+        }
+        if (_sg_is_depth_or_depth_stencil_format(img->cmn.pixel_format)) {
+            return false;
+        }
+        if (((res->x + res->width) > img->cmn.width) || ((res->y + res->height) > img->cmn.height)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// calls the callbacks of finished reads, this happens at the end of sg_commit()
+_SOKOL_PRIVATE void _sg_update_pending_reads(void) {
+    for (int i = 0; i < _SG_MAX_PENDING_READS; i++) {
+        _sg_read_item_t* item = &_sg.reads.items[i];
+        if (!item->active) {
+            continue;
+        }
+        bool failed = false;
+        const void* ptr = _sg_map_read(i, (int)item->result.data.size, &failed);
+        if (failed) {
+            _SG_ERROR(IMAGE_READ_FAILED);
+            item->result.data.ptr = 0;
+            item->result.data.size = 0;
+            item->result.failed = true;
+        }
+        else {
+            item->result.data.ptr = ptr;
+        }
+        if (ptr || failed) {
+            item->callback(&item->result);
+            _sg_discard_read(i);
+            _sg_clear(item, sizeof(_sg_read_item_t));
+            _sg.reads.num_pending--;
+        }
+    }
+}
+
+// pending reads are dropped without calling their callback
+_SOKOL_PRIVATE void _sg_discard_pending_reads(void) {
+    for (int i = 0; i < _SG_MAX_PENDING_READS; i++) {
+        if (_sg.reads.items[i].active) {
+            _sg_discard_read(i);
+        }
+    }
+    _sg_clear(&_sg.reads, sizeof(_sg.reads));
+}
+
+_SOKOL_PRIVATE sg_desc _sg_desc_defaults(const sg_desc* desc) {
+    /*
+        NOTE: on WebGPU, the default color pixel format MUST be provided,
+        cannot be a default compile-time constant.
+    */
+    sg_desc res = *desc;
+    #if defined(SOKOL_WGPU)
+        SOKOL_ASSERT(SG_PIXELFORMAT_NONE != res.context.color_format);
+    #elif defined(SOKOL_METAL) || defined(SOKOL_D3D11)
+        res.context.color_format = _sg_def(res.context.color_format, SG_PIXELFORMAT_BGRA8);
+    #else
+        res.context.color_format = _sg_def(res.context.color_format, SG_PIXELFORMAT_RGBA8);
+    #endif
+    res.context.depth_format = _sg_def(res.context.depth_format, SG_PIXELFORMAT_DEPTH_STENCIL);
+    res.context.sample_count = _sg_def(res.context.sample_count, 1);
+    res.buffer_pool_size = _sg_def(res.buffer_pool_size, _SG_DEFAULT_BUFFER_POOL_SIZE);
+    res.image_pool_size = _sg_def(res.image_pool_size, _SG_DEFAULT_IMAGE_POOL_SIZE);
+    res.sampler_pool_size = _sg_def(res.sampler_pool_size, _SG_DEFAULT_SAMPLER_POOL_SIZE);
+    res.shader_pool_size = _sg_def(res.shader_pool_size, _SG_DEFAULT_SHADER_POOL_SIZE);
+    res.pipeline_pool_size = _sg_def(res.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
+    res.pass_pool_size = _sg_def(res.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
+    res.context_pool_size = _sg_def(res.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
+    res.recording_pool_size = _sg_def(res.recording_pool_size, _SG_DEFAULT_RECORDING_POOL_SIZE);
+    res.encoder_pool_size = _sg_def(res.encoder_pool_size, _SG_DEFAULT_ENCODER_POOL_SIZE);
+    res.binding_set_pool_size = _sg_def(res.binding_set_pool_size, _SG_DEFAULT_BINDING_SET_POOL_SIZE);
+    res.transient_pool_size = _sg_def(res.transient_pool_size, _SG_DEFAULT_TRANSIENT_POOL_SIZE);
+    res.uniform_buffer_size = _sg_def(res.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
+    res.upload_buffer_size = _sg_def(res.upload_buffer_size, _SG_DEFAULT_UPLOAD_BUFFER_SIZE);
+    res.max_commit_listeners = _sg_def(res.max_commit_listeners, _SG_DEFAULT_MAX_COMMIT_LISTENERS);
+    res.wgpu_bindgroups_cache_size = _sg_def(res.wgpu_bindgroups_cache_size, _SG_DEFAULT_WGPU_BINDGROUP_CACHE_SIZE);
+    return res;
+}
+
+// ██████  ██    ██ ██████  ██      ██  ██████
+// ██   ██ ██    ██ ██   ██ ██      ██ ██
+// ██████  ██    ██ ██████  ██      ██ ██
+// ██      ██    ██ ██   ██ ██      ██ ██
+// ██       ██████  ██████  ███████ ██  ██████
+//
+// >>public
+SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
+    SOKOL_ASSERT((desc->allocator.alloc_fn && desc->allocator.free_fn) || (!desc->allocator.alloc_fn && !desc->allocator.free_fn));
+    _SG_CLEAR_ARC_STRUCT(_sg_state_t, _sg);
+    _sg.desc = _sg_desc_defaults(desc);
+    _sg_setup_pools(&_sg.pools, &_sg.desc);
+    _sg_setup_commit_listeners(&_sg.desc);
+    _sg_setup_pipeline_cache(&_sg.desc);
+    _sg_setup_transients(&_sg.desc);
+    _sg_setup_upload_buffer(&_sg.desc);
+    _sg.frame_index = 1;
+    _sg.stats_enabled = true;
+    _sg_setup_backend(&_sg.desc);
+    _sg_setup_timings(&_sg.desc);
+    _sg.valid = true;
+    sg_setup_context();
+}
+
+SOKOL_API_IMPL void sg_shutdown(void) {
+    // no memory budget callbacks while everything is torn down
+    _sg_memory_lock_budget();
+    /* can only delete resources for the currently set context here, if multiple
+    contexts are used, the app code must take care of properly releasing them
+    (since only the app code can switch between 3D-API contexts)
+    */
+    if (_sg.active_context.id != SG_INVALID_ID) {
+        _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, _sg.active_context.id);
+        if (ctx) {
+            _sg_discard_all_resources(&_sg.pools, _sg.active_context.id);
+            _sg_discard_context(ctx);
+        }
+    }
+    _sg_discard_pending_reads();
+    _sg_discard_backend();
+    _sg_discard_commit_listeners();
+    _sg_discard_pipeline_cache();
+    _sg_discard_transients();
+    _sg_discard_upload_buffer();
+    _sg_discard_draw_queue();
+    _sg_discard_all_recordings();
+    _sg_discard_all_encoders();
+    _sg_discard_all_binding_sets();
+    _sg_discard_pools(&_sg.pools);
+    _SG_CLEAR_ARC_STRUCT(_sg_state_t, _sg);
+}
+
+SOKOL_API_IMPL bool sg_isvalid(void) {
+    return _sg.valid;
+}
+
+SOKOL_API_IMPL sg_desc sg_query_desc(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.desc;
+}
+
+SOKOL_API_IMPL sg_backend sg_query_backend(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.backend;
+}
+
+SOKOL_API_IMPL sg_features sg_query_features(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.features;
+}
+
+SOKOL_API_IMPL sg_limits sg_query_limits(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.limits;
+}
+
+SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
+    SOKOL_ASSERT(_sg.valid);
+    int fmt_index = (int) fmt;
+    SOKOL_ASSERT((fmt_index > SG_PIXELFORMAT_NONE) && (fmt_index < _SG_PIXELFORMAT_NUM));
+    return _sg.formats[fmt_index];
+}
+
+SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.prev_stats;
+}
+
+SOKOL_API_IMPL sg_pass_timings sg_query_pass_timings(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.timings.result;
+}
+
+SOKOL_API_IMPL sg_pool_stats sg_query_pool_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pool_stats res;
+    _sg_clear(&res, sizeof(res));
+    res.buffers = _sg_pool_usage(&_sg.pools.buffer_pool);
+    res.images = _sg_pool_usage(&_sg.pools.image_pool);
+    res.samplers = _sg_pool_usage(&_sg.pools.sampler_pool);
+    res.shaders = _sg_pool_usage(&_sg.pools.shader_pool);
+    res.pipelines = _sg_pool_usage(&_sg.pools.pipeline_pool);
+    res.passes = _sg_pool_usage(&_sg.pools.pass_pool);
+    return res;
+}
+
+SOKOL_API_IMPL sg_memory_stats sg_query_memory_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.memory.stats;
+}
+
+// returns the index of a matching or newly created transient image marked as in use, or -1
+_SOKOL_PRIVATE int _sg_transient_acquire_image(const sg_transient_image_desc* key, uint64_t hash, const char* label) {
+    int item_index = _sg_transient_find_image(key, hash);
+    if (item_index >= 0) {
+        _sg_stats_add(num_transient_hits, 1);
+    } else {
+        _sg_stats_add(num_transient_misses, 1);
+        item_index = _sg_transient_alloc_item();
+        if (item_index < 0) {
+            _SG_ERROR(TRANSIENT_POOL_EXHAUSTED);
+            return -1;
+        }
+        sg_image_desc img_desc;
+        _sg_clear(&img_desc, sizeof(img_desc));
+        img_desc.render_target = true;
+        img_desc.width = key->width;
+        img_desc.height = key->height;
+        img_desc.pixel_format = key->pixel_format;
+        img_desc.sample_count = key->sample_count;
+        img_desc.label = label;
+        const sg_image img = sg_make_image(&img_desc);
+        if (sg_query_image_state(img) != SG_RESOURCESTATE_VALID) {
+            sg_destroy_image(img);
+            return -1;
+        }
+        _sg_transient_item_t* item = &_sg.transients.items[item_index];
+        item->id = img.id;
+        item->hash = hash;
+        item->img_key = *key;
+        const _sg_image_t* img_ptr = _sg_lookup_image(&_sg.pools, img.id);
+        SOKOL_ASSERT(img_ptr);
+        item->size = _sg_image_memory_size(&img_ptr->cmn);
+        _sg.transients.size += item->size;
+        if (_sg.transients.size > _sg.transients.peak_size) {
+            _sg.transients.peak_size = _sg.transients.size;
+        }
+    }
+    _sg_transient_item_t* item = &_sg.transients.items[item_index];
+    item->in_use = true;
+    item->last_frame_index = _sg.frame_index;
+    return item_index;
+}
+
+// returns the index of a matching or newly created transient pass marked as in use, or -1
+_SOKOL_PRIVATE int _sg_transient_acquire_pass(const sg_pass_desc* desc, const sg_pass_desc* key, uint64_t hash) {
+    int item_index = _sg_transient_find_pass(key, hash);
+    if (item_index >= 0) {
+        _sg_stats_add(num_transient_hits, 1);
+    } else {
+        _sg_stats_add(num_transient_misses, 1);
+        item_index = _sg_transient_alloc_item();
+        if (item_index < 0) {
+            _SG_ERROR(TRANSIENT_POOL_EXHAUSTED);
+            return -1;
+        }
+        const sg_pass pass = sg_make_pass(desc);
+        if (sg_query_pass_state(pass) != SG_RESOURCESTATE_VALID) {
+            sg_destroy_pass(pass);
+            return -1;
+        }
+        _sg_transient_item_t* item = &_sg.transients.items[item_index];
+        item->id = pass.id;
+        item->is_pass = true;
+        item->hash = hash;
+        item->pass_key = *key;
+    }
+    _sg_transient_item_t* item = &_sg.transients.items[item_index];
+    item->in_use = true;
+    item->last_frame_index = _sg.frame_index;
+    return item_index;
+}
+
+SOKOL_API_IMPL sg_image sg_acquire_transient_image(const sg_transient_image_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_image res = { SG_INVALID_ID };
+    uint64_t hash = 0;
+    const sg_transient_image_desc key = _sg_transient_image_key(desc, &hash);
+    if (!_sg_validate_acquire_transient_image(&key)) {
+        return res;
+    }
+    // evicting and creating transient images must not be interrupted by the budget callback
+    _sg_memory_lock_budget();
+    const int item_index = _sg_transient_acquire_image(&key, hash, desc->label);
+    _sg_memory_unlock_budget();
+    if (item_index >= 0) {
+        res.id = _sg.transients.items[item_index].id;
+    }
+    return res;
+}
+
+SOKOL_API_IMPL sg_pass sg_acquire_transient_pass(const sg_pass_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT((desc->_start_canary == 0) && (desc->_end_canary == 0));
+    sg_pass res = { SG_INVALID_ID };
+    uint64_t hash = 0;
+    const sg_pass_desc key = _sg_transient_pass_key(desc, &hash);
+    _sg_memory_lock_budget();
+    const int item_index = _sg_transient_acquire_pass(desc, &key, hash);
+    _sg_memory_unlock_budget();
+    if (item_index >= 0) {
+        res.id = _sg.transients.items[item_index].id;
+    }
+    return res;
+}
+
+SOKOL_API_IMPL void sg_release_transient_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_transient_item_t* item = 0;
+    if (img_id.id != SG_INVALID_ID) {
+        for (int i = 0; i < _sg.transients.num_items; i++) {
+            if ((_sg.transients.items[i].id == img_id.id) && !_sg.transients.items[i].is_pass) {
+                item = &_sg.transients.items[i];
+                break;
+            }
+        }
+    }
+    if (!_sg_validate_release_transient_image(item)) {
+        return;
+    }
+    if (item) {
+        item->in_use = false;
+    }
+}
+
+SOKOL_API_IMPL sg_transient_stats sg_query_transient_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_transient_stats res;
+    _sg_clear(&res, sizeof(res));
+    for (int i = 0; i < _sg.transients.num_items; i++) {
+        const _sg_transient_item_t* item = &_sg.transients.items[i];
+        if (item->id == SG_INVALID_ID) {
+            continue;
+        }
+        if (item->is_pass) {
+            res.num_passes++;
+        } else {
+            res.num_images++;
+            if (item->in_use) {
+                res.num_images_in_use++;
+            }
+        }
+    }
+    res.size = _sg.transients.size;
+    res.peak_size = _sg.transients.peak_size;
+    return res;
+}
+
+SOKOL_API_IMPL sg_context sg_setup_context(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_context res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &_sg.pools.contexts[slot_index].slot, slot_index);
+        _sg_context_t* ctx = _sg_context_at(&_sg.pools, res.id);
+        ctx->slot.state = _sg_create_context(ctx);
+        SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
+        _sg_activate_context(ctx);
+    } else {
+        // pool is exhausted
+        res.id = SG_INVALID_ID;
+    }
+    _sg.active_context = res;
+    return res;
+}
+
+SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
+    SOKOL_ASSERT(_sg.valid);
+    // the budget callback sees the memory drop once the context is gone
+    _sg_memory_lock_budget();
+    _sg_discard_all_resources(&_sg.pools, ctx_id.id);
+    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
+    if (ctx) {
+        _sg_discard_context(ctx);
+        _sg_reset_context_to_alloc_state(ctx);
+        _sg_reset_slot(&ctx->slot);
+        _sg_pool_free_index(&_sg.pools.context_pool, _sg_slot_index(ctx_id.id));
+    }
+    _sg.active_context.id = SG_INVALID_ID;
+    _sg_activate_context(0);
+    _sg_memory_unlock_budget();
+}
+
+SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg.active_context = ctx_id;
+    _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
+    // NOTE: ctx can be 0 here if the context is no longer valid
+    _sg_uniform_cache_reset();
+    _sg_activate_context(ctx);
+}
+
+SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(trace_hooks);
+    _SOKOL_UNUSED(trace_hooks);
+    #if defined(SOKOL_TRACE_HOOKS)
+        sg_trace_hooks old_hooks = _sg.hooks;
+        _sg.hooks = *trace_hooks;
+    #else
+        static sg_trace_hooks old_hooks;
+        _SG_WARN(TRACE_HOOKS_NOT_ENABLED);
+    #endif
+    return old_hooks;
+}
+
+SOKOL_API_IMPL sg_buffer sg_alloc_buffer(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_buffer res = _sg_alloc_buffer();
+    _SG_TRACE_ARGS(alloc_buffer, res);
+    return res;
+}
+
+SOKOL_API_IMPL sg_image sg_alloc_image(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_image res = _sg_alloc_image();
+    _SG_TRACE_ARGS(alloc_image, res);
+    return res;
+}
+
+SOKOL_API_IMPL sg_sampler sg_alloc_sampler(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_sampler res = _sg_alloc_sampler();
+    _SG_TRACE_ARGS(alloc_sampler, res);
+    return res;
+}
+
+SOKOL_API_IMPL sg_shader sg_alloc_shader(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_shader res = _sg_alloc_shader();
+    _SG_TRACE_ARGS(alloc_shader, res);
+    return res;
+}
+
+SOKOL_API_IMPL sg_pipeline sg_alloc_pipeline(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pipeline res = _sg_alloc_pipeline();
+    _SG_TRACE_ARGS(alloc_pipeline, res);
+    return res;
+}
+
+SOKOL_API_IMPL sg_pass sg_alloc_pass(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pass res = _sg_alloc_pass();
+    _SG_TRACE_ARGS(alloc_pass, res);
+    return res;
+}
+
+SOKOL_API_IMPL void sg_dealloc_buffer(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_buffer(buf);
+        } else {
+            _SG_ERROR(DEALLOC_BUFFER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(dealloc_buffer, buf_id);
+}
+
+SOKOL_API_IMPL void sg_dealloc_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img) {
+        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_image(img);
+        } else {
+            _SG_ERROR(DEALLOC_IMAGE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(dealloc_image, img_id);
+}
+
+SOKOL_API_IMPL void sg_dealloc_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_sampler(smp);
+        } else {
+            _SG_ERROR(DEALLOC_SAMPLER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(dealloc_sampler, smp_id);
+}
+
+SOKOL_API_IMPL void sg_dealloc_shader(sg_shader shd_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    if (shd) {
+        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_shader(shd);
+        } else {
+            _SG_ERROR(DEALLOC_SHADER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(dealloc_shader, shd_id);
+}
+
+SOKOL_API_IMPL void sg_dealloc_pipeline(sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip) {
+        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_pipeline(pip);
+        } else {
+            _SG_ERROR(DEALLOC_PIPELINE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(dealloc_pipeline, pip_id);
+}
+
+SOKOL_API_IMPL void sg_dealloc_pass(sg_pass pass_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass) {
+        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_pass(pass);
+        } else {
+            _SG_ERROR(DEALLOC_PASS_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(dealloc_pass, pass_id);
+}
+
+SOKOL_API_IMPL void sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_buffer_desc desc_def = _sg_buffer_desc_defaults(desc);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_memory_lock_budget();
+            _sg_init_buffer(buf, &desc_def);
+            SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED));
+            _sg_memory_unlock_budget();
+        } else {
+            _SG_ERROR(INIT_BUFFER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(init_buffer, buf_id, &desc_def);
+}
+
+SOKOL_API_IMPL void sg_init_image(sg_image img_id, const sg_image_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_image_desc desc_def = _sg_image_desc_defaults(desc);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img) {
+        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_memory_lock_budget();
+            _sg_init_image(img, &desc_def);
+            SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED));
+            _sg_memory_unlock_budget();
+        } else {
+            _SG_ERROR(INIT_IMAGE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(init_image, img_id, &desc_def);
+}
+
+SOKOL_API_IMPL void sg_init_sampler(sg_sampler smp_id, const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_sampler_desc desc_def = _sg_sampler_desc_defaults(desc);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_init_sampler(smp, &desc_def);
+            SOKOL_ASSERT((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED));
+        } else {
+            _SG_ERROR(INIT_SAMPLER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(init_sampler, smp_id, &desc_def);
+}
+
+SOKOL_API_IMPL void sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_shader_desc desc_def = _sg_shader_desc_defaults(desc);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    if (shd) {
+        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_init_shader(shd, &desc_def);
+            SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING));
+        } else {
+            _SG_ERROR(INIT_SHADER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(init_shader, shd_id, &desc_def);
+}
+
+SOKOL_API_IMPL void sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(desc);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip) {
+        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_init_pipeline(pip, &desc_def);
+            SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING));
+        } else {
+            _SG_ERROR(INIT_PIPELINE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(init_pipeline, pip_id, &desc_def);
+}
+
+SOKOL_API_IMPL void sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pass_desc desc_def = _sg_pass_desc_defaults(desc);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass) {
+        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_init_pass(pass, &desc_def);
+            SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED));
+        } else {
+            _SG_ERROR(INIT_PASS_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(init_pass, pass_id, &desc_def);
+}
+
+SOKOL_API_IMPL void sg_uninit_buffer(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        if ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_memory_lock_budget();
+            _sg_uninit_buffer(buf);
+            SOKOL_ASSERT(buf->slot.state == SG_RESOURCESTATE_ALLOC);
+            _sg_memory_unlock_budget();
+        } else {
+            _SG_ERROR(UNINIT_BUFFER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(uninit_buffer, buf_id);
+}
+
+SOKOL_API_IMPL void sg_uninit_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img) {
+        if ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_memory_lock_budget();
+            _sg_uninit_image(img);
+            SOKOL_ASSERT(img->slot.state == SG_RESOURCESTATE_ALLOC);
+            _sg_memory_unlock_budget();
+        } else {
+            _SG_ERROR(UNINIT_IMAGE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(uninit_image, img_id);
+}
+
+SOKOL_API_IMPL void sg_uninit_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        if ((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_uninit_sampler(smp);
+            SOKOL_ASSERT(smp->slot.state == SG_RESOURCESTATE_ALLOC);
+        } else {
+            _SG_ERROR(UNINIT_SAMPLER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(uninit_sampler, smp_id);
+}
+
+SOKOL_API_IMPL void sg_uninit_shader(sg_shader shd_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    if (shd) {
+        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
+            _sg_uninit_shader(shd);
+            SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_ALLOC);
+        } else {
+            _SG_ERROR(UNINIT_SHADER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(uninit_shader, shd_id);
+}
+
+SOKOL_API_IMPL void sg_uninit_pipeline(sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip) {
+        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING)) {
+            _sg_uninit_pipeline(pip);
+            SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_ALLOC);
+        } else {
+            _SG_ERROR(UNINIT_PIPELINE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(uninit_pipeline, pip_id);
+}
+
+SOKOL_API_IMPL void sg_uninit_pass(sg_pass pass_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass) {
+        if ((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_uninit_pass(pass);
+            SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_ALLOC);
+        } else {
+            _SG_ERROR(UNINIT_PASS_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(uninit_pass, pass_id);
+}
+
+SOKOL_API_IMPL void sg_fail_buffer(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
+            buf->slot.ctx_id = _sg.active_context.id;
+            buf->slot.state = SG_RESOURCESTATE_FAILED;
+        } else {
+            _SG_ERROR(FAIL_BUFFER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(fail_buffer, buf_id);
+}
+
+SOKOL_API_IMPL void sg_fail_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img) {
+        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
+            img->slot.ctx_id = _sg.active_context.id;
+            img->slot.state = SG_RESOURCESTATE_FAILED;
+        } else {
+            _SG_ERROR(FAIL_IMAGE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(fail_image, img_id);
+}
+
+SOKOL_API_IMPL void sg_fail_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
+            smp->slot.ctx_id = _sg.active_context.id;
+            smp->slot.state = SG_RESOURCESTATE_FAILED;
+        } else {
+            _SG_ERROR(FAIL_SAMPLER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(fail_sampler, smp_id);
+}
+
+SOKOL_API_IMPL void sg_fail_shader(sg_shader shd_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    if (shd) {
+        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
+            shd->slot.ctx_id = _sg.active_context.id;
+            shd->slot.state = SG_RESOURCESTATE_FAILED;
+        } else {
+            _SG_ERROR(FAIL_SHADER_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(fail_shader, shd_id);
+}
+
+SOKOL_API_IMPL void sg_fail_pipeline(sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip) {
+        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
+            pip->slot.ctx_id = _sg.active_context.id;
+            pip->slot.state = SG_RESOURCESTATE_FAILED;
+        } else {
+            _SG_ERROR(FAIL_PIPELINE_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(fail_pipeline, pip_id);
+}
+
+SOKOL_API_IMPL void sg_fail_pass(sg_pass pass_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass) {
+        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
+            pass->slot.ctx_id = _sg.active_context.id;
+            pass->slot.state = SG_RESOURCESTATE_FAILED;
+        } else {
+            _SG_ERROR(FAIL_PASS_INVALID_STATE);
+        }
+    }
+    _SG_TRACE_ARGS(fail_pass, pass_id);
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_buffer_state(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    sg_resource_state res = buf ? buf->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_image_state(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    sg_resource_state res = img ? img->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_sampler_state(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    sg_resource_state res = smp ? smp->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_shader_state(sg_shader shd_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    sg_resource_state res = shd ? shd->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_pipeline_state(sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    sg_resource_state res = pip ? pip->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_pass_state(sg_pass pass_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    sg_resource_state res = pass ? pass->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_buffer sg_make_buffer(const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_buffer_desc desc_def = _sg_buffer_desc_defaults(desc);
+    sg_buffer buf_id = _sg_alloc_buffer();
+    if (buf_id.id != SG_INVALID_ID) {
+        _sg_buffer_t* buf = _sg_buffer_at(&_sg.pools, buf_id.id);
+        SOKOL_ASSERT(buf && (buf->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_memory_lock_budget();
+        _sg_init_buffer(buf, &desc_def);
+        SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED));
+        _sg_memory_unlock_budget();
+    }
+    _SG_TRACE_ARGS(make_buffer, &desc_def, buf_id);
+    return buf_id;
+}
+
+SOKOL_API_IMPL sg_image sg_make_image(const sg_image_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_image_desc desc_def = _sg_image_desc_defaults(desc);
+    sg_image img_id = _sg_alloc_image();
+    if (img_id.id != SG_INVALID_ID) {
+        _sg_image_t* img = _sg_image_at(&_sg.pools, img_id.id);
+        SOKOL_ASSERT(img && (img->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_memory_lock_budget();
+        _sg_init_image(img, &desc_def);
+        SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED));
+        _sg_memory_unlock_budget();
+    }
+    _SG_TRACE_ARGS(make_image, &desc_def, img_id);
+    return img_id;
+}
+
+SOKOL_API_IMPL sg_sampler sg_make_sampler(const sg_sampler_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_sampler_desc desc_def = _sg_sampler_desc_defaults(desc);
+    sg_sampler smp_id = _sg_alloc_sampler();
+    if (smp_id.id != SG_INVALID_ID) {
+        _sg_sampler_t* smp = _sg_sampler_at(&_sg.pools, smp_id.id);
+        SOKOL_ASSERT(smp && (smp->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_init_sampler(smp, &desc_def);
+        SOKOL_ASSERT((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED));
+    }
+    _SG_TRACE_ARGS(make_sampler, &desc_def, smp_id);
+    return smp_id;
+}
+
+SOKOL_API_IMPL sg_shader sg_make_shader(const sg_shader_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_shader_desc desc_def = _sg_shader_desc_defaults(desc);
+    sg_shader shd_id = _sg_alloc_shader();
+    if (shd_id.id != SG_INVALID_ID) {
+        _sg_shader_t* shd = _sg_shader_at(&_sg.pools, shd_id.id);
+        SOKOL_ASSERT(shd && (shd->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_init_shader(shd, &desc_def);
+        SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING));
+    }
+    _SG_TRACE_ARGS(make_shader, &desc_def, shd_id);
+    return shd_id;
+}
+
+SOKOL_API_IMPL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(desc);
+    sg_pipeline_desc cache_key;
+    uint64_t cache_hash = 0;
+    if (_sg.pipeline_cache.items) {
+        cache_hash = _sg_pipeline_cache_key(&desc_def, &cache_key);
+        const sg_pipeline cached_pip_id = { _sg_pipeline_cache_get(&cache_key, cache_hash) };
+        if (cached_pip_id.id != SG_INVALID_ID) {
+            _sg_stats_add(num_pipeline_cache_hits, 1);
+            return cached_pip_id;
+        }
+        _sg_stats_add(num_pipeline_cache_misses, 1);
+    }
+    sg_pipeline pip_id = _sg_alloc_pipeline();
+    if (pip_id.id != SG_INVALID_ID) {
+        _sg_pipeline_t* pip = _sg_pipeline_at(&_sg.pools, pip_id.id);
+        SOKOL_ASSERT(pip && (pip->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_init_pipeline(pip, &desc_def);
+        SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING));
+        if (_sg.pipeline_cache.items && (pip->slot.state == SG_RESOURCESTATE_VALID)) {
+            _sg_pipeline_cache_add(pip_id.id, &cache_key, cache_hash);
+        }
+    }
+    _SG_TRACE_ARGS(make_pipeline, &desc_def, pip_id);
+    return pip_id;
+}
+
+SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_pass_desc desc_def = _sg_pass_desc_defaults(desc);
+    sg_pass pass_id = _sg_alloc_pass();
+    if (pass_id.id != SG_INVALID_ID) {
+        _sg_pass_t* pass = _sg_pass_at(&_sg.pools, pass_id.id);
+        SOKOL_ASSERT(pass && (pass->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_init_pass(pass, &desc_def);
+        SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED));
+    }
+    _SG_TRACE_ARGS(make_pass, &desc_def, pass_id);
+    return pass_id;
+}
+
+SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_buffer, buf_id);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf) {
+        _sg_memory_lock_budget();
+        if ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_uninit_buffer(buf);
+            SOKOL_ASSERT(buf->slot.state == SG_RESOURCESTATE_ALLOC);
+        }
+        if (buf->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_buffer(buf);
+            SOKOL_ASSERT(buf->slot.state == SG_RESOURCESTATE_INITIAL);
+        }
+        _sg_memory_unlock_budget();
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_image, img_id);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img) {
+        _sg_memory_lock_budget();
+        if ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_uninit_image(img);
+            SOKOL_ASSERT(img->slot.state == SG_RESOURCESTATE_ALLOC);
+        }
+        if (img->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_image(img);
+            SOKOL_ASSERT(img->slot.state == SG_RESOURCESTATE_INITIAL);
+        }
+        _sg_memory_unlock_budget();
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_sampler(sg_sampler smp_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_sampler, smp_id);
+    _sg_sampler_t* smp = _sg_lookup_sampler(&_sg.pools, smp_id.id);
+    if (smp) {
+        if ((smp->slot.state == SG_RESOURCESTATE_VALID) || (smp->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_uninit_sampler(smp);
+            SOKOL_ASSERT(smp->slot.state == SG_RESOURCESTATE_ALLOC);
+        }
+        if (smp->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_sampler(smp);
+            SOKOL_ASSERT(smp->slot.state == SG_RESOURCESTATE_INITIAL);
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_shader, shd_id);
+    _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
+    if (shd) {
+        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
+            _sg_uninit_shader(shd);
+            SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_ALLOC);
+        }
+        if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_shader(shd);
+            SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_INITIAL);
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip && _sg_pipeline_cache_release(pip_id.id)) {
+        // a cached pipeline which is still referenced elsewhere
+        return;
+    }
+    _SG_TRACE_ARGS(destroy_pipeline, pip_id);
+    if (pip) {
+        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING)) {
+            _sg_uninit_pipeline(pip);
+            SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_ALLOC);
+        }
+        if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_pipeline(pip);
+            SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_INITIAL);
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_destroy_pass(sg_pass pass_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_pass, pass_id);
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass) {
+        if ((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED)) {
+            _sg_uninit_pass(pass);
+            SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_ALLOC);
+        }
+        if (pass->slot.state == SG_RESOURCESTATE_ALLOC) {
+            _sg_dealloc_pass(pass);
+            SOKOL_ASSERT(pass->slot.state == SG_RESOURCESTATE_INITIAL);
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(pass_action);
+    SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
+    sg_pass_action pa;
+    _sg_resolve_default_pass_action(pass_action, &pa);
+    _sg.cur_pass.id = SG_INVALID_ID;
+    _sg.in_pass = true;
+    _sg.pass_valid = true;
+    _sg_uniform_cache_reset();
+    _sg_timings_begin_pass(_sg.cur_pass);
+    _sg_begin_pass(0, &pa, width, height);
+    _SG_TRACE_ARGS(begin_default_pass, &pa, width, height);
+}
+
+SOKOL_API_IMPL void sg_begin_default_passf(const sg_pass_action* pass_action, float width, float height) {
+    sg_begin_default_pass(pass_action, (int)width, (int)height);
+}
+
+SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_action) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(pass_action);
+    SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
+    _sg.cur_pass = pass_id;
+    _sg.in_pass = true;
+    _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
+    if (pass && _sg_validate_begin_pass(pass)) {
+        _sg.pass_valid = true;
+        sg_pass_action pa;
+        _sg_resolve_default_pass_action(pass_action, &pa);
+        _sg_uniform_cache_reset();
+        _sg_timings_begin_pass(pass_id);
         _sg_begin_pass(pass, &pa, pass->cmn.width, pass->cmn.height);
         _SG_TRACE_ARGS(begin_pass, pass_id, &pa);
     } else {
-        _sg.pass_valid = false;
+        _sg.pass_valid = false;
+    }
+}
+
+SOKOL_API_IMPL void sg_begin_compute_pass(void) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg.cur_pass.id = SG_INVALID_ID;
+    _sg.in_pass = true;
+    _sg.compute_pass = true;
+    if (_sg_validate_begin_compute_pass() && _sg.features.compute) {
+        _sg.pass_valid = true;
+        _sg_uniform_cache_reset();
+        _SG_TRACE_NOARGS(begin_compute_pass);
+    } else {
+        _sg.pass_valid = false;
+    }
+}
+
+SOKOL_API_IMPL void sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_stats_add(num_apply_viewport, 1);
+    if (!_sg.pass_valid) {
+        return;
+    }
+    if (_sg.rec.active) {
+        _sg_record_rect(_SG_RECCMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+    } else {
+        _sg_apply_viewport(x, y, width, height, origin_top_left);
+    }
+    _SG_TRACE_ARGS(apply_viewport, x, y, width, height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_apply_viewportf(float x, float y, float width, float height, bool origin_top_left) {
+    sg_apply_viewport((int)x, (int)y, (int)width, (int)height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_stats_add(num_apply_scissor_rect, 1);
+    if (!_sg.pass_valid) {
+        return;
+    }
+    if (_sg.rec.active) {
+        _sg_record_rect(_SG_RECCMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+    } else {
+        _sg_apply_scissor_rect(x, y, width, height, origin_top_left);
+    }
+    _SG_TRACE_ARGS(apply_scissor_rect, x, y, width, height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_apply_scissor_rectf(float x, float y, float width, float height, bool origin_top_left) {
+    sg_apply_scissor_rect((int)x, (int)y, (int)width, (int)height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_stats_add(num_apply_pipeline, 1);
+    _sg.bindings_applied = false;
+    _sg.cur_pipeline_pending = false;
+    const _sg_pipeline_t* pending_pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pending_pip && (pending_pip->slot.state == SG_RESOURCESTATE_PENDING)) {
+        // not an error, skip rendering until the shader is ready
+        _sg_stats_add(num_apply_pending_pipeline, 1);
+        _sg.cur_pipeline_pending = true;
+        _sg.next_draw_valid = false;
+        return;
+    }
+    if (!_sg_validate_apply_pipeline(pip_id)) {
+        _sg.next_draw_valid = false;
+        return;
+    }
+    if (!_sg.pass_valid) {
+        return;
+    }
+    _sg.cur_pipeline = pip_id;
+    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    SOKOL_ASSERT(pip);
+    _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
+    _sg.next_draw_valid &= (pip->cmn.is_compute == _sg.compute_pass);
+    SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
+    if (_sg.rec.active) {
+        _sg_record_apply_pipeline(pip);
+    } else {
+        _sg_uniform_cache_reset();
+        _sg_apply_pipeline(pip);
+    }
+    _SG_TRACE_ARGS(apply_pipeline, pip_id);
+}
+
+SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(bindings);
+    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    _sg_stats_add(num_apply_bindings, 1);
+    if (_sg.cur_pipeline_pending) {
+        _sg.bindings_applied = true;
+        return;
+    }
+    // compute bindings are resolved through the vertex stage slot
+    sg_bindings cs_bindings;
+    if (_sg.compute_pass) {
+        if (!_sg_validate_apply_compute_bindings(bindings)) {
+            _sg.next_draw_valid = false;
+            return;
+        }
+        _sg_clear(&cs_bindings, sizeof(cs_bindings));
+        cs_bindings.vs = bindings->cs;
+        bindings = &cs_bindings;
+    }
+    if (!_sg_validate_apply_bindings(bindings)) {
+        _sg.next_draw_valid = false;
+        return;
+    }
+    _sg.bindings_applied = true;
+
+    _sg_bindings_t bnd;
+    _sg_clear(&bnd, sizeof(bnd));
+    bnd.pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+    if (0 == bnd.pip) {
+        _sg.next_draw_valid = false;
+    }
+
+    for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++, bnd.num_vbs++) {
+        if (bindings->vertex_buffers[i].id) {
+            bnd.vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+            bnd.vb_offsets[i] = bindings->vertex_buffer_offsets[i];
+            if (bnd.vbs[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vbs[i]->slot.state);
+                _sg.next_draw_valid &= !bnd.vbs[i]->cmn.append_overflow;
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    if (bindings->index_buffer.id) {
+        bnd.ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        bnd.ib_offset = bindings->index_buffer_offset;
+        if (bnd.ib) {
+            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.ib->slot.state);
+            _sg.next_draw_valid &= !bnd.ib->cmn.append_overflow;
+        } else {
+            _sg.next_draw_valid = false;
+        }
+    }
+
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, bnd.num_vs_imgs++) {
+        if (bindings->vs.images[i].id) {
+            bnd.vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs.images[i].id);
+            if (bnd.vs_imgs[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vs_imgs[i]->slot.state);
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++, bnd.num_vs_smps++) {
+        if (bindings->vs.samplers[i].id) {
+            bnd.vs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->vs.samplers[i].id);
+            if (bnd.vs_smps[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vs_smps[i]->slot.state);
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, bnd.num_fs_imgs++) {
+        if (bindings->fs.images[i].id) {
+            bnd.fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs.images[i].id);
+            if (bnd.fs_imgs[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.fs_imgs[i]->slot.state);
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++, bnd.num_fs_smps++) {
+        if (bindings->fs.samplers[i].id) {
+            bnd.fs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->fs.samplers[i].id);
+            if (bnd.fs_smps[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.fs_smps[i]->slot.state);
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++, bnd.num_vs_sbufs++) {
+        if (bindings->vs.storage_buffers[i].id) {
+            bnd.vs_sbufs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vs.storage_buffers[i].id);
+            if (bnd.vs_sbufs[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vs_sbufs[i]->slot.state);
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++, bnd.num_fs_sbufs++) {
+        if (bindings->fs.storage_buffers[i].id) {
+            bnd.fs_sbufs[i] = _sg_lookup_buffer(&_sg.pools, bindings->fs.storage_buffers[i].id);
+            if (bnd.fs_sbufs[i]) {
+                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.fs_sbufs[i]->slot.state);
+            } else {
+                _sg.next_draw_valid = false;
+            }
+        } else {
+            break;
+        }
+    }
+
+    if (_sg.next_draw_valid) {
+        if (_sg.rec.active) {
+            _sg_record_apply_bindings(&bnd);
+        } else {
+            _sg.next_draw_valid &= _sg_apply_bindings(&bnd);
+        }
+        _SG_TRACE_ARGS(apply_bindings, bindings);
+    }
+}
+
+SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS) || (stage == SG_SHADERSTAGE_CS));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_stats_add(num_apply_uniforms, 1);
+    _sg_stats_add(size_apply_uniforms, (uint32_t)data->size);
+    if (_sg.cur_pipeline_pending) {
+        return;
+    }
+    if (!_sg_validate_apply_uniforms(stage, ub_index, data)) {
+        _sg.next_draw_valid = false;
+        return;
+    }
+    if (!_sg.pass_valid) {
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        return;
+    }
+    // compute shader uniforms live in the vertex stage slot
+    const sg_shader_stage slot = _sg_shader_stage_slot(stage);
+    if (_sg.rec.active) {
+        _sg_record_apply_uniforms(slot, ub_index, data);
+    } else if (_sg_uniform_cache_test_and_set(slot, ub_index, data)) {
+        _sg_stats_add(num_skipped_apply_uniforms, 1);
+    } else {
+        _sg_apply_uniforms(slot, ub_index, data);
     }
+    _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data);
 }
 
-SOKOL_API_IMPL void sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left) {
+SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instances) {
     SOKOL_ASSERT(_sg.valid);
-    _sg_stats_add(num_apply_viewport, 1);
+    SOKOL_ASSERT(base_element >= 0);
+    SOKOL_ASSERT(num_elements >= 0);
+    SOKOL_ASSERT(num_instances >= 0);
+    _sg_stats_add(num_draw, 1);
+    if (_sg.compute_pass) {
+        _SG_ERROR(DRAW_IN_COMPUTE_PASS);
+        return;
+    }
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_applied) {
+            _SG_WARN(DRAW_WITHOUT_BINDINGS);
+        }
+    #endif
     if (!_sg.pass_valid) {
         return;
     }
-    _sg_apply_viewport(x, y, width, height, origin_top_left);
-    _SG_TRACE_ARGS(apply_viewport, x, y, width, height, origin_top_left);
+    if (!_sg.next_draw_valid) {
+        return;
+    }
+    if (!_sg.bindings_applied) {
+        return;
+    }
+    /* attempting to draw with zero elements or instances is not technically an
+       error, but might be handled as an error in the backend API (e.g. on Metal)
+    */
+    if ((0 == num_elements) || (0 == num_instances)) {
+        return;
+    }
+    if (_sg.rec.active) {
+        _sg_record_draw(base_element, num_elements, num_instances);
+    } else {
+        _sg_draw(base_element, num_elements, num_instances);
+    }
+    _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
-SOKOL_API_IMPL void sg_apply_viewportf(float x, float y, float width, float height, bool origin_top_left) {
-    sg_apply_viewport((int)x, (int)y, (int)width, (int)height, origin_top_left);
+SOKOL_API_IMPL void sg_draw_multi(const sg_draw_args* args, int count) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(args || (0 == count));
+    SOKOL_ASSERT(count >= 0);
+    _sg_stats_add(num_draw_multi, 1);
+    if (_sg.compute_pass) {
+        _SG_ERROR(DRAW_IN_COMPUTE_PASS);
+        return;
+    }
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_applied) {
+            _SG_WARN(DRAW_WITHOUT_BINDINGS);
+        }
+    #endif
+    if (!_sg.pass_valid) {
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        return;
+    }
+    if (!_sg.bindings_applied) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        SOKOL_ASSERT((args[i].base_element >= 0) && (args[i].num_elements >= 0) && (args[i].num_instances >= 0));
+    }
+    if (_sg.rec.active) {
+        for (int i = 0; i < count; i++) {
+            if (_sg_draw_args_drawable(&args[i])) {
+                _sg_record_draw(args[i].base_element, args[i].num_elements, args[i].num_instances);
+            }
+        }
+    } else if (count > 0) {
+        _sg_draw_multi(args, count);
+    }
+    _SG_TRACE_ARGS(draw_multi, args, count);
 }
 
-SOKOL_API_IMPL void sg_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left) {
+SOKOL_API_IMPL void sg_draw_indirect(sg_buffer buf_id, int offset, int count) {
     SOKOL_ASSERT(_sg.valid);
-    _sg_stats_add(num_apply_scissor_rect, 1);
+    SOKOL_ASSERT(count >= 0);
+    _sg_stats_add(num_draw_indirect, 1);
+    if (_sg.compute_pass) {
+        _SG_ERROR(DRAW_IN_COMPUTE_PASS);
+        return;
+    }
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_applied) {
+            _SG_WARN(DRAW_WITHOUT_BINDINGS);
+        }
+    #endif
+    if (!_sg_validate_draw_indirect(buf_id, offset, count)) {
+        return;
+    }
     if (!_sg.pass_valid) {
         return;
     }
-    _sg_apply_scissor_rect(x, y, width, height, origin_top_left);
-    _SG_TRACE_ARGS(apply_scissor_rect, x, y, width, height, origin_top_left);
+    if (!_sg.next_draw_valid) {
+        return;
+    }
+    if (!_sg.bindings_applied) {
+        return;
+    }
+    if (_sg.rec.active || (0 == count)) {
+        return;
+    }
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID) && (buf->cmn.type == SG_BUFFERTYPE_INDIRECTBUFFER)) {
+        // out-of-bounds checks must also happen in release mode since the fallback reads CPU memory
+        if ((offset >= 0) && ((size_t)offset + (size_t)count * sizeof(sg_draw_indirect_args) <= (size_t)buf->cmn.size)) {
+            _sg_draw_indirect(buf, offset, count);
+        }
+    }
+    _SG_TRACE_ARGS(draw_indirect, buf_id, offset, count);
 }
 
-SOKOL_API_IMPL void sg_apply_scissor_rectf(float x, float y, float width, float height, bool origin_top_left) {
-    sg_apply_scissor_rect((int)x, (int)y, (int)width, (int)height, origin_top_left);
+SOKOL_API_IMPL void sg_dispatch(int num_groups_x, int num_groups_y, int num_groups_z) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((num_groups_x >= 0) && (num_groups_y >= 0) && (num_groups_z >= 0));
+    _sg_stats_add(num_dispatch, 1);
+    if (!_sg_validate_dispatch()) {
+        return;
+    }
+    if (!_sg.compute_pass || !_sg.pass_valid) {
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        return;
+    }
+    if (!_sg.bindings_applied) {
+        return;
+    }
+    if ((0 == num_groups_x) || (0 == num_groups_y) || (0 == num_groups_z)) {
+        return;
+    }
+    _sg_dispatch(num_groups_x, num_groups_y, num_groups_z);
+    _SG_TRACE_ARGS(dispatch, num_groups_x, num_groups_y, num_groups_z);
 }
 
-SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
+SOKOL_API_IMPL void sg_end_pass(void) {
     SOKOL_ASSERT(_sg.valid);
-    _sg_stats_add(num_apply_pipeline, 1);
-    _sg.bindings_applied = false;
-    if (!_sg_validate_apply_pipeline(pip_id)) {
-        _sg.next_draw_valid = false;
+    _sg.in_pass = false;
+    _sg_stats_add(num_passes, 1);
+    if (_sg.compute_pass) {
+        // compute passes have no backend render pass to finish
+        _sg.compute_pass = false;
+        _sg.cur_pipeline_pending = false;
+        _sg.cur_pipeline.id = SG_INVALID_ID;
+        _sg.pass_valid = false;
+        _SG_TRACE_NOARGS(end_pass);
         return;
     }
+    if (_sg.rec.active) {
+        _SG_ERROR(RECORDING_NOT_FINISHED);
+        _sg_recording_t* rec = _sg_current_recording();
+        if (rec) {
+            _sg_discard_recording(rec);
+        }
+        _sg_clear(&_sg.rec, sizeof(_sg.rec));
+    }
+    _sg.cur_pipeline_pending = false;
     if (!_sg.pass_valid) {
+        _sg.draw_queue.num_items = 0;
+        _sg.draw_queue.ub_pos = 0;
         return;
     }
-    _sg.cur_pipeline = pip_id;
-    _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-    SOKOL_ASSERT(pip);
-    _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
-    SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
-    _sg_apply_pipeline(pip);
-    _SG_TRACE_ARGS(apply_pipeline, pip_id);
+    _sg_flush_draw_queue();
+    _sg_end_pass();
+    _sg_timings_end_pass();
+    if (_sg.cur_pass.id != SG_INVALID_ID) {
+        const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
+        if (pass) {
+            _sg_generate_pass_mipmaps(pass);
+        }
+    }
+    _sg.cur_pass.id = SG_INVALID_ID;
+    _sg.cur_pipeline.id = SG_INVALID_ID;
+    _sg.pass_valid = false;
+    _SG_TRACE_NOARGS(end_pass);
 }
 
-SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
+SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(bindings);
-    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
-    _sg_stats_add(num_apply_bindings, 1);
-    if (!_sg_validate_apply_bindings(bindings)) {
+    _sg_timings_commit();
+    if (_sg.desc.enable_async_shaders) {
+        _sg_update_pending_resources();
+    }
+    _sg_memory_lock_budget();
+    _sg_transient_commit();
+    _sg_memory_unlock_budget();
+    _sg_commit();
+    _sg.stats.frame_index = _sg.frame_index;
+    _sg.prev_stats = _sg.stats;
+    _sg_clear(&_sg.stats, sizeof(_sg.stats));
+    _sg_notify_commit_listeners();
+    _SG_TRACE_NOARGS(commit);
+    _sg.frame_index++;
+    if (_sg.reads.num_pending > 0) {
+        _sg_update_pending_reads();
+    }
+}
+
+SOKOL_API_IMPL void sg_begin_recording(void) {
+    SOKOL_ASSERT(_sg.valid);
+    if (!_sg_validate_begin_recording()) {
+        return;
+    }
+    if (!_sg.pass_valid || _sg.rec.active || _sg.compute_pass) {
+        return;
+    }
+    _sg.rec.active = true;
+    _sg.rec.cur_pipeline = _sg.cur_pipeline;
+    _sg.rec.bindings_applied = _sg.bindings_applied;
+    _sg.rec.next_draw_valid = _sg.next_draw_valid;
+    _sg.rec.cur_pipeline_pending = _sg.cur_pipeline_pending;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.recording_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_recording_t* rec = &_sg.pools.recordings[slot_index];
+        _sg.rec.id.id = _sg_slot_alloc(&_sg.pools.recording_pool, &rec->slot, slot_index);
+        rec->slot.ctx_id = _sg.active_context.id;
+        _sg_current_pass_attrs(&rec->pass_attrs);
+    } else {
+        // commands will be dropped until sg_end_recording()
+        _sg.rec.id.id = SG_INVALID_ID;
+        _SG_ERROR(RECORDING_POOL_EXHAUSTED);
+    }
+}
+
+SOKOL_API_IMPL sg_recording sg_end_recording(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_recording res = { SG_INVALID_ID };
+    if (!_sg_validate_end_recording()) {
+        return res;
+    }
+    if (!_sg.rec.active) {
+        return res;
+    }
+    _sg_recording_t* rec = _sg_current_recording();
+    if (rec) {
+        rec->slot.state = SG_RESOURCESTATE_VALID;
+        res = _sg.rec.id;
+    }
+    // the backend hasn't seen any of the recorded commands, so restore the pre-recording state
+    _sg.cur_pipeline = _sg.rec.cur_pipeline;
+    _sg.bindings_applied = _sg.rec.bindings_applied;
+    _sg.next_draw_valid = _sg.rec.next_draw_valid;
+    _sg.cur_pipeline_pending = _sg.rec.cur_pipeline_pending;
+    _sg_clear(&_sg.rec, sizeof(_sg.rec));
+    return res;
+}
+
+SOKOL_API_IMPL void sg_replay(sg_recording rec_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_stats_add(num_replay, 1);
+    if (!_sg_validate_replay(rec_id)) {
         _sg.next_draw_valid = false;
         return;
     }
-    _sg.bindings_applied = true;
+    if (!_sg.pass_valid || _sg.rec.active || _sg.compute_pass) {
+        return;
+    }
+    _sg_recording_t* rec = _sg_lookup_recording(&_sg.pools, rec_id.id);
+    if (!(rec && (rec->slot.state == SG_RESOURCESTATE_VALID))) {
+        return;
+    }
+    if (!_sg_recording_resources_valid(rec)) {
+        return;
+    }
+    _sg_stats_add(num_replay_commands, (uint32_t)rec->num_cmds);
+    _sg_replay(rec);
+    // the last pipeline in the recording is now applied, but bindings are not
+    if (rec->last_pipeline.id != SG_INVALID_ID) {
+        _sg.cur_pipeline = rec->last_pipeline;
+        _sg.cur_pipeline_pending = false;
+        _sg.next_draw_valid = true;
+    }
+    _sg.bindings_applied = false;
+}
+
+SOKOL_API_IMPL void sg_destroy_recording(sg_recording rec_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_recording_t* rec = _sg_lookup_recording(&_sg.pools, rec_id.id);
+    if (rec) {
+        _sg_discard_recording(rec);
+    }
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_recording_state(sg_recording rec_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_recording_t* rec = _sg_lookup_recording(&_sg.pools, rec_id.id);
+    sg_resource_state res = rec ? rec->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL sg_encoder sg_make_encoder(const sg_encoder_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_encoder_desc desc_def = _sg_encoder_desc_defaults(desc);
+    sg_encoder res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.encoder_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_encoder_t* enc = &_sg.pools.encoders[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.encoder_pool, &enc->slot, slot_index);
+        _sg_init_encoder(enc, &desc_def);
+    } else {
+        res.id = SG_INVALID_ID;
+        _SG_ERROR(ENCODER_POOL_EXHAUSTED);
+    }
+    return res;
+}
 
-    _sg_bindings_t bnd;
-    _sg_clear(&bnd, sizeof(bnd));
-    bnd.pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
-    if (0 == bnd.pip) {
-        _sg.next_draw_valid = false;
+SOKOL_API_IMPL void sg_destroy_encoder(sg_encoder enc_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc) {
+        _sg_discard_encoder(enc);
     }
+}
 
-    for (int i = 0; i < SG_MAX_VERTEX_BUFFERS; i++, bnd.num_vbs++) {
-        if (bindings->vertex_buffers[i].id) {
-            bnd.vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
-            bnd.vb_offsets[i] = bindings->vertex_buffer_offsets[i];
-            if (bnd.vbs[i]) {
-                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vbs[i]->slot.state);
-                _sg.next_draw_valid &= !bnd.vbs[i]->cmn.append_overflow;
-            } else {
-                _sg.next_draw_valid = false;
-            }
-        } else {
-            break;
-        }
-    }
+SOKOL_API_IMPL void sg_encoder_apply_viewport(sg_encoder enc_id, int x, int y, int width, int height, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_encoder_rect(enc_id, _SG_RECCMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+}
 
-    if (bindings->index_buffer.id) {
-        bnd.ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
-        bnd.ib_offset = bindings->index_buffer_offset;
-        if (bnd.ib) {
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.ib->slot.state);
-            _sg.next_draw_valid &= !bnd.ib->cmn.append_overflow;
-        } else {
-            _sg.next_draw_valid = false;
-        }
-    }
+SOKOL_API_IMPL void sg_encoder_apply_scissor_rect(sg_encoder enc_id, int x, int y, int width, int height, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_encoder_rect(enc_id, _SG_RECCMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+}
 
-    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, bnd.num_vs_imgs++) {
-        if (bindings->vs.images[i].id) {
-            bnd.vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs.images[i].id);
-            if (bnd.vs_imgs[i]) {
-                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vs_imgs[i]->slot.state);
-            } else {
-                _sg.next_draw_valid = false;
-            }
-        } else {
-            break;
+SOKOL_API_IMPL void sg_encoder_apply_pipeline(sg_encoder enc_id, sg_pipeline pip_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc && (enc->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_enccmd_t* cmd = _sg_encoder_next_cmd(enc, _SG_RECCMD_APPLY_PIPELINE, 0);
+        if (cmd) {
+            cmd->args.pip = pip_id;
         }
     }
+}
 
-    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++, bnd.num_vs_smps++) {
-        if (bindings->vs.samplers[i].id) {
-            bnd.vs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->vs.samplers[i].id);
-            if (bnd.vs_smps[i]) {
-                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.vs_smps[i]->slot.state);
-            } else {
-                _sg.next_draw_valid = false;
-            }
-        } else {
-            break;
+SOKOL_API_IMPL void sg_encoder_apply_bindings(sg_encoder enc_id, const sg_bindings* bindings) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(bindings);
+    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc && (enc->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_enccmd_t* cmd = _sg_encoder_next_cmd(enc, _SG_RECCMD_APPLY_BINDINGS, (int)sizeof(sg_bindings));
+        if (cmd) {
+            memcpy(_sg_enccmd_payload(cmd), bindings, sizeof(sg_bindings));
         }
     }
+}
 
-    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, bnd.num_fs_imgs++) {
-        if (bindings->fs.images[i].id) {
-            bnd.fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs.images[i].id);
-            if (bnd.fs_imgs[i]) {
-                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.fs_imgs[i]->slot.state);
-            } else {
-                _sg.next_draw_valid = false;
-            }
-        } else {
-            break;
+SOKOL_API_IMPL void sg_encoder_apply_uniforms(sg_encoder enc_id, sg_shader_stage stage, int ub_index, const sg_range* data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc && (enc->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_enccmd_t* cmd = _sg_encoder_next_cmd(enc, _SG_RECCMD_APPLY_UNIFORMS, (int)data->size);
+        if (cmd) {
+            cmd->args.uniforms.stage = stage;
+            cmd->args.uniforms.ub_index = ub_index;
+            cmd->args.uniforms.size = (int)data->size;
+            memcpy(_sg_enccmd_payload(cmd), data->ptr, data->size);
         }
     }
+}
 
-    for (int i = 0; i < SG_MAX_SHADERSTAGE_SAMPLERS; i++, bnd.num_fs_smps++) {
-        if (bindings->fs.samplers[i].id) {
-            bnd.fs_smps[i] = _sg_lookup_sampler(&_sg.pools, bindings->fs.samplers[i].id);
-            if (bnd.fs_smps[i]) {
-                _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == bnd.fs_smps[i]->slot.state);
-            } else {
-                _sg.next_draw_valid = false;
-            }
-        } else {
-            break;
+SOKOL_API_IMPL void sg_encoder_draw(sg_encoder enc_id, int base_element, int num_elements, int num_instances) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(base_element >= 0);
+    SOKOL_ASSERT(num_elements >= 0);
+    SOKOL_ASSERT(num_instances >= 0);
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc && (enc->slot.state == SG_RESOURCESTATE_VALID)) {
+        _sg_enccmd_t* cmd = _sg_encoder_next_cmd(enc, _SG_RECCMD_DRAW, 0);
+        if (cmd) {
+            cmd->args.draw.base_element = base_element;
+            cmd->args.draw.num_elements = num_elements;
+            cmd->args.draw.num_instances = num_instances;
         }
     }
+}
 
-    if (_sg.next_draw_valid) {
-        _sg.next_draw_valid &= _sg_apply_bindings(&bnd);
-        _SG_TRACE_ARGS(apply_bindings, bindings);
+SOKOL_API_IMPL void sg_encoder_rewind(sg_encoder enc_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (enc) {
+        enc->pos = 0;
+        enc->overflow = false;
     }
 }
 
-SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
+SOKOL_API_IMPL bool sg_query_encoder_overflow(sg_encoder enc_id) {
     SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS));
-    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
-    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
-    _sg_stats_add(num_apply_uniforms, 1);
-    _sg_stats_add(size_apply_uniforms, (uint32_t)data->size);
-    if (!_sg_validate_apply_uniforms(stage, ub_index, data)) {
-        _sg.next_draw_valid = false;
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    bool result = enc ? enc->overflow : false;
+    return result;
+}
+
+SOKOL_API_IMPL sg_resource_state sg_query_encoder_state(sg_encoder enc_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    sg_resource_state res = enc ? enc->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
+}
+
+SOKOL_API_IMPL void sg_submit_encoder(sg_encoder enc_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_stats_add(num_submit_encoder, 1);
+    if (!_sg_validate_submit_encoder(enc_id)) {
         return;
     }
-    if (!_sg.pass_valid) {
+    _sg_encoder_t* enc = _sg_lookup_encoder(&_sg.pools, enc_id.id);
+    if (!(enc && (enc->slot.state == SG_RESOURCESTATE_VALID))) {
         return;
     }
-    if (!_sg.next_draw_valid) {
-        return;
+    if (enc->overflow) {
+        _SG_ERROR(ENCODER_OVERFLOW);
+    } else {
+        _sg_submit_encoder(enc);
     }
-    _sg_apply_uniforms(stage, ub_index, data);
-    _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data);
+    enc->pos = 0;
+    enc->overflow = false;
 }
 
-SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instances) {
+SOKOL_API_IMPL void sg_queue_draw(const sg_queued_draw* draw) {
     SOKOL_ASSERT(_sg.valid);
-    SOKOL_ASSERT(base_element >= 0);
-    SOKOL_ASSERT(num_elements >= 0);
-    SOKOL_ASSERT(num_instances >= 0);
-    _sg_stats_add(num_draw, 1);
-    #if defined(SOKOL_DEBUG)
-        if (!_sg.bindings_applied) {
-            _SG_WARN(DRAW_WITHOUT_BINDINGS);
-        }
-    #endif
-    if (!_sg.pass_valid) {
+    SOKOL_ASSERT(draw);
+    SOKOL_ASSERT((draw->base_element >= 0) && (draw->num_elements >= 0) && (draw->num_instances >= 0));
+    if (!_sg_validate_queue_draw(draw)) {
         return;
     }
-    if (!_sg.next_draw_valid) {
+    if (!_sg.pass_valid || _sg.rec.active || _sg.compute_pass) {
         return;
     }
-    if (!_sg.bindings_applied) {
-        return;
+    _sg_queue_draw(draw);
+}
+
+SOKOL_API_IMPL sg_binding_set sg_make_binding_set(const sg_binding_set_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_binding_set res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.binding_set_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        _sg_binding_set_t* bs = &_sg.pools.binding_sets[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.binding_set_pool, &bs->slot, slot_index);
+        _sg_init_binding_set(bs, desc);
+    } else {
+        res.id = SG_INVALID_ID;
+        _SG_ERROR(BINDING_SET_POOL_EXHAUSTED);
     }
-    /* attempting to draw with zero elements or instances is not technically an
-       error, but might be handled as an error in the backend API (e.g. on Metal)
-    */
-    if ((0 == num_elements) || (0 == num_instances)) {
-        return;
+    return res;
+}
+
+SOKOL_API_IMPL void sg_destroy_binding_set(sg_binding_set bs_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_binding_set_t* bs = _sg_lookup_binding_set(&_sg.pools, bs_id.id);
+    if (bs) {
+        _sg_discard_binding_set(bs);
     }
-    _sg_draw(base_element, num_elements, num_instances);
-    _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
-SOKOL_API_IMPL void sg_end_pass(void) {
+SOKOL_API_IMPL void sg_apply_binding_set(sg_binding_set bs_id) {
     SOKOL_ASSERT(_sg.valid);
-    _sg_stats_add(num_passes, 1);
-    if (!_sg.pass_valid) {
+    _sg_stats_add(num_apply_bindings, 1);
+    _sg_binding_set_t* bs = _sg_lookup_binding_set(&_sg.pools, bs_id.id);
+    if (_sg.cur_pipeline_pending) {
+        _sg.bindings_applied = true;
         return;
     }
-    _sg_end_pass();
-    _sg.cur_pass.id = SG_INVALID_ID;
-    _sg.cur_pipeline.id = SG_INVALID_ID;
-    _sg.pass_valid = false;
-    _SG_TRACE_NOARGS(end_pass);
+    if (!_sg_validate_apply_binding_set(bs) || _sg.compute_pass) {
+        _sg.next_draw_valid = false;
+        return;
+    }
+    _sg.bindings_applied = true;
+    if (!(bs && (bs->slot.state == SG_RESOURCESTATE_VALID) && _sg_binding_set_resources_valid(bs))) {
+        _sg.next_draw_valid = false;
+        return;
+    }
+    _sg_bindings_t* bnd = &bs->bnd;
+    bnd->pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+    if (0 == bnd->pip) {
+        _sg.next_draw_valid = false;
+    }
+    for (int i = 0; i < bnd->num_vbs; i++) {
+        _sg.next_draw_valid &= !bnd->vbs[i]->cmn.append_overflow;
+    }
+    if (bnd->ib) {
+        _sg.next_draw_valid &= !bnd->ib->cmn.append_overflow;
+    }
+    if (_sg.next_draw_valid) {
+        if (_sg.rec.active) {
+            _sg_record_apply_bindings(bnd);
+        } else {
+            _sg.next_draw_valid &= _sg_apply_bindings(bnd);
+        }
+    }
 }
 
-SOKOL_API_IMPL void sg_commit(void) {
+SOKOL_API_IMPL sg_resource_state sg_query_binding_set_state(sg_binding_set bs_id) {
     SOKOL_ASSERT(_sg.valid);
-    _sg_commit();
-    _sg.stats.frame_index = _sg.frame_index;
-    _sg.prev_stats = _sg.stats;
-    _sg_clear(&_sg.stats, sizeof(_sg.stats));
-    _sg_notify_commit_listeners();
-    _SG_TRACE_NOARGS(commit);
-    _sg.frame_index++;
+    _sg_binding_set_t* bs = _sg_lookup_binding_set(&_sg.pools, bs_id.id);
+    sg_resource_state res = bs ? bs->slot.state : SG_RESOURCESTATE_INVALID;
+    return res;
 }
 
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_uniform_cache_reset();
     _sg_reset_state_cache();
     _SG_TRACE_NOARGS(reset_state_cache);
 }
@@ -17994,6 +24638,9 @@ SOKOL_API_IMPL void sg_update_buffer(sg_buffer buf_id, const sg_range* data) {
             // update and append on same buffer in same frame not allowed
             SOKOL_ASSERT(buf->cmn.append_frame_index != _sg.frame_index);
             _sg_update_buffer(buf, data);
+            if (buf->cmn.indirect_data) {
+                memcpy(buf->cmn.indirect_data, data->ptr, data->size);
+            }
             buf->cmn.update_frame_index = _sg.frame_index;
         }
     }
@@ -18007,7 +24654,9 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
     _sg_stats_add(size_append_buffer, (uint32_t)data->size);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     int result;
-    if (buf) {
+    if (buf && (buf->cmn.usage == SG_USAGE_STREAM_RING)) {
+        result = _sg_append_ring_buffer(buf, data);
+    } else if (buf) {
         // rewind append cursor in a new frame
         if (buf->cmn.append_frame_index != _sg.frame_index) {
             buf->cmn.append_pos = 0;
@@ -18026,6 +24675,9 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
                     // update and append on same buffer in same frame not allowed
                     SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
                     _sg_append_buffer(buf, data, buf->cmn.append_frame_index != _sg.frame_index);
+                    if (buf->cmn.indirect_data) {
+                        memcpy(buf->cmn.indirect_data + start_pos, data->ptr, data->size);
+                    }
                     buf->cmn.append_pos += (int) _sg_roundup_u64(data->size, 4);
                     buf->cmn.append_frame_index = _sg.frame_index;
                 }
@@ -18057,13 +24709,125 @@ SOKOL_API_IMPL bool sg_query_buffer_will_overflow(sg_buffer buf_id, size_t size)
         if (buf->cmn.append_frame_index != _sg.frame_index) {
             append_pos = 0;
         }
-        if ((append_pos + _sg_roundup((int)size, 4)) > buf->cmn.size) {
+        const int max_size = (buf->cmn.usage == SG_USAGE_STREAM_RING) ? _sg_ring_region_size(buf->cmn.size) : buf->cmn.size;
+        if ((append_pos + _sg_roundup((int)size, 4)) > max_size) {
             result = true;
         }
     }
     return result;
 }
 
+SOKOL_API_IMPL sg_mapped_range sg_map_buffer_range(sg_buffer buf_id, size_t size) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(size > 0);
+    _sg_stats_add(num_map_buffer, 1);
+    _sg_stats_add(size_map_buffer, (uint32_t)size);
+    sg_mapped_range res;
+    _sg_clear(&res, sizeof(res));
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+        if (_sg_validate_map_buffer(buf)) {
+            if ((buf->cmn.usage == SG_USAGE_STREAM_RING) && !buf->cmn.mapped) {
+                res = _sg_map_ring_buffer(buf, size);
+            }
+        }
+    }
+    return res;
+}
+
+SOKOL_API_IMPL void sg_unmap_buffer_range(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+        if (_sg_validate_unmap_buffer(buf)) {
+            if (buf->cmn.mapped) {
+                _sg_unmap_ring_buffer(buf);
+            }
+        }
+    }
+}
+
+SOKOL_API_IMPL sg_mapped_range sg_map_image_upload(sg_image img_id, int face, int mip_level) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_mapped_range res;
+    _sg_clear(&res, sizeof(res));
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+        if (_sg_validate_map_image_upload(img, face, mip_level)) {
+            if (_sg.features.image_upload && !_sg.upload.mapped) {
+                res = _sg_map_image_upload(img, face, mip_level);
+            }
+        }
+    }
+    return res;
+}
+
+SOKOL_API_IMPL sg_image_upload sg_unmap_image_upload(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_image_upload res;
+    _sg_clear(&res, sizeof(res));
+    if (_sg_validate_unmap_image_upload(img_id.id)) {
+        if (_sg.upload.mapped && (_sg.upload.map_img_id == img_id.id)) {
+            res = _sg_unmap_image_upload(_sg_lookup_image(&_sg.pools, img_id.id));
+        }
+    }
+    return res;
+}
+
+SOKOL_API_IMPL bool sg_query_image_upload_done(sg_image_upload upload) {
+    SOKOL_ASSERT(_sg.valid);
+    if (_sg.upload.queue_count > 0) {
+        _sg_retire_uploads();
+    }
+    return (upload.id != SG_INVALID_ID) && (upload.id <= _sg.upload.done_id);
+}
+
+SOKOL_API_IMPL bool sg_read_image_async(const sg_read_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    sg_read_result res;
+    _sg_image_t* img = _sg_resolve_read_desc(desc, &res);
+    if (!_sg_validate_read_image(desc, img, &res, 0)) {
+        return false;
+    }
+    if (!_sg_read_desc_valid(desc, img, &res) || (0 == desc->callback)) {
+        return false;
+    }
+    int read_index = -1;
+    for (int i = 0; i < _SG_MAX_PENDING_READS; i++) {
+        if (!_sg.reads.items[i].active) {
+            read_index = i;
+            break;
+        }
+    }
+    if (read_index < 0) {
+        _SG_ERROR(IMAGE_READ_QUEUE_FULL);
+        return false;
+    }
+    _sg_read_item_t* item = &_sg.reads.items[read_index];
+    item->active = true;
+    item->result = res;
+    item->callback = desc->callback;
+    _sg.reads.num_pending++;
+    _sg_start_read(img, &item->result, read_index);
+    return true;
+}
+
+SOKOL_API_IMPL bool sg_read_image(const sg_read_desc* desc, const sg_range* data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc && data);
+    sg_read_result res;
+    _sg_image_t* img = _sg_resolve_read_desc(desc, &res);
+    if (!_sg_validate_read_image(desc, img, &res, data)) {
+        return false;
+    }
+    if (!_sg_read_desc_valid(desc, img, &res) || !data->ptr || (data->size < res.data.size)) {
+        return false;
+    }
+    _sg_read_image(img, &res, (void*)data->ptr);
+    return true;
+}
+
 SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data) {
     SOKOL_ASSERT(_sg.valid);
     _sg_stats_add(num_update_image, 1);
@@ -18086,9 +24850,23 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data)
     _SG_TRACE_ARGS(update_image, img_id, data);
 }
 
+SOKOL_API_IMPL void sg_generate_mipmaps(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+        if (_sg_validate_generate_mipmaps(img)) {
+            if (_sg_can_generate_mipmaps(img)) {
+                _sg_stats_add(num_generate_mipmaps, 1);
+                _sg_generate_mipmaps(img);
+            }
+        }
+    }
+}
+
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
+    _sg_timings_push_debug_group(name);
     _sg_push_debug_group(name);
     _SG_TRACE_ARGS(push_debug_group, name);
 }
@@ -18096,6 +24874,7 @@ SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
 SOKOL_API_IMPL void sg_pop_debug_group(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_pop_debug_group();
+    _sg_timings_pop_debug_group();
     _SG_TRACE_NOARGS(pop_debug_group);
 }
 
@@ -18143,6 +24922,9 @@ SOKOL_API_IMPL sg_buffer_info sg_query_buffer_info(sg_buffer buf_id) {
         info.num_slots = buf->cmn.num_slots;
         info.active_slot = buf->cmn.active_slot;
         #endif
+        if (buf->slot.state == SG_RESOURCESTATE_VALID) {
+            info.memory_size = _sg_buffer_memory_size(&buf->cmn);
+        }
     }
     return info;
 }
@@ -18164,6 +24946,9 @@ SOKOL_API_IMPL sg_image_info sg_query_image_info(sg_image img_id) {
         info.num_slots = img->cmn.num_slots;
         info.active_slot = img->cmn.active_slot;
         #endif
+        if (img->slot.state == SG_RESOURCESTATE_VALID) {
+            info.memory_size = _sg_image_memory_size(&img->cmn);
+        }
     }
     return info;
 }
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+//  sokol_fetch_bench.c
+//
+//  Throughput benchmark for loading many small files with sokol_fetch.h
+//  compared to a plain fopen()/fread() loop.
+//
+//  A set of test files is written into a directory (default: current
+//  directory), then all files are loaded once with the FILE* loop and
+//  once through a single sokol-fetch channel with 1, 8 and 64 lanes.
+//  The sokol-fetch IO thread issues the reads of all waiting lanes as
+//  one batch, the sokol-fetch-bench-uring variant is compiled with
+//  SFETCH_USE_IO_URING so that the batch goes through an io_uring instead
+//  of one pread() call after another.
+//
+//  Usage: sokol-fetch-bench [dir] [num_files] [file_size_kb]
+//
+//  NOTE: the files will be in the page cache right after they have been
+//  written, for cold-cache numbers drop the page cache between the write
+//  and the read phase (e.g. 'echo 3 > /proc/sys/vm/drop_caches').
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#include "sokol_fetch.h"
+#include "sokol_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_LANES (64)
+#define MAX_FILES (4096)
+#define MAX_FILE_SIZE (16 * 1024 * 1024)
+
+static struct {
+    const char* dir;
+    int num_files;
+    uint32_t file_size;
+    char paths[MAX_FILES][256];
+    uint8_t* buffers[MAX_LANES];
+    int num_finished;
+    int num_failed;
+    uint64_t num_bytes;
+} state;
+
+static void write_files(void) {
+    uint8_t* data = (uint8_t*) malloc(state.file_size);
+    for (uint32_t i = 0; i < state.file_size; i++) {
+        data[i] = (uint8_t)i;
+    }
+    for (int i = 0; i < state.num_files; i++) {
+        snprintf(state.paths[i], sizeof(state.paths[i]), "%s/sfetch_bench_%04d.bin", state.dir, i);
+        FILE* fp = fopen(state.paths[i], "wb");
+        if (!fp) {
+            fprintf(stderr, "failed to create '%s'\n", state.paths[i]);
+            exit(10);
+        }
+        fwrite(data, 1, state.file_size, fp);
+        fclose(fp);
+    }
+    free(data);
+}
+
+static void remove_files(void) {
+    for (int i = 0; i < state.num_files; i++) {
+        remove(state.paths[i]);
+    }
+}
+
+static void print_result(const char* name, uint64_t ticks, uint64_t num_bytes) {
+    const double secs = stm_sec(ticks);
+    printf("%-24s %8.2f ms %10.1f MB/s\n", name, stm_ms(ticks), ((double)num_bytes / (1024.0 * 1024.0)) / secs);
+}
+
+// the baseline: load one file after another with stdio
+static void run_stdio(void) {
+    uint64_t num_bytes = 0;
+    const uint64_t start = stm_now();
+    for (int i = 0; i < state.num_files; i++) {
+        FILE* fp = fopen(state.paths[i], "rb");
+        if (fp) {
+            fseek(fp, 0, SEEK_END);
+            const long size = ftell(fp);
+            fseek(fp, 0, SEEK_SET);
+            if ((size > 0) && ((uint32_t)size <= state.file_size)) {
+                num_bytes += fread(state.buffers[i % MAX_LANES], 1, (size_t)size, fp);
+            }
+            fclose(fp);
+        }
+    }
+    print_result("fopen/fread", stm_since(start), num_bytes);
+}
+
+// each lane gets its own buffer, bound when a request has been dispatched
+static void response_callback(const sfetch_response_t* response) {
+    if (response->dispatched) {
+        sfetch_bind_buffer(response->handle, (sfetch_range_t){ state.buffers[response->lane], state.file_size });
+    }
+    if (response->fetched) {
+        state.num_bytes += response->data.size;
+    }
+    if (response->finished) {
+        state.num_finished++;
+        if (response->failed) {
+            state.num_failed++;
+        }
+    }
+}
+
+static void run_sfetch(int num_lanes) {
+    sfetch_setup(&(sfetch_desc_t){
+        .max_requests = (uint32_t)state.num_files,
+        .num_channels = 1,
+        .num_lanes = (uint32_t)num_lanes,
+    });
+    state.num_finished = 0;
+    state.num_failed = 0;
+    state.num_bytes = 0;
+    const uint64_t start = stm_now();
+    for (int i = 0; i < state.num_files; i++) {
+        sfetch_send(&(sfetch_request_t){
+            .path = state.paths[i],
+            .callback = response_callback,
+        });
+    }
+    while (state.num_finished < state.num_files) {
+        sfetch_dowork();
+    }
+    const uint64_t ticks = stm_since(start);
+    sfetch_shutdown();
+    char name[64];
+    #if defined(SFETCH_USE_IO_URING)
+    snprintf(name, sizeof(name), "sfetch io_uring %2d lanes", num_lanes);
+    #else
+    snprintf(name, sizeof(name), "sfetch pread %2d lanes", num_lanes);
+    #endif
+    print_result(name, ticks, state.num_bytes);
+    if (state.num_failed > 0) {
+        printf("  (%d requests failed)\n", state.num_failed);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    state.dir = (argc > 1) ? argv[1] : ".";
+    state.num_files = (argc > 2) ? atoi(argv[2]) : 1024;
+    state.file_size = (argc > 3) ? (uint32_t)atoi(argv[3]) * 1024 : 256 * 1024;
+    if ((state.num_files <= 0) || (state.num_files > MAX_FILES) || (state.file_size == 0) || (state.file_size > MAX_FILE_SIZE)) {
+        fprintf(stderr, "usage: %s [dir] [num_files (1..%d)] [file_size_kb (1..%d)]\n", argv[0], MAX_FILES, MAX_FILE_SIZE / 1024);
+        return 10;
+    }
+    for (int i = 0; i < MAX_LANES; i++) {
+        state.buffers[i] = (uint8_t*) malloc(state.file_size);
+    }
+    stm_setup();
+    write_files();
+    printf("%d files x %u KB in '%s'\n", state.num_files, state.file_size / 1024, state.dir);
+    run_stdio();
+    run_sfetch(1);
+    run_sfetch(8);
+    run_sfetch(MAX_LANES);
+    remove_files();
+    for (int i = 0; i < MAX_LANES; i++) {
+        free(state.buffers[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_bench.c
+//
+//  Microbenchmark for the per-draw CPU overhead of sokol_gfx.h on the dummy
+//  backend (sg_apply_pipeline(), sg_apply_bindings() and sg_draw()).
+//
+//  A large number of pipelines, buffers and images is created and cycled
+//  through so that the resource pool items don't all stay in the CPU cache,
+//  which makes the numbers sensitive to the memory layout of the pool items.
+//
+//  Build in release mode and run without arguments, results are printed
+//  as nanoseconds per call (best of 32 passes with 4096 draws each).
+//------------------------------------------------------------------------------
+#include "../functional/force_dummy_backend.h"
+#define SOKOL_IMPL
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+#include <stdio.h>
+
+#define NUM_PIPELINES (1024)
+#define NUM_BUFFERS (1024)
+#define NUM_IMAGES (1024)
+#define NUM_SAMPLERS (16)
+#define DRAWS_PER_PASS (4096)
+#define NUM_DRAWS (DRAWS_PER_PASS * 32)
+
+static struct {
+    sg_pipeline pip[NUM_PIPELINES];
+    sg_buffer vbuf[NUM_BUFFERS];
+    sg_image img[NUM_IMAGES];
+    sg_sampler smp[NUM_SAMPLERS];
+} state;
+
+static void init(void) {
+    sg_setup(&(sg_desc){
+        .buffer_pool_size = NUM_BUFFERS,
+        .image_pool_size = NUM_IMAGES,
+        .shader_pool_size = NUM_PIPELINES,
+        .pipeline_pool_size = NUM_PIPELINES,
+    });
+    for (int i = 0; i < NUM_PIPELINES; i++) {
+        sg_shader shd = sg_make_shader(&(sg_shader_desc){
+            .fs = {
+                .images[0].used = true,
+                .samplers[0].used = true,
+                .image_sampler_pairs[0] = { .used = true, .image_slot = 0, .sampler_slot = 0 },
+            },
+        });
+        state.pip[i] = sg_make_pipeline(&(sg_pipeline_desc){
+            .shader = shd,
+            .layout = {
+                .attrs = {
+                    [0].format = SG_VERTEXFORMAT_FLOAT3,
+                    [1].format = SG_VERTEXFORMAT_FLOAT4,
+                    [2].format = SG_VERTEXFORMAT_FLOAT2,
+                },
+            },
+        });
+    }
+    static const float vertices[9 * 3] = { 0 };
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        state.vbuf[i] = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    }
+    for (int i = 0; i < NUM_IMAGES; i++) {
+        state.img[i] = sg_make_image(&(sg_image_desc){ .render_target = true, .width = 16, .height = 16 });
+    }
+    for (int i = 0; i < NUM_SAMPLERS; i++) {
+        state.smp[i] = sg_make_sampler(&(sg_sampler_desc){0});
+    }
+}
+
+// cheap pseudo-random resource indices, so the access pattern isn't linear
+static int rnd(uint32_t* x, int num) {
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return (int)(*x % (uint32_t)num);
+}
+
+static sg_bindings bindings(uint32_t* x) {
+    return (sg_bindings){
+        .vertex_buffers[0] = state.vbuf[rnd(x, NUM_BUFFERS)],
+        .fs = {
+            .images[0] = state.img[rnd(x, NUM_IMAGES)],
+            .samplers[0] = state.smp[rnd(x, NUM_SAMPLERS)],
+        },
+    };
+}
+
+typedef enum {
+    APPLY_PIPELINE,
+    APPLY_BINDINGS,
+    DRAW,
+} step_t;
+
+// runs NUM_DRAWS random draws up to and including the given step, returns the
+// best time in ticks for one pass worth of draws
+static uint64_t run(step_t last_step) {
+    static sg_bindings bnd[DRAWS_PER_PASS];
+    static int pip[DRAWS_PER_PASS];
+    uint32_t x = 0x0badf00d;
+    uint64_t best = 0;
+    for (int i = 0; i < NUM_DRAWS; i += DRAWS_PER_PASS) {
+        for (int j = 0; j < DRAWS_PER_PASS; j++) {
+            pip[j] = rnd(&x, NUM_PIPELINES);
+            bnd[j] = bindings(&x);
+        }
+        sg_begin_default_pass(&(sg_pass_action){0}, 640, 480);
+        const uint64_t start = stm_now();
+        for (int j = 0; j < DRAWS_PER_PASS; j++) {
+            sg_apply_pipeline(state.pip[pip[j]]);
+            if (last_step >= APPLY_BINDINGS) {
+                sg_apply_bindings(&bnd[j]);
+            }
+            if (last_step >= DRAW) {
+                sg_draw(0, 3, 1);
+            }
+        }
+        const uint64_t t = stm_since(start);
+        if ((0 == best) || (t < best)) {
+            best = t;
+        }
+        sg_end_pass();
+        sg_commit();
+    }
+    return best;
+}
+
+int main(void) {
+    stm_setup();
+    init();
+    run(DRAW);  // warm up
+    const double t_pip = stm_ns(run(APPLY_PIPELINE)) / DRAWS_PER_PASS;
+    const double t_bnd = stm_ns(run(APPLY_BINDINGS)) / DRAWS_PER_PASS;
+    const double t_draw = stm_ns(run(DRAW)) / DRAWS_PER_PASS;
+    printf("sg_apply_pipeline:  %6.1f ns\n", t_pip);
+    printf("sg_apply_bindings:  %6.1f ns\n", t_bnd - t_pip);
+    printf("sg_draw:            %6.1f ns\n", t_draw - t_bnd);
+    printf("total per draw:     %6.1f ns\n", t_draw);
+    sg_shutdown();
+    return 0;
+}
@@ -8,6 +8,8 @@
 #define SFETCH_MAX_PATH (32)
 #include "sokol_fetch.h"
 #include "utest.h"
+#define SFETCH_PACK_NO_MAIN
+#include "sfetch_pack.c"
 
 #define T(b) EXPECT_TRUE(b)
 #define TSTR(s0, s1) EXPECT_TRUE(0 == strcmp(s0,s1))
@@ -320,7 +322,9 @@ UTEST(sokol_fetch, channel_init_discard) {
     _sfetch_channel_init(&chn, 0, num_slots, num_lanes, channel_worker);
     T(chn.valid);
     T(_sfetch_ring_full(&chn.free_lanes));
-    T(_sfetch_ring_empty(&chn.user_sent));
+    for (int i = 0; i < SFETCH_NUM_PRIORITIES; i++) {
+        T(_sfetch_ring_empty(&chn.user_sent[i]));
+    }
     T(_sfetch_ring_empty(&chn.user_incoming));
     #if !defined(__EMSCRIPTEN__)
     T(_sfetch_ring_empty(&chn.thread_incoming));
@@ -860,3 +864,708 @@ UTEST(sokol_fetch, load_file_cancel_after_dispatch) {
     T(load_file_cancel_after_dispatch_passed);
     sfetch_shutdown();
 }
+
+/* load a byte range in one go, and stream a byte range up to the end of file in chunks */
+static bool load_file_range_passed;
+static bool load_file_range_chunked_passed;
+static uint8_t load_file_range_buf[50000];
+static uint8_t load_file_range_chunked_content[500000];
+static void load_file_range_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        if ((response->data_offset == 100000) &&
+            (response->data.ptr == load_file_range_buf) &&
+            (response->data.size == sizeof(load_file_range_buf)) &&
+            response->finished)
+        {
+            load_file_range_passed = true;
+        }
+    }
+}
+
+static void load_file_range_chunked_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        // data_offset is the offset in the whole file, not in the byte range
+        if ((response->data_offset >= 200000) && ((response->data_offset + response->data.size) <= combatsignal_file_size)) {
+            memcpy(&load_file_range_chunked_content[response->data_offset], response->data.ptr, response->data.size);
+            if (response->finished && ((response->data_offset + response->data.size) == combatsignal_file_size)) {
+                load_file_range_chunked_passed = true;
+            }
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_file_range) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_file_range_buf, 0, sizeof(load_file_range_buf));
+    memset(load_file_range_chunked_content, 0, sizeof(load_file_range_chunked_content));
+    load_file_range_passed = false;
+    load_file_range_chunked_passed = false;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 4 });
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_range_callback,
+        .offset = 100000,
+        .size = sizeof(load_file_range_buf),
+        .buffer = SFETCH_RANGE(load_file_range_buf),
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_range_chunked_callback,
+        .offset = 200000,
+        .chunk_size = sizeof(load_chunk_buf),
+        .buffer = SFETCH_RANGE(load_chunk_buf),
+    });
+    // the whole file for comparison
+    sfetch_handle_t h2 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1) || sfetch_handle_valid(h2)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_file_range_passed);
+    T(load_file_range_chunked_passed);
+    T(0 == memcmp(load_file_range_buf, &load_file_buf[100000], sizeof(load_file_range_buf)));
+    T(0 == memcmp(&load_file_range_chunked_content[200000], &load_file_buf[200000], combatsignal_file_size - 200000));
+    sfetch_shutdown();
+}
+
+/* byte ranges that don't fit into the file must fail */
+static int load_file_range_eof_count;
+static void load_file_range_eof_callback(const sfetch_response_t* response) {
+    if (response->finished && response->failed && (response->error_code == SFETCH_ERROR_UNEXPECTED_EOF)) {
+        load_file_range_eof_count++;
+    }
+}
+
+UTEST(sokol_fetch, load_file_range_eof) {
+    load_file_range_eof_count = 0;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 2 });
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_range_eof_callback,
+        .offset = combatsignal_file_size + 1,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_range_eof_callback,
+        .offset = combatsignal_file_size - 10,
+        .size = 20,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(2 == load_file_range_eof_count);
+    sfetch_shutdown();
+}
+
+/* memory-mapped requests hand out the mapped file data instead of loading into a buffer */
+static bool load_file_mmap_passed;
+static bool load_file_mmap_range_passed;
+static sfetch_mapping_t load_file_mmap_mapping;
+static void load_file_mmap_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        if ((response->data_offset == 0) &&
+            (response->data.size == combatsignal_file_size) &&
+            (response->buffer.ptr == 0) &&
+            (0 == memcmp(response->data.ptr, load_file_buf, combatsignal_file_size)))
+        {
+            load_file_mmap_passed = true;
+        }
+    }
+}
+
+static void load_file_mmap_range_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        if ((response->data_offset == 12345) &&
+            (response->data.size == 20000) &&
+            (0 == memcmp(response->data.ptr, &load_file_buf[12345], 20000)))
+        {
+            load_file_mmap_range_passed = true;
+            // keep the mapped data alive after the request has finished
+            load_file_mmap_mapping = sfetch_keep_mapping(response->handle);
+        }
+    }
+}
+
+static void wait_fixed_buffer(void) {
+    sfetch_handle_t h = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    int frame_count = 0;
+    while (sfetch_handle_valid(h) && (frame_count++ < 10000)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+}
+
+UTEST(sokol_fetch, load_file_mmap) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(&load_file_mmap_mapping, 0, sizeof(load_file_mmap_mapping));
+    load_file_fixed_buffer_passed = false;
+    load_file_mmap_passed = false;
+    load_file_mmap_range_passed = false;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 2 });
+    // load the whole file into a buffer for comparison
+    wait_fixed_buffer();
+    T(load_file_fixed_buffer_passed);
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mmap_callback,
+        .memory_map = true,
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mmap_range_callback,
+        .offset = 12345,
+        .size = 20000,
+        .memory_map = true,
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_file_mmap_passed);
+    T(load_file_mmap_range_passed);
+    sfetch_shutdown();
+    // the kept mapping outlives the request and even the sokol-fetch context
+    T(load_file_mmap_mapping.base_ptr != 0);
+    T(load_file_mmap_mapping.data.size == 20000);
+    T(0 == memcmp(load_file_mmap_mapping.data.ptr, &load_file_buf[12345], 20000));
+    sfetch_release_mapping(&load_file_mmap_mapping);
+}
+
+UTEST(sokol_fetch, load_file_mmap_invalid) {
+    sfetch_setup(&(sfetch_desc_t){0});
+    // memory-mapped requests can't be streamed...
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mmap_callback,
+        .memory_map = true,
+        .chunk_size = sizeof(load_chunk_buf),
+        .buffer = SFETCH_RANGE(load_chunk_buf),
+    });
+    T(!sfetch_handle_valid(h0));
+    // ...and don't take a buffer
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mmap_callback,
+        .memory_map = true,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    T(!sfetch_handle_valid(h1));
+    sfetch_shutdown();
+}
+
+/* pack files, written with the sfetch-pack code from util/sfetch_pack.c */
+static const char pack_text[] = "Hello Pack!";
+static uint8_t pack_bin[1000];
+
+static void write_test_file(const char* path, const void* data, size_t size) {
+    FILE* fp = fopen(path, "wb");
+    if (fp) {
+        fwrite(data, 1, size, fp);
+        fclose(fp);
+    }
+}
+
+// the loose pack_a.txt and pack_b.bin are removed after packing, so they can only be loaded from the pack file
+static bool make_test_pack(void) {
+    for (size_t i = 0; i < sizeof(pack_bin); i++) {
+        pack_bin[i] = (uint8_t)(i * 7);
+    }
+    write_test_file("pack_a.txt", pack_text, strlen(pack_text));
+    write_test_file("pack_b.bin", pack_bin, sizeof(pack_bin));
+    const char* paths[] = { "pack_a.txt", "comsi.s3m", "pack_b.bin" };
+    const bool res = sfetch_pack_write("test.pack", 0, 64, 3, paths);
+    remove("pack_a.txt");
+    remove("pack_b.bin");
+    return res;
+}
+
+UTEST(sokol_fetch, pack_write) {
+    T(make_test_pack());
+    static uint8_t pack_data[500000];
+    FILE* fp = fopen("test.pack", "rb");
+    T(fp != 0);
+    if (!fp) {
+        return;
+    }
+    const size_t pack_size = fread(pack_data, 1, sizeof(pack_data), fp);
+    fclose(fp);
+    T(pack_size > (16 + 3 * 32 + combatsignal_file_size));
+    T(0 == memcmp(pack_data, "SFPK", 4));
+    T(_sfetch_pack_read_u32(pack_data + 4) == 2);
+    T(_sfetch_pack_read_u32(pack_data + 8) == 3);
+    T(_sfetch_pack_read_u32(pack_data + 12) == 64);
+    const char* path_table = (const char*)(pack_data + 16 + 3 * 32);
+    bool found_text = false;
+    for (int i = 0; i < 3; i++) {
+        const uint8_t* entry = pack_data + 16 + i * 32;
+        const uint64_t hash = _sfetch_pack_read_u64(entry);
+        const uint64_t offset = _sfetch_pack_read_u64(entry + 8);
+        const uint64_t size = _sfetch_pack_read_u64(entry + 16);
+        const uint32_t path_offset = _sfetch_pack_read_u32(entry + 24);
+        const uint32_t path_length = _sfetch_pack_read_u32(entry + 28);
+        // sorted by hash, file data aligned and inside the pack file
+        if (i > 0) {
+            T(hash > _sfetch_pack_read_u64(entry - 32));
+        }
+        T((offset % 64) == 0);
+        T((offset + size) <= pack_size);
+        // the path table contains the zero-terminated path
+        T(strlen(&path_table[path_offset]) == path_length);
+        T(hash == _sfetch_pack_hash(&path_table[path_offset]));
+        if (hash == _sfetch_pack_hash("pack_a.txt")) {
+            T(0 == strcmp(&path_table[path_offset], "pack_a.txt"));
+            found_text = (size == strlen(pack_text)) && (0 == memcmp(pack_data + offset, pack_text, size));
+        }
+    }
+    T(found_text);
+    remove("test.pack");
+    // duplicate paths are rejected
+    const char* dup_paths[] = { "comsi.s3m", "comsi.s3m" };
+    T(!sfetch_pack_write("dup.pack", 0, 16, 2, dup_paths));
+    // so are missing files
+    const char* missing_paths[] = { "missing.bin" };
+    T(!sfetch_pack_write("missing.pack", 0, 16, 1, missing_paths));
+    // ...and paths which are absolute or point outside of the pack root
+    const char* bad_paths[] = { "/comsi.s3m", "C:/comsi.s3m", "../comsi.s3m", "a/../../comsi.s3m", "a\\..\\b", "" };
+    for (int i = 0; i < 6; i++) {
+        T(!sfetch_pack_write("bad.pack", 0, 16, 1, &bad_paths[i]));
+    }
+    T(sfetch_pack_path_valid("a/..b/c.."));
+}
+
+static bool load_pack_text_passed;
+static bool load_pack_range_passed;
+static bool load_pack_chunked_passed;
+static bool load_pack_mmap_passed;
+static int load_pack_failed_count;
+static uint8_t load_pack_text_buf[64];
+static uint8_t load_pack_range_buf[200];
+static uint8_t load_pack_chunked_content[500000];
+
+static void load_pack_text_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        load_pack_text_passed = (response->data_offset == 0) &&
+                                (response->data.size == strlen(pack_text)) &&
+                                (0 == memcmp(response->data.ptr, pack_text, strlen(pack_text)));
+    }
+}
+
+static void load_pack_range_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        // data_offset is relative to the packed file, not the pack file
+        load_pack_range_passed = (response->data_offset == 100) &&
+                                 (response->data.size == sizeof(load_pack_range_buf)) &&
+                                 (0 == memcmp(response->data.ptr, &pack_bin[100], sizeof(load_pack_range_buf)));
+    }
+}
+
+static void load_pack_chunked_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        if ((response->data_offset + response->data.size) <= combatsignal_file_size) {
+            memcpy(&load_pack_chunked_content[response->data_offset], response->data.ptr, response->data.size);
+            if (response->finished && ((response->data_offset + response->data.size) == combatsignal_file_size)) {
+                load_pack_chunked_passed = true;
+            }
+        }
+    }
+}
+
+static void load_pack_mmap_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        load_pack_mmap_passed = (response->data_offset == 0) &&
+                                (response->data.size == combatsignal_file_size) &&
+                                (0 == memcmp(response->data.ptr, load_file_buf, combatsignal_file_size));
+    }
+}
+
+static void load_pack_failed_callback(const sfetch_response_t* response) {
+    if (response->finished && response->failed) {
+        if (((response->error_code == SFETCH_ERROR_FILE_NOT_FOUND) && (0 == strcmp(response->path, "pack_c.txt"))) ||
+            ((response->error_code == SFETCH_ERROR_UNEXPECTED_EOF) && (0 == strcmp(response->path, "pack_a.txt"))))
+        {
+            load_pack_failed_count++;
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_pack) {
+    T(make_test_pack());
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_pack_chunked_content, 0, sizeof(load_pack_chunked_content));
+    load_file_fixed_buffer_passed = false;
+    load_pack_text_passed = false;
+    load_pack_range_passed = false;
+    load_pack_chunked_passed = false;
+    load_pack_mmap_passed = false;
+    load_pack_failed_count = 0;
+    sfetch_setup(&(sfetch_desc_t){ .num_channels = 2, .num_lanes = 4 });
+    // load the loose file for comparison before the pack file is mounted
+    wait_fixed_buffer();
+    T(load_file_fixed_buffer_passed);
+    T(sfetch_mount_pack("test.pack"));
+    sfetch_handle_t h[6];
+    h[0] = sfetch_send(&(sfetch_request_t){
+        .path = "pack_a.txt",
+        .callback = load_pack_text_callback,
+        .buffer = SFETCH_RANGE(load_pack_text_buf),
+    });
+    h[1] = sfetch_send(&(sfetch_request_t){
+        .path = "pack_b.bin",
+        .channel = 1,
+        .callback = load_pack_range_callback,
+        .offset = 100,
+        .size = sizeof(load_pack_range_buf),
+        .buffer = SFETCH_RANGE(load_pack_range_buf),
+    });
+    h[2] = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_pack_chunked_callback,
+        .chunk_size = sizeof(load_chunk_buf),
+        .buffer = SFETCH_RANGE(load_chunk_buf),
+    });
+    h[3] = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .channel = 1,
+        .callback = load_pack_mmap_callback,
+        .memory_map = true,
+    });
+    // paths which are not in the pack file go to the filesystem...
+    h[4] = sfetch_send(&(sfetch_request_t){
+        .path = "pack_c.txt",
+        .callback = load_pack_failed_callback,
+        .buffer = SFETCH_RANGE(load_pack_text_buf),
+    });
+    // ...and byte ranges are limited to the packed file
+    h[5] = sfetch_send(&(sfetch_request_t){
+        .path = "pack_a.txt",
+        .channel = 1,
+        .callback = load_pack_failed_callback,
+        .offset = 5,
+        .size = 20,
+        .buffer = SFETCH_RANGE(load_pack_text_buf),
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    bool any_valid = true;
+    while (any_valid && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+        any_valid = false;
+        for (int i = 0; i < 6; i++) {
+            any_valid |= sfetch_handle_valid(h[i]);
+        }
+    }
+    T(frame_count < max_frames);
+    T(load_pack_text_passed);
+    T(load_pack_range_passed);
+    T(load_pack_chunked_passed);
+    T(0 == memcmp(load_pack_chunked_content, load_file_buf, combatsignal_file_size));
+    T(load_pack_mmap_passed);
+    T(2 == load_pack_failed_count);
+    sfetch_shutdown();
+    remove("test.pack");
+}
+
+UTEST(sokol_fetch, mount_pack_invalid) {
+    sfetch_setup(&(sfetch_desc_t){0});
+    T(!sfetch_mount_pack("missing.pack"));
+    // not a pack file
+    T(!sfetch_mount_pack("comsi.s3m"));
+    // a truncated pack file
+    static uint8_t truncated[16 + 32];
+    memcpy(truncated, "SFPK", 4);
+    truncated[4] = 2;
+    truncated[8] = 2;
+    write_test_file("trunc.pack", truncated, sizeof(truncated));
+    T(!sfetch_mount_pack("trunc.pack"));
+    remove("trunc.pack");
+    // a path table entry which isn't zero-terminated
+    static uint8_t unterminated[16 + 32 + 4];
+    memcpy(unterminated, "SFPK", 4);
+    unterminated[4] = 2;
+    unterminated[8] = 1;
+    unterminated[16 + 28] = 4;
+    memcpy(&unterminated[16 + 32], "abcd", 4);
+    write_test_file("unterminated.pack", unterminated, sizeof(unterminated));
+    T(!sfetch_mount_pack("unterminated.pack"));
+    remove("unterminated.pack");
+    sfetch_shutdown();
+}
+
+/* a path whose hash matches an entry in the pack file but whose path doesn't */
+static bool load_pack_collision_passed;
+static void load_pack_collision_callback(const sfetch_response_t* response) {
+    if (response->finished) {
+        load_pack_collision_passed = response->failed && (response->error_code == SFETCH_ERROR_FILE_NOT_FOUND);
+    }
+}
+
+UTEST(sokol_fetch, load_pack_collision) {
+    // fake a hash collision: the entry has the hash of "pack_x.txt" but stores "pack_y.txt"
+    static uint8_t pack[16 + 32 + 16 + 4];
+    memcpy(pack, "SFPK", 4);
+    pack[4] = 2;
+    pack[8] = 1;
+    pack[12] = 1;
+    const uint64_t hash = _sfetch_pack_hash("pack_x.txt");
+    for (int i = 0; i < 8; i++) {
+        pack[16 + i] = (uint8_t)(hash >> (i * 8));
+    }
+    pack[16 + 8] = 16 + 32 + 16;
+    pack[16 + 16] = 4;
+    pack[16 + 28] = 10;
+    memcpy(&pack[16 + 32], "pack_y.txt", 11);
+    memcpy(&pack[16 + 32 + 16], "data", 4);
+    write_test_file("collision.pack", pack, sizeof(pack));
+    load_pack_collision_passed = false;
+    sfetch_setup(&(sfetch_desc_t){0});
+    T(sfetch_mount_pack("collision.pack"));
+    sfetch_handle_t h = sfetch_send(&(sfetch_request_t){
+        .path = "pack_x.txt",
+        .callback = load_pack_collision_callback,
+        .buffer = SFETCH_RANGE(load_pack_text_buf),
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (sfetch_handle_valid(h) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_pack_collision_passed);
+    sfetch_shutdown();
+    remove("collision.pack");
+}
+
+/* with a single lane, a high-priority request overtakes the requests sent before it */
+#define LOAD_PRIORITY_NUM_REQUESTS (5)
+static int load_priority_order[LOAD_PRIORITY_NUM_REQUESTS];
+static int load_priority_count;
+static uint8_t load_priority_buf[LOAD_PRIORITY_NUM_REQUESTS][1024];
+static void load_priority_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished && (load_priority_count < LOAD_PRIORITY_NUM_REQUESTS)) {
+        load_priority_order[load_priority_count++] = *(int*)response->user_data;
+    }
+}
+
+UTEST(sokol_fetch, load_priority) {
+    load_priority_count = 0;
+    memset(load_priority_order, 0xFF, sizeof(load_priority_order));
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 1 });
+    sfetch_handle_t h[LOAD_PRIORITY_NUM_REQUESTS];
+    // requests 0..3 are background requests, request 4 has the highest
+    // priority, request 2 has a medium priority
+    const uint32_t priorities[LOAD_PRIORITY_NUM_REQUESTS] = { 0, 0, 1, 0, SFETCH_NUM_PRIORITIES - 1 };
+    for (int i = 0; i < LOAD_PRIORITY_NUM_REQUESTS; i++) {
+        h[i] = sfetch_send(&(sfetch_request_t){
+            .path = "comsi.s3m",
+            .callback = load_priority_callback,
+            .size = sizeof(load_priority_buf[i]),
+            .priority = priorities[i],
+            .buffer = SFETCH_RANGE(load_priority_buf[i]),
+            .user_data = SFETCH_RANGE(i),
+        });
+        T(sfetch_handle_valid(h[i]));
+    }
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((load_priority_count < LOAD_PRIORITY_NUM_REQUESTS) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_priority_order[0] == 4);
+    T(load_priority_order[1] == 2);
+    T(load_priority_order[2] == 0);
+    T(load_priority_order[3] == 1);
+    T(load_priority_order[4] == 3);
+    // priorities must be less than SFETCH_NUM_PRIORITIES
+    sfetch_handle_t h_invalid = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_priority_callback,
+        .priority = SFETCH_NUM_PRIORITIES,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    T(!sfetch_handle_valid(h_invalid));
+    sfetch_shutdown();
+}
+
+/* coalesced requests piggyback on an in-flight request for the same file */
+static int load_coalesce_frame;
+static int load_coalesce_leader_frame;
+static int load_coalesce_shared_frame;
+static int load_coalesce_copy_frame;
+static bool load_coalesce_shared_passed;
+static bool load_coalesce_copy_passed;
+static bool load_coalesce_range_passed;
+static uint8_t load_coalesce_copy_buf[500000];
+static uint8_t load_coalesce_range_buf[1000];
+
+static void load_coalesce_leader_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        load_coalesce_leader_frame = load_coalesce_frame;
+    }
+}
+
+static void load_coalesce_shared_callback(const sfetch_response_t* response) {
+    // without a buffer, the data is in the buffer of the leading request
+    if (response->fetched && response->finished) {
+        load_coalesce_shared_frame = load_coalesce_frame;
+        load_coalesce_shared_passed = (response->data.ptr == load_file_buf) &&
+                                      (response->data.size == combatsignal_file_size) &&
+                                      (response->lane == _SFETCH_INVALID_LANE) &&
+                                      (response->buffer.ptr == 0);
+    }
+}
+
+static void load_coalesce_copy_callback(const sfetch_response_t* response) {
+    // with a buffer, the data is copied into that buffer
+    if (response->fetched && response->finished) {
+        load_coalesce_copy_frame = load_coalesce_frame;
+        load_coalesce_copy_passed = (response->data.ptr == load_coalesce_copy_buf) &&
+                                    (response->data.size == combatsignal_file_size) &&
+                                    (0 == memcmp(load_coalesce_copy_buf, load_file_buf, combatsignal_file_size));
+    }
+}
+
+static void load_coalesce_range_callback(const sfetch_response_t* response) {
+    // a different byte range isn't coalesced
+    if (response->fetched && response->finished) {
+        load_coalesce_range_passed = (response->data.ptr == load_coalesce_range_buf) &&
+                                     (response->data_offset == 1000) &&
+                                     (response->lane == 0) &&
+                                     (load_coalesce_frame > load_coalesce_leader_frame);
+    }
+}
+
+UTEST(sokol_fetch, load_coalesce) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_coalesce_copy_buf, 0, sizeof(load_coalesce_copy_buf));
+    load_coalesce_frame = 0;
+    load_coalesce_leader_frame = -1;
+    load_coalesce_shared_frame = -2;
+    load_coalesce_copy_frame = -3;
+    load_coalesce_shared_passed = false;
+    load_coalesce_copy_passed = false;
+    load_coalesce_range_passed = false;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 1 });
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_leader_callback,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_range_callback,
+        .offset = 1000,
+        .size = sizeof(load_coalesce_range_buf),
+        .coalesce = true,
+        .buffer = SFETCH_RANGE(load_coalesce_range_buf),
+    });
+    sfetch_handle_t h2 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_shared_callback,
+        .coalesce = true,
+    });
+    sfetch_handle_t h3 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_copy_callback,
+        .coalesce = true,
+        .buffer = SFETCH_RANGE(load_coalesce_copy_buf),
+    });
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1) || sfetch_handle_valid(h2) || sfetch_handle_valid(h3)) && (load_coalesce_frame++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(load_coalesce_frame < max_frames);
+    T(load_coalesce_shared_passed);
+    T(load_coalesce_copy_passed);
+    T(load_coalesce_range_passed);
+    // the coalesced requests finish together with the request which read the file
+    T(load_coalesce_shared_frame == load_coalesce_leader_frame);
+    T(load_coalesce_copy_frame == load_coalesce_leader_frame);
+    sfetch_shutdown();
+}
+
+/* if the leading request is cancelled, the coalesced request loads the file itself */
+static bool load_coalesce_cancel_leader_passed;
+static bool load_coalesce_cancel_follower_passed;
+static void load_coalesce_cancel_leader_callback(const sfetch_response_t* response) {
+    if (response->finished && response->cancelled) {
+        load_coalesce_cancel_leader_passed = true;
+    }
+}
+
+static void load_coalesce_cancel_follower_callback(const sfetch_response_t* response) {
+    if (response->dispatched) {
+        sfetch_bind_buffer(response->handle, SFETCH_RANGE(load_coalesce_copy_buf));
+    }
+    if (response->fetched && response->finished) {
+        load_coalesce_cancel_follower_passed = (response->data.ptr == load_coalesce_copy_buf) &&
+                                               (response->data.size == combatsignal_file_size);
+    }
+}
+
+UTEST(sokol_fetch, load_coalesce_cancel) {
+    load_coalesce_cancel_leader_passed = false;
+    load_coalesce_cancel_follower_passed = false;
+    sfetch_setup(&(sfetch_desc_t){0});
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_cancel_leader_callback,
+        .buffer = SFETCH_RANGE(load_file_buf),
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_cancel_follower_callback,
+        .coalesce = true,
+    });
+    sfetch_cancel(h0);
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_coalesce_cancel_leader_passed);
+    T(load_coalesce_cancel_follower_passed);
+    // coalesced requests can't be streamed or memory-mapped
+    sfetch_handle_t h2 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_cancel_follower_callback,
+        .coalesce = true,
+        .chunk_size = sizeof(load_chunk_buf),
+        .buffer = SFETCH_RANGE(load_chunk_buf),
+    });
+    T(!sfetch_handle_valid(h2));
+    sfetch_handle_t h3 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_coalesce_cancel_follower_callback,
+        .coalesce = true,
+        .memory_map = true,
+    });
+    T(!sfetch_handle_valid(h3));
+    sfetch_shutdown();
+}
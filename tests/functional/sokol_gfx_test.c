@@ -105,6 +105,8 @@ UTEST(sokol_gfx, query_desc) {
     T(desc.pipeline_pool_size == _SG_DEFAULT_PIPELINE_POOL_SIZE);
     T(desc.pass_pool_size == 64);
     T(desc.context_pool_size == _SG_DEFAULT_CONTEXT_POOL_SIZE);
+    T(desc.recording_pool_size == _SG_DEFAULT_RECORDING_POOL_SIZE);
+    T(desc.binding_set_pool_size == _SG_DEFAULT_BINDING_SET_POOL_SIZE);
     T(desc.uniform_buffer_size == _SG_DEFAULT_UB_SIZE);
     sg_shutdown();
 }
@@ -2875,3 +2877,2210 @@ UTEST(sokol_gfx, make_pass_validate_depth_image_sample_count) {
     T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
     sg_shutdown();
 }
+
+static sg_pipeline create_pipeline_with_uniforms(void) {
+    return sg_make_pipeline(&(sg_pipeline_desc){
+        .layout = {
+            .attrs[0].format = SG_VERTEXFORMAT_FLOAT3
+        },
+        .shader = sg_make_shader(&(sg_shader_desc){
+            .vs.uniform_blocks[0].size = 16,
+        })
+    });
+}
+
+static void record_draw(sg_pipeline pip, sg_buffer vbuf) {
+    static const float params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    sg_draw(0, 3, 1);
+}
+
+UTEST(sokol_gfx, record_replay) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    record_draw(pip, vbuf);
+    record_draw(pip, vbuf);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    sg_commit();
+    T(rec.id != SG_INVALID_ID);
+    T(sg_query_recording_state(rec) == SG_RESOURCESTATE_VALID);
+    sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_pipeline == 2);
+    T(stats.num_draw == 2);
+    T(stats.num_replay == 0);
+    const _sg_recording_t* r = _sg_lookup_recording(&_sg.pools, rec.id);
+    T(r->num_cmds == 8);
+    T(r->num_bindings == 2);
+    T(r->ub_pos == 32);
+    T(r->last_pipeline.id == pip.id);
+
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_replay(rec);
+    sg_replay(rec);
+    sg_replay(rec);
+    T(_sg.cur_pipeline.id == pip.id);
+    T(!_sg.bindings_applied);
+    sg_end_pass();
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.num_replay == 3);
+    T(stats.num_replay_commands == 24);
+    T(stats.num_apply_pipeline == 0);
+    T(stats.num_apply_bindings == 0);
+    T(stats.num_apply_uniforms == 0);
+    T(stats.num_draw == 0);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, recording_restores_render_state) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    T(_sg.cur_pipeline.id == SG_INVALID_ID);
+    sg_begin_recording();
+    record_draw(pip, vbuf);
+    T(_sg.cur_pipeline.id == pip.id);
+    sg_end_recording();
+    T(_sg.cur_pipeline.id == SG_INVALID_ID);
+    T(!_sg.bindings_applied);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, recording_skips_invalid_draws) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_apply_pipeline(pip);
+    // draw without bindings isn't recorded
+    sg_draw(0, 3, 1);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    // draws with zero elements or instances aren't recorded
+    sg_draw(0, 0, 1);
+    sg_draw(0, 3, 0);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    const _sg_recording_t* r = _sg_lookup_recording(&_sg.pools, rec.id);
+    T(r->num_cmds == 2);
+    T(r->cmds[0].type == _SG_RECCMD_APPLY_PIPELINE);
+    T(r->cmds[1].type == _SG_RECCMD_APPLY_BINDINGS);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, replay_with_destroyed_resource) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    record_draw(pip, vbuf);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    sg_commit();
+    sg_destroy_buffer(vbuf);
+    reset_log_items();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_replay(rec);
+    sg_end_pass();
+    sg_commit();
+    T(log_items[0] == SG_LOGITEM_VALIDATE_REPLAY_RESOURCE_EXISTS);
+    T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_replay == 1);
+    T(stats.num_replay_commands == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, replay_with_destroyed_pre_applied_pipeline) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    // the pipeline is applied before recording starts, and recorded with the bindings
+    sg_apply_pipeline(pip);
+    sg_begin_recording();
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw(0, 3, 1);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    sg_commit();
+    const _sg_recording_t* r = _sg_lookup_recording(&_sg.pools, rec.id);
+    T(r->num_cmds == 3);
+    T(r->cmds[0].type == _SG_RECCMD_APPLY_PIPELINE);
+    T(r->cmds[1].type == _SG_RECCMD_APPLY_BINDINGS);
+    T(r->last_pipeline.id == pip.id);
+    sg_destroy_pipeline(pip);
+    reset_log_items();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_replay(rec);
+    sg_end_pass();
+    sg_commit();
+    T(log_items[0] == SG_LOGITEM_VALIDATE_REPLAY_RESOURCE_EXISTS);
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_replay == 1);
+    T(stats.num_replay_commands == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, replay_pass_attrs_mismatch) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    record_draw(pip, vbuf);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    const sg_pass pass = sg_make_pass(&(sg_pass_desc){
+        .color_attachments[0].image = create_image(),
+    });
+    reset_log_items();
+    sg_begin_pass(pass, &(sg_pass_action){0});
+    sg_replay(rec);
+    sg_end_pass();
+    T(log_items[0] == SG_LOGITEM_VALIDATE_REPLAY_PASS_ATTRS);
+    T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, begin_recording_outside_pass) {
+    setup(&(sg_desc){0});
+    sg_begin_recording();
+    T(log_items[0] == SG_LOGITEM_VALIDATE_BEGINREC_PASS);
+    T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
+    T(!_sg.rec.active);
+    reset_log_items();
+    const sg_recording rec = sg_end_recording();
+    T(rec.id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_ENDREC_NOT_RECORDING);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, nested_recording) {
+    setup(&(sg_desc){0});
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_begin_recording();
+    T(log_items[0] == SG_LOGITEM_VALIDATE_BEGINREC_NESTED);
+    T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
+    const sg_recording rec = sg_end_recording();
+    T(sg_query_recording_state(rec) == SG_RESOURCESTATE_VALID);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, end_pass_while_recording) {
+    setup(&(sg_desc){0});
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_end_pass();
+    T(log_items[0] == SG_LOGITEM_RECORDING_NOT_FINISHED);
+    T(!_sg.rec.active);
+    T(_sg.pools.recording_pool.queue_top == _SG_DEFAULT_RECORDING_POOL_SIZE);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, recording_pool_exhausted) {
+    setup(&(sg_desc){ .recording_pool_size = 1 });
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    const sg_recording rec0 = sg_end_recording();
+    T(sg_query_recording_state(rec0) == SG_RESOURCESTATE_VALID);
+    sg_begin_recording();
+    T(log_items[0] == SG_LOGITEM_RECORDING_POOL_EXHAUSTED);
+    // commands are neither recorded nor executed
+    record_draw(pip, vbuf);
+    const sg_recording rec1 = sg_end_recording();
+    T(rec1.id == SG_INVALID_ID);
+    sg_destroy_recording(rec0);
+    T(sg_query_recording_state(rec0) == SG_RESOURCESTATE_INVALID);
+    sg_begin_recording();
+    const sg_recording rec2 = sg_end_recording();
+    T(sg_query_recording_state(rec2) == SG_RESOURCESTATE_VALID);
+    T(rec2.id != rec0.id);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+static void encode_draw(sg_encoder enc, sg_pipeline pip, sg_buffer vbuf) {
+    static const float params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    sg_encoder_apply_pipeline(enc, pip);
+    sg_encoder_apply_bindings(enc, &(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_encoder_apply_uniforms(enc, SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    sg_encoder_draw(enc, 0, 3, 1);
+}
+
+UTEST(sokol_gfx, encoder_submit) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    const sg_encoder enc = sg_make_encoder(&(sg_encoder_desc){0});
+    T(sg_query_encoder_state(enc) == SG_RESOURCESTATE_VALID);
+    const _sg_encoder_t* e = _sg_lookup_encoder(&_sg.pools, enc.id);
+    T(e->size == _SG_DEFAULT_ENCODER_SIZE);
+    encode_draw(enc, pip, vbuf);
+    encode_draw(enc, pip, vbuf);
+    T(e->pos > 0);
+    T(!sg_query_encoder_overflow(enc));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_submit_encoder(enc);
+    sg_end_pass();
+    sg_commit();
+    T(e->pos == 0);
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_submit_encoder == 1);
+    T(stats.num_apply_pipeline == 2);
+    T(stats.num_apply_bindings == 2);
+    T(stats.num_apply_uniforms == 2);
+    T(stats.size_apply_uniforms == 32);
+    T(stats.num_draw == 2);
+    T(num_log_called == 0);
+    sg_destroy_encoder(enc);
+    T(sg_query_encoder_state(enc) == SG_RESOURCESTATE_INVALID);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, encoder_submit_order) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip0 = create_pipeline_with_uniforms();
+    const sg_pipeline pip1 = create_pipeline_with_uniforms();
+    const sg_encoder enc0 = sg_make_encoder(&(sg_encoder_desc){0});
+    const sg_encoder enc1 = sg_make_encoder(&(sg_encoder_desc){0});
+    encode_draw(enc0, pip0, vbuf);
+    encode_draw(enc1, pip1, vbuf);
+    // the submission order defines the command order, use a recording to inspect it
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_submit_encoder(enc1);
+    sg_submit_encoder(enc0);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    const _sg_recording_t* r = _sg_lookup_recording(&_sg.pools, rec.id);
+    T(r->num_cmds == 8);
+    T(r->cmds[0].type == _SG_RECCMD_APPLY_PIPELINE);
+    T(r->cmds[0].args.pip->slot.id == pip1.id);
+    T(r->cmds[4].type == _SG_RECCMD_APPLY_PIPELINE);
+    T(r->cmds[4].args.pip->slot.id == pip0.id);
+    T(r->cmds[7].type == _SG_RECCMD_DRAW);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, encoder_overflow) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    const sg_encoder enc = sg_make_encoder(&(sg_encoder_desc){ .size = 64 });
+    encode_draw(enc, pip, vbuf);
+    T(sg_query_encoder_overflow(enc));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_submit_encoder(enc);
+    sg_end_pass();
+    sg_commit();
+    T(log_items[0] == SG_LOGITEM_ENCODER_OVERFLOW);
+    T(!sg_query_encoder_overflow(enc));
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_pipeline == 0);
+    T(stats.num_draw == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, encoder_rewind) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    const sg_encoder enc = sg_make_encoder(&(sg_encoder_desc){0});
+    encode_draw(enc, pip, vbuf);
+    sg_encoder_rewind(enc);
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_submit_encoder(enc);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_submit_encoder == 1);
+    T(stats.num_draw == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_encoder_validate_size) {
+    setup(&(sg_desc){0});
+    const sg_encoder enc = sg_make_encoder(&(sg_encoder_desc){ .size = -1 });
+    T(sg_query_encoder_state(enc) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_ENCODERDESC_SIZE);
+    T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
+    reset_log_items();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_submit_encoder(enc);
+    sg_end_pass();
+    T(log_items[0] == SG_LOGITEM_VALIDATE_SUBMITENC_ENCODER);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, encoder_pool_exhausted) {
+    setup(&(sg_desc){ .encoder_pool_size = 1 });
+    const sg_encoder enc0 = sg_make_encoder(&(sg_encoder_desc){0});
+    T(sg_query_encoder_state(enc0) == SG_RESOURCESTATE_VALID);
+    const sg_encoder enc1 = sg_make_encoder(&(sg_encoder_desc){0});
+    T(enc1.id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_ENCODER_POOL_EXHAUSTED);
+    sg_shutdown();
+}
+
+static sg_buffer create_indirect_buffer(const sg_draw_indirect_args* args, size_t size) {
+    return sg_make_buffer(&(sg_buffer_desc){
+        .type = SG_BUFFERTYPE_INDIRECTBUFFER,
+        .data = { .ptr = args, .size = size },
+    });
+}
+
+UTEST(sokol_gfx, draw_multi) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_draw_args args[3] = {
+        { .base_element = 0, .num_elements = 3, .num_instances = 1 },
+        { .base_element = 3, .num_elements = 0, .num_instances = 1 },
+        { .base_element = 6, .num_elements = 3, .num_instances = 1 },
+    };
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_multi(args, 3);
+    sg_draw_multi(args, 0);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_draw_multi == 2);
+    T(stats.num_draw == 0);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, record_draw_multi) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_draw_args args[3] = {
+        { .base_element = 0, .num_elements = 3, .num_instances = 1 },
+        { .base_element = 3, .num_elements = 3, .num_instances = 0 },
+        { .base_element = 6, .num_elements = 3, .num_instances = 1 },
+    };
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_multi(args, 3);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    const _sg_recording_t* r = _sg_lookup_recording(&_sg.pools, rec.id);
+    T(r->num_cmds == 4);
+    T(r->cmds[2].type == _SG_RECCMD_DRAW);
+    T(r->cmds[2].args.draw.base_element == 0);
+    T(r->cmds[3].type == _SG_RECCMD_DRAW);
+    T(r->cmds[3].args.draw.base_element == 6);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, indirect_buffer_cpu_copy) {
+    setup(&(sg_desc){0});
+    const sg_draw_indirect_args args[2] = {
+        { .num_elements = 3, .num_instances = 1, .base_element = 0 },
+        { .num_elements = 6, .num_instances = 2, .base_element = 3 },
+    };
+    const sg_buffer ibuf = create_indirect_buffer(args, sizeof(args));
+    T(sg_query_buffer_state(ibuf) == SG_RESOURCESTATE_VALID);
+    const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, ibuf.id);
+    T(buf->cmn.indirect_data);
+    T(0 == memcmp(buf->cmn.indirect_data, args, sizeof(args)));
+
+    const sg_buffer dbuf = sg_make_buffer(&(sg_buffer_desc){
+        .type = SG_BUFFERTYPE_INDIRECTBUFFER,
+        .usage = SG_USAGE_STREAM,
+        .size = sizeof(args),
+    });
+    sg_append_buffer(dbuf, &(sg_range){ &args[1], sizeof(sg_draw_indirect_args) });
+    sg_append_buffer(dbuf, &(sg_range){ &args[0], sizeof(sg_draw_indirect_args) });
+    const _sg_buffer_t* dyn_buf = _sg_lookup_buffer(&_sg.pools, dbuf.id);
+    const sg_draw_indirect_args* dyn_args = (const sg_draw_indirect_args*) dyn_buf->cmn.indirect_data;
+    T(dyn_args[0].num_elements == 6);
+    T(dyn_args[1].num_elements == 3);
+    sg_commit();
+    sg_update_buffer(dbuf, &SG_RANGE(args));
+    T(dyn_args[0].num_elements == 3);
+    T(dyn_args[1].num_elements == 6);
+
+    // vertex buffers don't have a CPU-side copy
+    const sg_buffer vbuf = create_buffer();
+    T(0 == _sg_lookup_buffer(&_sg.pools, vbuf.id)->cmn.indirect_data);
+    sg_destroy_buffer(ibuf);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, draw_indirect) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_draw_indirect_args args[2] = {
+        { .num_elements = 3, .num_instances = 1, .base_element = 0 },
+        { .num_elements = 3, .num_instances = 1, .base_element = 3 },
+    };
+    const sg_buffer ibuf = create_indirect_buffer(args, sizeof(args));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_indirect(ibuf, 0, 2);
+    sg_draw_indirect(ibuf, sizeof(sg_draw_indirect_args), 1);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_draw_indirect == 2);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, draw_indirect_validate_buffer) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_indirect(vbuf, 0, 1);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_BUFFER_TYPE);
+    T(log_items[1] == SG_LOGITEM_VALIDATION_FAILED);
+    reset_log_items();
+    const sg_buffer ibuf = sg_make_buffer(&(sg_buffer_desc){
+        .type = SG_BUFFERTYPE_INDIRECTBUFFER,
+        .usage = SG_USAGE_STREAM,
+        .size = sizeof(sg_draw_indirect_args),
+    });
+    sg_destroy_buffer(ibuf);
+    sg_draw_indirect(ibuf, 0, 1);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_BUFFER_EXISTS);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, draw_indirect_validate_range) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_draw_indirect_args args[2] = {
+        { .num_elements = 3, .num_instances = 1, .base_element = 0 },
+        { .num_elements = 3, .num_instances = 1, .base_element = 3 },
+    };
+    const sg_buffer ibuf = create_indirect_buffer(args, sizeof(args));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_indirect(ibuf, 2, 1);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_OFFSET);
+    reset_log_items();
+    sg_draw_indirect(ibuf, sizeof(sg_draw_indirect_args), 2);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_SIZE);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, draw_indirect_validate_reserved) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_draw_indirect_args args[3] = {
+        { .num_elements = 3, .num_instances = 1, .base_element = 0 },
+        { .num_elements = 3, .num_instances = 1, .base_element = 3, .base_vertex = 1 },
+        { .num_elements = 3, .num_instances = 1, .base_element = 6, .base_instance = 1 },
+    };
+    const sg_buffer ibuf = create_indirect_buffer(args, sizeof(args));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_indirect(ibuf, 0, 1);
+    T(num_log_called == 0);
+    sg_draw_indirect(ibuf, 0, 2);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_RESERVED);
+    reset_log_items();
+    sg_draw_indirect(ibuf, 2 * sizeof(sg_draw_indirect_args), 1);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_RESERVED);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, draw_indirect_while_recording) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_draw_indirect_args args = { .num_elements = 3, .num_instances = 1 };
+    const sg_buffer ibuf = create_indirect_buffer(&args, sizeof(args));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw_indirect(ibuf, 0, 1);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DRAWINDIRECT_WHILE_RECORDING);
+    sg_end_recording();
+    sg_end_pass();
+    sg_shutdown();
+}
+
+static sg_buffer create_ring_buffer(size_t size) {
+    return sg_make_buffer(&(sg_buffer_desc){
+        .usage = SG_USAGE_STREAM_RING,
+        .size = size,
+    });
+}
+
+UTEST(sokol_gfx, ring_buffer_map_unmap) {
+    setup(&(sg_desc){0});
+    const sg_buffer buf = create_ring_buffer(1024);
+    T(sg_query_buffer_state(buf) == SG_RESOURCESTATE_VALID);
+    const _sg_buffer_t* b = _sg_lookup_buffer(&_sg.pools, buf.id);
+    T(b->cmn.num_slots == 1);
+    const int region_base = (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES) * 512;
+
+    const sg_mapped_range r0 = sg_map_buffer_range(buf, 10);
+    T(r0.ptr);
+    T(r0.size == 10);
+    T(r0.offset == region_base);
+    memset(r0.ptr, 0xAB, r0.size);
+    sg_unmap_buffer_range(buf);
+    T(b->cmn.ring_data[region_base] == 0xAB);
+    T(b->cmn.ring_data[region_base + 9] == 0xAB);
+
+    // mapped ranges are 4-byte aligned
+    const sg_mapped_range r1 = sg_map_buffer_range(buf, 16);
+    T(r1.ptr);
+    T(r1.offset == region_base + 12);
+    sg_unmap_buffer_range(buf);
+
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_map_buffer == 2);
+    T(stats.size_map_buffer == 26);
+
+    // next frame uses the next frame region
+    const sg_mapped_range r2 = sg_map_buffer_range(buf, 4);
+    T(r2.offset == (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES) * 512);
+    T(r2.offset != region_base);
+    sg_unmap_buffer_range(buf);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, ring_buffer_overflow) {
+    setup(&(sg_desc){0});
+    const sg_buffer buf = create_ring_buffer(1024);
+    T(!sg_query_buffer_will_overflow(buf, 512));
+    T(sg_query_buffer_will_overflow(buf, 513));
+    const sg_mapped_range r0 = sg_map_buffer_range(buf, 400);
+    T(r0.ptr);
+    sg_unmap_buffer_range(buf);
+    T(!sg_query_buffer_overflow(buf));
+    const sg_mapped_range r1 = sg_map_buffer_range(buf, 200);
+    T(0 == r1.ptr);
+    T(0 == r1.size);
+    T(sg_query_buffer_overflow(buf));
+    // overflow state is sticky for the rest of the frame
+    const sg_mapped_range r2 = sg_map_buffer_range(buf, 4);
+    T(0 == r2.ptr);
+    sg_commit();
+    const sg_mapped_range r3 = sg_map_buffer_range(buf, 200);
+    T(r3.ptr);
+    T(!sg_query_buffer_overflow(buf));
+    sg_unmap_buffer_range(buf);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, ring_buffer_append) {
+    setup(&(sg_desc){0});
+    const sg_buffer buf = create_ring_buffer(1024);
+    const _sg_buffer_t* b = _sg_lookup_buffer(&_sg.pools, buf.id);
+    const int region_base = (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES) * 512;
+    const uint32_t data0[3] = { 1, 2, 3 };
+    const uint32_t data1[2] = { 4, 5 };
+    T(sg_append_buffer(buf, &SG_RANGE(data0)) == region_base);
+    T(sg_append_buffer(buf, &SG_RANGE(data1)) == region_base + 12);
+    const uint32_t* ring = (const uint32_t*) (b->cmn.ring_data + region_base);
+    T(ring[0] == 1);
+    T(ring[2] == 3);
+    T(ring[3] == 4);
+    T(ring[4] == 5);
+    T(!b->cmn.mapped);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, ring_buffer_validate_map) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_mapped_range r0 = sg_map_buffer_range(vbuf, 4);
+    T(0 == r0.ptr);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_MAPBUF_USAGE);
+    reset_log_items();
+    const sg_buffer buf = create_ring_buffer(1024);
+    sg_unmap_buffer_range(buf);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_UNMAPBUF_NOT_MAPPED);
+    reset_log_items();
+    const sg_mapped_range r1 = sg_map_buffer_range(buf, 4);
+    T(r1.ptr);
+    const sg_mapped_range r2 = sg_map_buffer_range(buf, 4);
+    T(0 == r2.ptr);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_MAPBUF_MAPPED);
+    reset_log_items();
+    const uint32_t data[2] = { 1, 2 };
+    sg_append_buffer(buf, &SG_RANGE(data));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_APPENDBUF_MAPPED);
+    sg_unmap_buffer_range(buf);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, ring_buffer_validate_update) {
+    setup(&(sg_desc){0});
+    const sg_buffer buf = create_ring_buffer(1024);
+    const uint32_t data[2] = { 1, 2 };
+    sg_update_buffer(buf, &SG_RANGE(data));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_UPDATEBUF_RING);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_ring_buffer_validate_size) {
+    setup(&(sg_desc){0});
+    const sg_buffer buf = create_ring_buffer(4);
+    T(sg_query_buffer_state(buf) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_BUFFERDESC_RING_SIZE);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_image_validate_stream_ring) {
+    setup(&(sg_desc){0});
+    const sg_image img = sg_make_image(&(sg_image_desc){
+        .width = 8,
+        .height = 8,
+        .usage = SG_USAGE_STREAM_RING,
+    });
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_IMAGEDESC_STREAM_RING);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_shader_validate_ub_glsl_name_std140) {
+    setup(&(sg_desc){0});
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){
+        .vs.uniform_blocks[0] = {
+            .size = 16,
+            .glsl_name = "vs_params",
+            .uniforms[0] = { .name = "offset", .type = SG_UNIFORMTYPE_FLOAT4 },
+        },
+    });
+    T(sg_query_shader_state(shd) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_SHADERDESC_UB_GLSL_NAME_STD140);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_shader_ub_glsl_name) {
+    setup(&(sg_desc){0});
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){
+        .vs.uniform_blocks[0] = {
+            .size = 16,
+            .layout = SG_UNIFORMLAYOUT_STD140,
+            .glsl_name = "vs_params",
+            .uniforms[0] = { .name = "offset", .type = SG_UNIFORMTYPE_FLOAT4 },
+        },
+    });
+    T(sg_query_shader_state(shd) == SG_RESOURCESTATE_VALID);
+    T(sg_query_shader_desc(shd).vs.uniform_blocks[0].size == 16);
+    sg_shutdown();
+}
+
+static void draw_with_uniforms(sg_pipeline pip, sg_buffer vbuf, float val) {
+    const float params[4] = { val, 2.0f, 3.0f, 4.0f };
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    sg_draw(0, 3, 1);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    sg_draw(0, 3, 1);
+}
+
+UTEST(sokol_gfx, uniform_cache_skips_redundant_uniforms) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    const float params[4] = { 5.0f, 6.0f, 7.0f, 8.0f };
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    draw_with_uniforms(pip, vbuf, 1.0f);
+    // changed data is not skipped
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    sg_draw(0, 3, 1);
+    // the cache is reset when a pipeline is applied
+    draw_with_uniforms(pip, vbuf, 5.0f);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_uniforms == 5);
+    T(stats.num_skipped_apply_uniforms == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, uniform_cache_disabled) {
+    setup(&(sg_desc){ .disable_uniform_cache = true });
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline_with_uniforms();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    draw_with_uniforms(pip, vbuf, 1.0f);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_uniforms == 2);
+    T(stats.num_skipped_apply_uniforms == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_apply_binding_set) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_binding_set bset = sg_make_binding_set(&(sg_binding_set_desc){
+        .bindings.vertex_buffers[0] = vbuf,
+    });
+    T(sg_query_binding_set_state(bset) == SG_RESOURCESTATE_VALID);
+    const _sg_binding_set_t* bs = _sg_lookup_binding_set(&_sg.pools, bset.id);
+    T(bs->num_refs == 1);
+    T(bs->bnd.num_vbs == 1);
+    T(bs->bnd.vbs[0] == _sg_lookup_buffer(&_sg.pools, vbuf.id));
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_binding_set(bset);
+    T(_sg.next_draw_valid);
+    #if defined(SOKOL_DEBUG)
+    T(bs->validated_pip_id == pip.id);
+    #endif
+    sg_draw(0, 3, 1);
+    sg_apply_binding_set(bset);
+    sg_draw(0, 3, 1);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_bindings == 2);
+    T(stats.num_draw == 2);
+    T(num_log_called == 0);
+    sg_destroy_binding_set(bset);
+    T(sg_query_binding_set_state(bset) == SG_RESOURCESTATE_INVALID);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, make_binding_set_validate_resources) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    sg_destroy_buffer(vbuf);
+    const sg_binding_set bset = sg_make_binding_set(&(sg_binding_set_desc){
+        .bindings.vertex_buffers[0] = vbuf,
+    });
+    T(sg_query_binding_set_state(bset) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_BINDINGSETDESC_BUFFER);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, apply_binding_set_resource_destroyed) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_binding_set bset = sg_make_binding_set(&(sg_binding_set_desc){
+        .bindings.vertex_buffers[0] = vbuf,
+    });
+    T(sg_query_binding_set_state(bset) == SG_RESOURCESTATE_VALID);
+    sg_destroy_buffer(vbuf);
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_binding_set(bset);
+    T(!_sg.next_draw_valid);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_ABNDSET_RESOURCE_EXISTS);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, apply_binding_set_validate_pipeline) {
+    setup(&(sg_desc){0});
+    static const uint16_t indices[] = { 0, 1, 2, 0 };
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_binding_set bset = sg_make_binding_set(&(sg_binding_set_desc){
+        .bindings = {
+            .vertex_buffers[0] = vbuf,
+            .index_buffer = sg_make_buffer(&(sg_buffer_desc){
+                .type = SG_BUFFERTYPE_INDEXBUFFER,
+                .data = SG_RANGE(indices),
+            }),
+        }
+    });
+    T(sg_query_binding_set_state(bset) == SG_RESOURCESTATE_VALID);
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_binding_set(bset);
+    T(!_sg.next_draw_valid);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_ABND_IB);
+    #if defined(SOKOL_DEBUG)
+    const _sg_binding_set_t* bs = _sg_lookup_binding_set(&_sg.pools, bset.id);
+    T(bs->validated_pip_id == SG_INVALID_ID);
+    #endif
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, record_binding_set) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_binding_set bset = sg_make_binding_set(&(sg_binding_set_desc){
+        .bindings.vertex_buffers[0] = vbuf,
+    });
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_apply_pipeline(pip);
+    sg_apply_binding_set(bset);
+    sg_draw(0, 3, 1);
+    const sg_recording rec = sg_end_recording();
+    sg_end_pass();
+    T(sg_query_recording_state(rec) == SG_RESOURCESTATE_VALID);
+    const _sg_recording_t* r = _sg_lookup_recording(&_sg.pools, rec.id);
+    T(r->num_cmds == 3);
+    T(r->num_bindings == 1);
+    T(r->bindings[0].vbs[0] == _sg_lookup_buffer(&_sg.pools, vbuf.id));
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pipeline_cache_hit) {
+    setup(&(sg_desc){ .enable_pipeline_cache = true });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    const sg_pipeline pip0 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+        .label = "pip0",
+    });
+    // defaults-patched desc and different label must result in a cache hit
+    const sg_pipeline pip1 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+        .primitive_type = SG_PRIMITIVETYPE_TRIANGLES,
+        .label = "pip1",
+    });
+    const sg_pipeline pip2 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+        .cull_mode = SG_CULLMODE_BACK,
+    });
+    T(pip0.id != SG_INVALID_ID);
+    T(pip0.id == pip1.id);
+    T(pip0.id != pip2.id);
+    T(_sg.pools.pipeline_pool.queue_top == (_sg.pools.pipeline_pool.size - 3));
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_pipeline_cache_hits == 1);
+    T(stats.num_pipeline_cache_misses == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pipeline_cache_refcount) {
+    setup(&(sg_desc){ .enable_pipeline_cache = true });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    const sg_pipeline_desc desc = {
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    };
+    const sg_pipeline pip0 = sg_make_pipeline(&desc);
+    const sg_pipeline pip1 = sg_make_pipeline(&desc);
+    T(pip0.id == pip1.id);
+    sg_destroy_pipeline(pip0);
+    T(sg_query_pipeline_state(pip0) == SG_RESOURCESTATE_VALID);
+    sg_destroy_pipeline(pip1);
+    T(sg_query_pipeline_state(pip0) == SG_RESOURCESTATE_INVALID);
+    // a destroyed pipeline must not be returned from the cache
+    const sg_pipeline pip2 = sg_make_pipeline(&desc);
+    T(sg_query_pipeline_state(pip2) == SG_RESOURCESTATE_VALID);
+    T(pip2.id != pip0.id);
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_pipeline_cache_hits == 1);
+    T(stats.num_pipeline_cache_misses == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pipeline_cache_churn) {
+    setup(&(sg_desc){ .enable_pipeline_cache = true, .pipeline_pool_size = 8 });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    // repeatedly create and destroy pipelines, this leaves removed entries
+    // in the hash table which must not break lookups
+    for (int round = 0; round < 32; round++) {
+        sg_pipeline pips[4];
+        for (int i = 0; i < 4; i++) {
+            pips[i] = sg_make_pipeline(&(sg_pipeline_desc){
+                .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+                .shader = shd,
+                .sample_count = 1 + ((round + i) & 3),
+            });
+            T(sg_query_pipeline_state(pips[i]) == SG_RESOURCESTATE_VALID);
+        }
+        for (int i = 0; i < 4; i++) {
+            const sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+                .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+                .shader = shd,
+                .sample_count = 1 + ((round + i) & 3),
+            });
+            T(pip.id == pips[i].id);
+            sg_destroy_pipeline(pip);
+        }
+        for (int i = 0; i < 4; i++) {
+            sg_destroy_pipeline(pips[i]);
+            T(sg_query_pipeline_state(pips[i]) == SG_RESOURCESTATE_INVALID);
+        }
+    }
+    // a pipeline destroyed behind the cache's back must not be returned
+    const sg_pipeline_desc desc = {
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    };
+    const sg_pipeline pip0 = sg_make_pipeline(&desc);
+    sg_uninit_pipeline(pip0);
+    sg_dealloc_pipeline(pip0);
+    const sg_pipeline pip1 = sg_make_pipeline(&desc);
+    T(pip1.id != pip0.id);
+    T(sg_query_pipeline_state(pip1) == SG_RESOURCESTATE_VALID);
+    T(sg_make_pipeline(&desc).id == pip1.id);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pipeline_cache_padding) {
+    setup(&(sg_desc){ .enable_pipeline_cache = true });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    sg_pipeline_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3;
+    desc.shader = shd;
+    const sg_pipeline pip0 = sg_make_pipeline(&desc);
+    // garbage in padding bytes must not cause a cache miss
+    uint8_t* ptr = (uint8_t*)&desc;
+    const size_t stencil_pad_start = offsetof(sg_pipeline_desc, stencil) + sizeof(bool);
+    const size_t stencil_pad_end = offsetof(sg_pipeline_desc, stencil) + offsetof(sg_stencil_state, front);
+    memset(ptr + stencil_pad_start, 0xFF, stencil_pad_end - stencil_pad_start);
+    const size_t tail_pad_start = offsetof(sg_pipeline_desc, compute) + sizeof(bool);
+    const size_t tail_pad_end = offsetof(sg_pipeline_desc, label);
+    memset(ptr + tail_pad_start, 0xFF, tail_pad_end - tail_pad_start);
+    const sg_pipeline pip1 = sg_make_pipeline(&desc);
+    T(pip0.id == pip1.id);
+    sg_commit();
+    T(sg_query_frame_stats().num_pipeline_cache_hits == 1);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pipeline_cache_disabled) {
+    setup(&(sg_desc){0});
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    const sg_pipeline_desc desc = {
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    };
+    const sg_pipeline pip0 = sg_make_pipeline(&desc);
+    const sg_pipeline pip1 = sg_make_pipeline(&desc);
+    T(pip0.id != pip1.id);
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_pipeline_cache_hits == 0);
+    T(stats.num_pipeline_cache_misses == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, queue_draw_sort_order) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    static const uint64_t keys[8] = {
+        0x0200000000000000, 5, 0x0100000000000300, 5, 0, 0x0100000000000200, 5, 0xFFFFFFFFFFFFFFFF
+    };
+    static const int expected_order[8] = { 4, 1, 3, 6, 5, 2, 0, 7 };
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    for (int i = 0; i < 8; i++) {
+        sg_queue_draw(&(sg_queued_draw){
+            .sort_key = keys[i],
+            .pipeline = pip,
+            .bindings.vertex_buffers[0] = vbuf,
+            .num_elements = 3,
+            .num_instances = 1,
+        });
+    }
+    T(_sg.draw_queue.num_items == 8);
+    const _sg_draw_queue_key_t* sorted = _sg_sort_draw_queue();
+    for (int i = 0; i < 8; i++) {
+        T(sorted[i].index == expected_order[i]);
+        T(sorted[i].key == keys[expected_order[i]]);
+    }
+    sg_end_pass();
+    T(_sg.draw_queue.num_items == 0);
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_queue_draw == 8);
+    T(stats.num_draw == 8);
+    T(stats.num_apply_pipeline == 1);
+    T(stats.num_apply_bindings == 1);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, queue_draw_saved_state_changes) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf0 = create_buffer();
+    const sg_buffer vbuf1 = create_buffer();
+    const sg_pipeline pip0 = create_pipeline_with_uniforms();
+    const sg_pipeline pip1 = create_pipeline_with_uniforms();
+    const float params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    // interleaved submission order: pip0/vbuf0, pip1/vbuf1, pip0/vbuf0, pip1/vbuf1
+    for (int i = 0; i < 4; i++) {
+        const bool odd = (i & 1) != 0;
+        sg_queue_draw(&(sg_queued_draw){
+            .sort_key = odd ? 2 : 1,
+            .pipeline = odd ? pip1 : pip0,
+            .bindings.vertex_buffers[0] = odd ? vbuf1 : vbuf0,
+            .vs_uniforms[0] = SG_RANGE(params),
+            .num_elements = 3,
+            .num_instances = 1,
+        });
+    }
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_queue_draw == 4);
+    T(stats.num_draw == 4);
+    T(stats.num_apply_pipeline == 2);
+    T(stats.num_apply_bindings == 2);
+    T(stats.num_apply_uniforms == 4);
+    T(stats.num_skipped_apply_uniforms == 2);
+    T(stats.num_queue_saved_apply_pipeline == 2);
+    T(stats.num_queue_saved_apply_bindings == 2);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, queue_draw_validate) {
+    setup(&(sg_desc){0});
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    const sg_queued_draw draw = {
+        .pipeline = pip,
+        .bindings.vertex_buffers[0] = vbuf,
+        .num_elements = 3,
+        .num_instances = 1,
+    };
+    sg_queue_draw(&draw);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_QUEUEDRAW_PASS);
+    T(_sg.draw_queue.num_items == 0);
+    reset_log_items();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_begin_recording();
+    sg_queue_draw(&draw);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_QUEUEDRAW_RECORDING);
+    T(_sg.draw_queue.num_items == 0);
+    sg_end_recording();
+    reset_log_items();
+    sg_queue_draw(&(sg_queued_draw){ .num_elements = 3, .num_instances = 1 });
+    T(log_items[0] == SG_LOGITEM_VALIDATE_QUEUEDRAW_PIPELINE);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pass_timings) {
+    setup(&(sg_desc){ .enable_pass_timings = true });
+    T(sg_query_features().pass_timings);
+    T(sg_query_pass_timings().frame_index == 0);
+    const sg_pass pass = create_pass();
+    const uint32_t frame_index = _sg.frame_index;
+    sg_push_debug_group("frame");
+    sg_begin_pass(pass, &(sg_pass_action){0});
+    sg_push_debug_group("a very long debug group name which is truncated");
+    sg_pop_debug_group();
+    sg_end_pass();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_end_pass();
+    sg_pop_debug_group();
+    sg_commit();
+    const sg_pass_timings t = sg_query_pass_timings();
+    T(t.frame_index == frame_index);
+    T(t.num_timings == 4);
+    T(t.timings[0].type == SG_TIMINGTYPE_DEBUG_GROUP);
+    T(0 == strcmp(t.timings[0].name, "frame"));
+    T(t.timings[0].depth == 0);
+    T(t.timings[0].gpu_time_ns == 7000);
+    T(t.timings[1].type == SG_TIMINGTYPE_PASS);
+    T(t.timings[1].pass.id == pass.id);
+    T(t.timings[1].name[0] == 0);
+    T(t.timings[1].depth == 1);
+    T(t.timings[1].gpu_time_ns == 3000);
+    T(t.timings[2].type == SG_TIMINGTYPE_DEBUG_GROUP);
+    T(0 == strcmp(t.timings[2].name, "a very long debug group name wh"));
+    T(t.timings[2].depth == 1);
+    T(t.timings[2].gpu_time_ns == 1000);
+    T(t.timings[3].type == SG_TIMINGTYPE_PASS);
+    T(t.timings[3].pass.id == SG_INVALID_ID);
+    T(t.timings[3].gpu_time_ns == 1000);
+    // a frame without passes or debug groups doesn't replace the last result
+    sg_commit();
+    T(sg_query_pass_timings().frame_index == frame_index);
+    sg_shutdown();
+}
+
+// the end of an outer debug group is written after the ends of the scopes nested in it,
+// the results of a frame must not be read before that timestamp is available
+UTEST(sokol_gfx, pass_timings_nested_pending) {
+    setup(&(sg_desc){ .enable_pass_timings = true });
+    const uint32_t frame_index = _sg.frame_index;
+    sg_push_debug_group("outer");
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_end_pass();
+    // the outer group is still open and ends in sg_commit()
+    const uint64_t last_inner_timestamp = _sg.dummy.timestamp_counter;
+    _sg.dummy.timestamp_completed = last_inner_timestamp;
+    sg_commit();
+    T(sg_query_pass_timings().frame_index == 0);
+    // ...once the GPU has caught up, the frame is read back in a later sg_commit()
+    _sg.dummy.timestamp_completed = 0;
+    sg_commit();
+    const sg_pass_timings t = sg_query_pass_timings();
+    T(t.frame_index == frame_index);
+    T(t.num_timings == 2);
+    T(t.timings[0].type == SG_TIMINGTYPE_DEBUG_GROUP);
+    T(t.timings[0].gpu_time_ns == 3000);
+    T(t.timings[1].type == SG_TIMINGTYPE_PASS);
+    T(t.timings[1].gpu_time_ns == 1000);
+    sg_pop_debug_group();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pass_timings_overflow) {
+    setup(&(sg_desc){ .enable_pass_timings = true });
+    for (int i = 0; i < SG_MAX_PASS_TIMINGS + 2; i++) {
+        sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+        sg_end_pass();
+    }
+    T(num_log_called == 1);
+    T(log_items[0] == SG_LOGITEM_PASS_TIMINGS_OVERFLOW);
+    sg_commit();
+    T(sg_query_pass_timings().num_timings == SG_MAX_PASS_TIMINGS);
+    // unbalanced debug groups end in sg_commit()
+    sg_push_debug_group("unbalanced");
+    sg_commit();
+    const sg_pass_timings t = sg_query_pass_timings();
+    T(t.num_timings == 1);
+    T(t.timings[0].gpu_time_ns == 1000);
+    sg_pop_debug_group();
+    T(_sg.timings.group_depth == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pass_timings_disabled) {
+    setup(&(sg_desc){0});
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_end_pass();
+    sg_commit();
+    T(sg_query_pass_timings().frame_index == 0);
+    T(sg_query_pass_timings().num_timings == 0);
+    sg_shutdown();
+}
+
+static struct {
+    int num_loads;
+    int num_stores;
+    uint64_t key;
+    sg_shader_binary bin;
+    uint8_t data[64];
+} shader_cache;
+
+static sg_shader_binary shader_cache_load(uint64_t key, void* user_data) {
+    (void)user_data;
+    shader_cache.num_loads++;
+    if ((shader_cache.num_stores > 0) && (key == shader_cache.key)) {
+        return shader_cache.bin;
+    }
+    return (sg_shader_binary){0};
+}
+
+static void shader_cache_store(uint64_t key, const sg_shader_binary* bin, void* user_data) {
+    (void)user_data;
+    shader_cache.num_stores++;
+    shader_cache.key = key;
+    shader_cache.bin.format = bin->format;
+    memcpy(shader_cache.data, bin->data.ptr, bin->data.size);
+    shader_cache.bin.data = (sg_range){ shader_cache.data, bin->data.size };
+}
+
+static sg_desc shader_cache_desc(void) {
+    memset(&shader_cache, 0, sizeof(shader_cache));
+    return (sg_desc){
+        .shader_cache = {
+            .load_fn = shader_cache_load,
+            .store_fn = shader_cache_store,
+        }
+    };
+}
+
+UTEST(sokol_gfx, shader_cache_key) {
+    setup(&(sg_desc){0});
+    const sg_shader_desc desc0 = { .vs.source = "vs0", .fs.source = "fs0" };
+    const sg_shader_desc desc1 = { .vs.source = "vs0", .fs.source = "fs1" };
+    const sg_shader_desc desc2 = { .vs.source = "vs", .fs.source = "0fs0" };
+    const sg_shader_desc desc3 = { .vs.source = "vs0", .fs.source = "fs0", .label = "label" };
+    T(_sg_shader_cache_key(&desc0) != _sg_shader_cache_key(&desc1));
+    T(_sg_shader_cache_key(&desc0) != _sg_shader_cache_key(&desc2));
+    T(_sg_shader_cache_key(&desc0) == _sg_shader_cache_key(&desc3));
+    T(_sg_shader_cache_key(&(sg_shader_desc){0}) != _sg_shader_cache_key(&(sg_shader_desc){ .vs.source = "" }));
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, shader_cache_hit_miss) {
+    const sg_desc desc = shader_cache_desc();
+    setup(&desc);
+    const sg_shader_desc shd_desc = { .vs.source = "vs", .fs.source = "fs" };
+    const sg_shader shd0 = sg_make_shader(&shd_desc);
+    T(sg_query_shader_state(shd0) == SG_RESOURCESTATE_VALID);
+    T(shader_cache.num_loads == 1);
+    T(shader_cache.num_stores == 1);
+    T(shader_cache.key == _sg_shader_cache_key(&shd_desc));
+    T(shader_cache.bin.data.size > 0);
+    const sg_shader shd1 = sg_make_shader(&shd_desc);
+    T(sg_query_shader_state(shd1) == SG_RESOURCESTATE_VALID);
+    T(shader_cache.num_loads == 2);
+    T(shader_cache.num_stores == 1);
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_shader_cache_hits == 1);
+    T(stats.num_shader_cache_misses == 1);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, shader_cache_rejected_binary) {
+    const sg_desc desc = shader_cache_desc();
+    setup(&desc);
+    const sg_shader_desc shd_desc = { .vs.source = "vs", .fs.source = "fs" };
+    sg_make_shader(&shd_desc);
+    T(shader_cache.num_stores == 1);
+    // a binary in an unknown format must be ignored and replaced
+    const uint32_t format = shader_cache.bin.format;
+    shader_cache.bin.format = format + 1;
+    const sg_shader shd = sg_make_shader(&shd_desc);
+    T(sg_query_shader_state(shd) == SG_RESOURCESTATE_VALID);
+    T(shader_cache.num_stores == 2);
+    T(shader_cache.bin.format == format);
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_shader_cache_hits == 0);
+    T(stats.num_shader_cache_misses == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, async_shader_pending) {
+    setup(&(sg_desc){ .enable_async_shaders = true });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    T(sg_query_shader_state(shd) == SG_RESOURCESTATE_PENDING);
+    const sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    });
+    T(sg_query_pipeline_state(pip) == SG_RESOURCESTATE_PENDING);
+    sg_commit();
+    T(sg_query_shader_state(shd) == SG_RESOURCESTATE_VALID);
+    T(sg_query_pipeline_state(pip) == SG_RESOURCESTATE_VALID);
+    // a pipeline with a finished shader is created immediately
+    const sg_pipeline pip1 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    });
+    T(sg_query_pipeline_state(pip1) == SG_RESOURCESTATE_VALID);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, async_shader_skip_draws) {
+    setup(&(sg_desc){ .enable_async_shaders = true });
+    const sg_buffer vbuf = create_buffer();
+    const sg_pipeline pip = create_pipeline();
+    T(sg_query_pipeline_state(pip) == SG_RESOURCESTATE_PENDING);
+    // the shader has no uniform blocks, so sg_apply_uniforms() would fail validation if it wasn't skipped
+    static const float params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    sg_draw(0, 3, 1);
+    sg_end_pass();
+    sg_commit();
+    T(num_log_called == 0);
+    T(sg_query_pipeline_state(pip) == SG_RESOURCESTATE_VALID);
+    sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_apply_pending_pipeline == 1);
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+    sg_draw(0, 3, 1);
+    sg_end_pass();
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.num_apply_pending_pipeline == 0);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, async_shader_destroy_pending) {
+    setup(&(sg_desc){ .enable_async_shaders = true });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    const sg_pipeline pip0 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    });
+    const sg_pipeline pip1 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    });
+    sg_destroy_pipeline(pip0);
+    T(sg_query_pipeline_state(pip0) == SG_RESOURCESTATE_INVALID);
+    // a pending pipeline fails when its shader is destroyed before it is ready
+    sg_destroy_shader(shd);
+    T(sg_query_shader_state(shd) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_pipeline_state(pip1) == SG_RESOURCESTATE_PENDING);
+    sg_commit();
+    T(sg_query_pipeline_state(pip1) == SG_RESOURCESTATE_FAILED);
+    // pending resources are cleaned up in sg_shutdown()
+    const sg_shader shd1 = sg_make_shader(&(sg_shader_desc){0});
+    sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd1,
+    });
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pool_growth) {
+    setup(&(sg_desc){
+        .buffer_pool_size = 2,
+        .enable_growable_pools = true,
+    });
+    sg_buffer buf[5];
+    for (int i = 0; i < 5; i++) {
+        buf[i] = create_buffer();
+        T(sg_query_buffer_state(buf[i]) == SG_RESOURCESTATE_VALID);
+    }
+    const _sg_buffer_t* buf0 = _sg_lookup_buffer(&_sg.pools, buf[0].id);
+    // the pool has grown twice by the initial pool size
+    T(_sg.pools.buffer_pool.size == 7);
+    T(_sg.pools.buffer_pool.num_chunks == 2);
+    T(create_buffer().id != SG_INVALID_ID);
+    T(create_buffer().id != SG_INVALID_ID);
+    // existing items must not move when the pool grows
+    T(_sg.pools.buffer_pool.num_chunks == 3);
+    T(_sg_lookup_buffer(&_sg.pools, buf[0].id) == buf0);
+    for (int i = 0; i < 3; i++) {
+        sg_destroy_buffer(buf[i]);
+    }
+    T(sg_query_buffer_state(buf[4]) == SG_RESOURCESTATE_VALID);
+    const sg_pool_stats stats = sg_query_pool_stats();
+    T(stats.buffers.size == 8);
+    T(stats.buffers.num_used == 4);
+    T(stats.buffers.high_water_mark == 7);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pool_growth_disabled) {
+    setup(&(sg_desc){ .buffer_pool_size = 2 });
+    T(create_buffer().id != SG_INVALID_ID);
+    T(create_buffer().id != SG_INVALID_ID);
+    T(create_buffer().id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_BUFFER_POOL_EXHAUSTED);
+    const sg_pool_stats stats = sg_query_pool_stats();
+    T(stats.buffers.size == 2);
+    T(stats.buffers.num_used == 2);
+    T(stats.buffers.high_water_mark == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pool_growth_pipeline_cache) {
+    setup(&(sg_desc){
+        .pipeline_pool_size = 1,
+        .enable_growable_pools = true,
+        .enable_pipeline_cache = true,
+    });
+    const sg_shader shd = sg_make_shader(&(sg_shader_desc){0});
+    sg_pipeline pip[3];
+    for (int i = 0; i < 3; i++) {
+        pip[i] = sg_make_pipeline(&(sg_pipeline_desc){
+            .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+            .shader = shd,
+            .primitive_type = (sg_primitive_type)(SG_PRIMITIVETYPE_POINTS + i),
+        });
+        T(sg_query_pipeline_state(pip[i]) == SG_RESOURCESTATE_VALID);
+    }
+    // pipelines in the grown part of the pool are found in the cache
+    const sg_pipeline pip2 = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+        .primitive_type = SG_PRIMITIVETYPE_POINTS + 2,
+    });
+    T(pip2.id == pip[2].id);
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_pipeline_cache_hits == 1);
+    T(stats.num_pipeline_cache_misses == 3);
+    sg_shutdown();
+}
+
+static sg_image create_dynamic_image(int width, int height) {
+    return sg_make_image(&(sg_image_desc){
+        .usage = SG_USAGE_DYNAMIC,
+        .width = width,
+        .height = height,
+    });
+}
+
+UTEST(sokol_gfx, image_upload_map_unmap) {
+    setup(&(sg_desc){0});
+    T(sg_query_features().image_upload);
+    const sg_image img = create_dynamic_image(16, 8);
+    const sg_mapped_range r0 = sg_map_image_upload(img, 0, 0);
+    T(r0.ptr);
+    T(r0.size == 16 * 8 * 4);
+    T(r0.offset == 0);
+    memset(r0.ptr, 0xAB, r0.size);
+    const sg_image_upload up0 = sg_unmap_image_upload(img);
+    T(up0.id != SG_INVALID_ID);
+    T(_sg.upload.staging[0] == 0xAB);
+    // multiple uploads per frame are allowed, offsets are 16-byte aligned
+    const sg_image img1 = create_dynamic_image(3, 1);
+    const sg_mapped_range r1 = sg_map_image_upload(img1, 0, 0);
+    T(r1.size == 12);
+    T(r1.offset == 512);
+    const sg_image_upload up1 = sg_unmap_image_upload(img1);
+    const sg_mapped_range r2 = sg_map_image_upload(img1, 0, 0);
+    T(r2.offset == 528);
+    const sg_image_upload up2 = sg_unmap_image_upload(img1);
+    T(!sg_query_image_upload_done(up0));
+    T(!sg_query_image_upload_done(up2));
+    sg_commit();
+    const sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.num_image_upload == 3);
+    T(stats.size_image_upload == 536);
+    T(sg_query_image_upload_done(up0));
+    T(sg_query_image_upload_done(up1));
+    T(sg_query_image_upload_done(up2));
+    T(!sg_query_image_upload_done((sg_image_upload){0}));
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, image_upload_buffer_full) {
+    setup(&(sg_desc){ .upload_buffer_size = 512 });
+    const sg_image img = sg_make_image(&(sg_image_desc){
+        .usage = SG_USAGE_DYNAMIC,
+        .width = 8,
+        .height = 8,
+        .num_mipmaps = 2,
+    });
+    const sg_mapped_range r0 = sg_map_image_upload(img, 0, 1);
+    T(r0.size == 4 * 4 * 4);
+    sg_unmap_image_upload(img);
+    const sg_mapped_range r1 = sg_map_image_upload(img, 0, 0);
+    T(r1.offset == 64);
+    sg_unmap_image_upload(img);
+    // the upload buffer is full until the GPU has finished pending uploads
+    const sg_mapped_range r2 = sg_map_image_upload(img, 0, 0);
+    T(0 == r2.ptr);
+    T(num_log_called == 0);
+    sg_commit();
+    // ...after which the upload buffer is recycled
+    const sg_mapped_range r3 = sg_map_image_upload(img, 0, 0);
+    T(r3.ptr);
+    T(r3.offset == 0);
+    sg_unmap_image_upload(img);
+    // an image which never fits into the upload buffer is an error
+    const sg_image big_img = create_dynamic_image(32, 32);
+    const sg_mapped_range r4 = sg_map_image_upload(big_img, 0, 0);
+    T(0 == r4.ptr);
+    T(log_items[0] == SG_LOGITEM_IMAGE_UPLOAD_TOO_BIG);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, image_upload_destroy_mapped) {
+    setup(&(sg_desc){0});
+    const sg_image img = create_dynamic_image(16, 16);
+    const sg_mapped_range r0 = sg_map_image_upload(img, 0, 0);
+    T(r0.ptr);
+    sg_destroy_image(img);
+    const sg_image_upload up = sg_unmap_image_upload(img);
+    T(up.id == SG_INVALID_ID);
+    T(!_sg.upload.mapped);
+    T(_sg.upload.queue_count == 0);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, image_upload_validate) {
+    setup(&(sg_desc){0});
+    const sg_image imm_img = create_image();
+    T(0 == sg_map_image_upload(imm_img, 0, 0).ptr);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_MAPIMG_USAGE);
+    reset_log_items();
+    const sg_image img = create_dynamic_image(16, 16);
+    T(0 == sg_map_image_upload(img, 1, 0).ptr);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_MAPIMG_FACE);
+    reset_log_items();
+    T(0 == sg_map_image_upload(img, 0, 1).ptr);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_MAPIMG_MIPLEVEL);
+    reset_log_items();
+    sg_unmap_image_upload(img);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_UNMAPIMG_NOT_MAPPED);
+    reset_log_items();
+    T(sg_map_image_upload(img, 0, 0).ptr);
+    T(0 == sg_map_image_upload(img, 0, 0).ptr);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_MAPIMG_MAPPED);
+    sg_unmap_image_upload(img);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, read_image_sync) {
+    setup(&(sg_desc){0});
+    T(sg_query_features().image_read);
+    const sg_image img = create_image();
+    uint8_t pixels[4 * 3 * 4];
+    memset(pixels, 0, sizeof(pixels));
+    T(sg_read_image(&(sg_read_desc){ .image = img, .x = 10, .y = 20, .width = 4, .height = 3 }, &SG_RANGE(pixels)));
+    T(pixels[0] == 10); T(pixels[1] == 20); T(pixels[2] == 0xFF); T(pixels[3] == 0xFF);
+    const uint8_t* last = &pixels[(2 * 4 + 3) * 4];
+    T(last[0] == 13); T(last[1] == 22); T(last[2] == 0xFF); T(last[3] == 0xFF);
+    // data too small for the whole image
+    T(!sg_read_image(&(sg_read_desc){ .image = img }, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_DATA_SIZE);
+    sg_shutdown();
+}
+
+static int read_num_called;
+static sg_read_result read_result;
+static uint8_t read_pixel[4];
+
+static void read_callback(const sg_read_result* res) {
+    read_num_called++;
+    read_result = *res;
+    if (res->data.ptr) {
+        memcpy(read_pixel, res->data.ptr, sizeof(read_pixel));
+    }
+}
+
+UTEST(sokol_gfx, read_image_async) {
+    setup(&(sg_desc){0});
+    read_num_called = 0;
+    const sg_image img = create_image();
+    T(sg_read_image_async(&(sg_read_desc){
+        .image = img,
+        .x = 200,
+        .y = 100,
+        .callback = read_callback,
+        .user_data = (void*)0xABCD,
+    }));
+    T(read_num_called == 0);
+    sg_commit();
+    T(read_num_called == 1);
+    T(read_result.image.id == img.id);
+    T(read_result.width == 56);
+    T(read_result.height == 28);
+    T(read_result.pixel_format == SG_PIXELFORMAT_RGBA8);
+    T(read_result.data.size == 56 * 28 * 4);
+    T(read_result.user_data == (void*)0xABCD);
+    T(read_pixel[0] == 200); T(read_pixel[1] == 100); T(read_pixel[2] == 0xFF);
+    sg_commit();
+    T(read_num_called == 1);
+    // reads from the default framebuffer need an explicit size
+    T(sg_read_image_async(&(sg_read_desc){ .width = 8, .height = 8, .callback = read_callback }));
+    sg_commit();
+    T(read_num_called == 2);
+    T(read_result.image.id == SG_INVALID_ID);
+    T(read_result.data.size == 8 * 8 * 4);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, read_image_queue_full) {
+    setup(&(sg_desc){0});
+    read_num_called = 0;
+    const sg_image img = create_image();
+    for (int i = 0; i < 16; i++) {
+        T(sg_read_image_async(&(sg_read_desc){ .image = img, .callback = read_callback }));
+    }
+    T(!sg_read_image_async(&(sg_read_desc){ .image = img, .callback = read_callback }));
+    T(log_items[0] == SG_LOGITEM_IMAGE_READ_QUEUE_FULL);
+    sg_commit();
+    T(read_num_called == 16);
+    // pending reads are dropped in sg_shutdown()
+    T(sg_read_image_async(&(sg_read_desc){ .image = img, .callback = read_callback }));
+    sg_shutdown();
+    T(read_num_called == 16);
+}
+
+UTEST(sokol_gfx, read_image_async_failed) {
+    setup(&(sg_desc){0});
+    read_num_called = 0;
+    const sg_image img = create_image();
+    T(sg_read_image_async(&(sg_read_desc){ .image = img, .callback = read_callback }));
+    _sg.dummy.fail_reads = true;
+    // a failed read calls the callback once with an empty result and frees its slot
+    sg_commit();
+    T(read_num_called == 1);
+    T(read_result.failed);
+    T(read_result.data.ptr == 0);
+    T(read_result.data.size == 0);
+    T(log_items[0] == SG_LOGITEM_IMAGE_READ_FAILED);
+    T(_sg.reads.num_pending == 0);
+    sg_commit();
+    T(read_num_called == 1);
+    _sg.dummy.fail_reads = false;
+    T(sg_read_image_async(&(sg_read_desc){ .image = img, .callback = read_callback }));
+    sg_commit();
+    T(read_num_called == 2);
+    T(!read_result.failed);
+    T(read_result.data.size == 256 * 128 * 4);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, read_image_default_msaa_no_validation) {
+    // the MSAA check for the default framebuffer must also happen without the validation layer
+    setup(&(sg_desc){ .disable_validation = true, .context.sample_count = 4 });
+    uint8_t pixels[64];
+    T(!sg_read_image(&(sg_read_desc){ .width = 4, .height = 4 }, &SG_RANGE(pixels)));
+    T(!sg_read_image_async(&(sg_read_desc){ .width = 4, .height = 4, .callback = read_callback }));
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, read_image_validate) {
+    setup(&(sg_desc){0});
+    uint8_t pixels[64];
+    const sg_image rt_img = create_image();
+    const sg_image dyn_img = create_dynamic_image(4, 4);
+    T(!sg_read_image(&(sg_read_desc){ .image = dyn_img }, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_RENDERTARGET);
+    reset_log_items();
+    T(!sg_read_image(&(sg_read_desc){ .image = rt_img, .x = 250, .width = 8, .height = 1 }, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_RECT);
+    reset_log_items();
+    T(!sg_read_image(&(sg_read_desc){ .image = rt_img, .x = 256 }, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_RECT);
+    reset_log_items();
+    T(!sg_read_image(&(sg_read_desc){0}, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_DEFAULT_SIZE);
+    reset_log_items();
+    T(!sg_read_image_async(&(sg_read_desc){ .image = rt_img }));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_CALLBACK);
+    reset_log_items();
+    const sg_image msaa_img = sg_make_image(&(sg_image_desc){ .render_target = true, .width = 4, .height = 4, .sample_count = 4 });
+    T(!sg_read_image(&(sg_read_desc){ .image = msaa_img }, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_MSAA);
+    reset_log_items();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    T(!sg_read_image(&(sg_read_desc){ .width = 4, .height = 4 }, &SG_RANGE(pixels)));
+    T(log_items[0] == SG_LOGITEM_VALIDATE_READIMG_IN_PASS);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, generate_mipmaps) {
+    setup(&(sg_desc){0});
+    T(sg_query_features().generate_mipmaps);
+    const sg_image rt_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 64,
+        .height = 64,
+        .num_mipmaps = 7,
+    });
+    const sg_image dyn_img = sg_make_image(&(sg_image_desc){
+        .usage = SG_USAGE_DYNAMIC,
+        .width = 64,
+        .height = 64,
+        .num_mipmaps = 7,
+    });
+    sg_generate_mipmaps(rt_img);
+    sg_generate_mipmaps(dyn_img);
+    // images with a single mip level are ignored
+    sg_generate_mipmaps(create_image());
+    T(num_log_called == 0);
+    sg_commit();
+    T(sg_query_frame_stats().num_generate_mipmaps == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, generate_mipmaps_end_pass) {
+    setup(&(sg_desc){0});
+    const sg_image img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 64,
+        .height = 64,
+        .num_mipmaps = 7,
+        .sample_count = 1,
+        .generate_mipmaps = true,
+    });
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_VALID);
+    const sg_pass mip0_pass = sg_make_pass(&(sg_pass_desc){ .color_attachments[0].image = img });
+    const sg_pass mip1_pass = sg_make_pass(&(sg_pass_desc){ .color_attachments[0] = { .image = img, .mip_level = 1 } });
+    sg_begin_pass(mip0_pass, &(sg_pass_action){0});
+    sg_end_pass();
+    // passes which render into other mip levels don't trigger mipmap generation
+    sg_begin_pass(mip1_pass, &(sg_pass_action){0});
+    sg_end_pass();
+    sg_commit();
+    T(sg_query_frame_stats().num_generate_mipmaps == 1);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, generate_mipmaps_validate) {
+    setup(&(sg_desc){0});
+    const sg_image img = sg_make_image(&(sg_image_desc){
+        .width = 4,
+        .height = 4,
+        .num_mipmaps = 3,
+        .generate_mipmaps = true,
+        .usage = SG_USAGE_DYNAMIC,
+    });
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_IMAGEDESC_GENMIPS_NO_RT);
+    reset_log_items();
+    const sg_image depth_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 4,
+        .height = 4,
+        .num_mipmaps = 3,
+        .pixel_format = SG_PIXELFORMAT_DEPTH,
+        .generate_mipmaps = true,
+    });
+    T(sg_query_image_state(depth_img) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_IMAGEDESC_GENMIPS_PIXELFORMAT);
+    reset_log_items();
+    const sg_image msaa_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 4,
+        .height = 4,
+        .sample_count = 4,
+        .generate_mipmaps = true,
+    });
+    T(sg_query_image_state(msaa_img) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_IMAGEDESC_GENMIPS_MSAA);
+    reset_log_items();
+    uint8_t pixels[4 * 4 * 4] = {0};
+    const sg_image imm_img = sg_make_image(&(sg_image_desc){
+        .width = 4,
+        .height = 4,
+        .data.subimage[0][0] = SG_RANGE(pixels),
+    });
+    sg_generate_mipmaps(imm_img);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_GENMIPS_USAGE);
+    reset_log_items();
+    const sg_image rt_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 4,
+        .height = 4,
+        .num_mipmaps = 3,
+    });
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_generate_mipmaps(rt_img);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_GENMIPS_IN_PASS);
+    sg_end_pass();
+    sg_commit();
+    T(sg_query_frame_stats().num_generate_mipmaps == 0);
+    sg_shutdown();
+}
+
+static sg_pipeline create_compute_pipeline(void) {
+    return sg_make_pipeline(&(sg_pipeline_desc){
+        .compute = true,
+        .shader = sg_make_shader(&(sg_shader_desc){
+            .cs = {
+                .source = "compute",
+                .uniform_blocks[0].size = 16,
+                .storage_buffers[0].used = true,
+            },
+        }),
+    });
+}
+
+static sg_buffer create_storage_buffer(void) {
+    return sg_make_buffer(&(sg_buffer_desc){
+        .type = SG_BUFFERTYPE_STORAGEBUFFER,
+        .usage = SG_USAGE_DYNAMIC,
+        .size = 1024,
+    });
+}
+
+UTEST(sokol_gfx, compute_dispatch) {
+    setup(&(sg_desc){0});
+    T(sg_query_features().compute);
+    const sg_pipeline pip = create_compute_pipeline();
+    T(sg_query_pipeline_state(pip) == SG_RESOURCESTATE_VALID);
+    const sg_buffer sbuf = create_storage_buffer();
+    T(sg_query_buffer_state(sbuf) == SG_RESOURCESTATE_VALID);
+    static const float params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    sg_begin_compute_pass();
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .cs.storage_buffers[0] = sbuf });
+    sg_apply_uniforms(SG_SHADERSTAGE_CS, 0, &SG_RANGE(params));
+    sg_dispatch(16, 1, 1);
+    // dispatches with zero groups are ignored
+    sg_dispatch(0, 1, 1);
+    sg_end_pass();
+    // storage buffers can be used as vertex buffers in render passes
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(create_pipeline());
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = sbuf });
+    sg_draw(0, 3, 1);
+    sg_end_pass();
+    T(num_log_called == 0);
+    sg_commit();
+    T(sg_query_frame_stats().num_dispatch == 2);
+    T(sg_query_frame_stats().num_passes == 2);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, compute_dispatch_flushes_uniforms) {
+    setup(&(sg_desc){0});
+    const sg_pipeline pip = create_compute_pipeline();
+    const sg_buffer sbuf = create_storage_buffer();
+    static const float params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    sg_begin_compute_pass();
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&(sg_bindings){ .cs.storage_buffers[0] = sbuf });
+    sg_apply_uniforms(SG_SHADERSTAGE_CS, 0, &SG_RANGE(params));
+    T(_sg.dummy.num_staged_uniforms == 1);
+    T(_sg.dummy.num_flushed_uniforms == 0);
+    // the dispatch must see the uniforms applied before it
+    sg_dispatch(16, 1, 1);
+    T(_sg.dummy.num_staged_uniforms == 0);
+    T(_sg.dummy.num_flushed_uniforms == 1);
+    sg_end_pass();
+    T(num_log_called == 0);
+    sg_commit();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, compute_validate) {
+    setup(&(sg_desc){0});
+    const sg_pipeline compute_pip = create_compute_pipeline();
+    const sg_pipeline render_pip = create_pipeline();
+    const sg_buffer sbuf = create_storage_buffer();
+
+    // a compute shader requires a compute pipeline
+    const sg_pipeline mismatch_pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = sg_make_shader(&(sg_shader_desc){ .cs.source = "compute" }),
+    });
+    T(sg_query_pipeline_state(mismatch_pip) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_PIPELINEDESC_COMPUTE);
+    reset_log_items();
+
+    // a shader can't have both render and compute stages
+    const sg_shader mixed_shd = sg_make_shader(&(sg_shader_desc){ .vs.source = "vs", .cs.source = "compute" });
+    T(sg_query_shader_state(mixed_shd) == SG_RESOURCESTATE_FAILED);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_SHADERDESC_COMPUTE_STAGES);
+    reset_log_items();
+
+    // dispatch outside of a compute pass
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(render_pip);
+    sg_dispatch(1, 1, 1);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_DISPATCH_COMPUTE_PASS);
+    reset_log_items();
+    sg_end_pass();
+
+    // render pipeline in a compute pass
+    sg_begin_compute_pass();
+    sg_apply_pipeline(render_pip);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_APIP_COMPUTE);
+    reset_log_items();
+
+    // missing storage buffer binding
+    sg_apply_pipeline(compute_pip);
+    sg_apply_bindings(&(sg_bindings){0});
+    T(log_items[0] == SG_LOGITEM_VALIDATE_ABND_EXPECTED_STORAGEBUFFER_BINDING);
+    reset_log_items();
+
+    // vertex buffers can't be bound in compute passes
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = create_buffer(), .cs.storage_buffers[0] = sbuf });
+    T(log_items[0] == SG_LOGITEM_VALIDATE_ABND_COMPUTE_BINDINGS);
+    reset_log_items();
+
+    // draw calls are not allowed in compute passes
+    sg_draw(0, 3, 1);
+    T(log_items[0] == SG_LOGITEM_DRAW_IN_COMPUTE_PASS);
+    sg_end_pass();
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, transient_images) {
+    setup(&(sg_desc){0});
+    const sg_transient_image_desc desc = { .width = 64, .height = 32 };
+    const sg_image img0 = sg_acquire_transient_image(&desc);
+    const sg_image img1 = sg_acquire_transient_image(&desc);
+    T(sg_query_image_state(img0) == SG_RESOURCESTATE_VALID);
+    T(sg_query_image_state(img1) == SG_RESOURCESTATE_VALID);
+    T(img0.id != img1.id);
+    T(sg_query_image_desc(img0).render_target);
+    sg_commit();
+    T(sg_query_frame_stats().num_transient_misses == 2);
+    // the same images are handed out in the next frame
+    T(sg_acquire_transient_image(&desc).id == img0.id);
+    T(sg_acquire_transient_image(&desc).id == img1.id);
+    // ...but not for a different size
+    const sg_image img2 = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 32, .height = 32 });
+    T((img2.id != img0.id) && (img2.id != img1.id));
+    // released images can be acquired again in the same frame
+    sg_release_transient_image(img2);
+    T(sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 32, .height = 32 }).id == img2.id);
+    const sg_transient_stats stats = sg_query_transient_stats();
+    T(stats.num_images == 3);
+    T(stats.num_images_in_use == 3);
+    T(stats.size == (64 * 32 * 4 * 2) + (32 * 32 * 4));
+    T(stats.peak_size == stats.size);
+    T(num_log_called == 0);
+    sg_commit();
+    T(sg_query_frame_stats().num_transient_hits == 3);
+    T(sg_query_frame_stats().num_transient_misses == 1);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, transient_passes) {
+    setup(&(sg_desc){0});
+    const sg_image img = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 64, .height = 64 });
+    const sg_pass pass0 = sg_acquire_transient_pass(&(sg_pass_desc){ .color_attachments[0].image = img });
+    const sg_pass pass1 = sg_acquire_transient_pass(&(sg_pass_desc){ .color_attachments[0].image = img, .label = "pass" });
+    T(sg_query_pass_state(pass0) == SG_RESOURCESTATE_VALID);
+    T(pass0.id == pass1.id);
+    T(sg_query_transient_stats().num_passes == 1);
+    // objects which haven't been acquired for 16 frames are destroyed, together with passes rendering into them
+    for (int i = 0; i < 16; i++) {
+        sg_commit();
+    }
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_VALID);
+    sg_commit();
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_pass_state(pass0) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_transient_stats().num_images == 0);
+    T(sg_query_transient_stats().num_passes == 0);
+    T(sg_query_transient_stats().size == 0);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, transient_pool_exhausted) {
+    setup(&(sg_desc){ .transient_pool_size = 2 });
+    const sg_image img0 = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 16, .height = 16 });
+    sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 16, .height = 16 });
+    T(sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 16, .height = 16 }).id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_TRANSIENT_POOL_EXHAUSTED);
+    reset_log_items();
+    sg_commit();
+    // in the next frame, the least recently used image is evicted to make room
+    sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 16, .height = 16 });
+    const sg_image img2 = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 8, .height = 8 });
+    T(sg_query_image_state(img2) == SG_RESOURCESTATE_VALID);
+    T(sg_query_image_state(img0) == SG_RESOURCESTATE_VALID);
+    T(num_log_called == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, transient_evict_pass_in_use) {
+    setup(&(sg_desc){ .transient_pool_size = 3 });
+    const sg_image img0 = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 16, .height = 16 });
+    const sg_pass pass0 = sg_acquire_transient_pass(&(sg_pass_desc){ .color_attachments[0].image = img0 });
+    const sg_image img1 = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 8, .height = 8 });
+    sg_release_transient_image(img0);
+    sg_release_transient_image(img1);
+    // img0 is not in use, but pass0 which renders into it is, so img1 is evicted instead
+    const sg_image img2 = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 4, .height = 4 });
+    T(sg_query_image_state(img2) == SG_RESOURCESTATE_VALID);
+    T(sg_query_image_state(img0) == SG_RESOURCESTATE_VALID);
+    T(sg_query_pass_state(pass0) == SG_RESOURCESTATE_VALID);
+    T(sg_query_image_state(img1) == SG_RESOURCESTATE_INVALID);
+    // with nothing else to evict, the pool is exhausted
+    sg_release_transient_image(img2);
+    T(sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 2, .height = 2 }).id != SG_INVALID_ID);
+    T(sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 1, .height = 1 }).id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_TRANSIENT_POOL_EXHAUSTED);
+    T(sg_query_pass_state(pass0) == SG_RESOURCESTATE_VALID);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, transient_validate) {
+    setup(&(sg_desc){0});
+    T(sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 0, .height = 16 }).id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_TRANSIENT_IMAGE_SIZE);
+    reset_log_items();
+    T(sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 16, .height = 16, .pixel_format = SG_PIXELFORMAT_BC1_RGBA }).id == SG_INVALID_ID);
+    T(log_items[0] == SG_LOGITEM_VALIDATE_TRANSIENT_IMAGE_RENDERABLE);
+    reset_log_items();
+    sg_release_transient_image(create_image());
+    T(log_items[0] == SG_LOGITEM_VALIDATE_TRANSIENT_IMAGE_RELEASE);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, memory_stats) {
+    setup(&(sg_desc){0});
+    const sg_buffer buf = sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_DYNAMIC, .size = 1024 });
+    T(sg_query_buffer_info(buf).memory_size == 1024 * SG_NUM_INFLIGHT_FRAMES);
+    const sg_image rt_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 64,
+        .height = 64,
+        .num_mipmaps = 2,
+    });
+    T(sg_query_image_info(rt_img).memory_size == (64 * 64 * 4) + (32 * 32 * 4));
+    const sg_image cube_img = sg_make_image(&(sg_image_desc){
+        .type = SG_IMAGETYPE_CUBE,
+        .usage = SG_USAGE_DYNAMIC,
+        .width = 8,
+        .height = 8,
+        .pixel_format = SG_PIXELFORMAT_R8,
+    });
+    T(sg_query_image_info(cube_img).memory_size == 8 * 8 * 6 * SG_NUM_INFLIGHT_FRAMES);
+    sg_memory_stats mem = sg_query_memory_stats();
+    T(mem.buffers.total == 1024 * SG_NUM_INFLIGHT_FRAMES);
+    T(mem.buffers.dynamic == mem.buffers.total);
+    T(mem.images.render_target == (64 * 64 * 4) + (32 * 32 * 4));
+    T(mem.images.dynamic == 8 * 8 * 6 * SG_NUM_INFLIGHT_FRAMES);
+    T(mem.images.total == mem.images.render_target + mem.images.dynamic);
+    T(mem.total == mem.images.total + mem.buffers.total);
+    const uint64_t peak = mem.total;
+    sg_destroy_image(rt_img);
+    // failed resources are not counted
+    sg_make_image(&(sg_image_desc){ .width = 0 });
+    mem = sg_query_memory_stats();
+    T(mem.images.render_target == 0);
+    T(mem.total == mem.images.dynamic + mem.buffers.total);
+    T(mem.peak_total == peak);
+    sg_shutdown();
+}
+
+static int budget_num_called;
+static bool budget_over;
+static void* budget_user_data;
+
+static void budget_callback(const sg_memory_stats* stats, bool over_budget, void* user_data) {
+    (void)stats;
+    budget_num_called++;
+    budget_over = over_budget;
+    budget_user_data = user_data;
+}
+
+UTEST(sokol_gfx, memory_budget) {
+    budget_num_called = 0;
+    budget_over = false;
+    budget_user_data = 0;
+    setup(&(sg_desc){
+        .memory_budget = {
+            .size = 2048,
+            .callback = budget_callback,
+            .user_data = &budget_num_called,
+        }
+    });
+    // stream buffers are counted once per inflight frame
+    const sg_buffer buf0 = sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_STREAM, .size = 256 });
+    T(budget_num_called == 0);
+    const sg_buffer buf1 = sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_STREAM, .size = 1024 });
+    T(budget_num_called == 1);
+    T(budget_over);
+    T(budget_user_data == &budget_num_called);
+    // the callback is only called when the threshold is crossed
+    const sg_buffer buf2 = sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_STREAM, .size = 256 });
+    T(budget_num_called == 1);
+    sg_destroy_buffer(buf1);
+    T(budget_num_called == 2);
+    T(!budget_over);
+    sg_destroy_buffer(buf2);
+    sg_destroy_buffer(buf0);
+    T(budget_num_called == 2);
+    T(sg_query_memory_stats().total == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, memory_budget_discard_context) {
+    budget_num_called = 0;
+    budget_over = false;
+    setup(&(sg_desc){
+        .memory_budget = {
+            .size = 2048,
+            .callback = budget_callback,
+        }
+    });
+    const sg_context ctx0 = _sg.active_context;
+    const uint64_t ctx0_size = sg_query_memory_stats().total;
+    const sg_context ctx1 = sg_setup_context();
+    sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_STREAM, .size = 1024 });
+    sg_make_image(&(sg_image_desc){ .render_target = true, .width = 16, .height = 16 });
+    T(budget_num_called == 1);
+    T(budget_over);
+    // resources of a discarded context no longer count against the budget
+    sg_discard_context(ctx1);
+    T(budget_num_called == 2);
+    T(!budget_over);
+    const sg_memory_stats mem = sg_query_memory_stats();
+    T(mem.total == ctx0_size);
+    T(mem.buffers.stream == 0);
+    T(mem.images.render_target == 0);
+    sg_activate_context(ctx0);
+    sg_shutdown();
+}
+
+// frees memory by destroying a resource when the memory usage goes over the budget
+static sg_buffer budget_destroy_buf;
+static bool budget_in_sokol_housekeeping;
+static void budget_destroy_callback(const sg_memory_stats* stats, bool over_budget, void* user_data) {
+    (void)stats; (void)user_data;
+    budget_num_called++;
+    budget_over = over_budget;
+    budget_in_sokol_housekeeping |= (_sg.memory.budget_lock != 0);
+    if (over_budget && (sg_query_buffer_state(budget_destroy_buf) == SG_RESOURCESTATE_VALID)) {
+        sg_destroy_buffer(budget_destroy_buf);
+    }
+}
+
+UTEST(sokol_gfx, memory_budget_teardown) {
+    budget_num_called = 0;
+    budget_over = false;
+    budget_in_sokol_housekeeping = false;
+    setup(&(sg_desc){
+        .memory_budget = {
+            .size = 2048,
+            .callback = budget_destroy_callback,
+        }
+    });
+    // the callback is called after the buffer has been created and may destroy resources
+    budget_destroy_buf = sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_STREAM, .size = 256 });
+    const sg_buffer buf = sg_make_buffer(&(sg_buffer_desc){ .usage = SG_USAGE_STREAM, .size = 1024 });
+    T(budget_num_called == 2);
+    T(!budget_over);
+    T(sg_query_buffer_state(budget_destroy_buf) == SG_RESOURCESTATE_INVALID);
+    T(sg_query_buffer_state(buf) == SG_RESOURCESTATE_VALID);
+    T(sg_query_memory_stats().total == sg_query_memory_stats().buffers.stream);
+    // transient images are reported after the transient bookkeeping is done
+    const sg_image img = sg_acquire_transient_image(&(sg_transient_image_desc){ .width = 64, .height = 64 });
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_VALID);
+    T(budget_num_called == 3);
+    T(budget_over);
+    sg_release_transient_image(img);
+    // ...and no callback while everything is torn down
+    sg_shutdown();
+    T(budget_num_called == 3);
+    T(!budget_in_sokol_housekeeping);
+}
@@ -0,0 +1,296 @@
+//------------------------------------------------------------------------------
+//  sfetch_pack.c
+//
+//  Command line tool to bundle files into a pack file which can be mounted
+//  with sfetch_mount_pack() (see the section PACK FILES in sokol_fetch.h
+//  for a description of the file format).
+//
+//  Usage: sfetch-pack [-a alignment] [-C dir] out.pack file...
+//
+//  -a alignment    alignment of the file data in bytes (default: 16)
+//  -C dir          read the input files relative to 'dir', the paths
+//                  in the pack file are the paths given on the command line
+//
+//  The paths are stored exactly as given (with backslashes replaced by
+//  forward slashes), and must be requested exactly like this in
+//  sfetch_send(). Absolute paths and paths with '..' components are
+//  rejected.
+//
+//  Build with:
+//
+//      cc -o sfetch-pack sfetch_pack.c
+//
+//  Define SFETCH_PACK_NO_MAIN to include this file into another C file
+//  and call sfetch_pack_write() directly.
+//------------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SFETCH_PACK_VERSION (2)
+#define SFETCH_PACK_HEADER_SIZE (16)
+#define SFETCH_PACK_ENTRY_SIZE (32)
+#define SFETCH_PACK_MAX_PATH (1024)
+
+typedef struct {
+    char path[SFETCH_PACK_MAX_PATH];    // path in the pack file
+    uint64_t path_hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t path_offset;               // offset of the path in the path table
+    uint32_t path_length;
+} sfetch_pack_entry_t;
+
+// 64-bit FNV-1a hash, must match _sfetch_pack_hash() in sokol_fetch.h
+static uint64_t sfetch_pack_hash(const char* str) {
+    uint64_t hash = 0xCBF29CE484222325;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+static void sfetch_pack_put_u32(uint8_t* dst, uint32_t val) {
+    for (int i = 0; i < 4; i++) {
+        dst[i] = (uint8_t)(val >> (i * 8));
+    }
+}
+
+static void sfetch_pack_put_u64(uint8_t* dst, uint64_t val) {
+    for (int i = 0; i < 8; i++) {
+        dst[i] = (uint8_t)(val >> (i * 8));
+    }
+}
+
+// paths must be relative and must not point outside of the pack file root
+static bool sfetch_pack_path_valid(const char* path) {
+    // a drive letter like 'C:' also makes a path absolute
+    if ((path[0] == 0) || (path[0] == '/') || (path[1] == ':')) {
+        return false;
+    }
+    const char* comp = path;
+    while (comp) {
+        const char* next = strchr(comp, '/');
+        const size_t len = next ? (size_t)(next - comp) : strlen(comp);
+        if ((len == 2) && (comp[0] == '.') && (comp[1] == '.')) {
+            return false;
+        }
+        comp = next ? next + 1 : 0;
+    }
+    return true;
+}
+
+static int sfetch_pack_compare_entries(const void* a, const void* b) {
+    const uint64_t hash_a = ((const sfetch_pack_entry_t*)a)->path_hash;
+    const uint64_t hash_b = ((const sfetch_pack_entry_t*)b)->path_hash;
+    return (hash_a < hash_b) ? -1 : ((hash_a > hash_b) ? 1 : 0);
+}
+
+static bool sfetch_pack_write_bytes(FILE* fp, const void* ptr, size_t num_bytes, uint64_t* pos) {
+    if ((num_bytes > 0) && (fwrite(ptr, 1, num_bytes, fp) != num_bytes)) {
+        return false;
+    }
+    *pos += num_bytes;
+    return true;
+}
+
+// zero-pad the output file up to the next multiple of the alignment
+static bool sfetch_pack_write_padding(FILE* fp, uint32_t alignment, uint64_t* pos) {
+    static const uint8_t zeros[256] = { 0 };
+    uint64_t num_bytes = (alignment - (*pos % alignment)) % alignment;
+    while (num_bytes > 0) {
+        const size_t n = (num_bytes > sizeof(zeros)) ? sizeof(zeros) : (size_t)num_bytes;
+        if (!sfetch_pack_write_bytes(fp, zeros, n, pos)) {
+            return false;
+        }
+        num_bytes -= n;
+    }
+    return true;
+}
+
+// append the content of a file to the pack file, and return its size
+static bool sfetch_pack_copy_file(FILE* dst, const char* src_path, uint64_t* pos, uint64_t* out_size) {
+    FILE* src = fopen(src_path, "rb");
+    if (!src) {
+        fprintf(stderr, "sfetch-pack: failed to open '%s'\n", src_path);
+        return false;
+    }
+    static uint8_t buf[64 * 1024];
+    uint64_t size = 0;
+    bool ok = true;
+    size_t num_read;
+    while ((num_read = fread(buf, 1, sizeof(buf), src)) > 0) {
+        if (!sfetch_pack_write_bytes(dst, buf, num_read, pos)) {
+            ok = false;
+            break;
+        }
+        size += num_read;
+    }
+    if (ferror(src)) {
+        fprintf(stderr, "sfetch-pack: failed to read '%s'\n", src_path);
+        ok = false;
+    }
+    fclose(src);
+    *out_size = size;
+    return ok;
+}
+
+// write a pack file with the given input files, returns false on error
+static bool sfetch_pack_write(const char* out_path, const char* dir, uint32_t alignment, int num_files, const char* const* paths) {
+    if ((alignment == 0) || (num_files < 0)) {
+        fprintf(stderr, "sfetch-pack: invalid arguments\n");
+        return false;
+    }
+    const size_t num_entries = (size_t)num_files;
+    sfetch_pack_entry_t* entries = (sfetch_pack_entry_t*) calloc(num_entries + 1, sizeof(sfetch_pack_entry_t));
+    if (!entries) {
+        fprintf(stderr, "sfetch-pack: out of memory\n");
+        return false;
+    }
+    for (size_t i = 0; i < num_entries; i++) {
+        if (strlen(paths[i]) >= SFETCH_PACK_MAX_PATH) {
+            fprintf(stderr, "sfetch-pack: path too long: '%s'\n", paths[i]);
+            free(entries);
+            return false;
+        }
+        strcpy(entries[i].path, paths[i]);
+        for (char* c = entries[i].path; *c; c++) {
+            if (*c == '\\') {
+                *c = '/';
+            }
+        }
+        if (!sfetch_pack_path_valid(entries[i].path)) {
+            fprintf(stderr, "sfetch-pack: absolute paths and '..' are not allowed: '%s'\n", paths[i]);
+            free(entries);
+            return false;
+        }
+        entries[i].path_hash = sfetch_pack_hash(entries[i].path);
+        entries[i].path_length = (uint32_t)strlen(entries[i].path);
+    }
+    qsort(entries, num_entries, sizeof(sfetch_pack_entry_t), sfetch_pack_compare_entries);
+    uint64_t paths_size = 0;
+    for (size_t i = 0; i < num_entries; i++) {
+        entries[i].path_offset = (uint32_t)paths_size;
+        paths_size += entries[i].path_length + 1;
+        if (paths_size > UINT32_MAX) {
+            fprintf(stderr, "sfetch-pack: too many paths\n");
+            free(entries);
+            return false;
+        }
+    }
+    for (size_t i = 1; i < num_entries; i++) {
+        if (entries[i].path_hash == entries[i-1].path_hash) {
+            if (0 == strcmp(entries[i].path, entries[i-1].path)) {
+                fprintf(stderr, "sfetch-pack: duplicate path '%s'\n", entries[i].path);
+            }
+            else {
+                fprintf(stderr, "sfetch-pack: hash collision between '%s' and '%s', rename one of the files\n", entries[i].path, entries[i-1].path);
+            }
+            free(entries);
+            return false;
+        }
+    }
+
+    FILE* fp = fopen(out_path, "wb");
+    if (!fp) {
+        fprintf(stderr, "sfetch-pack: failed to create '%s'\n", out_path);
+        free(entries);
+        return false;
+    }
+    // the header and index are written last, when all offsets and sizes are known,
+    // the path table follows the index
+    uint64_t pos = 0;
+    uint8_t zeros[SFETCH_PACK_ENTRY_SIZE] = { 0 };
+    bool ok = sfetch_pack_write_bytes(fp, zeros, SFETCH_PACK_HEADER_SIZE, &pos);
+    for (size_t i = 0; ok && (i < num_entries); i++) {
+        ok = sfetch_pack_write_bytes(fp, zeros, SFETCH_PACK_ENTRY_SIZE, &pos);
+    }
+    for (size_t i = 0; ok && (i < num_entries); i++) {
+        ok = sfetch_pack_write_bytes(fp, entries[i].path, entries[i].path_length + 1, &pos);
+    }
+    for (size_t i = 0; ok && (i < num_entries); i++) {
+        char src_path[2 * SFETCH_PACK_MAX_PATH];
+        if (dir) {
+            snprintf(src_path, sizeof(src_path), "%s/%s", dir, entries[i].path);
+        }
+        else {
+            snprintf(src_path, sizeof(src_path), "%s", entries[i].path);
+        }
+        ok = sfetch_pack_write_padding(fp, alignment, &pos);
+        entries[i].offset = pos;
+        ok = ok && sfetch_pack_copy_file(fp, src_path, &pos, &entries[i].size);
+    }
+    if (ok) {
+        uint8_t header[SFETCH_PACK_HEADER_SIZE];
+        memcpy(header, "SFPK", 4);
+        sfetch_pack_put_u32(header + 4, SFETCH_PACK_VERSION);
+        sfetch_pack_put_u32(header + 8, (uint32_t)num_entries);
+        sfetch_pack_put_u32(header + 12, alignment);
+        ok = (0 == fseek(fp, 0, SEEK_SET));
+        pos = 0;
+        ok = ok && sfetch_pack_write_bytes(fp, header, sizeof(header), &pos);
+        for (size_t i = 0; ok && (i < num_entries); i++) {
+            uint8_t entry[SFETCH_PACK_ENTRY_SIZE];
+            sfetch_pack_put_u64(entry, entries[i].path_hash);
+            sfetch_pack_put_u64(entry + 8, entries[i].offset);
+            sfetch_pack_put_u64(entry + 16, entries[i].size);
+            sfetch_pack_put_u32(entry + 24, entries[i].path_offset);
+            sfetch_pack_put_u32(entry + 28, entries[i].path_length);
+            ok = sfetch_pack_write_bytes(fp, entry, sizeof(entry), &pos);
+        }
+        if (!ok) {
+            fprintf(stderr, "sfetch-pack: failed to write '%s'\n", out_path);
+        }
+    }
+    if (0 != fclose(fp)) {
+        ok = false;
+    }
+    if (!ok) {
+        remove(out_path);
+    }
+    free(entries);
+    return ok;
+}
+
+#if !defined(SFETCH_PACK_NO_MAIN)
+static void sfetch_pack_usage(void) {
+    fprintf(stderr, "usage: sfetch-pack [-a alignment] [-C dir] out.pack file...\n");
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t alignment = 16;
+    const char* dir = 0;
+    int arg = 1;
+    while ((arg < argc) && (argv[arg][0] == '-')) {
+        if ((0 == strcmp(argv[arg], "-a")) && ((arg + 1) < argc)) {
+            const long val = strtol(argv[arg + 1], 0, 10);
+            if ((val <= 0) || (val > (1 << 20))) {
+                fprintf(stderr, "sfetch-pack: invalid alignment '%s'\n", argv[arg + 1]);
+                return 10;
+            }
+            alignment = (uint32_t)val;
+            arg += 2;
+        }
+        else if ((0 == strcmp(argv[arg], "-C")) && ((arg + 1) < argc)) {
+            dir = argv[arg + 1];
+            arg += 2;
+        }
+        else {
+            sfetch_pack_usage();
+            return 10;
+        }
+    }
+    if ((argc - arg) < 2) {
+        sfetch_pack_usage();
+        return 10;
+    }
+    const char* out_path = argv[arg];
+    if (!sfetch_pack_write(out_path, dir, alignment, argc - arg - 1, (const char* const*)&argv[arg + 1])) {
+        return 10;
+    }
+    return 0;
+}
+#endif
@@ -276,10 +276,12 @@ typedef struct sg_imgui_shader_t {
     sg_imgui_str_t vs_d3d11_target;
     sg_imgui_str_t vs_image_sampler_name[SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS];
     sg_imgui_str_t vs_uniform_name[SG_MAX_SHADERSTAGE_UBS][SG_MAX_UB_MEMBERS];
+    sg_imgui_str_t vs_uniform_block_name[SG_MAX_SHADERSTAGE_UBS];
     sg_imgui_str_t fs_entry;
     sg_imgui_str_t fs_d3d11_target;
     sg_imgui_str_t fs_image_sampler_name[SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS];
     sg_imgui_str_t fs_uniform_name[SG_MAX_SHADERSTAGE_UBS][SG_MAX_UB_MEMBERS];
+    sg_imgui_str_t fs_uniform_block_name[SG_MAX_SHADERSTAGE_UBS];
     sg_imgui_str_t attr_name[SG_MAX_VERTEX_ATTRIBUTES];
     sg_imgui_str_t attr_sem_name[SG_MAX_VERTEX_ATTRIBUTES];
     sg_shader_desc desc;
@@ -1014,6 +1016,12 @@ _SOKOL_PRIVATE int _sg_imgui_slot_index(uint32_t id) {
     return slot_index;
 }
 
+// resources in slots added by a growing sokol-gfx pool are not tracked, they map to the unused slot 0
+_SOKOL_PRIVATE int _sg_imgui_tracked_slot_index(uint32_t id, int num_slots) {
+    const int slot_index = _sg_imgui_slot_index(id);
+    return (slot_index < num_slots) ? slot_index : 0;
+}
+
 _SOKOL_PRIVATE uint32_t _sg_imgui_align_u32(uint32_t val, uint32_t align) {
     SOKOL_ASSERT((align > 0) && ((align & (align - 1)) == 0));
     return (val + (align - 1)) & ~(align - 1);
@@ -1138,6 +1146,7 @@ _SOKOL_PRIVATE const char* _sg_imgui_resourcestate_string(sg_resource_state s) {
         case SG_RESOURCESTATE_ALLOC:    return "SG_RESOURCESTATE_ALLOC";
         case SG_RESOURCESTATE_VALID:    return "SG_RESOURCESTATE_VALID";
         case SG_RESOURCESTATE_FAILED:   return "SG_RESOURCESTATE_FAILED";
+        case SG_RESOURCESTATE_PENDING:  return "SG_RESOURCESTATE_PENDING";
         default:                        return "SG_RESOURCESTATE_INVALID";
     }
 }
@@ -1166,6 +1175,8 @@ _SOKOL_PRIVATE const char* _sg_imgui_buffertype_string(sg_buffer_type t) {
     switch (t) {
         case SG_BUFFERTYPE_VERTEXBUFFER:    return "SG_BUFFERTYPE_VERTEXBUFFER";
         case SG_BUFFERTYPE_INDEXBUFFER:     return "SG_BUFFERTYPE_INDEXBUFFER";
+        case SG_BUFFERTYPE_INDIRECTBUFFER:  return "SG_BUFFERTYPE_INDIRECTBUFFER";
+        case SG_BUFFERTYPE_STORAGEBUFFER:   return "SG_BUFFERTYPE_STORAGEBUFFER";
         default:                            return "???";
     }
 }
@@ -1175,6 +1186,7 @@ _SOKOL_PRIVATE const char* _sg_imgui_usage_string(sg_usage u) {
         case SG_USAGE_IMMUTABLE:    return "SG_USAGE_IMMUTABLE";
         case SG_USAGE_DYNAMIC:      return "SG_USAGE_DYNAMIC";
         case SG_USAGE_STREAM:       return "SG_USAGE_STREAM";
+        case SG_USAGE_STREAM_RING:  return "SG_USAGE_STREAM_RING";
         default:                    return "???";
     }
 }
@@ -1479,6 +1491,7 @@ _SOKOL_PRIVATE const char* _sg_imgui_shaderstage_string(sg_shader_stage stage) {
     switch (stage) {
         case SG_SHADERSTAGE_VS:     return "SG_SHADERSTAGE_VS";
         case SG_SHADERSTAGE_FS:     return "SG_SHADERSTAGE_FS";
+        case SG_SHADERSTAGE_CS:     return "SG_SHADERSTAGE_CS";
         default:                    return "???";
     }
 }
@@ -1505,7 +1518,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_res_id_string(uint32_t res_id, const cha
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_buffer_id_string(sg_imgui_t* ctx, sg_buffer buf_id) {
     if (buf_id.id != SG_INVALID_ID) {
-        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(buf_id.id)];
+        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_tracked_slot_index(buf_id.id, ctx->buffers.num_slots)];
         return _sg_imgui_res_id_string(buf_id.id, buf_ui->label.buf);
     } else {
         return _sg_imgui_make_str("<invalid>");
@@ -1514,7 +1527,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_buffer_id_string(sg_imgui_t* ctx, sg_buf
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_image_id_string(sg_imgui_t* ctx, sg_image img_id) {
     if (img_id.id != SG_INVALID_ID) {
-        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img_id.id)];
+        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_tracked_slot_index(img_id.id, ctx->images.num_slots)];
         return _sg_imgui_res_id_string(img_id.id, img_ui->label.buf);
     } else {
         return _sg_imgui_make_str("<invalid>");
@@ -1523,7 +1536,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_image_id_string(sg_imgui_t* ctx, sg_imag
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_sampler_id_string(sg_imgui_t* ctx, sg_sampler smp_id) {
     if (smp_id.id != SG_INVALID_ID) {
-        const sg_imgui_sampler_t* smp_ui = &ctx->samplers.slots[_sg_imgui_slot_index(smp_id.id)];
+        const sg_imgui_sampler_t* smp_ui = &ctx->samplers.slots[_sg_imgui_tracked_slot_index(smp_id.id, ctx->samplers.num_slots)];
         return _sg_imgui_res_id_string(smp_id.id, smp_ui->label.buf);
     } else {
         return _sg_imgui_make_str("<invalid>");
@@ -1532,7 +1545,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_sampler_id_string(sg_imgui_t* ctx, sg_sa
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_shader_id_string(sg_imgui_t* ctx, sg_shader shd_id) {
     if (shd_id.id != SG_INVALID_ID) {
-        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(shd_id.id)];
+        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_tracked_slot_index(shd_id.id, ctx->shaders.num_slots)];
         return _sg_imgui_res_id_string(shd_id.id, shd_ui->label.buf);
     } else {
         return _sg_imgui_make_str("<invalid>");
@@ -1541,7 +1554,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_shader_id_string(sg_imgui_t* ctx, sg_sha
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pipeline_id_string(sg_imgui_t* ctx, sg_pipeline pip_id) {
     if (pip_id.id != SG_INVALID_ID) {
-        const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(pip_id.id)];
+        const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_tracked_slot_index(pip_id.id, ctx->pipelines.num_slots)];
         return _sg_imgui_res_id_string(pip_id.id, pip_ui->label.buf);
     } else {
         return _sg_imgui_make_str("<invalid>");
@@ -1550,7 +1563,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pipeline_id_string(sg_imgui_t* ctx, sg_p
 
 _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pass_id_string(sg_imgui_t* ctx, sg_pass pass_id) {
     if (pass_id.id != SG_INVALID_ID) {
-        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(pass_id.id)];
+        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_tracked_slot_index(pass_id.id, ctx->passes.num_slots)];
         return _sg_imgui_res_id_string(pass_id.id, pass_ui->label.buf);
     } else {
         return _sg_imgui_make_str("<invalid>");
@@ -1559,7 +1572,10 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pass_id_string(sg_imgui_t* ctx, sg_pass
 
 /*--- RESOURCE HELPERS -------------------------------------------------------*/
 _SOKOL_PRIVATE void _sg_imgui_buffer_created(sg_imgui_t* ctx, sg_buffer res_id, int slot_index, const sg_buffer_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->buffers.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->buffers.num_slots) {
+        return;
+    }
     sg_imgui_buffer_t* buf = &ctx->buffers.slots[slot_index];
     buf->res_id = res_id;
     buf->desc = *desc;
@@ -1567,13 +1583,19 @@ _SOKOL_PRIVATE void _sg_imgui_buffer_created(sg_imgui_t* ctx, sg_buffer res_id,
 }
 
 _SOKOL_PRIVATE void _sg_imgui_buffer_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->buffers.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->buffers.num_slots) {
+        return;
+    }
     sg_imgui_buffer_t* buf = &ctx->buffers.slots[slot_index];
     buf->res_id.id = SG_INVALID_ID;
 }
 
 _SOKOL_PRIVATE void _sg_imgui_image_created(sg_imgui_t* ctx, sg_image res_id, int slot_index, const sg_image_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->images.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->images.num_slots) {
+        return;
+    }
     sg_imgui_image_t* img = &ctx->images.slots[slot_index];
     img->res_id = res_id;
     img->desc = *desc;
@@ -1587,14 +1609,20 @@ _SOKOL_PRIVATE void _sg_imgui_image_created(sg_imgui_t* ctx, sg_image res_id, in
 }
 
 _SOKOL_PRIVATE void _sg_imgui_image_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->images.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->images.num_slots) {
+        return;
+    }
     sg_imgui_image_t* img = &ctx->images.slots[slot_index];
     img->res_id.id = SG_INVALID_ID;
     simgui_destroy_image(img->simgui_img);
 }
 
 _SOKOL_PRIVATE void _sg_imgui_sampler_created(sg_imgui_t* ctx, sg_sampler res_id, int slot_index, const sg_sampler_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->samplers.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->samplers.num_slots) {
+        return;
+    }
     sg_imgui_sampler_t* smp = &ctx->samplers.slots[slot_index];
     smp->res_id = res_id;
     smp->desc = *desc;
@@ -1602,13 +1630,19 @@ _SOKOL_PRIVATE void _sg_imgui_sampler_created(sg_imgui_t* ctx, sg_sampler res_id
 }
 
 _SOKOL_PRIVATE void _sg_imgui_sampler_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->samplers.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->samplers.num_slots) {
+        return;
+    }
     sg_imgui_sampler_t* smp = &ctx->samplers.slots[slot_index];
     smp->res_id.id = SG_INVALID_ID;
 }
 
 _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id, int slot_index, const sg_shader_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->shaders.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->shaders.num_slots) {
+        return;
+    }
     sg_imgui_shader_t* shd = &ctx->shaders.slots[slot_index];
     shd->res_id = res_id;
     shd->desc = *desc;
@@ -1630,6 +1664,11 @@ _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id,
         shd->desc.fs.d3d11_target = shd->fs_d3d11_target.buf;
     }
     for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        sg_shader_uniform_block_desc* ubd = &shd->desc.vs.uniform_blocks[i];
+        if (ubd->glsl_name) {
+            shd->vs_uniform_block_name[i] = _sg_imgui_make_str(ubd->glsl_name);
+            ubd->glsl_name = shd->vs_uniform_block_name[i].buf;
+        }
         for (int j = 0; j < SG_MAX_UB_MEMBERS; j++) {
             sg_shader_uniform_desc* ud = &shd->desc.vs.uniform_blocks[i].uniforms[j];
             if (ud->name) {
@@ -1639,6 +1678,11 @@ _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id,
         }
     }
     for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        sg_shader_uniform_block_desc* ubd = &shd->desc.fs.uniform_blocks[i];
+        if (ubd->glsl_name) {
+            shd->fs_uniform_block_name[i] = _sg_imgui_make_str(ubd->glsl_name);
+            ubd->glsl_name = shd->fs_uniform_block_name[i].buf;
+        }
         for (int j = 0; j < SG_MAX_UB_MEMBERS; j++) {
             sg_shader_uniform_desc* ud = &shd->desc.fs.uniform_blocks[i].uniforms[j];
             if (ud->name) {
@@ -1671,6 +1715,24 @@ _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id,
     if (shd->desc.fs.bytecode.ptr) {
         shd->desc.fs.bytecode.ptr = _sg_imgui_bin_dup(&ctx->desc.allocator, shd->desc.fs.bytecode.ptr, shd->desc.fs.bytecode.size);
     }
+    // compute stage names are not tracked, only the code is kept
+    shd->desc.cs.entry = 0;
+    shd->desc.cs.d3d11_target = 0;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        shd->desc.cs.uniform_blocks[i].glsl_name = 0;
+        for (int j = 0; j < SG_MAX_UB_MEMBERS; j++) {
+            shd->desc.cs.uniform_blocks[i].uniforms[j].name = 0;
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGESAMPLERPAIRS; i++) {
+        shd->desc.cs.image_sampler_pairs[i].glsl_name = 0;
+    }
+    if (shd->desc.cs.source) {
+        shd->desc.cs.source = _sg_imgui_str_dup(&ctx->desc.allocator, shd->desc.cs.source);
+    }
+    if (shd->desc.cs.bytecode.ptr) {
+        shd->desc.cs.bytecode.ptr = _sg_imgui_bin_dup(&ctx->desc.allocator, shd->desc.cs.bytecode.ptr, shd->desc.cs.bytecode.size);
+    }
     for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
         sg_shader_attr_desc* ad = &shd->desc.attrs[i];
         if (ad->name) {
@@ -1685,7 +1747,10 @@ _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id,
 }
 
 _SOKOL_PRIVATE void _sg_imgui_shader_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->shaders.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->shaders.num_slots) {
+        return;
+    }
     sg_imgui_shader_t* shd = &ctx->shaders.slots[slot_index];
     shd->res_id.id = SG_INVALID_ID;
     if (shd->desc.vs.source) {
@@ -1704,10 +1769,21 @@ _SOKOL_PRIVATE void _sg_imgui_shader_destroyed(sg_imgui_t* ctx, int slot_index)
         _sg_imgui_free(&ctx->desc.allocator, (void*)shd->desc.fs.bytecode.ptr);
         shd->desc.fs.bytecode.ptr = 0;
     }
+    if (shd->desc.cs.source) {
+        _sg_imgui_free(&ctx->desc.allocator, (void*)shd->desc.cs.source);
+        shd->desc.cs.source = 0;
+    }
+    if (shd->desc.cs.bytecode.ptr) {
+        _sg_imgui_free(&ctx->desc.allocator, (void*)shd->desc.cs.bytecode.ptr);
+        shd->desc.cs.bytecode.ptr = 0;
+    }
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pipeline_created(sg_imgui_t* ctx, sg_pipeline res_id, int slot_index, const sg_pipeline_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->pipelines.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->pipelines.num_slots) {
+        return;
+    }
     sg_imgui_pipeline_t* pip = &ctx->pipelines.slots[slot_index];
     pip->res_id = res_id;
     pip->label = _sg_imgui_make_str(desc->label);
@@ -1716,13 +1792,19 @@ _SOKOL_PRIVATE void _sg_imgui_pipeline_created(sg_imgui_t* ctx, sg_pipeline res_
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pipeline_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->pipelines.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->pipelines.num_slots) {
+        return;
+    }
     sg_imgui_pipeline_t* pip = &ctx->pipelines.slots[slot_index];
     pip->res_id.id = SG_INVALID_ID;
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pass_created(sg_imgui_t* ctx, sg_pass res_id, int slot_index, const sg_pass_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->passes.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->passes.num_slots) {
+        return;
+    }
     sg_imgui_pass_t* pass = &ctx->passes.slots[slot_index];
     pass->res_id = res_id;
     for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
@@ -1735,7 +1817,10 @@ _SOKOL_PRIVATE void _sg_imgui_pass_created(sg_imgui_t* ctx, sg_pass res_id, int
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pass_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->passes.num_slots));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->passes.num_slots) {
+        return;
+    }
     sg_imgui_pass_t* pass = &ctx->passes.slots[slot_index];
     pass->res_id.id = SG_INVALID_ID;
 }
@@ -3184,7 +3269,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_resid_link(uint32_t res_type, uint32_t res_id
 _SOKOL_PRIVATE bool _sg_imgui_draw_buffer_link(sg_imgui_t* ctx, sg_buffer buf) {
     bool retval = false;
     if (buf.id != SG_INVALID_ID) {
-        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(buf.id)];
+        const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_tracked_slot_index(buf.id, ctx->buffers.num_slots)];
         retval = _sg_imgui_draw_resid_link(1, buf.id, buf_ui->label.buf);
     }
     return retval;
@@ -3193,7 +3278,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_buffer_link(sg_imgui_t* ctx, sg_buffer buf) {
 _SOKOL_PRIVATE bool _sg_imgui_draw_image_link(sg_imgui_t* ctx, sg_image img) {
     bool retval = false;
     if (img.id != SG_INVALID_ID) {
-        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img.id)];
+        const sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_tracked_slot_index(img.id, ctx->images.num_slots)];
         retval = _sg_imgui_draw_resid_link(2, img.id, img_ui->label.buf);
     }
     return retval;
@@ -3202,7 +3287,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_image_link(sg_imgui_t* ctx, sg_image img) {
 _SOKOL_PRIVATE bool _sg_imgui_draw_sampler_link(sg_imgui_t* ctx, sg_sampler smp) {
     bool retval = false;
     if (smp.id != SG_INVALID_ID) {
-        const sg_imgui_sampler_t* smp_ui = &ctx->samplers.slots[_sg_imgui_slot_index(smp.id)];
+        const sg_imgui_sampler_t* smp_ui = &ctx->samplers.slots[_sg_imgui_tracked_slot_index(smp.id, ctx->samplers.num_slots)];
         retval = _sg_imgui_draw_resid_link(2, smp.id, smp_ui->label.buf);
     }
     return retval;
@@ -3211,7 +3296,7 @@ _SOKOL_PRIVATE bool _sg_imgui_draw_sampler_link(sg_imgui_t* ctx, sg_sampler smp)
 _SOKOL_PRIVATE bool _sg_imgui_draw_shader_link(sg_imgui_t* ctx, sg_shader shd) {
     bool retval = false;
     if (shd.id != SG_INVALID_ID) {
-        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(shd.id)];
+        const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_tracked_slot_index(shd.id, ctx->shaders.num_slots)];
         retval = _sg_imgui_draw_resid_link(3, shd.id, shd_ui->label.buf);
     }
     return retval;
@@ -3370,13 +3455,14 @@ _SOKOL_PRIVATE void _sg_imgui_draw_buffer_panel(sg_imgui_t* ctx, sg_buffer buf)
         igBeginChild_Str("buffer", IMVEC2(0,0), false, 0);
         sg_buffer_info info = sg_query_buffer_info(buf);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_slot_index(buf.id)];
+            const sg_imgui_buffer_t* buf_ui = &ctx->buffers.slots[_sg_imgui_tracked_slot_index(buf.id, ctx->buffers.num_slots)];
             igText("Label: %s", buf_ui->label.buf[0] ? buf_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             igSeparator();
             igText("Type:  %s", _sg_imgui_buffertype_string(buf_ui->desc.type));
             igText("Usage: %s", _sg_imgui_usage_string(buf_ui->desc.usage));
             igText("Size:  %d", buf_ui->desc.size);
+            igText("Memory Size: %d KB", (int)(info.memory_size / 1024));
             if (buf_ui->desc.usage != SG_USAGE_IMMUTABLE) {
                 igSeparator();
                 igText("Num Slots:     %d", info.num_slots);
@@ -3401,7 +3487,7 @@ _SOKOL_PRIVATE bool _sg_imgui_image_renderable(sg_image_type type, sg_pixel_form
 
 _SOKOL_PRIVATE void _sg_imgui_draw_embedded_image(sg_imgui_t* ctx, sg_image img, float* scale) {
     if (sg_query_image_state(img) == SG_RESOURCESTATE_VALID) {
-        sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img.id)];
+        sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_tracked_slot_index(img.id, ctx->images.num_slots)];
         if (_sg_imgui_image_renderable(img_ui->desc.type, img_ui->desc.pixel_format, img_ui->desc.sample_count)) {
             igPushID_Int((int)img.id);
             igSliderFloat("Scale", scale, 0.125f, 8.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
@@ -3420,7 +3506,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_image_panel(sg_imgui_t* ctx, sg_image img) {
         igBeginChild_Str("image", IMVEC2(0,0), false, 0);
         sg_image_info info = sg_query_image_info(img);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_slot_index(img.id)];
+            sg_imgui_image_t* img_ui = &ctx->images.slots[_sg_imgui_tracked_slot_index(img.id, ctx->images.num_slots)];
             const sg_image_desc* desc = &img_ui->desc;
             igText("Label: %s", img_ui->label.buf[0] ? img_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
@@ -3434,8 +3520,10 @@ _SOKOL_PRIVATE void _sg_imgui_draw_image_panel(sg_imgui_t* ctx, sg_image img) {
             igText("Height:         %d", desc->height);
             igText("Num Slices:     %d", desc->num_slices);
             igText("Num Mipmaps:    %d", desc->num_mipmaps);
+            igText("Gen Mipmaps:    %s", _sg_imgui_bool_string(desc->generate_mipmaps));
             igText("Pixel Format:   %s", _sg_imgui_pixelformat_string(desc->pixel_format));
             igText("Sample Count:   %d", desc->sample_count);
+            igText("Memory Size:    %d KB", (int)(info.memory_size / 1024));
             if (desc->usage != SG_USAGE_IMMUTABLE) {
                 igSeparator();
                 igText("Num Slots:     %d", info.num_slots);
@@ -3454,7 +3542,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_sampler_panel(sg_imgui_t* ctx, sg_sampler smp
         igBeginChild_Str("sampler", IMVEC2(0,0), false, 0);
         sg_sampler_info info = sg_query_sampler_info(smp);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            sg_imgui_sampler_t* smp_ui = &ctx->samplers.slots[_sg_imgui_slot_index(smp.id)];
+            sg_imgui_sampler_t* smp_ui = &ctx->samplers.slots[_sg_imgui_tracked_slot_index(smp.id, ctx->samplers.num_slots)];
             const sg_sampler_desc* desc = &smp_ui->desc;
             igText("Label: %s", smp_ui->label.buf[0] ? smp_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
@@ -3517,7 +3605,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_shader_stage(const sg_shader_stage_desc* stag
         if (igTreeNode_Str("Uniform Blocks")) {
             for (int i = 0; i < num_valid_ubs; i++) {
                 const sg_shader_uniform_block_desc* ub = &stage->uniform_blocks[i];
-                igText("#%d: (size: %d layout: %s)\n", i, ub->size, _sg_imgui_uniformlayout_string(ub->layout));
+                igText("#%d: (size: %d layout: %s glsl_name: %s)\n", i, ub->size, _sg_imgui_uniformlayout_string(ub->layout), ub->glsl_name ? ub->glsl_name : "---");
                 for (int j = 0; j < SG_MAX_UB_MEMBERS; j++) {
                     const sg_shader_uniform_desc* u = &ub->uniforms[j];
                     if (SG_UNIFORMTYPE_INVALID != u->type) {
@@ -3591,7 +3679,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_shader_panel(sg_imgui_t* ctx, sg_shader shd)
         igBeginChild_Str("shader", IMVEC2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
         sg_shader_info info = sg_query_shader_info(shd);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(shd.id)];
+            const sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_tracked_slot_index(shd.id, ctx->shaders.num_slots)];
             igText("Label: %s", shd_ui->label.buf[0] ? shd_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             igSeparator();
@@ -3615,6 +3703,10 @@ _SOKOL_PRIVATE void _sg_imgui_draw_shader_panel(sg_imgui_t* ctx, sg_shader shd)
                 _sg_imgui_draw_shader_stage(&shd_ui->desc.fs);
                 igTreePop();
             }
+            if ((shd_ui->desc.cs.source || shd_ui->desc.cs.bytecode.ptr) && igTreeNode_Str("Compute Shader Stage")) {
+                _sg_imgui_draw_shader_stage(&shd_ui->desc.cs);
+                igTreePop();
+            }
         } else {
             igText("Shader 0x%08X not valid!", shd.id);
         }
@@ -3704,7 +3796,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_pipeline_panel(sg_imgui_t* ctx, sg_pipeline p
         igBeginChild_Str("pipeline", IMVEC2(0,0), false, 0);
         sg_pipeline_info info = sg_query_pipeline_info(pip);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(pip.id)];
+            const sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_tracked_slot_index(pip.id, ctx->pipelines.num_slots)];
             igText("Label: %s", pip_ui->label.buf[0] ? pip_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             igSeparator();
@@ -3763,7 +3855,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_pass_panel(sg_imgui_t* ctx, sg_pass pass) {
         igBeginChild_Str("pass", IMVEC2(0,0), false, 0);
         sg_pass_info info = sg_query_pass_info(pass);
         if (info.slot.state == SG_RESOURCESTATE_VALID) {
-            sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(pass.id)];
+            sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_tracked_slot_index(pass.id, ctx->passes.num_slots)];
             igText("Label: %s", pass_ui->label.buf[0] ? pass_ui->label.buf : "---");
             _sg_imgui_draw_resource_slot(&info.slot);
             for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
@@ -3881,16 +3973,18 @@ _SOKOL_PRIVATE void _sg_imgui_draw_uniforms_panel(sg_imgui_t* ctx, const sg_imgu
         igText("Pipeline object not valid!");
         return;
    }
-    sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_slot_index(args->pipeline.id)];
+    sg_imgui_pipeline_t* pip_ui = &ctx->pipelines.slots[_sg_imgui_tracked_slot_index(args->pipeline.id, ctx->pipelines.num_slots)];
     if (sg_query_shader_state(pip_ui->desc.shader) != SG_RESOURCESTATE_VALID) {
         igText("Shader object not valid!");
         return;
     }
-    sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_slot_index(pip_ui->desc.shader.id)];
+    sg_imgui_shader_t* shd_ui = &ctx->shaders.slots[_sg_imgui_tracked_slot_index(pip_ui->desc.shader.id, ctx->shaders.num_slots)];
     SOKOL_ASSERT(shd_ui->res_id.id == pip_ui->desc.shader.id);
     const sg_shader_uniform_block_desc* ub_desc = (args->stage == SG_SHADERSTAGE_VS) ?
         &shd_ui->desc.vs.uniform_blocks[args->ub_index] :
-        &shd_ui->desc.fs.uniform_blocks[args->ub_index];
+        ((args->stage == SG_SHADERSTAGE_FS) ?
+            &shd_ui->desc.fs.uniform_blocks[args->ub_index] :
+            &shd_ui->desc.cs.uniform_blocks[args->ub_index]);
     SOKOL_ASSERT(args->data_size <= ub_desc->size);
     bool draw_dump = false;
     if (ub_desc->uniforms[0].type == SG_UNIFORMTYPE_INVALID) {
@@ -3979,7 +4073,7 @@ _SOKOL_PRIVATE void _sg_imgui_draw_passaction_panel(sg_imgui_t* ctx, sg_pass pas
         /* default pass: one color attachment */
         num_color_atts = 1;
     } else {
-        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_slot_index(pass.id)];
+        const sg_imgui_pass_t* pass_ui = &ctx->passes.slots[_sg_imgui_tracked_slot_index(pass.id, ctx->passes.num_slots)];
         for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
             if (pass_ui->desc.color_attachments[i].image.id != SG_INVALID_ID) {
                 num_color_atts++;
@@ -4188,6 +4282,13 @@ _SOKOL_PRIVATE void _sg_imgui_draw_caps_panel(void) {
     igText("    image_clamp_to_border: %s", _sg_imgui_bool_string(f.image_clamp_to_border));
     igText("    mrt_independent_blend_state: %s", _sg_imgui_bool_string(f.mrt_independent_blend_state));
     igText("    mrt_independent_write_mask: %s", _sg_imgui_bool_string(f.mrt_independent_write_mask));
+    igText("    multi_draw: %s", _sg_imgui_bool_string(f.multi_draw));
+    igText("    draw_indirect: %s", _sg_imgui_bool_string(f.draw_indirect));
+    igText("    pass_timings: %s", _sg_imgui_bool_string(f.pass_timings));
+    igText("    image_upload: %s", _sg_imgui_bool_string(f.image_upload));
+    igText("    image_read: %s", _sg_imgui_bool_string(f.image_read));
+    igText("    generate_mipmaps: %s", _sg_imgui_bool_string(f.generate_mipmaps));
+    igText("    compute: %s", _sg_imgui_bool_string(f.compute));
     sg_limits l = sg_query_limits();
     igText("\nLimits:\n");
     igText("    max_image_size_2d: %d", l.max_image_size_2d);
@@ -4246,14 +4347,29 @@ _SOKOL_PRIVATE void _sg_imgui_draw_frame_stats_panel(sg_imgui_t* ctx) {
         _sg_imgui_frame_stats(num_apply_pipeline);
         _sg_imgui_frame_stats(num_apply_bindings);
         _sg_imgui_frame_stats(num_apply_uniforms);
+        _sg_imgui_frame_stats(num_skipped_apply_uniforms);
+        _sg_imgui_frame_stats(num_pipeline_cache_hits);
+        _sg_imgui_frame_stats(num_pipeline_cache_misses);
+        _sg_imgui_frame_stats(num_queue_draw);
+        _sg_imgui_frame_stats(num_queue_saved_apply_pipeline);
+        _sg_imgui_frame_stats(num_queue_saved_apply_bindings);
+        _sg_imgui_frame_stats(num_shader_cache_hits);
+        _sg_imgui_frame_stats(num_shader_cache_misses);
+        _sg_imgui_frame_stats(num_apply_pending_pipeline);
+        _sg_imgui_frame_stats(num_transient_hits);
+        _sg_imgui_frame_stats(num_transient_misses);
         _sg_imgui_frame_stats(num_draw);
         _sg_imgui_frame_stats(num_update_buffer);
         _sg_imgui_frame_stats(num_append_buffer);
         _sg_imgui_frame_stats(num_update_image);
+        _sg_imgui_frame_stats(num_image_upload);
+        _sg_imgui_frame_stats(num_generate_mipmaps);
+        _sg_imgui_frame_stats(num_dispatch);
         _sg_imgui_frame_stats(size_apply_uniforms);
         _sg_imgui_frame_stats(size_update_buffer);
         _sg_imgui_frame_stats(size_append_buffer);
         _sg_imgui_frame_stats(size_update_image);
+        _sg_imgui_frame_stats(size_image_upload);
         switch (sg_query_backend()) {
             case SG_BACKEND_GLCORE33:
             case SG_BACKEND_GLES3:
@@ -4268,6 +4384,9 @@ _SOKOL_PRIVATE void _sg_imgui_draw_frame_stats_panel(sg_imgui_t* ctx) {
                 _sg_imgui_frame_stats(gl.num_enable_vertex_attrib_array);
                 _sg_imgui_frame_stats(gl.num_disable_vertex_attrib_array);
                 _sg_imgui_frame_stats(gl.num_uniform);
+                _sg_imgui_frame_stats(gl.num_bind_uniform_buffer);
+                _sg_imgui_frame_stats(gl.num_upload_uniform_buffer);
+                _sg_imgui_frame_stats(gl.size_upload_uniform_buffer);
                 break;
             case SG_BACKEND_WGPU:
                 _sg_imgui_frame_stats(wgpu.uniforms.num_set_bindgroup);